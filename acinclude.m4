@@ -64,6 +64,16 @@ AC_DEFUN([AX_LIBEWF_CHECK_LOCAL],
   dnl Check for internationalization functions in libewf/libewf_i18n.c 
   AC_CHECK_FUNCS([bindtextdomain])
 
+  dnl Check for memory mapped file functions in libewf/libewf_file_mapping.c
+  AC_CHECK_HEADERS([fcntl.h sys/mman.h sys/stat.h unistd.h])
+  AC_CHECK_FUNCS([mmap munmap])
+
+  dnl Check for asynchronous file IO headers in libewf/libewf_io_uring.c
+  AC_CHECK_HEADERS([errno.h])
+
+  dnl Check for buffered file IO functions in libewf/libewf_buffered_file_io_handle.c
+  AC_CHECK_FUNCS([fallocate posix_fadvise posix_fallocate posix_memalign sync_file_range])
+
   dnl Check if library should be build with verbose output
   AX_COMMON_CHECK_ENABLE_VERBOSE_OUTPUT
 
@@ -92,6 +102,9 @@ AC_DEFUN([AX_EWFTOOLS_CHECK_LOCAL],
   [dnl Headers used in ewftools
   AC_CHECK_HEADERS([signal.h sys/signal.h unistd.h])
 
+  dnl Headers used in ewftools/nbd_handle.c
+  AC_CHECK_HEADERS([sys/socket.h sys/un.h])
+
   dnl Functions used in ewftools
   AC_CHECK_FUNCS([close getopt setvbuf])
 
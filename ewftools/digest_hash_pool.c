@@ -0,0 +1,873 @@
+/*
+ * Digest hash pool
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "digest_hash_pool.h"
+#include "ewftools_libcerror.h"
+#include "ewftools_libcnotify.h"
+#include "ewftools_libcthreads.h"
+#include "ewftools_libhmac.h"
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Creates a digest hash pool
+ * Make sure the value digest_hash_pool is referencing, is set to NULL
+ *
+ * A thread is started for every digest context that is set. The digest
+ * contexts are referenced by the pool and must remain available until
+ * the pool is joined or freed.
+ * Returns 1 if successful or -1 on error
+ */
+int digest_hash_pool_initialize(
+     digest_hash_pool_t **digest_hash_pool,
+     libhmac_md5_context_t *md5_context,
+     libhmac_sha1_context_t *sha1_context,
+     libhmac_sha256_context_t *sha256_context,
+     libcerror_error_t **error )
+{
+	digest_hash_pool_worker_t *worker = NULL;
+	static char *function             = "digest_hash_pool_initialize";
+	int digest_type                   = 0;
+
+	if( digest_hash_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest hash pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *digest_hash_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid digest hash pool value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*digest_hash_pool = memory_allocate_structure(
+	                     digest_hash_pool_t );
+
+	if( *digest_hash_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create digest hash pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *digest_hash_pool,
+	     0,
+	     sizeof( digest_hash_pool_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear digest hash pool.",
+		 function );
+
+		memory_free(
+		 *digest_hash_pool );
+
+		*digest_hash_pool = NULL;
+
+		return( -1 );
+	}
+	( *digest_hash_pool )->md5_context    = md5_context;
+	( *digest_hash_pool )->sha1_context   = sha1_context;
+	( *digest_hash_pool )->sha256_context = sha256_context;
+
+	if( libcthreads_mutex_initialize(
+	     &( ( *digest_hash_pool )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *digest_hash_pool )->condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create condition.",
+		 function );
+
+		goto on_error;
+	}
+	for( digest_type = 0;
+	     digest_type < DIGEST_HASH_POOL_NUMBER_OF_DIGEST_TYPES;
+	     digest_type++ )
+	{
+		if( ( ( digest_type == DIGEST_HASH_POOL_DIGEST_TYPE_MD5 )
+		  &&  ( md5_context == NULL ) )
+		 || ( ( digest_type == DIGEST_HASH_POOL_DIGEST_TYPE_SHA1 )
+		  &&  ( sha1_context == NULL ) )
+		 || ( ( digest_type == DIGEST_HASH_POOL_DIGEST_TYPE_SHA256 )
+		  &&  ( sha256_context == NULL ) ) )
+		{
+			continue;
+		}
+		worker = &( ( *digest_hash_pool )->workers[ digest_type ] );
+
+		worker->digest_hash_pool = *digest_hash_pool;
+		worker->digest_type      = digest_type;
+
+		if( libcthreads_thread_create(
+		     &( worker->thread ),
+		     NULL,
+		     (int (*)(void *)) &digest_hash_pool_worker_callback,
+		     (void *) worker,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create digest hash thread: %d.",
+			 function,
+			 digest_type );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( *digest_hash_pool != NULL )
+	{
+		digest_hash_pool_free(
+		 digest_hash_pool,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees a digest hash pool
+ * Any thread that is still running is joined first
+ * Returns 1 if successful or -1 on error
+ */
+int digest_hash_pool_free(
+     digest_hash_pool_t **digest_hash_pool,
+     libcerror_error_t **error )
+{
+	static char *function = "digest_hash_pool_free";
+	int buffer_index      = 0;
+	int digest_type       = 0;
+	int result            = 1;
+
+	if( digest_hash_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest hash pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *digest_hash_pool != NULL )
+	{
+		for( digest_type = 0;
+		     digest_type < DIGEST_HASH_POOL_NUMBER_OF_DIGEST_TYPES;
+		     digest_type++ )
+		{
+			if( ( *digest_hash_pool )->workers[ digest_type ].thread != NULL )
+			{
+				break;
+			}
+		}
+		if( digest_type < DIGEST_HASH_POOL_NUMBER_OF_DIGEST_TYPES )
+		{
+			/* The status of the digest hashes is irrelevant here
+			 */
+			if( digest_hash_pool_join(
+			     *digest_hash_pool,
+			     NULL ) != 1 )
+			{
+				for( digest_type = 0;
+				     digest_type < DIGEST_HASH_POOL_NUMBER_OF_DIGEST_TYPES;
+				     digest_type++ )
+				{
+					if( ( *digest_hash_pool )->workers[ digest_type ].thread != NULL )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+						 "%s: unable to join digest hash thread: %d.",
+						 function,
+						 digest_type );
+
+						result = -1;
+
+						break;
+					}
+				}
+			}
+		}
+		if( ( *digest_hash_pool )->condition != NULL )
+		{
+			if( libcthreads_condition_free(
+			     &( ( *digest_hash_pool )->condition ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free condition.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *digest_hash_pool )->mutex != NULL )
+		{
+			if( libcthreads_mutex_free(
+			     &( ( *digest_hash_pool )->mutex ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free mutex.",
+				 function );
+
+				result = -1;
+			}
+		}
+		for( buffer_index = 0;
+		     buffer_index < DIGEST_HASH_POOL_NUMBER_OF_BUFFERS;
+		     buffer_index++ )
+		{
+			if( ( *digest_hash_pool )->buffers[ buffer_index ] != NULL )
+			{
+				memory_free(
+				 ( *digest_hash_pool )->buffers[ buffer_index ] );
+			}
+		}
+		memory_free(
+		 *digest_hash_pool );
+
+		*digest_hash_pool = NULL;
+	}
+	return( result );
+}
+
+/* Updates the digest hashes with a copy of the buffer
+ * Blocks while all the buffers in the ring are still being hashed
+ * Returns 1 if successful or -1 on error
+ */
+int digest_hash_pool_update(
+     digest_hash_pool_t *digest_hash_pool,
+     const uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	void *reallocation                = NULL;
+	static char *function             = "digest_hash_pool_update";
+	uint64_t number_of_hashed_buffers = 0;
+	int buffer_index                  = 0;
+	int digest_type                   = 0;
+	int status                        = 0;
+
+	if( digest_hash_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest hash pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( digest_hash_pool->finished != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid digest hash pool - already finished.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( buffer_size == 0 )
+	 || ( buffer_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     digest_hash_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	/* Wait until every thread has hashed the oldest buffer in the ring
+	 */
+	do
+	{
+		status = digest_hash_pool->status;
+
+		if( status != 0 )
+		{
+			break;
+		}
+		number_of_hashed_buffers = digest_hash_pool->number_of_buffers;
+
+		for( digest_type = 0;
+		     digest_type < DIGEST_HASH_POOL_NUMBER_OF_DIGEST_TYPES;
+		     digest_type++ )
+		{
+			if( ( digest_hash_pool->workers[ digest_type ].thread != NULL )
+			 && ( digest_hash_pool->workers[ digest_type ].number_of_hashed_buffers < number_of_hashed_buffers ) )
+			{
+				number_of_hashed_buffers = digest_hash_pool->workers[ digest_type ].number_of_hashed_buffers;
+			}
+		}
+		if( ( digest_hash_pool->number_of_buffers - number_of_hashed_buffers ) < DIGEST_HASH_POOL_NUMBER_OF_BUFFERS )
+		{
+			break;
+		}
+		if( libcthreads_condition_wait(
+		     digest_hash_pool->condition,
+		     digest_hash_pool->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to wait for condition.",
+			 function );
+
+			libcthreads_mutex_release(
+			 digest_hash_pool->mutex,
+			 NULL );
+
+			return( -1 );
+		}
+	}
+	while( 1 );
+
+	buffer_index = (int) ( digest_hash_pool->number_of_buffers % DIGEST_HASH_POOL_NUMBER_OF_BUFFERS );
+
+	if( libcthreads_mutex_release(
+	     digest_hash_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( status != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update digest hash.",
+		 function );
+
+		return( -1 );
+	}
+	/* None of the threads references the buffer at this point
+	 */
+	if( buffer_size > digest_hash_pool->buffer_sizes[ buffer_index ] )
+	{
+		reallocation = memory_reallocate(
+		                digest_hash_pool->buffers[ buffer_index ],
+		                sizeof( uint8_t ) * buffer_size );
+
+		if( reallocation == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize buffer: %d.",
+			 function,
+			 buffer_index );
+
+			return( -1 );
+		}
+		digest_hash_pool->buffers[ buffer_index ]      = (uint8_t *) reallocation;
+		digest_hash_pool->buffer_sizes[ buffer_index ] = buffer_size;
+	}
+	if( memory_copy(
+	     digest_hash_pool->buffers[ buffer_index ],
+	     buffer,
+	     buffer_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy buffer: %d.",
+		 function,
+		 buffer_index );
+
+		return( -1 );
+	}
+	digest_hash_pool->buffer_data_sizes[ buffer_index ] = buffer_size;
+
+	if( libcthreads_mutex_grab(
+	     digest_hash_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	digest_hash_pool->number_of_buffers += 1;
+
+	if( libcthreads_condition_broadcast(
+	     digest_hash_pool->condition,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to broadcast condition.",
+		 function );
+
+		libcthreads_mutex_release(
+		 digest_hash_pool->mutex,
+		 NULL );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_release(
+	     digest_hash_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Waits for the threads to hash the remaining buffers and joins them
+ * After the pool was joined the digest contexts can be finalized
+ * Returns 1 if successful or -1 on error
+ */
+int digest_hash_pool_join(
+     digest_hash_pool_t *digest_hash_pool,
+     libcerror_error_t **error )
+{
+	static char *function = "digest_hash_pool_join";
+	int digest_type       = 0;
+	int result            = 1;
+
+	if( digest_hash_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest hash pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     digest_hash_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	digest_hash_pool->finished = 1;
+
+	if( libcthreads_condition_broadcast(
+	     digest_hash_pool->condition,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to broadcast condition.",
+		 function );
+
+		libcthreads_mutex_release(
+		 digest_hash_pool->mutex,
+		 NULL );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_release(
+	     digest_hash_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	for( digest_type = 0;
+	     digest_type < DIGEST_HASH_POOL_NUMBER_OF_DIGEST_TYPES;
+	     digest_type++ )
+	{
+		if( digest_hash_pool->workers[ digest_type ].thread == NULL )
+		{
+			continue;
+		}
+		if( libcthreads_thread_join(
+		     &( digest_hash_pool->workers[ digest_type ].thread ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join digest hash thread: %d.",
+			 function,
+			 digest_type );
+
+			result = -1;
+		}
+	}
+	if( ( result == 1 )
+	 && ( digest_hash_pool->status != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update digest hash.",
+		 function );
+
+		result = -1;
+	}
+	return( result );
+}
+
+/* Hashes the buffers in the ring for a specific digest type
+ * Callback function for the digest hash threads
+ * Returns 1 if successful or -1 on error
+ */
+int digest_hash_pool_worker_callback(
+     digest_hash_pool_worker_t *worker )
+{
+	digest_hash_pool_t *digest_hash_pool = NULL;
+	libcerror_error_t *error             = NULL;
+	uint8_t *buffer                      = NULL;
+	static char *function                = "digest_hash_pool_worker_callback";
+	size_t buffer_size                   = 0;
+	int buffer_index                     = 0;
+	int result                           = 0;
+
+	if( worker == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid worker.",
+		 function );
+
+		goto on_error;
+	}
+	digest_hash_pool = worker->digest_hash_pool;
+
+	if( digest_hash_pool == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid worker - missing digest hash pool.",
+		 function );
+
+		goto on_error;
+	}
+	do
+	{
+		if( libcthreads_mutex_grab(
+		     digest_hash_pool->mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			goto on_error;
+		}
+		while( ( worker->number_of_hashed_buffers == digest_hash_pool->number_of_buffers )
+		    && ( digest_hash_pool->finished == 0 )
+		    && ( digest_hash_pool->status == 0 ) )
+		{
+			if( libcthreads_condition_wait(
+			     digest_hash_pool->condition,
+			     digest_hash_pool->mutex,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to wait for condition.",
+				 function );
+
+				libcthreads_mutex_release(
+				 digest_hash_pool->mutex,
+				 NULL );
+
+				goto on_error;
+			}
+		}
+		buffer = NULL;
+
+		if( ( worker->number_of_hashed_buffers < digest_hash_pool->number_of_buffers )
+		 && ( digest_hash_pool->status == 0 ) )
+		{
+			buffer_index = (int) ( worker->number_of_hashed_buffers % DIGEST_HASH_POOL_NUMBER_OF_BUFFERS );
+			buffer       = digest_hash_pool->buffers[ buffer_index ];
+			buffer_size  = digest_hash_pool->buffer_data_sizes[ buffer_index ];
+		}
+		if( libcthreads_mutex_release(
+		     digest_hash_pool->mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			goto on_error;
+		}
+		if( buffer == NULL )
+		{
+			break;
+		}
+		switch( worker->digest_type )
+		{
+			case DIGEST_HASH_POOL_DIGEST_TYPE_MD5:
+				result = libhmac_md5_update(
+				          digest_hash_pool->md5_context,
+				          buffer,
+				          buffer_size,
+				          &error );
+				break;
+
+			case DIGEST_HASH_POOL_DIGEST_TYPE_SHA1:
+				result = libhmac_sha1_update(
+				          digest_hash_pool->sha1_context,
+				          buffer,
+				          buffer_size,
+				          &error );
+				break;
+
+			case DIGEST_HASH_POOL_DIGEST_TYPE_SHA256:
+				result = libhmac_sha256_update(
+				          digest_hash_pool->sha256_context,
+				          buffer,
+				          buffer_size,
+				          &error );
+				break;
+
+			default:
+				result = -1;
+				break;
+		}
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update digest hash: %d.",
+			 function,
+			 worker->digest_type );
+
+			goto on_error;
+		}
+		if( libcthreads_mutex_grab(
+		     digest_hash_pool->mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			goto on_error;
+		}
+		worker->number_of_hashed_buffers += 1;
+
+		if( libcthreads_condition_broadcast(
+		     digest_hash_pool->condition,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to broadcast condition.",
+			 function );
+
+			libcthreads_mutex_release(
+			 digest_hash_pool->mutex,
+			 NULL );
+
+			goto on_error;
+		}
+		if( libcthreads_mutex_release(
+		     digest_hash_pool->mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	while( 1 );
+
+	return( 1 );
+
+on_error:
+	if( digest_hash_pool != NULL )
+	{
+		/* Wake up the thread that is waiting for the ring to drain
+		 */
+		if( libcthreads_mutex_grab(
+		     digest_hash_pool->mutex,
+		     NULL ) == 1 )
+		{
+			digest_hash_pool->status = -1;
+
+			libcthreads_condition_broadcast(
+			 digest_hash_pool->condition,
+			 NULL );
+
+			libcthreads_mutex_release(
+			 digest_hash_pool->mutex,
+			 NULL );
+		}
+	}
+	if( error != NULL )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
@@ -0,0 +1,156 @@
+/*
+ * Digest hash pool
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _DIGEST_HASH_POOL_H )
+#define _DIGEST_HASH_POOL_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
+#include "ewftools_libhmac.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* The number of buffers in the ring shared by the digest hash threads
+ */
+#define DIGEST_HASH_POOL_NUMBER_OF_BUFFERS		16
+
+enum DIGEST_HASH_POOL_DIGEST_TYPES
+{
+	DIGEST_HASH_POOL_DIGEST_TYPE_MD5		= 0,
+	DIGEST_HASH_POOL_DIGEST_TYPE_SHA1		= 1,
+	DIGEST_HASH_POOL_DIGEST_TYPE_SHA256		= 2,
+
+	DIGEST_HASH_POOL_NUMBER_OF_DIGEST_TYPES		= 3
+};
+
+typedef struct digest_hash_pool digest_hash_pool_t;
+
+typedef struct digest_hash_pool_worker digest_hash_pool_worker_t;
+
+struct digest_hash_pool_worker
+{
+	/* The digest hash pool
+	 */
+	digest_hash_pool_t *digest_hash_pool;
+
+	/* The digest type
+	 */
+	int digest_type;
+
+	/* The thread
+	 */
+	libcthreads_thread_t *thread;
+
+	/* The number of buffers hashed by the thread
+	 */
+	uint64_t number_of_hashed_buffers;
+};
+
+struct digest_hash_pool
+{
+	/* The MD5 digest context
+	 */
+	libhmac_md5_context_t *md5_context;
+
+	/* The SHA1 digest context
+	 */
+	libhmac_sha1_context_t *sha1_context;
+
+	/* The SHA256 digest context
+	 */
+	libhmac_sha256_context_t *sha256_context;
+
+	/* The workers, one per digest type
+	 */
+	digest_hash_pool_worker_t workers[ DIGEST_HASH_POOL_NUMBER_OF_DIGEST_TYPES ];
+
+	/* The buffers, used as a ring buffer in update order
+	 */
+	uint8_t *buffers[ DIGEST_HASH_POOL_NUMBER_OF_BUFFERS ];
+
+	/* The allocated sizes of the buffers
+	 */
+	size_t buffer_sizes[ DIGEST_HASH_POOL_NUMBER_OF_BUFFERS ];
+
+	/* The sizes of the data in the buffers
+	 */
+	size_t buffer_data_sizes[ DIGEST_HASH_POOL_NUMBER_OF_BUFFERS ];
+
+	/* The number of buffers pushed onto the ring
+	 */
+	uint64_t number_of_buffers;
+
+	/* Value to indicate no more buffers will be pushed
+	 */
+	uint8_t finished;
+
+	/* The status, 0 if the threads are running without error or -1 on error
+	 */
+	int status;
+
+	/* The mutex that protects the ring state
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The condition that is signalled when the ring state changes
+	 */
+	libcthreads_condition_t *condition;
+};
+
+int digest_hash_pool_initialize(
+     digest_hash_pool_t **digest_hash_pool,
+     libhmac_md5_context_t *md5_context,
+     libhmac_sha1_context_t *sha1_context,
+     libhmac_sha256_context_t *sha256_context,
+     libcerror_error_t **error );
+
+int digest_hash_pool_free(
+     digest_hash_pool_t **digest_hash_pool,
+     libcerror_error_t **error );
+
+int digest_hash_pool_update(
+     digest_hash_pool_t *digest_hash_pool,
+     const uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error );
+
+int digest_hash_pool_join(
+     digest_hash_pool_t *digest_hash_pool,
+     libcerror_error_t **error );
+
+int digest_hash_pool_worker_callback(
+     digest_hash_pool_worker_t *worker );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _DIGEST_HASH_POOL_H ) */
+
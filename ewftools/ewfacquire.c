@@ -49,6 +49,7 @@
 #include "ewftools_unused.h"
 #include "imaging_handle.h"
 #include "log_handle.h"
+#include "output_writer_pool.h"
 #include "process_status.h"
 #include "storage_media_buffer.h"
 #include "storage_media_buffer_queue.h"
@@ -125,13 +126,18 @@ void ewfacquire_usage_fprint(
 	                 "                  [ -e examiner_name ] [ -E evidence_number ] [ -f format ]\n"
 	                 "                  [ -g number_of_sectors ] [ -j jobs ] [ -l log_filename ]\n"
 	                 "                  [ -m media_type ] [ -M media_flags ] [ -N notes ]\n"
-	                 "                  [ -o offset ] [ -p process_buffer_size ]\n"
-	                 "                  [ -P bytes_per_sector ] [ -r read_error_retries ]\n"
+	                 "                  [ -o offset ] [ -O write_mode ]\n"
+	                 "                  [ -p process_buffer_size ] [ -P bytes_per_sector ]\n"
+	                 "                  [ -r read_error_retries ]\n"
 	                 "                  [ -S segment_file_size ] [ -t target ] [ -T toc_file ]\n"
-	                 "                  [ -2 secondary_target ] [ -hqRsuvVwx ] source\n\n" );
+	                 "                  [ -2 secondary_target ] [ -ahqRsuvVwxy ] source\n\n" );
 
 	fprintf( stream, "\tsource: the source file(s) or device\n\n" );
 
+	fprintf( stream, "\t-a:     pre-allocate the segment files to the segment file size\n"
+	                 "\t        to reduce file system fragmentation, the unused space is\n"
+	                 "\t        released when a segment file is closed (not used with\n"
+	                 "\t        write mode: unbuffered)\n" );
 	fprintf( stream, "\t-A:     codepage of header section, options: ascii (default),\n"
 	                 "\t        windows-874, windows-932, windows-936, windows-949,\n"
 	                 "\t        windows-950, windows-1250, windows-1251, windows-1252,\n"
@@ -170,6 +176,10 @@ void ewfacquire_usage_fprint(
 	fprintf( stream, "\t-M:     specify the media flags, options: logical, physical (default)\n" );
 	fprintf( stream, "\t-N:     specify the notes (default is notes).\n" );
 	fprintf( stream, "\t-o:     specify the offset to start to acquire (default is 0)\n" );
+	fprintf( stream, "\t-O:     specify how the segment files are written, options: buffered\n"
+	                 "\t        (default), nocache (releases the written data from the page\n"
+	                 "\t        cache), direct (bypasses the page cache where supported) or\n"
+	                 "\t        unbuffered (writes every chunk and section separately)\n" );
 	fprintf( stream, "\t-p:     specify the process buffer size (default is the chunk size)\n" );
 	fprintf( stream, "\t-P:     specify the number of bytes per sector (default is 512)\n"
 	                 "\t        (use this to override the automatic bytes per sector detection)\n" );
@@ -210,8 +220,12 @@ void ewfacquire_usage_fprint(
 	fprintf( stream, "\t-w:     zero sectors on read error (mimic EnCase like behavior)\n" );
 	fprintf( stream, "\t-x:     use the chunk data instead of the buffered read and write\n"
 	                 "\t        functions.\n" );
-	fprintf( stream, "\t-2:     specify the secondary target file (without extension) to write\n"
-	                 "\t        to\n" );
+	fprintf( stream, "\t-y:     use adaptive compression, which stores chunks uncompressed\n"
+	                 "\t        in regions of incompressible data without compressing them\n"
+	                 "\t        in full (not used with compression level: none or for the\n"
+	                 "\t        ewf and smart formats)\n" );
+	fprintf( stream, "\t-2:     specify a secondary target file (without extension) to write\n"
+	                 "\t        to, can be repeated to write more than one secondary target\n" );
 }
 
 /* Signal handler for ewfacquire
@@ -777,6 +791,16 @@ int ewfacquire_read_input(
 
 		goto on_error;
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* Pack the chunks once in the process thread pool so that the output writer pool
+	 * only needs to write them to the secondary output handles
+	 */
+	if( ( imaging_handle->number_of_threads != 0 )
+	 && ( imaging_handle->number_of_secondary_output_handles > 0 ) )
+	{
+		use_chunk_data_functions = 1;
+	}
+#endif
 	if( use_chunk_data_functions != 0 )
 	{
 		process_buffer_size       = (size_t) chunk_size;
@@ -865,6 +889,19 @@ int ewfacquire_read_input(
 
 			goto on_error;
 		}
+		if( imaging_handle_initialize_output_writer_pool(
+		     imaging_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize output writer pool.",
+			 function );
+
+			goto on_error;
+		}
 	}
 #endif
 	if( imaging_handle_initialize_integrity_hash(
@@ -1275,6 +1312,35 @@ int ewfacquire_read_input(
 			goto on_error;
 		}
 	}
+	if( imaging_handle->output_writer_pool != NULL )
+	{
+		if( output_writer_pool_join(
+		     imaging_handle->output_writer_pool,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join output writer pool.",
+			 function );
+
+			goto on_error;
+		}
+		if( output_writer_pool_free(
+		     &( imaging_handle->output_writer_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free output writer pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	if( imaging_handle->output_list != NULL )
 	{
 		if( imaging_handle_empty_output_list(
@@ -1534,6 +1600,12 @@ on_error:
 		 &( imaging_handle->output_thread_pool ),
 		 NULL );
 	}
+	if( imaging_handle->output_writer_pool != NULL )
+	{
+		output_writer_pool_free(
+		 &( imaging_handle->output_writer_pool ),
+		 NULL );
+	}
 	if( imaging_handle->output_list != NULL )
 	{
 		imaging_handle_empty_output_list(
@@ -1565,6 +1637,7 @@ int main( int argc, char * const argv[] )
 	system_character_t input_buffer[ EWFACQUIRE_INPUT_BUFFER_SIZE ];
 	system_character_t media_information_model[ 64 ];
 	system_character_t media_information_serial_number[ 64 ];
+	system_character_t *option_secondary_target_filenames[ IMAGING_HANDLE_MAXIMUM_NUMBER_OF_SECONDARY_TARGETS ];
 
 	libcerror_error_t *error                             = NULL;
 	log_handle_t *log_handle                             = NULL;
@@ -1585,8 +1658,8 @@ int main( int argc, char * const argv[] )
 	system_character_t *option_number_of_error_retries   = NULL;
 	system_character_t *option_number_of_jobs            = NULL;
 	system_character_t *option_offset                    = NULL;
+	system_character_t *option_output_write_mode         = NULL;
 	system_character_t *option_process_buffer_size       = NULL;
-	system_character_t *option_secondary_target_filename = NULL;
 	system_character_t *option_sector_error_granularity  = NULL;
 	system_character_t *option_sectors_per_chunk         = NULL;
 	system_character_t *option_size                      = NULL;
@@ -1598,15 +1671,20 @@ int main( int argc, char * const argv[] )
 	size_t string_length                                 = 0;
 	off64_t resume_acquiry_offset                        = 0;
 	uint8_t calculate_md5                                = 1;
+	uint8_t preallocate_segment_files                    = 0;
 	uint8_t print_status_information                     = 1;
 	uint8_t resume_acquiry                               = 0;
 	uint8_t swap_byte_pairs                              = 0;
+	uint8_t use_adaptive_compression                     = 0;
 	uint8_t use_chunk_data_functions                     = 0;
 	uint8_t verbose                                      = 0;
 	uint8_t zero_buffer_on_error                         = 0;
 	int8_t acquiry_parameters_confirmed                  = 0;
 	int interactive_mode                                 = 1;
+	int number_of_secondary_targets                      = 0;
 	int result                                           = 0;
+	int secondary_target_index                           = 0;
+	int target_index                                     = 0;
 
 	libcnotify_stream_set(
 	 stderr,
@@ -1641,7 +1719,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = ewftools_getopt(
 	                   argc,
 	                   argv,
-	                   _SYSTEM_STRING( "A:b:B:c:C:d:D:e:E:f:g:hj:l:m:M:N:o:p:P:qr:RsS:t:T:uvVwx2:" ) ) ) != (system_integer_t) -1 )
+	                   _SYSTEM_STRING( "aA:b:B:c:C:d:D:e:E:f:g:hj:l:m:M:N:o:O:p:P:qr:RsS:t:T:uvVwxy2:" ) ) ) != (system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -1661,6 +1739,11 @@ int main( int argc, char * const argv[] )
 
 				goto on_error;
 
+			case (system_integer_t) 'a':
+				preallocate_segment_files = 1;
+
+				break;
+
 			case (system_integer_t) 'A':
 				option_header_codepage = optarg;
 
@@ -1756,6 +1839,11 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (system_integer_t) 'O':
+				option_output_write_mode = optarg;
+
+				break;
+
 			case (system_integer_t) 'p':
 				option_process_buffer_size = optarg;
 
@@ -1831,8 +1919,28 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (system_integer_t) 'y':
+				use_adaptive_compression = 1;
+
+				break;
+
 			case (system_integer_t) '2':
-				option_secondary_target_filename = optarg;
+				if( number_of_secondary_targets >= IMAGING_HANDLE_MAXIMUM_NUMBER_OF_SECONDARY_TARGETS )
+				{
+					ewftools_output_version_fprint(
+					 stdout,
+					 program );
+
+					fprintf(
+					 stderr,
+					 "Unsupported number of secondary targets, maximum is: %d.\n",
+					 IMAGING_HANDLE_MAXIMUM_NUMBER_OF_SECONDARY_TARGETS );
+
+					goto on_error;
+				}
+				option_secondary_target_filenames[ number_of_secondary_targets ] = optarg;
+
+				number_of_secondary_targets++;
 
 				break;
 		}
@@ -1880,25 +1988,49 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
-	if( ( option_target_filename != NULL )
-	 && ( option_secondary_target_filename != NULL ) )
+	for( secondary_target_index = 0;
+	     secondary_target_index < number_of_secondary_targets;
+	     secondary_target_index++ )
 	{
 		string_length = system_string_length(
-				 option_secondary_target_filename );
+				 option_secondary_target_filenames[ secondary_target_index ] );
 
-		if( system_string_length(
-		     option_target_filename ) == string_length )
+		if( option_target_filename != NULL )
 		{
-			if( system_string_compare(
-			     option_target_filename,
-			     option_secondary_target_filename,
-			     string_length ) == 0 )
+			if( system_string_length(
+			     option_target_filename ) == string_length )
 			{
-				fprintf(
-				 stderr,
-				 "Primary and secondary target cannot be the same.\n" );
+				if( system_string_compare(
+				     option_target_filename,
+				     option_secondary_target_filenames[ secondary_target_index ],
+				     string_length ) == 0 )
+				{
+					fprintf(
+					 stderr,
+					 "Primary and secondary target cannot be the same.\n" );
 
-				goto on_error;
+					goto on_error;
+				}
+			}
+		}
+		for( target_index = 0;
+		     target_index < secondary_target_index;
+		     target_index++ )
+		{
+			if( system_string_length(
+			     option_secondary_target_filenames[ target_index ] ) == string_length )
+			{
+				if( system_string_compare(
+				     option_secondary_target_filenames[ target_index ],
+				     option_secondary_target_filenames[ secondary_target_index ],
+				     string_length ) == 0 )
+				{
+					fprintf(
+					 stderr,
+					 "Secondary targets cannot be the same.\n" );
+
+					goto on_error;
+				}
 			}
 		}
 	}
@@ -2131,13 +2263,15 @@ int main( int argc, char * const argv[] )
 			}
 		}
 	}
-	if( option_secondary_target_filename != NULL )
+	for( secondary_target_index = 0;
+	     secondary_target_index < number_of_secondary_targets;
+	     secondary_target_index++ )
 	{
 		if( imaging_handle_set_string(
 		     ewfacquire_imaging_handle,
-		     option_secondary_target_filename,
-		     &( ewfacquire_imaging_handle->secondary_target_filename ),
-		     &( ewfacquire_imaging_handle->secondary_target_filename_size ),
+		     option_secondary_target_filenames[ secondary_target_index ],
+		     &( ewfacquire_imaging_handle->secondary_target_filenames[ secondary_target_index ] ),
+		     &( ewfacquire_imaging_handle->secondary_target_filename_sizes[ secondary_target_index ] ),
 		     &error ) != 1 )
 		{
 			fprintf(
@@ -2146,11 +2280,13 @@ int main( int argc, char * const argv[] )
 
 			goto on_error;
 		}
+		ewfacquire_imaging_handle->number_of_secondary_targets += 1;
+
 		/* Make sure we can write the secondary target file
 		 */
 		if( imaging_handle_check_write_access(
 		     ewfacquire_imaging_handle,
-		     ewfacquire_imaging_handle->secondary_target_filename,
+		     ewfacquire_imaging_handle->secondary_target_filenames[ secondary_target_index ],
 		     &error ) != 1 )
 		{
 #if defined( HAVE_VERBOSE_OUTPUT )
@@ -2516,6 +2652,43 @@ int main( int argc, char * const argv[] )
 			 "Unsupported acquiry size defaulting to: all bytes.\n" );
 		}
 	}
+	if( option_output_write_mode != NULL )
+	{
+		result = imaging_handle_set_write_mode(
+			  ewfacquire_imaging_handle,
+			  option_output_write_mode,
+			  &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set write mode.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported write mode defaulting to: buffered.\n" );
+		}
+	}
+	if( preallocate_segment_files != 0 )
+	{
+		if( ewfacquire_imaging_handle->write_buffer_size == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Pre-allocation is not supported with write mode: unbuffered.\n" );
+		}
+		else
+		{
+			ewfacquire_imaging_handle->write_flags |= LIBEWF_WRITE_FLAG_PREALLOCATE;
+		}
+	}
+	ewfacquire_imaging_handle->use_adaptive_compression = use_adaptive_compression;
+
 	if( option_process_buffer_size != NULL )
 	{
 		result = imaging_handle_set_process_buffer_size(
@@ -3191,11 +3364,13 @@ int main( int argc, char * const argv[] )
 
 			goto on_error;
 		}
-		if( ewfacquire_imaging_handle->secondary_target_filename != NULL )
+		for( secondary_target_index = 0;
+		     secondary_target_index < ewfacquire_imaging_handle->number_of_secondary_targets;
+		     secondary_target_index++ )
 		{
 			if( imaging_handle_open_secondary_output(
 			     ewfacquire_imaging_handle,
-			     ewfacquire_imaging_handle->secondary_target_filename,
+			     ewfacquire_imaging_handle->secondary_target_filenames[ secondary_target_index ],
 			     resume_acquiry,
 			     &error ) != 1 )
 			{
@@ -56,6 +56,7 @@
 #include "ewftools_unused.h"
 #include "imaging_handle.h"
 #include "log_handle.h"
+#include "output_writer_pool.h"
 #include "process_status.h"
 #include "storage_media_buffer.h"
 #include "storage_media_buffer_queue.h"
@@ -123,13 +124,18 @@ void usage_fprint(
 	                 "                        [ -E evidence_number ] [ -f format ] [ -j jobs ]\n"
 	                 "                        [ -l log_filename ] [ -m media_type ]\n"
 	                 "                        [ -M media_flags ] [ -N notes ]\n"
-	                 "                        [ -o offset ] [ -p process_buffer_size ]\n"
+	                 "                        [ -o offset ] [ -O write_mode ]\n"
+	                 "                        [ -p process_buffer_size ]\n"
 	                 "                        [ -P bytes_per_sector ] [ -S segment_file_size ]\n"
 	                 "                        [ -t target ] [ -2 secondary_target ]\n"
-	                 "                        [ -hqsvVx ]\n\n" );
+	                 "                        [ -ahqsvVxy ]\n\n" );
 
 	fprintf( stream, "\tReads data from stdin\n\n" );
 
+	fprintf( stream, "\t-a: pre-allocate the segment files to the segment file size\n"
+	                 "\t    to reduce file system fragmentation, the unused space is\n"
+	                 "\t    released when a segment file is closed (not used with\n"
+	                 "\t    write mode: unbuffered)\n" );
 	fprintf( stream, "\t-A: codepage of header section, options: ascii (default),\n"
 	                 "\t    windows-874, windows-932, windows-936, windows-949,\n"
 	                 "\t    windows-950, windows-1250, windows-1251, windows-1252,\n"
@@ -167,6 +173,10 @@ void usage_fprint(
 	fprintf( stream, "\t-M: specify the media flags, options: logical, physical (default)\n" );
 	fprintf( stream, "\t-N: specify the notes (default is notes).\n" );
 	fprintf( stream, "\t-o: specify the offset to start to acquire (default is 0)\n" );
+	fprintf( stream, "\t-O: specify how the segment files are written, options: buffered\n"
+	                 "\t    (default), nocache (releases the written data from the page\n"
+	                 "\t    cache), direct (bypasses the page cache where supported) or\n"
+	                 "\t    unbuffered (writes every chunk and section separately)\n" );
 	fprintf( stream, "\t-p: specify the process buffer size (default is the chunk size)\n" );
 	fprintf( stream, "\t-P: specify the number of bytes per sector (default is 512)\n" );
 	fprintf( stream, "\t-q: quiet shows minimal status information\n" );
@@ -198,7 +208,11 @@ void usage_fprint(
 	fprintf( stream, "\t-v: verbose output to stderr\n" );
 	fprintf( stream, "\t-V: print version\n" );
 	fprintf( stream, "\t-x: use the chunk data instead of the buffered read and write functions.\n" );
-	fprintf( stream, "\t-2: specify the secondary target file (without extension) to write to\n" );
+	fprintf( stream, "\t-y: use adaptive compression, which stores chunks uncompressed in regions\n"
+	                 "\t    of incompressible data without compressing them in full (not used\n"
+	                 "\t    with compression level: none or for the ewf and smart formats)\n" );
+	fprintf( stream, "\t-2: specify a secondary target file (without extension) to write to,\n"
+	                 "\t    can be repeated to write more than one secondary target\n" );
 }
 
 /* Signal handler for ewfacquire
@@ -587,6 +601,16 @@ int ewfacquirestream_read_input(
 
 		return( -1 );
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* Pack the chunks once in the process thread pool so that the output writer pool
+	 * only needs to write them to the secondary output handles
+	 */
+	if( ( imaging_handle->number_of_threads != 0 )
+	 && ( imaging_handle->number_of_secondary_output_handles > 0 ) )
+	{
+		use_chunk_data_functions = 1;
+	}
+#endif
 	if( use_chunk_data_functions != 0 )
 	{
 		process_buffer_size       = (size_t) chunk_size;
@@ -675,6 +699,19 @@ int ewfacquirestream_read_input(
 
 			goto on_error;
 		}
+		if( imaging_handle_initialize_output_writer_pool(
+		     imaging_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize output writer pool.",
+			 function );
+
+			goto on_error;
+		}
 	}
 #endif
 	if( imaging_handle_initialize_integrity_hash(
@@ -1007,6 +1044,35 @@ int ewfacquirestream_read_input(
 			goto on_error;
 		}
 	}
+	if( imaging_handle->output_writer_pool != NULL )
+	{
+		if( output_writer_pool_join(
+		     imaging_handle->output_writer_pool,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join output writer pool.",
+			 function );
+
+			goto on_error;
+		}
+		if( output_writer_pool_free(
+		     &( imaging_handle->output_writer_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free output writer pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	if( imaging_handle->output_list != NULL )
 	{
 		if( imaging_handle_empty_output_list(
@@ -1184,6 +1250,12 @@ on_error:
 		 &( imaging_handle->output_thread_pool ),
 		 NULL );
 	}
+	if( imaging_handle->output_writer_pool != NULL )
+	{
+		output_writer_pool_free(
+		 &( imaging_handle->output_writer_pool ),
+		 NULL );
+	}
 	if( imaging_handle->output_list != NULL )
 	{
 		imaging_handle_empty_output_list(
@@ -1212,6 +1284,8 @@ int wmain( int argc, wchar_t * const argv[] )
 int main( int argc, char * const argv[] )
 #endif
 {
+	system_character_t *option_secondary_target_filenames[ IMAGING_HANDLE_MAXIMUM_NUMBER_OF_SECONDARY_TARGETS ];
+
 	libcerror_error_t *error                             = NULL;
 	log_handle_t *log_handle                             = NULL;
 	system_character_t *log_filename                     = NULL;
@@ -1230,8 +1304,8 @@ int main( int argc, char * const argv[] )
 	system_character_t *option_notes                     = NULL;
 	system_character_t *option_number_of_jobs            = NULL;
 	system_character_t *option_offset                    = NULL;
+	system_character_t *option_output_write_mode         = NULL;
 	system_character_t *option_process_buffer_size       = NULL;
-        system_character_t *option_secondary_target_filename = NULL;
         system_character_t *option_sectors_per_chunk         = NULL;
 	system_character_t *option_size                      = NULL;
         system_character_t *option_target_filename           = NULL;
@@ -1239,13 +1313,18 @@ int main( int argc, char * const argv[] )
 	system_integer_t option                              = 0;
 	size_t string_length                                 = 0;
 	uint8_t calculate_md5                                = 1;
+	uint8_t preallocate_segment_files                    = 0;
 	uint8_t print_status_information                     = 1;
 	uint8_t read_error_retries                           = 2;
 	uint8_t resume_acquiry                               = 0;
 	uint8_t swap_byte_pairs                              = 0;
+	uint8_t use_adaptive_compression                     = 0;
 	uint8_t use_chunk_data_functions                     = 0;
 	uint8_t verbose                                      = 0;
+	int number_of_secondary_targets                      = 0;
 	int result                                           = 0;
+	int secondary_target_index                           = 0;
+	int target_index                                     = 0;
 
 	libcnotify_stream_set(
 	 stderr,
@@ -1307,7 +1386,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = ewftools_getopt(
 	                   argc,
 	                   argv,
-	                   _SYSTEM_STRING( "A:b:B:c:C:d:D:e:E:f:hj:l:m:M:N:o:p:P:qsS:t:vVx2:" ) ) ) != (system_integer_t) -1 )
+	                   _SYSTEM_STRING( "aA:b:B:c:C:d:D:e:E:f:hj:l:m:M:N:o:O:p:P:qsS:t:vVxy2:" ) ) ) != (system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -1327,6 +1406,11 @@ int main( int argc, char * const argv[] )
 
 				goto on_error;
 
+			case (system_integer_t) 'a':
+				preallocate_segment_files = 1;
+
+				break;
+
 			case (system_integer_t) 'A':
 				option_header_codepage = optarg;
 
@@ -1417,6 +1501,11 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (system_integer_t) 'O':
+				option_output_write_mode = optarg;
+
+				break;
+
 			case (system_integer_t) 'p':
 				option_process_buffer_size = optarg;
 
@@ -1467,8 +1556,28 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (system_integer_t) 'y':
+				use_adaptive_compression = 1;
+
+				break;
+
 			case (system_integer_t) '2':
-				option_secondary_target_filename = optarg;
+				if( number_of_secondary_targets >= IMAGING_HANDLE_MAXIMUM_NUMBER_OF_SECONDARY_TARGETS )
+				{
+					ewftools_output_version_fprint(
+					 stdout,
+					 program );
+
+					fprintf(
+					 stderr,
+					 "Unsupported number of secondary targets, maximum is: %d.\n",
+					 IMAGING_HANDLE_MAXIMUM_NUMBER_OF_SECONDARY_TARGETS );
+
+					goto on_error;
+				}
+				option_secondary_target_filenames[ number_of_secondary_targets ] = optarg;
+
+				number_of_secondary_targets++;
 
 				break;
 		}
@@ -1488,25 +1597,49 @@ int main( int argc, char * const argv[] )
 	 NULL );
 #endif
 
-	if( ( option_target_filename != NULL )
-	 && ( option_secondary_target_filename != NULL ) )
+	for( secondary_target_index = 0;
+	     secondary_target_index < number_of_secondary_targets;
+	     secondary_target_index++ )
 	{
 		string_length = system_string_length(
-				 option_secondary_target_filename );
+				 option_secondary_target_filenames[ secondary_target_index ] );
 
-		if( system_string_length(
-		     option_target_filename ) == string_length )
+		if( option_target_filename != NULL )
 		{
-			if( system_string_compare(
-			     option_target_filename,
-			     option_secondary_target_filename,
-			     string_length ) == 0 )
+			if( system_string_length(
+			     option_target_filename ) == string_length )
 			{
-				fprintf(
-				 stderr,
-				 "Primary and secondary target cannot be the same.\n" );
+				if( system_string_compare(
+				     option_target_filename,
+				     option_secondary_target_filenames[ secondary_target_index ],
+				     string_length ) == 0 )
+				{
+					fprintf(
+					 stderr,
+					 "Primary and secondary target cannot be the same.\n" );
 
-				goto on_error;
+					goto on_error;
+				}
+			}
+		}
+		for( target_index = 0;
+		     target_index < secondary_target_index;
+		     target_index++ )
+		{
+			if( system_string_length(
+			     option_secondary_target_filenames[ target_index ] ) == string_length )
+			{
+				if( system_string_compare(
+				     option_secondary_target_filenames[ target_index ],
+				     option_secondary_target_filenames[ secondary_target_index ],
+				     string_length ) == 0 )
+				{
+					fprintf(
+					 stderr,
+					 "Secondary targets cannot be the same.\n" );
+
+					goto on_error;
+				}
 			}
 		}
 	}
@@ -1596,13 +1729,15 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
-	if( option_secondary_target_filename != NULL )
+	for( secondary_target_index = 0;
+	     secondary_target_index < number_of_secondary_targets;
+	     secondary_target_index++ )
 	{
 		if( imaging_handle_set_string(
 		     ewfacquirestream_imaging_handle,
-		     option_secondary_target_filename,
-		     &( ewfacquirestream_imaging_handle->secondary_target_filename ),
-		     &( ewfacquirestream_imaging_handle->secondary_target_filename_size ),
+		     option_secondary_target_filenames[ secondary_target_index ],
+		     &( ewfacquirestream_imaging_handle->secondary_target_filenames[ secondary_target_index ] ),
+		     &( ewfacquirestream_imaging_handle->secondary_target_filename_sizes[ secondary_target_index ] ),
 		     &error ) != 1 )
 		{
 			fprintf(
@@ -1611,11 +1746,13 @@ int main( int argc, char * const argv[] )
 
 			goto on_error;
 		}
+		ewfacquirestream_imaging_handle->number_of_secondary_targets += 1;
+
 		/* Make sure we can write the secondary target file
 		 */
 		if( imaging_handle_check_write_access(
 		     ewfacquirestream_imaging_handle,
-		     ewfacquirestream_imaging_handle->secondary_target_filename,
+		     ewfacquirestream_imaging_handle->secondary_target_filenames[ secondary_target_index ],
 		     &error ) != 1 )
 		{
 #if defined( HAVE_VERBOSE_OUTPUT )
@@ -1929,6 +2066,43 @@ int main( int argc, char * const argv[] )
 			 "Unsupported acquiry size defaulting to: all bytes.\n" );
 		}
 	}
+	if( option_output_write_mode != NULL )
+	{
+		result = imaging_handle_set_write_mode(
+			  ewfacquirestream_imaging_handle,
+			  option_output_write_mode,
+			  &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set write mode.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported write mode defaulting to: buffered.\n" );
+		}
+	}
+	if( preallocate_segment_files != 0 )
+	{
+		if( ewfacquirestream_imaging_handle->write_buffer_size == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Pre-allocation is not supported with write mode: unbuffered.\n" );
+		}
+		else
+		{
+			ewfacquirestream_imaging_handle->write_flags |= LIBEWF_WRITE_FLAG_PREALLOCATE;
+		}
+	}
+	ewfacquirestream_imaging_handle->use_adaptive_compression = use_adaptive_compression;
+
 	if( option_process_buffer_size != NULL )
 	{
 		result = imaging_handle_set_process_buffer_size(
@@ -2032,11 +2206,13 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
-	if( ewfacquirestream_imaging_handle->secondary_target_filename != NULL )
+	for( secondary_target_index = 0;
+	     secondary_target_index < ewfacquirestream_imaging_handle->number_of_secondary_targets;
+	     secondary_target_index++ )
 	{
 		if( imaging_handle_open_secondary_output(
 		     ewfacquirestream_imaging_handle,
-		     ewfacquirestream_imaging_handle->secondary_target_filename,
+		     ewfacquirestream_imaging_handle->secondary_target_filenames[ secondary_target_index ],
 		     resume_acquiry,
 		     &error ) != 1 )
 		{
@@ -32,6 +32,10 @@
 #define EWFCOMMON_MAXIMUM_SEGMENT_FILE_SIZE_32BIT	INT32_MAX
 #define EWFCOMMON_MAXIMUM_SEGMENT_FILE_SIZE_64BIT	INT64_MAX
 
+/* The size of the buffer used to coalesce the writes to a segment file
+ */
+#define EWFCOMMON_WRITE_BUFFER_SIZE			( 8 * 1024 * 1024 )
+
 /* This definition is intended for automated testing of variable process buffer sizes
  */
 #if !defined( EWFCOMMON_PROCESS_BUFFER_SIZE )
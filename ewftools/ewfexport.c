@@ -123,10 +123,15 @@ void usage_fprint(
 	                 "                 [ -B number_of_bytes ] [ -c compression_values ]\n"
 	                 "                 [ -d digest_type ] [ -f format ] [ -j jobs ] [ -l log_filename ]\n"
 	                 "                 [ -o offset ] [ -p process_buffer_size ]\n"
-	                 "                 [ -S segment_file_size ] [ -t target ] [ -hqsuvVwx ] ewf_files\n\n" );
+	                 "                 [ -S segment_file_size ] [ -t target ] [ -ahPqsuvVwxyz ]\n"
+	                 "                 ewf_files\n\n" );
 
 	fprintf( stream, "\tewf_files: the first or the entire set of EWF segment files\n\n" );
 
+	fprintf( stream, "\t-a:        pre-allocate the segment files to the segment file size\n"
+	                 "\t           to reduce file system fragmentation, the unused space is\n"
+	                 "\t           released when a segment file is closed (not used for raw\n"
+	                 "\t           and files format)\n" );
 	fprintf( stream, "\t-A:        codepage of header section, options: ascii (default),\n"
 	                 "\t           windows-874, windows-932, windows-936, windows-949,\n"
 	                 "\t           windows-950, windows-1250, windows-1251, windows-1252,\n"
@@ -159,6 +164,9 @@ void usage_fprint(
 	fprintf( stream, "\t-l:        logs export errors and the digest (hash) to the log_filename\n" );
 	fprintf( stream, "\t-o:        specify the offset to start the export (default is 0)\n" );
 	fprintf( stream, "\t-p:        specify the process buffer size (default is the chunk size)\n" );
+	fprintf( stream, "\t-P:        copy the stored chunk data instead of unpacking and packing\n"
+	                 "\t           it again, only used for an EWF format with the same chunk\n"
+	                 "\t           size and compression method as the input\n" );
 	fprintf( stream, "\t-q:        quiet shows minimal status information\n" );
 	fprintf( stream, "\t-s:        swap byte pairs of the media data (from AB to BA)\n"
 	                 "\t           (use this for big to little endian conversion and vice\n"
@@ -196,6 +204,12 @@ void usage_fprint(
 	fprintf( stream, "\t-w:        zero sectors on checksum error (mimic EnCase like behavior)\n" );
 	fprintf( stream, "\t-x:        use the chunk data instead of the buffered read and write\n"
 	                 "\t           functions.\n" );
+	fprintf( stream, "\t-y:        use adaptive compression, which stores chunks uncompressed\n"
+	                 "\t           in regions of incompressible data without compressing them\n"
+	                 "\t           in full (not used with compression level: none or for the\n"
+	                 "\t           raw, files, ewf and smart formats)\n" );
+	fprintf( stream, "\t-z:        skip empty blocks instead of writing them, which creates\n"
+	                 "\t           a sparse file, only used for the raw format\n" );
 }
 
 /* Signal handler for ewfexport
@@ -276,9 +290,13 @@ int main( int argc, char * const argv[] )
 	system_character_t *request_string                 = NULL;
 	system_integer_t option                            = 0;
 	uint8_t calculate_md5                              = 1;
+	uint8_t copy_packed_chunks                         = 0;
+	uint8_t preallocate_segment_files                  = 0;
 	uint8_t print_status_information                   = 1;
 	uint8_t swap_byte_pairs                            = 0;
+	uint8_t use_adaptive_compression                   = 0;
 	uint8_t use_chunk_data_functions                   = 0;
+	uint8_t use_sparse_output                          = 0;
 	uint8_t verbose                                    = 0;
 	uint8_t zero_chunk_on_error                        = 0;
 	int interactive_mode                               = 1;
@@ -346,7 +364,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = ewftools_getopt(
 	                   argc,
 	                   argv,
-	                   _SYSTEM_STRING( "A:b:B:c:d:f:hj:l:o:p:qsS:t:uvVwx" ) ) ) != (system_integer_t) -1 )
+	                   _SYSTEM_STRING( "aA:b:B:c:d:f:hj:l:o:p:PqsS:t:uvVwxyz" ) ) ) != (system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -366,6 +384,11 @@ int main( int argc, char * const argv[] )
 
 				goto on_error;
 
+			case (system_integer_t) 'a':
+				preallocate_segment_files = 1;
+
+				break;
+
 			case (system_integer_t) 'A':
 				option_header_codepage = optarg;
 
@@ -426,6 +449,11 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (system_integer_t) 'P':
+				copy_packed_chunks = 1;
+
+				break;
+
 			case (system_integer_t) 'q':
 				print_status_information = 0;
 
@@ -474,6 +502,16 @@ int main( int argc, char * const argv[] )
 			case (system_integer_t) 'x':
 				use_chunk_data_functions = 1;
 
+				break;
+
+			case (system_integer_t) 'y':
+				use_adaptive_compression = 1;
+
+				break;
+
+			case (system_integer_t) 'z':
+				use_sparse_output = 1;
+
 				break;
 		}
 	}
@@ -559,6 +597,15 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
+	ewfexport_export_handle->copy_packed_chunks       = copy_packed_chunks;
+	ewfexport_export_handle->use_adaptive_compression = use_adaptive_compression;
+	ewfexport_export_handle->use_sparse_output        = use_sparse_output;
+
+	if( preallocate_segment_files != 0 )
+	{
+		ewfexport_export_handle->write_flags |= LIBEWF_WRITE_FLAG_PREALLOCATE;
+	}
+
 #if defined( HAVE_GETRLIMIT )
 	if( getrlimit(
             RLIMIT_NOFILE,
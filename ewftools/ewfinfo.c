@@ -77,7 +77,8 @@ void usage_fprint(
 	                 "Compression Format).\n\n" );
 
 	fprintf( stream, "Usage: ewfinfo [ -A codepage ] [ -B bodyfile ] [ -d date_format ]\n"
-	                 "               [ -f format ]  [ -F path ] [ -ehHimvVx ] ewf_files\n\n" );
+	                 "               [ -f format ]  [ -F path ] [ -x index_file ]\n"
+	                 "               [ -ehHimvV ] ewf_files\n\n" );
 
 	fprintf( stream, "\tewf_files: the first or the entire set of EWF segment files\n\n" );
 
@@ -99,6 +100,8 @@ void usage_fprint(
 	fprintf( stream, "\t-m:        only show EWF media information\n" );
 	fprintf( stream, "\t-v:        verbose output to stderr\n" );
 	fprintf( stream, "\t-V:        print version\n" );
+	fprintf( stream, "\t-x:        use an index file to speed up opening the EWF files,\n"
+	                 "\t           the index file is created if missing or outdated\n" );
 }
 
 /* Signal handler for ewfinfo
@@ -161,6 +164,7 @@ int main( int argc, char * const argv[] )
 	system_character_t *option_date_format       = NULL;
 	system_character_t *option_file_entry        = NULL;
 	system_character_t *option_header_codepage   = NULL;
+	system_character_t *option_index_file        = NULL;
 	system_character_t *option_output_format     = NULL;
 	system_character_t *program                  = _SYSTEM_STRING( "ewfinfo" );
 	system_integer_t option                      = 0;
@@ -208,7 +212,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = ewftools_getopt(
 	                   argc,
 	                   argv,
-	                   _SYSTEM_STRING( "A:B:d:ef:F:hHimvV" ) ) ) != (system_integer_t) -1 )
+	                   _SYSTEM_STRING( "A:B:d:ef:F:hHimvVx:" ) ) ) != (system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -349,6 +353,11 @@ int main( int argc, char * const argv[] )
 				 stdout );
 
 				return( EXIT_SUCCESS );
+
+			case (system_integer_t) 'x':
+				option_index_file = optarg;
+
+				break;
 		}
 	}
 	if( optind == argc )
@@ -405,6 +414,20 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 	}
+	if( option_index_file != NULL )
+	{
+		if( info_handle_set_index_filename(
+		     ewfinfo_info_handle,
+		     option_index_file,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set index file.\n" );
+
+			goto on_error;
+		}
+	}
 	if( option_output_format != NULL )
 	{
 		result = info_handle_set_output_format(
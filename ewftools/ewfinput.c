@@ -36,6 +36,7 @@
 #endif
 
 #include "byte_size_string.h"
+#include "ewfcommon.h"
 #include "ewfinput.h"
 #include "ewftools_libcerror.h"
 #include "ewftools_libewf.h"
@@ -1080,6 +1081,106 @@ int ewfinput_determine_header_codepage(
 	return( result );
 }
 
+/* Determines the segment file write buffer size and write flags from a write mode string
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int ewfinput_determine_write_mode(
+     const system_character_t *string,
+     size_t *write_buffer_size,
+     uint8_t *write_flags,
+     libcerror_error_t **error )
+{
+	static char *function = "ewfinput_determine_write_mode";
+	size_t string_length  = 0;
+	int result            = 0;
+
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	if( write_buffer_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write buffer size.",
+		 function );
+
+		return( -1 );
+	}
+	if( write_flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write flags.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( string_length == 6 )
+	{
+		if( system_string_compare(
+		     string,
+		     _SYSTEM_STRING( "direct" ),
+		     6 ) == 0 )
+		{
+			*write_buffer_size = EWFCOMMON_WRITE_BUFFER_SIZE;
+			*write_flags       = LIBEWF_WRITE_FLAG_DIRECT_IO | LIBEWF_WRITE_FLAG_DONT_CACHE;
+			result             = 1;
+		}
+	}
+	else if( string_length == 7 )
+	{
+		if( system_string_compare(
+		     string,
+		     _SYSTEM_STRING( "nocache" ),
+		     7 ) == 0 )
+		{
+			*write_buffer_size = EWFCOMMON_WRITE_BUFFER_SIZE;
+			*write_flags       = LIBEWF_WRITE_FLAG_DONT_CACHE;
+			result             = 1;
+		}
+	}
+	else if( string_length == 8 )
+	{
+		if( system_string_compare(
+		     string,
+		     _SYSTEM_STRING( "buffered" ),
+		     8 ) == 0 )
+		{
+			*write_buffer_size = EWFCOMMON_WRITE_BUFFER_SIZE;
+			*write_flags       = 0;
+			result             = 1;
+		}
+	}
+	else if( string_length == 10 )
+	{
+		if( system_string_compare(
+		     string,
+		     _SYSTEM_STRING( "unbuffered" ),
+		     10 ) == 0 )
+		{
+			*write_buffer_size = 0;
+			*write_flags       = 0;
+			result             = 1;
+		}
+	}
+	return( result );
+}
+
 /* Determines the yes or no value from a string
  * Returns 1 if successful, 0 if unsupported value or -1 on error
  */
@@ -101,6 +101,12 @@ int ewfinput_determine_header_codepage(
      int *header_codepage,
      libcerror_error_t **error );
 
+int ewfinput_determine_write_mode(
+     const system_character_t *string,
+     size_t *write_buffer_size,
+     uint8_t *write_flags,
+     libcerror_error_t **error );
+
 int ewfinput_determine_yes_no(
      const system_character_t *string,
      uint8_t *yes_no_value,
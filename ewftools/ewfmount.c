@@ -71,7 +71,7 @@ void usage_fprint(
 	}
 	fprintf( stream, "Use ewfmount to mount an Expert Witness Compression Format (EWF) image file\n\n" );
 
-	fprintf( stream, "Usage: ewfmount [ -f format ] [ -X extended_options ] [ -hvV ] image mount_point\n\n" );
+	fprintf( stream, "Usage: ewfmount [ -f format ] [ -X extended_options ] [ -hsvV ] image mount_point\n\n" );
 
 	fprintf( stream, "\timage:       an Expert Witness Compression Format (EWF) image file\n\n" );
 	fprintf( stream, "\tmount_point: the directory to serve as mount point\n\n" );
@@ -79,6 +79,8 @@ void usage_fprint(
 	fprintf( stream, "\t-f:          specify the input format, options: raw (default), files (restricted to\n"
 	                 "\t             logical volume files)\n" );
 	fprintf( stream, "\t-h:          shows this help\n" );
+	fprintf( stream, "\t-s:          single-threaded mode, by default requests are handled by\n"
+	                 "\t             multiple threads if multi-threaded mode is supported\n" );
 	fprintf( stream, "\t-v:          verbose output to stderr, while ewfmount will remain running in the\n"
 	                 "\t             foreground\n" );
 	fprintf( stream, "\t-V:          print version\n" );
@@ -152,19 +154,23 @@ int main( int argc, char * const argv[] )
 	size_t path_prefix_size                     = 0;
 	int number_of_sources                       = 0;
 	int result                                  = 0;
+	int single_threaded                         = 0;
 	int verbose                                 = 0;
 
 #if !defined( HAVE_GLOB_H )
 	ewftools_glob_t *glob                       = NULL;
 #endif
 
-#if defined( HAVE_LIBFUSE ) || defined( HAVE_LIBOSXFUSE )
+#if defined( HAVE_LIBFUSE ) || defined( HAVE_LIBFUSE3 ) || defined( HAVE_LIBOSXFUSE )
 	struct fuse_operations ewfmount_fuse_operations;
 
 	struct fuse_args ewfmount_fuse_arguments    = FUSE_ARGS_INIT(0, NULL);
-	struct fuse_chan *ewfmount_fuse_channel     = NULL;
 	struct fuse *ewfmount_fuse_handle           = NULL;
 
+#if !defined( HAVE_LIBFUSE3 )
+	struct fuse_chan *ewfmount_fuse_channel     = NULL;
+#endif
+
 #elif defined( HAVE_LIBDOKAN )
 	DOKAN_OPERATIONS ewfmount_dokan_operations;
 	DOKAN_OPTIONS ewfmount_dokan_options;
@@ -203,7 +209,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = ewftools_getopt(
 	                   argc,
 	                   argv,
-	                   _SYSTEM_STRING( "f:hvVX:" ) ) ) != (system_integer_t) -1 )
+	                   _SYSTEM_STRING( "f:hsvVX:" ) ) ) != (system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -230,6 +236,11 @@ int main( int argc, char * const argv[] )
 
 				return( EXIT_SUCCESS );
 
+			case (system_integer_t) 's':
+				single_threaded = 1;
+
+				break;
+
 			case (system_integer_t) 'v':
 				verbose = 1;
 
@@ -425,7 +436,7 @@ int main( int argc, char * const argv[] )
 		goto on_error;
 	}
 #endif
-#if defined( HAVE_LIBFUSE ) || defined( HAVE_LIBOSXFUSE )
+#if defined( HAVE_LIBFUSE ) || defined( HAVE_LIBFUSE3 ) || defined( HAVE_LIBOSXFUSE )
 	if( option_extended_options != NULL )
 	{
 		/* This argument is required but ignored
@@ -461,6 +472,47 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 	}
+#if defined( HAVE_LIBFUSE3 )
+	if( ewfmount_fuse_arguments.argc == 0 )
+	{
+		/* This argument is required but ignored
+		 */
+		if( fuse_opt_add_arg(
+		     &ewfmount_fuse_arguments,
+		     "" ) != 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable add fuse arguments.\n" );
+
+			goto on_error;
+		}
+	}
+	/* Request large reads to prevent the kernel from splitting reads
+	 * into 128 KiB requests
+	 */
+	if( fuse_opt_add_arg(
+	     &ewfmount_fuse_arguments,
+	     "-o" ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable add fuse arguments.\n" );
+
+		goto on_error;
+	}
+	if( fuse_opt_add_arg(
+	     &ewfmount_fuse_arguments,
+	     MOUNT_FUSE_MAXIMUM_READ_SIZE_OPTION ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable add fuse arguments.\n" );
+
+		goto on_error;
+	}
+#endif /* defined( HAVE_LIBFUSE3 ) */
+
 	if( memory_set(
 	     &ewfmount_fuse_operations,
 	     0,
@@ -481,6 +533,42 @@ int main( int argc, char * const argv[] )
 	ewfmount_fuse_operations.getattr    = &mount_fuse_getattr;
 	ewfmount_fuse_operations.destroy    = &mount_fuse_destroy;
 
+#if defined( HAVE_LIBFUSE3 )
+	ewfmount_fuse_operations.init       = &mount_fuse_init;
+#endif
+
+#if defined( MOUNT_FUSE_HAVE_LSEEK )
+	ewfmount_fuse_operations.lseek      = &mount_fuse_lseek;
+#endif
+
+#if defined( HAVE_LIBFUSE3 )
+	ewfmount_fuse_handle = fuse_new(
+	                        &ewfmount_fuse_arguments,
+	                        &ewfmount_fuse_operations,
+	                        sizeof( struct fuse_operations ),
+	                        ewfmount_mount_handle );
+
+	if( ewfmount_fuse_handle == NULL )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create fuse handle.\n" );
+
+		goto on_error;
+	}
+	result = fuse_mount(
+	          ewfmount_fuse_handle,
+	          mount_point );
+
+	if( result != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to fuse mount file system.\n" );
+
+		goto on_error;
+	}
+#else
 	ewfmount_fuse_channel = fuse_mount(
 	                         mount_point,
 	                         &ewfmount_fuse_arguments );
@@ -508,6 +596,8 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
+#endif /* defined( HAVE_LIBFUSE3 ) */
+
 	if( verbose == 0 )
 	{
 		if( fuse_daemonize(
@@ -520,9 +610,26 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 	}
-	result = fuse_loop(
-	          ewfmount_fuse_handle );
-
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The source image(s) are opened read-only which allows the handle to be read concurrently
+	 */
+	if( single_threaded == 0 )
+	{
+#if defined( HAVE_LIBFUSE3 )
+		result = fuse_loop_mt(
+		          ewfmount_fuse_handle,
+		          0 );
+#else
+		result = fuse_loop_mt(
+		          ewfmount_fuse_handle );
+#endif
+	}
+	else
+#endif
+	{
+		result = fuse_loop(
+		          ewfmount_fuse_handle );
+	}
 	if( result != 0 )
 	{
 		fprintf(
@@ -531,6 +638,10 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
+#if defined( HAVE_LIBFUSE3 )
+	fuse_unmount(
+	 ewfmount_fuse_handle );
+#endif
 	fuse_destroy(
 	 ewfmount_fuse_handle );
 
@@ -566,6 +677,10 @@ int main( int argc, char * const argv[] )
 	ewfmount_dokan_options.ThreadCount = 0;
 	ewfmount_dokan_options.MountPoint  = mount_point;
 
+	if( single_threaded != 0 )
+	{
+		ewfmount_dokan_options.ThreadCount = 1;
+	}
 	if( verbose != 0 )
 	{
 		ewfmount_dokan_options.Options |= DOKAN_OPTION_STDERR;
@@ -696,7 +811,7 @@ int main( int argc, char * const argv[] )
 
 	return( EXIT_FAILURE );
 
-#endif /* defined( HAVE_LIBFUSE ) || defined( HAVE_LIBOSXFUSE ) */
+#endif /* defined( HAVE_LIBFUSE ) || defined( HAVE_LIBFUSE3 ) || defined( HAVE_LIBOSXFUSE ) */
 
 on_error:
 	if( error != NULL )
@@ -706,9 +821,13 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
-#if defined( HAVE_LIBFUSE ) || defined( HAVE_LIBOSXFUSE )
+#if defined( HAVE_LIBFUSE ) || defined( HAVE_LIBFUSE3 ) || defined( HAVE_LIBOSXFUSE )
 	if( ewfmount_fuse_handle != NULL )
 	{
+#if defined( HAVE_LIBFUSE3 )
+		fuse_unmount(
+		 ewfmount_fuse_handle );
+#endif
 		fuse_destroy(
 		 ewfmount_fuse_handle );
 	}
@@ -0,0 +1,500 @@
+/*
+ * Serves an Expert Witness Compression Format (EWF) image file as a network block device (NBD)
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#include <stdio.h>
+
+#if defined( HAVE_IO_H ) || defined( WINAPI )
+#include <io.h>
+#endif
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#if defined( HAVE_SYS_RESOURCE_H )
+#include <sys/resource.h>
+#endif
+
+#include "ewftools_getopt.h"
+#include "ewftools_glob.h"
+#include "ewftools_i18n.h"
+#include "ewftools_libcerror.h"
+#include "ewftools_libclocale.h"
+#include "ewftools_libcnotify.h"
+#include "ewftools_libewf.h"
+#include "ewftools_output.h"
+#include "ewftools_signal.h"
+#include "ewftools_unused.h"
+#include "nbd_handle.h"
+
+nbd_handle_t *ewfnbd_nbd_handle = NULL;
+int ewfnbd_abort                = 0;
+
+/* Prints usage information
+ */
+void usage_fprint(
+      FILE *stream )
+{
+	if( stream == NULL )
+	{
+		return;
+	}
+	fprintf( stream, "Use ewfnbd to serve an Expert Witness Compression Format (EWF) image file\n"
+	                 "as a network block device (NBD) on a Unix domain socket\n\n" );
+
+	fprintf( stream, "Usage: ewfnbd [ -j jobs ] [ -hvV ] ewf_files socket_path\n\n" );
+
+	fprintf( stream, "\tewf_files:   the first or the entire set of EWF segment files\n\n" );
+	fprintf( stream, "\tsocket_path: the path of the Unix domain socket to listen on\n\n" );
+
+	fprintf( stream, "\t-h:          shows this help\n" );
+	fprintf( stream, "\t-j:          the number of concurrent requests handled per connection\n"
+	                 "\t             (threads), between 0 and 32, where 0 handles the requests\n"
+	                 "\t             in order, default is 4. Note that multiple connections are\n"
+	                 "\t             handled concurrently in any case\n" );
+	fprintf( stream, "\t-v:          verbose output to stderr\n" );
+	fprintf( stream, "\t-V:          print version\n" );
+}
+
+/* Signal handler for ewfnbd
+ */
+void ewfnbd_signal_handler(
+      ewftools_signal_t signal EWFTOOLS_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "ewfnbd_signal_handler";
+
+	EWFTOOLS_UNREFERENCED_PARAMETER( signal )
+
+	ewfnbd_abort = 1;
+
+	if( ewfnbd_nbd_handle != NULL )
+	{
+		if( nbd_handle_signal_abort(
+		     ewfnbd_nbd_handle,
+		     &error ) != 1 )
+		{
+			libcnotify_printf(
+			 "%s: unable to signal NBD handle to abort.\n",
+			 function );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	/* Force stdin to close otherwise any function reading it will remain blocked
+	 */
+#if defined( WINAPI ) && !defined( __CYGWIN__ )
+	if( _close(
+	     0 ) != 0 )
+#else
+	if( close(
+	     0 ) != 0 )
+#endif
+	{
+		libcnotify_printf(
+		 "%s: unable to close stdin.\n",
+		 function );
+	}
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+#if defined( HAVE_GETRLIMIT )
+	struct rlimit limit_data;
+#endif
+
+	system_character_t * const *sources       = NULL;
+	libewf_error_t *error                     = NULL;
+	system_character_t *option_number_of_jobs = NULL;
+	system_character_t *socket_path           = NULL;
+	char *program                             = _SYSTEM_STRING( "ewfnbd" );
+	system_integer_t option                   = 0;
+	int number_of_sources                     = 0;
+	int result                                = 0;
+	int verbose                               = 0;
+
+#if !defined( HAVE_GLOB_H )
+	ewftools_glob_t *glob                     = NULL;
+#endif
+
+	libcnotify_stream_set(
+	 stderr,
+	 NULL );
+	libcnotify_verbose_set(
+	 1 );
+
+	if( libclocale_initialize(
+	     "ewftools",
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize locale values.\n" );
+
+		goto on_error;
+	}
+	if( ewftools_output_initialize(
+	     _IONBF,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize output settings.\n" );
+
+		goto on_error;
+	}
+	ewftools_output_version_fprint(
+	 stdout,
+	 program );
+
+	while( ( option = ewftools_getopt(
+	                   argc,
+	                   argv,
+	                   _SYSTEM_STRING( "hj:vV" ) ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_SYSTEM "\n",
+				 argv[ optind - 1 ] );
+
+				usage_fprint(
+				 stdout );
+
+				return( EXIT_FAILURE );
+
+			case (system_integer_t) 'h':
+				usage_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+
+			case (system_integer_t) 'j':
+				option_number_of_jobs = optarg;
+
+				break;
+
+			case (system_integer_t) 'v':
+				verbose = 1;
+
+				break;
+
+			case (system_integer_t) 'V':
+				ewftools_output_copyright_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+		}
+	}
+	if( optind == argc )
+	{
+		fprintf(
+		 stderr,
+		 "Missing source image(s).\n" );
+
+		usage_fprint(
+		 stdout );
+
+		return( EXIT_FAILURE );
+	}
+	if( ( optind + 1 ) == argc )
+	{
+		fprintf(
+		 stderr,
+		 "Missing socket path.\n" );
+
+		usage_fprint(
+		 stdout );
+
+		return( EXIT_FAILURE );
+	}
+	socket_path = argv[ argc - 1 ];
+
+	libcnotify_verbose_set(
+	 verbose );
+	libewf_notify_set_stream(
+	 stderr,
+	 NULL );
+	libewf_notify_set_verbose(
+	 verbose );
+
+#if !defined( HAVE_GLOB_H )
+	if( ewftools_glob_initialize(
+	     &glob,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize glob.\n" );
+
+		goto on_error;
+	}
+	if( ewftools_glob_resolve(
+	     glob,
+	     &( argv[ optind ] ),
+	     argc - optind - 1,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to resolve glob.\n" );
+
+		goto on_error;
+	}
+	if( ewftools_glob_get_results(
+	     glob,
+	     &number_of_sources,
+	     (system_character_t ***) &sources,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to retrieve glob results.\n" );
+
+		goto on_error;
+	}
+#else
+	sources           = &( argv[ optind ] );
+	number_of_sources = argc - optind - 1;
+#endif
+
+	if( nbd_handle_initialize(
+	     &ewfnbd_nbd_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize NBD handle.\n" );
+
+		goto on_error;
+	}
+	if( option_number_of_jobs != NULL )
+	{
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		result = nbd_handle_set_number_of_threads(
+			  ewfnbd_nbd_handle,
+			  option_number_of_jobs,
+			  &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set number of jobs (threads).\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			ewfnbd_nbd_handle->number_of_threads = 4;
+
+			fprintf(
+			 stderr,
+			 "Unsupported number of jobs (threads) defaulting to: %d.\n",
+			 ewfnbd_nbd_handle->number_of_threads );
+		}
+#else
+		ewfnbd_nbd_handle->number_of_threads = 0;
+
+		fprintf(
+		 stderr,
+		 "Unsupported number of jobs (threads) defaulting to: %d.\n",
+		 ewfnbd_nbd_handle->number_of_threads );
+#endif
+	}
+#if defined( HAVE_GETRLIMIT )
+	if( getrlimit(
+	     RLIMIT_NOFILE,
+	     &limit_data ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to determine limit: number of open file descriptors.\n" );
+	}
+	if( limit_data.rlim_max > (rlim_t) INT_MAX )
+	{
+		limit_data.rlim_max = (rlim_t) INT_MAX;
+	}
+	if( limit_data.rlim_max > 0 )
+	{
+		limit_data.rlim_max /= 2;
+	}
+	if( nbd_handle_set_maximum_number_of_open_handles(
+	     ewfnbd_nbd_handle,
+	     (int) limit_data.rlim_max,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to set maximum number of open file handles.\n" );
+
+		goto on_error;
+	}
+#endif /* defined( HAVE_GETRLIMIT ) */
+
+	if( nbd_handle_open_input(
+	     ewfnbd_nbd_handle,
+	     sources,
+	     number_of_sources,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open source image(s)\n" );
+
+		goto on_error;
+	}
+#if !defined( HAVE_GLOB_H )
+	if( ewftools_glob_free(
+	     &glob,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free glob.\n" );
+
+		goto on_error;
+	}
+#endif
+#if defined( HAVE_SYS_SOCKET_H ) && defined( HAVE_SYS_UN_H ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( ewftools_signal_attach(
+	     ewfnbd_signal_handler,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to attach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	fprintf(
+	 stdout,
+	 "Serving on: %" PRIs_SYSTEM "\n",
+	 socket_path );
+
+	if( nbd_handle_serve(
+	     ewfnbd_nbd_handle,
+	     socket_path,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to serve NBD.\n" );
+
+		goto on_error;
+	}
+	if( ewftools_signal_detach(
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to detach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( nbd_handle_close_input(
+	     ewfnbd_nbd_handle,
+	     &error ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close NBD handle.\n" );
+
+		goto on_error;
+	}
+	if( nbd_handle_free(
+	     &ewfnbd_nbd_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free NBD handle.\n" );
+
+		goto on_error;
+	}
+	return( EXIT_SUCCESS );
+
+#else
+	fprintf(
+	 stderr,
+	 "No sub system to serve NBD.\n" );
+
+	nbd_handle_free(
+	 &ewfnbd_nbd_handle,
+	 NULL );
+
+	return( EXIT_FAILURE );
+
+#endif /* defined( HAVE_SYS_SOCKET_H ) && defined( HAVE_SYS_UN_H ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER ) */
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( ewfnbd_nbd_handle != NULL )
+	{
+		nbd_handle_free(
+		 &ewfnbd_nbd_handle,
+		 NULL );
+	}
+#if !defined( HAVE_GLOB_H )
+	if( glob != NULL )
+	{
+		ewftools_glob_free(
+		 &glob,
+		 NULL );
+	}
+#endif
+	return( EXIT_FAILURE );
+}
+
@@ -312,6 +312,24 @@ int export_handle_free(
 				result = -1;
 			}
 		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( ( *export_handle )->digest_hash_pool != NULL )
+		{
+			if( digest_hash_pool_free(
+			     &( ( *export_handle )->digest_hash_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free digest hash pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
 		if( ( *export_handle )->md5_context != NULL )
 		{
 			if( libhmac_md5_free(
@@ -1170,6 +1188,34 @@ ssize_t export_handle_write_storage_media_buffer(
 				       write_size );
 #endif
 		}
+		else if( ( export_handle->use_sparse_output != 0 )
+		      && ( storage_media_buffer->raw_buffer[ 0 ] == 0 )
+		      && ( memory_compare(
+		            storage_media_buffer->raw_buffer,
+		            &( storage_media_buffer->raw_buffer[ 1 ] ),
+		            write_size - 1 ) == 0 ) )
+		{
+			/* Empty blocks are skipped which leaves a hole in the output
+			 */
+			if( libsmraw_handle_seek_offset(
+			     export_handle->raw_output_handle,
+			     (off64_t) write_size,
+			     SEEK_CUR,
+			     error ) == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_SEEK_FAILED,
+				 "%s: unable to seek past empty block in raw output.",
+				 function );
+
+				return( -1 );
+			}
+			export_handle->sparse_output_ends_with_hole = 1;
+
+			write_count = (ssize_t) write_size;
+		}
 		else
 		{
 			write_count = libsmraw_handle_write_buffer(
@@ -1177,6 +1223,8 @@ ssize_t export_handle_write_storage_media_buffer(
 				       storage_media_buffer->raw_buffer,
 				       write_size,
 				       error );
+
+			export_handle->sparse_output_ends_with_hole = 0;
 		}
 	}
 	if( write_count < 0 )
@@ -1232,6 +1280,164 @@ off64_t export_handle_seek_offset(
 	return( offset );
 }
 
+/* Reads a storage media buffer that only contains empty chunks
+ * The chunks are not read from the input but the storage media buffer is cleared
+ * and the input offset is moved past the chunks
+ * Returns the number of bytes read, 0 if the data does not consist of empty chunks or -1 on error
+ */
+ssize_t export_handle_read_empty_storage_media_buffer(
+         export_handle_t *export_handle,
+         storage_media_buffer_t *storage_media_buffer,
+         size_t read_size,
+         libcerror_error_t **error )
+{
+	static char *function = "export_handle_read_empty_storage_media_buffer";
+	off64_t input_offset  = 0;
+	size_t checked_size   = 0;
+	uint64_t chunk_index  = 0;
+	uint64_t fill_pattern = 0;
+	int result            = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->input_chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid export handle - missing input chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_size > storage_media_buffer->raw_buffer_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid read size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( storage_media_buffer->mode != STORAGE_MEDIA_BUFFER_MODE_BUFFERED )
+	 || ( read_size == 0 ) )
+	{
+		return( 0 );
+	}
+	if( libewf_handle_get_offset(
+	     export_handle->input_handle,
+	     &input_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve input offset.",
+		 function );
+
+		return( -1 );
+	}
+	/* Only entire chunks or the last chunk of the input can be skipped
+	 */
+	if( ( input_offset % export_handle->input_chunk_size ) != 0 )
+	{
+		return( 0 );
+	}
+	if( ( ( read_size % export_handle->input_chunk_size ) != 0 )
+	 && ( ( (size64_t) input_offset + read_size ) != export_handle->input_media_size ) )
+	{
+		return( 0 );
+	}
+	chunk_index = (uint64_t) input_offset / export_handle->input_chunk_size;
+
+	for( checked_size = 0;
+	     checked_size < read_size;
+	     checked_size += export_handle->input_chunk_size )
+	{
+		result = libewf_handle_get_chunk_fill_info(
+		          export_handle->input_handle,
+		          chunk_index,
+		          &fill_pattern,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk: %" PRIu64 " fill information.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		else if( ( result == 0 )
+		      || ( fill_pattern != 0 ) )
+		{
+			return( 0 );
+		}
+		chunk_index++;
+	}
+	if( memory_set(
+	     storage_media_buffer->raw_buffer,
+	     0,
+	     read_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear storage media buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_handle_seek_offset(
+	     export_handle->input_handle,
+	     (off64_t) read_size,
+	     SEEK_CUR,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek past empty chunks in input.",
+		 function );
+
+		return( -1 );
+	}
+	storage_media_buffer->raw_buffer_data_size = read_size;
+	storage_media_buffer->requested_size       = read_size;
+
+	return( (ssize_t) read_size );
+}
+
 /* Swaps the byte order of byte pairs within a buffer of a certain size
  * Returns 1 if successful, -1 on error
  */
@@ -1374,9 +1580,39 @@ int export_handle_initialize_integrity_hash(
 		}
 		export_handle->sha256_context_initialized = 1;
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( ( export_handle->number_of_threads != 0 )
+	 && ( ( export_handle->md5_context != NULL )
+	  ||  ( export_handle->sha1_context != NULL )
+	  ||  ( export_handle->sha256_context != NULL ) ) )
+	{
+		if( digest_hash_pool_initialize(
+		     &( export_handle->digest_hash_pool ),
+		     export_handle->md5_context,
+		     export_handle->sha1_context,
+		     export_handle->sha256_context,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create digest hash pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
 	return( 1 );
 
 on_error:
+	if( export_handle->sha256_context != NULL )
+	{
+		libhmac_sha256_free(
+		 &( export_handle->sha256_context ),
+		 NULL );
+	}
 	if( export_handle->sha1_context != NULL )
 	{
 		libhmac_sha1_free(
@@ -1437,6 +1673,27 @@ int export_handle_update_integrity_hash(
 
 		return( -1 );
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( export_handle->digest_hash_pool != NULL )
+	{
+		if( digest_hash_pool_update(
+		     export_handle->digest_hash_pool,
+		     buffer,
+		     buffer_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update digest hash pool.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+#endif
 	if( export_handle->calculate_md5 != 0 )
 	{
 		if( libhmac_md5_update(
@@ -1518,6 +1775,37 @@ int export_handle_finalize_integrity_hash(
 
 		return( -1 );
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( export_handle->digest_hash_pool != NULL )
+	{
+		if( digest_hash_pool_join(
+		     export_handle->digest_hash_pool,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join digest hash pool.",
+			 function );
+
+			return( -1 );
+		}
+		if( digest_hash_pool_free(
+		     &( export_handle->digest_hash_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free digest hash pool.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
 	if( export_handle->calculate_md5 != 0 )
 	{
 		if( export_handle->calculated_md5_hash_string == NULL )
@@ -1695,6 +1983,130 @@ int export_handle_input_is_corrupted(
 	return( result );
 }
 
+/* Determines if the stored chunk data of the input can be copied to the output
+ * This requires an EWF output of the same format version, chunk size and compression method
+ * of which the full media is exported without swapping byte pairs
+ * Returns 1 if the stored chunk data can be copied, 0 if not or -1 on error
+ */
+int export_handle_can_copy_packed_chunks(
+     export_handle_t *export_handle,
+     libcerror_error_t **error )
+{
+	static char *function             = "export_handle_can_copy_packed_chunks";
+	size32_t output_chunk_size        = 0;
+	uint16_t input_compression_method = 0;
+	uint8_t input_format              = 0;
+	uint8_t input_is_ewf2             = 0;
+	uint8_t output_is_ewf2            = 0;
+	int result                        = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( export_handle->output_format != EXPORT_HANDLE_OUTPUT_FORMAT_EWF )
+	 || ( export_handle->swap_byte_pairs != 0 )
+	 || ( export_handle->export_offset != 0 )
+	 || ( export_handle->export_size != export_handle->input_media_size ) )
+	{
+		return( 0 );
+	}
+	if( export_handle_get_output_chunk_size(
+	     export_handle,
+	     &output_chunk_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve the output chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_chunk_size != export_handle->input_chunk_size )
+	{
+		return( 0 );
+	}
+	if( libewf_handle_get_compression_method(
+	     export_handle->input_handle,
+	     &input_compression_method,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve input compression method.",
+		 function );
+
+		return( -1 );
+	}
+	if( input_compression_method != export_handle->compression_method )
+	{
+		return( 0 );
+	}
+	if( libewf_handle_get_format(
+	     export_handle->input_handle,
+	     &input_format,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve input format.",
+		 function );
+
+		return( -1 );
+	}
+	input_is_ewf2 = (uint8_t) ( ( input_format == LIBEWF_FORMAT_V2_ENCASE7 )
+	                         || ( input_format == LIBEWF_FORMAT_V2_LOGICAL_ENCASE7 ) );
+
+	output_is_ewf2 = (uint8_t) ( ( export_handle->ewf_format == LIBEWF_FORMAT_V2_ENCASE7 )
+	                          || ( export_handle->ewf_format == LIBEWF_FORMAT_V2_LOGICAL_ENCASE7 ) );
+
+	if( input_is_ewf2 != output_is_ewf2 )
+	{
+		return( 0 );
+	}
+	/* SMART uses a different segment file type than the EnCase formats
+	 */
+	if( ( input_format == LIBEWF_FORMAT_SMART )
+	 != ( export_handle->ewf_format == LIBEWF_FORMAT_SMART ) )
+	{
+		return( 0 );
+	}
+	result = libewf_handle_segment_files_encrypted(
+	          export_handle->input_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if segment files are encrypted.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
 /* Retrieves the chunk size
  * Returns 1 if successful or -1 on error
  */
@@ -3546,6 +3958,7 @@ int export_handle_set_output_values(
 
 	static char *function      = "export_handle_set_output_values";
 	size_t value_string_length = 0;
+	uint8_t compression_flags  = 0;
 	int result                 = 0;
 
 	if( export_handle == NULL )
@@ -3843,10 +4256,16 @@ int export_handle_set_output_values(
 
 			return( -1 );
 		}
+		compression_flags = export_handle->compression_flags;
+
+		if( export_handle->use_adaptive_compression != 0 )
+		{
+			compression_flags |= LIBEWF_COMPRESS_FLAG_USE_ADAPTIVE_COMPRESSION;
+		}
 		if( libewf_handle_set_compression_values(
 		     export_handle->ewf_output_handle,
 		     export_handle->compression_level,
-		     export_handle->compression_flags,
+		     compression_flags,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
@@ -3898,6 +4317,21 @@ int export_handle_set_output_values(
 
 			return( -1 );
 		}
+		if( libewf_handle_set_write_buffer_values(
+		     export_handle->ewf_output_handle,
+		     EWFCOMMON_WRITE_BUFFER_SIZE,
+		     export_handle->write_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set write buffer values.",
+			 function );
+
+			return( -1 );
+		}
 		if( copy_input_values == 0 )
 		{
 			if( libewf_handle_set_sectors_per_chunk(
@@ -4135,7 +4569,8 @@ int export_handle_append_read_error(
 	{
 		number_of_sectors += 1;
 	}
-	if( export_handle->use_chunk_data_functions != 0 )
+	if( ( export_handle->use_chunk_data_functions != 0 )
+	 || ( export_handle->copy_packed_chunks != 0 ) )
 	{
 		if( libewf_handle_append_checksum_error(
 		     export_handle->input_handle,
@@ -4355,6 +4790,7 @@ ssize_t export_handle_finalize(
 {
 	static char *function = "export_handle_finalize";
 	ssize_t write_count   = 0;
+	uint8_t empty_byte    = 0;
 
 	if( export_handle == NULL )
 	{
@@ -4445,6 +4881,44 @@ ssize_t export_handle_finalize(
 			return( -1 );
 		}
 	}
+	else if( ( export_handle->output_format == EXPORT_HANDLE_OUTPUT_FORMAT_RAW )
+	      && ( export_handle->use_stdout == 0 )
+	      && ( export_handle->sparse_output_ends_with_hole != 0 ) )
+	{
+		/* Write the last byte of the raw output so that a hole at the end is part of the output
+		 */
+		if( libsmraw_handle_seek_offset(
+		     export_handle->raw_output_handle,
+		     (off64_t) export_handle->export_size - 1,
+		     SEEK_SET,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek last byte in raw output.",
+			 function );
+
+			return( -1 );
+		}
+		if( libsmraw_handle_write_buffer(
+		     export_handle->raw_output_handle,
+		     &empty_byte,
+		     1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write last byte in raw output.",
+			 function );
+
+			return( -1 );
+		}
+		export_handle->sparse_output_ends_with_hole = 0;
+	}
 	return( write_count );
 }
 
@@ -5064,6 +5538,7 @@ int export_handle_export_input(
 	ssize_t write_count                                 = 0;
 	uint8_t storage_media_buffer_mode                   = 0;
 	int maximum_number_of_queued_items                  = 0;
+	int result                                          = 0;
 	int status                                          = PROCESS_STATUS_COMPLETED;
 
 	if( export_handle == NULL )
@@ -5164,7 +5639,58 @@ int export_handle_export_input(
 			goto on_error;
 		}
 	}
-	if( export_handle->use_chunk_data_functions != 0 )
+	if( export_handle->copy_packed_chunks != 0 )
+	{
+		result = export_handle_can_copy_packed_chunks(
+		          export_handle,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if the stored chunk data can be copied.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			if( export_handle->notify_stream != NULL )
+			{
+				fprintf(
+				 export_handle->notify_stream,
+				 "Unable to copy the stored chunk data, the output format, chunk size or compression method differs from the input. The chunk data will be packed again.\n\n" );
+			}
+			export_handle->copy_packed_chunks = 0;
+		}
+	}
+	if( export_handle->use_sparse_output != 0 )
+	{
+		if( ( export_handle->output_format != EXPORT_HANDLE_OUTPUT_FORMAT_RAW )
+		 || ( export_handle->use_stdout != 0 ) )
+		{
+			if( export_handle->notify_stream != NULL )
+			{
+				fprintf(
+				 export_handle->notify_stream,
+				 "Sparse output is only supported for the raw format written to a file. Empty blocks will be written.\n\n" );
+			}
+			export_handle->use_sparse_output = 0;
+		}
+	}
+	if( export_handle->copy_packed_chunks != 0 )
+	{
+		/* The stored chunk data is copied sequentially since there is no chunk data to pack
+		 */
+		export_handle->number_of_threads = 0;
+
+		process_buffer_size       = (size_t) export_handle->input_chunk_size;
+		storage_media_buffer_mode = STORAGE_MEDIA_BUFFER_MODE_PACKED_CHUNK_DATA;
+	}
+	else if( export_handle->use_chunk_data_functions != 0 )
 	{
 		if( export_handle_get_output_chunk_size(
 		     export_handle,
@@ -5388,12 +5914,24 @@ int export_handle_export_input(
 		{
 			read_size = (size_t) remaining_export_size;
 		}
-		read_count = storage_media_buffer_read_from_handle(
-		              input_storage_media_buffer,
-		              export_handle->input_handle,
-		              read_size,
-		              error );
+		read_count = 0;
 
+		if( export_handle->use_sparse_output != 0 )
+		{
+			read_count = export_handle_read_empty_storage_media_buffer(
+			              export_handle,
+			              input_storage_media_buffer,
+			              read_size,
+			              error );
+		}
+		if( read_count == 0 )
+		{
+			read_count = storage_media_buffer_read_from_handle(
+			              input_storage_media_buffer,
+			              export_handle->input_handle,
+			              read_size,
+			              error );
+		}
 		if( read_count < 0 )
 		{
 			libcerror_error_set(
@@ -5443,6 +5981,28 @@ int export_handle_export_input(
 		else
 #endif
 		{
+			if( input_storage_media_buffer->mode == STORAGE_MEDIA_BUFFER_MODE_PACKED_CHUNK_DATA )
+			{
+				/* The stored chunk data is written before it is unpacked in place to calculate the digest hashes
+				 */
+				write_count = export_handle_write_storage_media_buffer(
+				               export_handle,
+				               input_storage_media_buffer,
+				               (size_t) read_count,
+				               error );
+
+				if( write_count < 0 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to write stored chunk data.",
+					 function );
+
+					goto on_error;
+				}
+			}
 			process_count = storage_media_buffer_read_process(
 			                 input_storage_media_buffer,
 			                 error );
@@ -5478,6 +6038,44 @@ int export_handle_export_input(
 					goto on_error;
 				}
 			}
+			else if( input_storage_media_buffer->mode == STORAGE_MEDIA_BUFFER_MODE_PACKED_CHUNK_DATA )
+			{
+				/* Corrupted chunks are copied as stored and marked as read errors
+				 */
+				result = libewf_data_chunk_is_corrupted(
+				          input_storage_media_buffer->data_chunk,
+				          error );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to determine if data chunk is corrupted.",
+					 function );
+
+					goto on_error;
+				}
+				else if( result != 0 )
+				{
+					if( export_handle_append_read_error(
+					     export_handle,
+					     input_storage_media_buffer->storage_media_offset,
+					     (size_t) read_count,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+						 "%s: unable to append read error.",
+						 function );
+
+						goto on_error;
+					}
+				}
+			}
 			if( storage_media_buffer_get_data(
 			     input_storage_media_buffer,
 			     &data,
@@ -5532,44 +6130,49 @@ int export_handle_export_input(
 			}
 			export_handle->last_offset_hashed += input_storage_media_buffer->processed_size;
 
-			if( ( export_handle->use_chunk_data_functions != 0 )
-			 && ( output_storage_media_buffer == NULL ) )
+			/* The stored chunk data was already written before it was unpacked
+			 */
+			if( input_storage_media_buffer->mode != STORAGE_MEDIA_BUFFER_MODE_PACKED_CHUNK_DATA )
 			{
-				if( storage_media_buffer_initialize(
-				     &output_storage_media_buffer,
-				     export_handle->ewf_output_handle,
-				     STORAGE_MEDIA_BUFFER_MODE_CHUNK_DATA,
-				     export_handle->output_chunk_size,
-				     error ) != 1 )
+				if( ( export_handle->use_chunk_data_functions != 0 )
+				 && ( output_storage_media_buffer == NULL ) )
+				{
+					if( storage_media_buffer_initialize(
+					     &output_storage_media_buffer,
+					     export_handle->ewf_output_handle,
+					     STORAGE_MEDIA_BUFFER_MODE_CHUNK_DATA,
+					     export_handle->output_chunk_size,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+						 "%s: unable to create output storage media buffer.",
+						 function );
+
+						goto on_error;
+					}
+				}
+				write_count = export_handle_write(
+				               export_handle,
+				               input_storage_media_buffer,
+				               output_storage_media_buffer,
+				               input_storage_media_buffer->processed_size,
+				               error );
+
+				if( write_count < 0 )
 				{
 					libcerror_error_set(
 					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-					 "%s: unable to create output storage media buffer.",
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to write to export handle.",
 					 function );
 
 					goto on_error;
 				}
 			}
-			write_count = export_handle_write(
-			               export_handle,
-			               input_storage_media_buffer,
-			               output_storage_media_buffer,
-			               input_storage_media_buffer->processed_size,
-			               error );
-
-			if( write_count < 0 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_WRITE_FAILED,
-				 "%s: unable to write to export handle.",
-				 function );
-
-				goto on_error;
-			}
 			if( process_status_update(
 			     export_handle->process_status,
 			     export_handle->last_offset_hashed,
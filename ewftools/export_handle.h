@@ -26,6 +26,7 @@
 #include <types.h>
 
 #include "digest_hash.h"
+#include "digest_hash_pool.h"
 #include "ewftools_libcdata.h"
 #include "ewftools_libcerror.h"
 #include "ewftools_libcthreads.h"
@@ -75,6 +76,10 @@ struct export_handle
 	 */
 	uint8_t compression_flags;
 
+	/* Value to indicate if adaptive compression should be used
+	 */
+	uint8_t use_adaptive_compression;
+
 	/* The output format
 	 */
 	uint8_t output_format;
@@ -155,6 +160,22 @@ struct export_handle
 	 */
 	uint8_t use_chunk_data_functions;
 
+	/* Value to indicate if the stored chunk data should be copied instead of being unpacked and packed again
+	 */
+	uint8_t copy_packed_chunks;
+
+	/* Value to indicate if empty blocks should be skipped in the raw output instead of being written
+	 */
+	uint8_t use_sparse_output;
+
+	/* Value to indicate if the raw output ends with a skipped empty block
+	 */
+	uint8_t sparse_output_ends_with_hole;
+
+	/* The segment file write flags
+	 */
+	uint8_t write_flags;
+
 	/* The process buffer size
 	 */
 	size_t process_buffer_size;
@@ -181,6 +202,10 @@ struct export_handle
 	 */
 	libcthreads_queue_t *storage_media_buffer_queue;
 
+	/* The digest hash pool
+	 */
+	digest_hash_pool_t *digest_hash_pool;
+
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
 	/* The libewf input handle
@@ -310,6 +335,12 @@ off64_t export_handle_seek_offset(
          off64_t offset,
          libcerror_error_t **error );
 
+ssize_t export_handle_read_empty_storage_media_buffer(
+         export_handle_t *export_handle,
+         storage_media_buffer_t *storage_media_buffer,
+         size_t read_size,
+         libcerror_error_t **error );
+
 int export_handle_swap_byte_pairs(
      export_handle_t *export_handle,
      uint8_t *buffer,
@@ -334,6 +365,10 @@ int export_handle_input_is_corrupted(
      export_handle_t *export_handle,
      libcerror_error_t **error );
 
+int export_handle_can_copy_packed_chunks(
+     export_handle_t *export_handle,
+     libcerror_error_t **error );
+
 int export_handle_get_output_chunk_size(
      export_handle_t *export_handle,
      size32_t *chunk_size,
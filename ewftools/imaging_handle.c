@@ -46,6 +46,7 @@
 #include "ewftools_system_string.h"
 #include "guid.h"
 #include "imaging_handle.h"
+#include "output_writer_pool.h"
 #include "platform.h"
 #include "storage_media_buffer.h"
 #include "storage_media_buffer_queue.h"
@@ -192,6 +193,7 @@ int imaging_handle_initialize(
 	( *imaging_handle )->maximum_segment_size     = EWFCOMMON_DEFAULT_SEGMENT_FILE_SIZE;
 	( *imaging_handle )->header_codepage          = LIBEWF_CODEPAGE_ASCII;
 	( *imaging_handle )->process_buffer_size      = EWFCOMMON_PROCESS_BUFFER_SIZE;
+	( *imaging_handle )->write_buffer_size        = EWFCOMMON_WRITE_BUFFER_SIZE;
 	( *imaging_handle )->notify_stream            = IMAGING_HANDLE_NOTIFY_STREAM;
 
 #if defined( HAVE_MULTI_THREAD_SUPPORT )
@@ -238,8 +240,9 @@ int imaging_handle_free(
      imaging_handle_t **imaging_handle,
      libcerror_error_t **error )
 {
-	static char *function = "imaging_handle_free";
-	int result            = 1;
+	static char *function   = "imaging_handle_free";
+	int output_handle_index = 0;
+	int result              = 1;
 
 	if( imaging_handle == NULL )
 	{
@@ -262,10 +265,15 @@ int imaging_handle_free(
 			memory_free(
 			 ( *imaging_handle )->target_filename );
 		}
-		if( ( *imaging_handle )->secondary_target_filename != NULL )
+		for( output_handle_index = 0;
+		     output_handle_index < IMAGING_HANDLE_MAXIMUM_NUMBER_OF_SECONDARY_TARGETS;
+		     output_handle_index++ )
 		{
-			memory_free(
-			 ( *imaging_handle )->secondary_target_filename );
+			if( ( *imaging_handle )->secondary_target_filenames[ output_handle_index ] != NULL )
+			{
+				memory_free(
+				 ( *imaging_handle )->secondary_target_filenames[ output_handle_index ] );
+			}
 		}
 		if( ( *imaging_handle )->case_number != NULL )
 		{
@@ -292,6 +300,24 @@ int imaging_handle_free(
 			memory_free(
 			 ( *imaging_handle )->notes );
 		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( ( *imaging_handle )->digest_hash_pool != NULL )
+		{
+			if( digest_hash_pool_free(
+			     &( ( *imaging_handle )->digest_hash_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free digest hash pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
 		if( ( *imaging_handle )->md5_context != NULL )
 		{
 			if( libhmac_md5_free(
@@ -368,18 +394,21 @@ int imaging_handle_free(
 
 			result = -1;
 		}
-		if( ( *imaging_handle )->secondary_output_handle != NULL )
+		for( output_handle_index = 0;
+		     output_handle_index < ( *imaging_handle )->number_of_secondary_output_handles;
+		     output_handle_index++ )
 		{
 			if( libewf_handle_free(
-			     &( ( *imaging_handle )->secondary_output_handle ),
+			     &( ( *imaging_handle )->secondary_output_handles[ output_handle_index ] ),
 			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to free secondary output handle.",
-				 function );
+				 "%s: unable to free secondary output handle: %d.",
+				 function,
+				 output_handle_index );
 
 				result = -1;
 			}
@@ -399,7 +428,8 @@ int imaging_handle_signal_abort(
      imaging_handle_t *imaging_handle,
      libcerror_error_t **error )
 {
-	static char *function = "imaging_handle_signal_abort";
+	static char *function   = "imaging_handle_signal_abort";
+	int output_handle_index = 0;
 
 	if( imaging_handle == NULL )
 	{
@@ -425,18 +455,21 @@ int imaging_handle_signal_abort(
 
 		return( -1 );
 	}
-	if( imaging_handle->secondary_output_handle != NULL )
-	{	
+	for( output_handle_index = 0;
+	     output_handle_index < imaging_handle->number_of_secondary_output_handles;
+	     output_handle_index++ )
+	{
 		if( libewf_handle_signal_abort(
-		     imaging_handle->output_handle,
+		     imaging_handle->secondary_output_handles[ output_handle_index ],
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to signal secondary output handle to abort.",
-			 function );
+			 "%s: unable to signal secondary output handle: %d to abort.",
+			 function,
+			 output_handle_index );
 
 			return( -1 );
 		}
@@ -711,7 +744,7 @@ on_error:
 	return( -1 );
 }
 
-/* Opens the secondary output of the imaging handle
+/* Opens an additional secondary output of the imaging handle
  * Returns 1 if successful or -1 on error
  */
 int imaging_handle_open_secondary_output(
@@ -722,6 +755,7 @@ int imaging_handle_open_secondary_output(
 {
 	system_character_t **libewf_filenames = NULL;
 	system_character_t *filenames[ 1 ]    = { NULL };
+	libewf_handle_t *output_handle        = NULL;
 	static char *function                 = "imaging_handle_open_secondary_output";
 	size_t first_filename_length          = 0;
 	int access_flags                      = 0;
@@ -738,13 +772,14 @@ int imaging_handle_open_secondary_output(
 
 		return( -1 );
 	}
-	if( imaging_handle->secondary_output_handle != NULL )
+	if( ( imaging_handle->number_of_secondary_output_handles < 0 )
+	 || ( imaging_handle->number_of_secondary_output_handles >= IMAGING_HANDLE_MAXIMUM_NUMBER_OF_SECONDARY_TARGETS ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid imaging handle - secondary output handle already set.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid imaging handle - number of secondary output handles value out of bounds.",
 		 function );
 
 		return( -1 );
@@ -803,7 +838,7 @@ int imaging_handle_open_secondary_output(
 		access_flags     = LIBEWF_OPEN_WRITE;
 	}
 	if( libewf_handle_initialize(
-	     &( imaging_handle->secondary_output_handle ),
+	     &output_handle,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
@@ -817,14 +852,14 @@ int imaging_handle_open_secondary_output(
 	}
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
 	if( libewf_handle_open_wide(
-	     imaging_handle->secondary_output_handle,
+	     output_handle,
 	     libewf_filenames,
 	     number_of_filenames,
 	     access_flags,
 	     error ) != 1 )
 #else
 	if( libewf_handle_open(
-	     imaging_handle->secondary_output_handle,
+	     output_handle,
 	     libewf_filenames,
 	     number_of_filenames,
 	     access_flags,
@@ -864,13 +899,17 @@ int imaging_handle_open_secondary_output(
 			goto on_error;
 		}
 	}
+	imaging_handle->secondary_output_handles[ imaging_handle->number_of_secondary_output_handles ] = output_handle;
+
+	imaging_handle->number_of_secondary_output_handles += 1;
+
 	return( 1 );
 
 on_error:
-	if( imaging_handle->secondary_output_handle != NULL )
+	if( output_handle != NULL )
 	{
 		libewf_handle_free(
-		 &( imaging_handle->secondary_output_handle ),
+		 &output_handle,
 		 NULL );
 	}
 	if( libewf_filenames != filenames )
@@ -971,7 +1010,8 @@ int imaging_handle_close(
      imaging_handle_t *imaging_handle,
      libcerror_error_t **error )
 {
-	static char *function = "imaging_handle_close";
+	static char *function   = "imaging_handle_close";
+	int output_handle_index = 0;
 
 	if( imaging_handle == NULL )
 	{
@@ -997,10 +1037,12 @@ int imaging_handle_close(
 
 		return( -1 );
 	}
-	if( imaging_handle->secondary_output_handle != NULL )
+	for( output_handle_index = 0;
+	     output_handle_index < imaging_handle->number_of_secondary_output_handles;
+	     output_handle_index++ )
 	{
 		if( libewf_handle_close(
-		     imaging_handle->secondary_output_handle,
+		     imaging_handle->secondary_output_handles[ output_handle_index ],
 		     error ) != 0 )
 		{
 			libcerror_error_set(
@@ -1028,6 +1070,7 @@ ssize_t imaging_handle_write_storage_media_buffer(
 	static char *function         = "imaging_handle_write_buffer";
 	ssize_t secondary_write_count = 0;
 	ssize_t write_count           = 0;
+	int output_handle_index       = 0;
 
 	if( imaging_handle == NULL )
 	{
@@ -1066,11 +1109,13 @@ ssize_t imaging_handle_write_storage_media_buffer(
 /* TODO ask for alternative segment file location and try again */
 		return( -1 );
 	}
-	if( imaging_handle->secondary_output_handle != NULL )
+	for( output_handle_index = 0;
+	     output_handle_index < imaging_handle->number_of_secondary_output_handles;
+	     output_handle_index++ )
 	{
 		secondary_write_count = storage_media_buffer_write_to_handle(
 		                         storage_media_buffer,
-		                         imaging_handle->secondary_output_handle,
+		                         imaging_handle->secondary_output_handles[ output_handle_index ],
 		                         write_size,
 		                         error );
 
@@ -1108,6 +1153,7 @@ off64_t imaging_handle_seek_offset(
 {
 	static char *function    = "imaging_handle_seek_offset";
 	off64_t secondary_offset = 0;
+	int output_handle_index  = 0;
 
 	if( imaging_handle == NULL )
 	{
@@ -1137,10 +1183,12 @@ off64_t imaging_handle_seek_offset(
 
 		return( -1 );
 	}
-	if( imaging_handle->secondary_output_handle != NULL )
+	for( output_handle_index = 0;
+	     output_handle_index < imaging_handle->number_of_secondary_output_handles;
+	     output_handle_index++ )
 	{
 		secondary_offset = libewf_handle_seek_offset(
-		                    imaging_handle->secondary_output_handle,
+		                    imaging_handle->secondary_output_handles[ output_handle_index ],
 		                    offset,
 		                    SEEK_SET,
 		                    error );
@@ -1351,9 +1399,39 @@ int imaging_handle_initialize_integrity_hash(
 		}
 		imaging_handle->sha256_context_initialized = 1;
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( ( imaging_handle->number_of_threads != 0 )
+	 && ( ( imaging_handle->md5_context != NULL )
+	  ||  ( imaging_handle->sha1_context != NULL )
+	  ||  ( imaging_handle->sha256_context != NULL ) ) )
+	{
+		if( digest_hash_pool_initialize(
+		     &( imaging_handle->digest_hash_pool ),
+		     imaging_handle->md5_context,
+		     imaging_handle->sha1_context,
+		     imaging_handle->sha256_context,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create digest hash pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
 	return( 1 );
 
 on_error:
+	if( imaging_handle->sha256_context != NULL )
+	{
+		libhmac_sha256_free(
+		 &( imaging_handle->sha256_context ),
+		 NULL );
+	}
 	if( imaging_handle->sha1_context != NULL )
 	{
 		libhmac_sha1_free(
@@ -1414,6 +1492,27 @@ int imaging_handle_update_integrity_hash(
 
 		return( -1 );
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( imaging_handle->digest_hash_pool != NULL )
+	{
+		if( digest_hash_pool_update(
+		     imaging_handle->digest_hash_pool,
+		     buffer,
+		     buffer_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update digest hash pool.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+#endif
 	if( imaging_handle->calculate_md5 != 0 )
 	{
 		if( libhmac_md5_update(
@@ -1495,6 +1594,37 @@ int imaging_handle_finalize_integrity_hash(
 
 		return( -1 );
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( imaging_handle->digest_hash_pool != NULL )
+	{
+		if( digest_hash_pool_join(
+		     imaging_handle->digest_hash_pool,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join digest hash pool.",
+			 function );
+
+			return( -1 );
+		}
+		if( digest_hash_pool_free(
+		     &( imaging_handle->digest_hash_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free digest hash pool.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
 	if( imaging_handle->calculate_md5 != 0 )
 	{
 		if( imaging_handle->calculated_md5_hash_string == NULL )
@@ -1726,8 +1856,8 @@ on_error:
 	return( -1 );
 }
 
-/* Prepares a storage media buffer for imaging
- * Callback function for the process thread pool
+/* Passes the storage media buffers in order of their offset to the output writer pool
+ * Callback function for the output thread pool
  * Returns 1 if successful or -1 on error
  */
 int imaging_handle_output_storage_media_buffer_callback(
@@ -1738,7 +1868,6 @@ int imaging_handle_output_storage_media_buffer_callback(
 	libcdata_list_element_t *next_element = NULL;
         libcerror_error_t *error              = NULL;
         static char *function                 = "imaging_handle_output_storage_media_buffer_callback";
-	ssize_t write_count                   = 0;
 	int result                            = 0;
 
 	if( imaging_handle == NULL )
@@ -1828,27 +1957,6 @@ int imaging_handle_output_storage_media_buffer_callback(
 		{
 			break;
 		}
-		write_count = imaging_handle_write_storage_media_buffer(
-			       imaging_handle,
-			       storage_media_buffer,
-			       storage_media_buffer->processed_size,
-			       &error );
-
-		if( write_count < 0 )
-		{
-			libcerror_error_set(
-			 &error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_WRITE_FAILED,
-			 "%s: unable to write storage media buffer.",
-			 function );
-
-			storage_media_buffer = NULL;
-
-			goto on_error;
-		}
-		imaging_handle->last_offset_written = storage_media_buffer->storage_media_offset + storage_media_buffer->processed_size;
-
 		if( libcdata_list_element_get_next_element(
 		     element,
 		     &next_element,
@@ -1899,16 +2007,24 @@ int imaging_handle_output_storage_media_buffer_callback(
 		}
 		element = next_element;
 
-		if( storage_media_buffer_queue_release_buffer(
-		     imaging_handle->storage_media_buffer_queue,
+		/* The storage media buffer can be reused as soon as it was pushed
+		 */
+		imaging_handle->last_offset_written = storage_media_buffer->storage_media_offset + storage_media_buffer->processed_size;
+
+		/* The output writer pool writes the storage media buffer to every output handle
+		 * and releases it onto the storage media buffer queue afterwards
+		 */
+		if( output_writer_pool_push(
+		     imaging_handle->output_writer_pool,
 		     storage_media_buffer,
+		     storage_media_buffer->processed_size,
 		     &error ) != 1 )
 		{
 			libcerror_error_set(
 			 &error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to release storage media buffer onto queue.",
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to push storage media buffer onto output writer pool.",
 			 function );
 
 			goto on_error;
@@ -2108,6 +2224,68 @@ int imaging_handle_empty_output_list(
 	return( 1 );
 }
 
+/* Creates the output writer pool that writes to the output handle and the secondary output handles
+ * Returns 1 if successful or -1 on error
+ */
+int imaging_handle_initialize_output_writer_pool(
+     imaging_handle_t *imaging_handle,
+     libcerror_error_t **error )
+{
+	libewf_handle_t *output_handles[ OUTPUT_WRITER_POOL_MAXIMUM_NUMBER_OF_OUTPUT_HANDLES ];
+
+	static char *function   = "imaging_handle_initialize_output_writer_pool";
+	int output_handle_index = 0;
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( imaging_handle->number_of_secondary_output_handles < 0 )
+	 || ( imaging_handle->number_of_secondary_output_handles > IMAGING_HANDLE_MAXIMUM_NUMBER_OF_SECONDARY_TARGETS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid imaging handle - number of secondary output handles value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	output_handles[ 0 ] = imaging_handle->output_handle;
+
+	for( output_handle_index = 0;
+	     output_handle_index < imaging_handle->number_of_secondary_output_handles;
+	     output_handle_index++ )
+	{
+		output_handles[ output_handle_index + 1 ] = imaging_handle->secondary_output_handles[ output_handle_index ];
+	}
+	if( output_writer_pool_initialize(
+	     &( imaging_handle->output_writer_pool ),
+	     output_handles,
+	     imaging_handle->number_of_secondary_output_handles + 1,
+	     imaging_handle->storage_media_buffer_queue,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create output writer pool.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
 /* Retrieves the chunk size
@@ -4182,6 +4360,48 @@ int imaging_handle_set_process_buffer_size(
 	return( result );
 }
 
+/* Sets the write mode
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int imaging_handle_set_write_mode(
+     imaging_handle_t *imaging_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "imaging_handle_set_write_mode";
+	int result            = 0;
+
+	if( imaging_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid imaging handle.",
+		 function );
+
+		return( -1 );
+	}
+	result = ewfinput_determine_write_mode(
+	          string,
+	          &( imaging_handle->write_buffer_size ),
+	          &( imaging_handle->write_flags ),
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine write mode.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
 /* Sets the number of threads
  * Returns 1 if successful, 0 if unsupported value or -1 on error
  */
@@ -4565,7 +4785,9 @@ int imaging_handle_set_output_values(
 	uint8_t guid_type     = 0;
 #endif
 
-	static char *function = "imaging_handle_set_output_values";
+	static char *function     = "imaging_handle_set_output_values";
+	uint8_t compression_flags = 0;
+	int output_handle_index   = 0;
 
 	if( imaging_handle == NULL )
 	{
@@ -4899,10 +5121,16 @@ int imaging_handle_set_output_values(
 
 		return( -1 );
 	}
+	compression_flags = imaging_handle->compression_flags;
+
+	if( imaging_handle->use_adaptive_compression != 0 )
+	{
+		compression_flags |= LIBEWF_COMPRESS_FLAG_USE_ADAPTIVE_COMPRESSION;
+	}
 	if( libewf_handle_set_compression_values(
 	     imaging_handle->output_handle,
 	     imaging_handle->compression_level,
-	     imaging_handle->compression_flags,
+	     compression_flags,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
@@ -4928,6 +5156,21 @@ int imaging_handle_set_output_values(
 
 		return( -1 );
 	}
+	if( libewf_handle_set_write_buffer_values(
+	     imaging_handle->output_handle,
+	     imaging_handle->write_buffer_size,
+	     imaging_handle->write_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set write buffer values.",
+		 function );
+
+		return( -1 );
+	}
 	if( libewf_handle_set_sectors_per_chunk(
 	     imaging_handle->output_handle,
 	     imaging_handle->sectors_per_chunk,
@@ -4961,10 +5204,12 @@ int imaging_handle_set_output_values(
 
 		return( -1 );
 	}
-	if( imaging_handle->secondary_output_handle != NULL )
+	for( output_handle_index = 0;
+	     output_handle_index < imaging_handle->number_of_secondary_output_handles;
+	     output_handle_index++ )
 	{
 		if( libewf_handle_set_header_codepage(
-		     imaging_handle->secondary_output_handle,
+		     imaging_handle->secondary_output_handles[ output_handle_index ],
 		     imaging_handle->header_codepage,
 		     error ) != 1 )
 		{
@@ -4978,7 +5223,7 @@ int imaging_handle_set_output_values(
 			return( -1 );
 		}
 		if( libewf_handle_set_bytes_per_sector(
-		     imaging_handle->secondary_output_handle,
+		     imaging_handle->secondary_output_handles[ output_handle_index ],
 		     imaging_handle->bytes_per_sector,
 		     error ) != 1 )
 		{
@@ -4992,7 +5237,7 @@ int imaging_handle_set_output_values(
 			return( -1 );
 		}
 		if( libewf_handle_set_media_size(
-		     imaging_handle->secondary_output_handle,
+		     imaging_handle->secondary_output_handles[ output_handle_index ],
 		     imaging_handle->acquiry_size,
 		     error ) != 1 )
 		{
@@ -5006,7 +5251,7 @@ int imaging_handle_set_output_values(
 			return( -1 );
 		}
 		if( libewf_handle_set_media_type(
-		     imaging_handle->secondary_output_handle,
+		     imaging_handle->secondary_output_handles[ output_handle_index ],
 		     imaging_handle->media_type,
 		     error ) != 1 )
 		{
@@ -5020,7 +5265,7 @@ int imaging_handle_set_output_values(
 			return( -1 );
 		}
 		if( libewf_handle_set_media_flags(
-		     imaging_handle->secondary_output_handle,
+		     imaging_handle->secondary_output_handles[ output_handle_index ],
 		     imaging_handle->media_flags,
 		     error ) != 1 )
 		{
@@ -5036,7 +5281,7 @@ int imaging_handle_set_output_values(
 		/* Format needs to be set before segment file size and compression values
 		 */
 		if( libewf_handle_set_format(
-		     imaging_handle->secondary_output_handle,
+		     imaging_handle->secondary_output_handles[ output_handle_index ],
 		     imaging_handle->ewf_format,
 		     error ) != 1 )
 		{
@@ -5050,7 +5295,7 @@ int imaging_handle_set_output_values(
 			return( -1 );
 		}
 		if( libewf_handle_set_compression_method(
-		     imaging_handle->secondary_output_handle,
+		     imaging_handle->secondary_output_handles[ output_handle_index ],
 		     imaging_handle->compression_method,
 		     error ) != 1 )
 		{
@@ -5064,9 +5309,9 @@ int imaging_handle_set_output_values(
 			return( -1 );
 		}
 		if( libewf_handle_set_compression_values(
-		     imaging_handle->secondary_output_handle,
+		     imaging_handle->secondary_output_handles[ output_handle_index ],
 		     imaging_handle->compression_level,
-		     imaging_handle->compression_flags,
+		     compression_flags,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
@@ -5079,7 +5324,7 @@ int imaging_handle_set_output_values(
 			return( -1 );
 		}
 		if( libewf_handle_set_maximum_segment_size(
-		     imaging_handle->secondary_output_handle,
+		     imaging_handle->secondary_output_handles[ output_handle_index ],
 		     imaging_handle->maximum_segment_size,
 		     error ) != 1 )
 		{
@@ -5092,8 +5337,23 @@ int imaging_handle_set_output_values(
 
 			return( -1 );
 		}
+		if( libewf_handle_set_write_buffer_values(
+		     imaging_handle->secondary_output_handles[ output_handle_index ],
+		     imaging_handle->write_buffer_size,
+		     imaging_handle->write_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set write buffer values in secondary output handle.",
+			 function );
+
+			return( -1 );
+		}
 		if( libewf_handle_set_sectors_per_chunk(
-		     imaging_handle->secondary_output_handle,
+		     imaging_handle->secondary_output_handles[ output_handle_index ],
 		     imaging_handle->sectors_per_chunk,
 		     error ) != 1 )
 		{
@@ -5107,7 +5367,7 @@ int imaging_handle_set_output_values(
 			return( -1 );
 		}
 		if( libewf_handle_set_error_granularity(
-		     imaging_handle->secondary_output_handle,
+		     imaging_handle->secondary_output_handles[ output_handle_index ],
 		     imaging_handle->sector_error_granularity,
 		     error ) != 1 )
 		{
@@ -5170,10 +5430,12 @@ int imaging_handle_set_output_values(
 
 			return( -1 );
 		}
-		if( imaging_handle->secondary_output_handle != NULL )
+		for( output_handle_index = 0;
+		     output_handle_index < imaging_handle->number_of_secondary_output_handles;
+		     output_handle_index++ )
 		{
 			if( libewf_handle_set_segment_file_set_identifier(
-			     imaging_handle->secondary_output_handle,
+			     imaging_handle->secondary_output_handles[ output_handle_index ],
 			     guid,
 			     GUID_SIZE,
 			     error ) != 1 )
@@ -5350,6 +5612,7 @@ int imaging_handle_set_header_value(
 {
 	static char *function      = "imaging_handle_set_header_value";
 	size_t header_value_length = 0;
+	int output_handle_index    = 0;
 	int result                 = 0;
 
 	if( imaging_handle == NULL )
@@ -5408,11 +5671,13 @@ int imaging_handle_set_header_value(
 
 			return( -1 );
 		}
-		if( imaging_handle->secondary_output_handle != NULL )
+		for( output_handle_index = 0;
+		     output_handle_index < imaging_handle->number_of_secondary_output_handles;
+		     output_handle_index++ )
 		{
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
 			result = libewf_handle_set_utf16_header_value(
-				  imaging_handle->secondary_output_handle,
+				  imaging_handle->secondary_output_handles[ output_handle_index ],
 				  identifier,
 				  identifier_length,
 				  (uint16_t *) header_value,
@@ -5420,7 +5685,7 @@ int imaging_handle_set_header_value(
 				  error );
 #else
 			result = libewf_handle_set_utf8_header_value(
-				  imaging_handle->secondary_output_handle,
+				  imaging_handle->secondary_output_handles[ output_handle_index ],
 				  identifier,
 				  identifier_length,
 				  (uint8_t *) header_value,
@@ -5458,6 +5723,7 @@ int imaging_handle_set_hash_value(
 	uint8_t *utf8_hash_value    = NULL;
 	static char *function       = "imaging_handle_set_hash_value";
 	size_t utf8_hash_value_size = 0;
+	int output_handle_index     = 0;
 
 	if( imaging_handle == NULL )
 	{
@@ -5533,10 +5799,12 @@ int imaging_handle_set_hash_value(
 
 		goto on_error;
 	}
-	if( imaging_handle->secondary_output_handle != NULL )
+	for( output_handle_index = 0;
+	     output_handle_index < imaging_handle->number_of_secondary_output_handles;
+	     output_handle_index++ )
 	{
 		if( libewf_handle_set_utf8_hash_value(
-		     imaging_handle->secondary_output_handle,
+		     imaging_handle->secondary_output_handles[ output_handle_index ],
 		     (uint8_t *) hash_value_identifier,
 		     hash_value_identifier_length,
 		     utf8_hash_value,
@@ -5580,6 +5848,7 @@ int imaging_handle_append_read_error(
 	static char *function      = "imaging_handle_append_read_error";
 	uint64_t number_of_sectors = 0;
 	uint64_t start_sector      = 0;
+	int output_handle_index    = 0;
 
 	if( imaging_handle == NULL )
 	{
@@ -5625,10 +5894,12 @@ int imaging_handle_append_read_error(
 
 		return( -1 );
 	}
-	if( imaging_handle->secondary_output_handle != NULL )
+	for( output_handle_index = 0;
+	     output_handle_index < imaging_handle->number_of_secondary_output_handles;
+	     output_handle_index++ )
 	{
 		if( libewf_handle_append_acquiry_error(
-		     imaging_handle->secondary_output_handle,
+		     imaging_handle->secondary_output_handles[ output_handle_index ],
 		     start_sector,
 		     number_of_sectors,
 		     error ) != 1 )
@@ -5655,7 +5926,8 @@ int imaging_handle_append_session(
      uint64_t number_of_sectors,
      libcerror_error_t **error )
 {
-	static char *function = "imaging_handle_append_session";
+	static char *function   = "imaging_handle_append_session";
+	int output_handle_index = 0;
 
 	if( imaging_handle == NULL )
 	{
@@ -5683,10 +5955,12 @@ int imaging_handle_append_session(
 
 		return( -1 );
 	}
-	if( imaging_handle->secondary_output_handle != NULL )
+	for( output_handle_index = 0;
+	     output_handle_index < imaging_handle->number_of_secondary_output_handles;
+	     output_handle_index++ )
 	{
 		if( libewf_handle_append_session(
-		     imaging_handle->secondary_output_handle,
+		     imaging_handle->secondary_output_handles[ output_handle_index ],
 		     start_sector,
 		     number_of_sectors,
 		     error ) != 1 )
@@ -5713,7 +5987,8 @@ int imaging_handle_append_track(
      uint64_t number_of_sectors,
      libcerror_error_t **error )
 {
-	static char *function = "imaging_handle_append_track";
+	static char *function   = "imaging_handle_append_track";
+	int output_handle_index = 0;
 
 	if( imaging_handle == NULL )
 	{
@@ -5741,10 +6016,12 @@ int imaging_handle_append_track(
 
 		return( -1 );
 	}
-	if( imaging_handle->secondary_output_handle != NULL )
+	for( output_handle_index = 0;
+	     output_handle_index < imaging_handle->number_of_secondary_output_handles;
+	     output_handle_index++ )
 	{
 		if( libewf_handle_append_track(
-		     imaging_handle->secondary_output_handle,
+		     imaging_handle->secondary_output_handles[ output_handle_index ],
 		     start_sector,
 		     number_of_sectors,
 		     error ) != 1 )
@@ -5772,6 +6049,7 @@ ssize_t imaging_handle_finalize(
 	static char *function         = "imaging_handle_finalize";
 	ssize_t secondary_write_count = 0;
 	ssize_t write_count           = 0;
+	int output_handle_index       = 0;
 
 	if( imaging_handle == NULL )
 	{
@@ -5859,10 +6137,12 @@ ssize_t imaging_handle_finalize(
 
 		return( -1 );
 	}
-	if( imaging_handle->secondary_output_handle != NULL )
+	for( output_handle_index = 0;
+	     output_handle_index < imaging_handle->number_of_secondary_output_handles;
+	     output_handle_index++ )
 	{
 		secondary_write_count = libewf_handle_write_finalize(
-		                         imaging_handle->secondary_output_handle,
+		                         imaging_handle->secondary_output_handles[ output_handle_index ],
 		                         error );
 
 		if( secondary_write_count == -1 )
@@ -5894,8 +6174,9 @@ int imaging_handle_print_parameters(
 	system_character_t acquiry_size_string[ 16 ];
 	system_character_t maximum_segment_size_string[ 16 ];
 
-	static char *function = "imaging_handle_print_parameters";
-	int result            = 0;
+	static char *function   = "imaging_handle_print_parameters";
+	int output_handle_index = 0;
+	int result              = 0;
 
 	if( imaging_handle == NULL )
 	{
@@ -5981,12 +6262,14 @@ int imaging_handle_print_parameters(
 	 imaging_handle->notify_stream,
 	 "\n" );
 
-	if( imaging_handle->secondary_target_filename != NULL )
+	for( output_handle_index = 0;
+	     output_handle_index < imaging_handle->number_of_secondary_targets;
+	     output_handle_index++ )
 	{
 		fprintf(
 		 imaging_handle->notify_stream,
 		 "Secondary copy:\t\t\t\t%" PRIs_SYSTEM "",
-		 imaging_handle->secondary_target_filename );
+		 imaging_handle->secondary_target_filenames[ output_handle_index ] );
 
 		if( resume_acquiry == 0 )
 		{
@@ -6312,6 +6595,13 @@ int imaging_handle_print_parameters(
 			 "none" );
 		}
 	}
+	if( ( imaging_handle->compression_level != LIBEWF_COMPRESSION_NONE )
+	 && ( imaging_handle->use_adaptive_compression != 0 ) )
+	{
+		fprintf(
+		 imaging_handle->notify_stream,
+		 " (adaptive)" );
+	}
 	fprintf(
 	 imaging_handle->notify_stream,
 	 "\n" );
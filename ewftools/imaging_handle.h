@@ -26,11 +26,13 @@
 #include <file_stream.h>
 #include <types.h>
 
+#include "digest_hash_pool.h"
 #include "ewftools_libcdata.h"
 #include "ewftools_libcerror.h"
 #include "ewftools_libcthreads.h"
 #include "ewftools_libewf.h"
 #include "ewftools_libhmac.h"
+#include "output_writer_pool.h"
 #include "process_status.h"
 #include "storage_media_buffer.h"
 
@@ -38,6 +40,10 @@
 extern "C" {
 #endif
 
+/* The maximum number of secondary targets
+ */
+#define IMAGING_HANDLE_MAXIMUM_NUMBER_OF_SECONDARY_TARGETS	( OUTPUT_WRITER_POOL_MAXIMUM_NUMBER_OF_OUTPUT_HANDLES - 1 )
+
 typedef struct imaging_handle imaging_handle_t;
 
 struct imaging_handle
@@ -54,13 +60,17 @@ struct imaging_handle
 	 */
 	size_t target_filename_size;
 
-	/* The secondary target filename
+	/* The secondary target filenames
+	 */
+	system_character_t *secondary_target_filenames[ IMAGING_HANDLE_MAXIMUM_NUMBER_OF_SECONDARY_TARGETS ];
+
+	/* The secondary target filename sizes
 	 */
-	system_character_t *secondary_target_filename;
+	size_t secondary_target_filename_sizes[ IMAGING_HANDLE_MAXIMUM_NUMBER_OF_SECONDARY_TARGETS ];
 
-	/* The secondary target filename size
+	/* The number of secondary targets
 	 */
-	size_t secondary_target_filename_size;
+	int number_of_secondary_targets;
 
 	/* The header codepage
 	 */
@@ -118,6 +128,10 @@ struct imaging_handle
 	 */
 	uint8_t compression_flags;
 
+	/* Value to indicate if adaptive compression should be used
+	 */
+	uint8_t use_adaptive_compression;
+
 	/* The EWF format
 	 */
 	uint8_t ewf_format;
@@ -210,6 +224,14 @@ struct imaging_handle
 	 */
 	size_t process_buffer_size;
 
+	/* The size of the buffer used to coalesce the writes to a segment file
+	 */
+	size_t write_buffer_size;
+
+	/* The segment file write flags
+	 */
+	uint8_t write_flags;
+
 	/* The number of threads in the process thread pool
 	 */
 	int number_of_threads;
@@ -232,15 +254,27 @@ struct imaging_handle
 	 */
 	libcthreads_queue_t *storage_media_buffer_queue;
 
+	/* The output writer pool
+	 */
+	output_writer_pool_t *output_writer_pool;
+
+	/* The digest hash pool
+	 */
+	digest_hash_pool_t *digest_hash_pool;
+
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
 	/* The libewf output handle
 	 */
 	libewf_handle_t *output_handle;
 
-	/* The secondary libewf output handle
+	/* The secondary libewf output handles
+	 */
+	libewf_handle_t *secondary_output_handles[ IMAGING_HANDLE_MAXIMUM_NUMBER_OF_SECONDARY_TARGETS ];
+
+	/* The number of secondary libewf output handles
 	 */
-	libewf_handle_t *secondary_output_handle;
+	int number_of_secondary_output_handles;
 
 	/* The input media size
 	 */
@@ -354,6 +388,10 @@ int imaging_handle_empty_output_list(
      imaging_handle_t *imaging_handle,
      libcerror_error_t **error );
 
+int imaging_handle_initialize_output_writer_pool(
+     imaging_handle_t *imaging_handle,
+     libcerror_error_t **error );
+
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
 int imaging_handle_get_chunk_size(
@@ -494,6 +532,11 @@ int imaging_handle_set_process_buffer_size(
      const system_character_t *string,
      libcerror_error_t **error );
 
+int imaging_handle_set_write_mode(
+     imaging_handle_t *imaging_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
 int imaging_handle_set_number_of_threads(
      imaging_handle_t *imaging_handle,
      const system_character_t *string,
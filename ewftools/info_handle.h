@@ -85,6 +85,11 @@ int info_handle_set_bodyfile(
      const system_character_t *filename,
      libcerror_error_t **error );
 
+int info_handle_set_index_filename(
+     info_handle_t *info_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
 int info_handle_set_maximum_number_of_open_handles(
      info_handle_t *info_handle,
      int maximum_number_of_open_handles,
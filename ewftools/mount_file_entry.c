@@ -1235,3 +1235,157 @@ int mount_file_entry_get_size(
 	return( 1 );
 }
 
+/* Retrieves the offset of the next data or hole at or after a specific offset
+ * A hole consists of empty chunks, only the data of the handle can contain holes
+ * The end of the data is considered a hole
+ * Returns 1 if successful, 0 if no such offset exists or -1 on error
+ */
+int mount_file_entry_get_next_data_or_hole_offset(
+     mount_file_entry_t *file_entry,
+     off64_t offset,
+     uint8_t find_hole,
+     off64_t *next_offset,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_file_entry_get_next_data_or_hole_offset";
+	size64_t size         = 0;
+	size32_t chunk_size   = 0;
+	uint64_t chunk_index  = 0;
+	uint64_t fill_pattern = 0;
+	int result            = 0;
+
+	if( file_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( next_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid next offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( mount_file_entry_get_size(
+	     file_entry,
+	     &size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve size.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) offset >= size )
+	{
+		return( 0 );
+	}
+	if( ( file_entry->type == MOUNT_FILE_ENTRY_TYPE_FILE_ENTRY )
+	 || ( file_entry->ewf_handle == NULL ) )
+	{
+		if( find_hole == 0 )
+		{
+			*next_offset = offset;
+		}
+		else
+		{
+			*next_offset = (off64_t) size;
+		}
+		return( 1 );
+	}
+	if( libewf_handle_get_chunk_size(
+	     file_entry->ewf_handle,
+	     &chunk_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk size from handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	for( chunk_index = (uint64_t) offset / chunk_size;
+	     ( chunk_index * chunk_size ) < size;
+	     chunk_index++ )
+	{
+		result = libewf_handle_get_chunk_fill_info(
+		          file_entry->ewf_handle,
+		          chunk_index,
+		          &fill_pattern,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve chunk: %" PRIu64 " fill information from handle.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		/* Stop at the first chunk that is empty when searching for a hole
+		 * or at the first chunk that is not empty when searching for data
+		 */
+		if( ( ( result != 0 )
+		  &&  ( fill_pattern == 0 ) ) == ( find_hole != 0 ) )
+		{
+			*next_offset = (off64_t) ( chunk_index * chunk_size );
+
+			if( *next_offset < offset )
+			{
+				*next_offset = offset;
+			}
+			return( 1 );
+		}
+	}
+	if( find_hole == 0 )
+	{
+		return( 0 );
+	}
+	*next_offset = (off64_t) size;
+
+	return( 1 );
+}
+
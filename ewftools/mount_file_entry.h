@@ -147,6 +147,13 @@ int mount_file_entry_get_size(
      size64_t *size,
      libcerror_error_t **error );
 
+int mount_file_entry_get_next_data_or_hole_offset(
+     mount_file_entry_t *file_entry,
+     off64_t offset,
+     uint8_t find_hole,
+     off64_t *next_offset,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -44,7 +44,7 @@
 
 extern mount_handle_t *ewfmount_mount_handle;
 
-#if defined( HAVE_LIBFUSE ) || defined( HAVE_LIBOSXFUSE )
+#if defined( HAVE_LIBFUSE ) || defined( HAVE_LIBFUSE3 ) || defined( HAVE_LIBOSXFUSE )
 
 #if ( SIZEOF_OFF_T != 8 ) && ( SIZEOF_OFF_T != 4 )
 #error Size of off_t not supported
@@ -255,11 +255,20 @@ int mount_fuse_filldir(
 
 		return( -1 );
 	}
+#if defined( HAVE_LIBFUSE3 )
 	if( filler(
 	     buffer,
 	     name,
 	     stat_info,
+	     0,
 	     0 ) == 1 )
+#else
+	if( filler(
+	     buffer,
+	     name,
+	     stat_info,
+	     0 ) == 1 )
+#endif
 	{
 		libcerror_error_set(
 		 error,
@@ -363,6 +372,11 @@ int mount_fuse_open(
 
 		goto on_error;
 	}
+	/* The data of the image does not change, hence the data cached by the kernel
+	 * remains valid when the file is opened again
+	 */
+	file_info->keep_cache = 1;
+
 	return( 0 );
 
 on_error:
@@ -485,6 +499,136 @@ on_error:
 	return( result );
 }
 
+#if defined( MOUNT_FUSE_HAVE_LSEEK )
+
+/* Seeks the next data or hole at or after the specified offset
+ * Only SEEK_DATA and SEEK_HOLE are passed by the kernel
+ * Returns the resulting offset if successful or a negative errno value otherwise
+ */
+off_t mount_fuse_lseek(
+       const char *path,
+       off_t offset,
+       int whence,
+       struct fuse_file_info *file_info )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "mount_fuse_lseek";
+	off64_t next_offset      = 0;
+	uint8_t find_hole        = 0;
+	int result               = 0;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: %s\n",
+		 function,
+		 path );
+	}
+#endif
+	if( path == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	if( whence == SEEK_DATA )
+	{
+		find_hole = 0;
+	}
+	else if( whence == SEEK_HOLE )
+	{
+		find_hole = 1;
+	}
+	else
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported whence.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	if( file_info == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file information.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	if( file_info->fh == (uint64_t) NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file information - missing file handle.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	if( offset < 0 )
+	{
+		return( -ENXIO );
+	}
+	result = mount_file_entry_get_next_data_or_hole_offset(
+	          (mount_file_entry_t *) file_info->fh,
+	          (off64_t) offset,
+	          find_hole,
+	          &next_offset,
+	          &error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve next data or hole offset from file entry.",
+		 function );
+
+		result = -EIO;
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		return( -ENXIO );
+	}
+	return( (off_t) next_offset );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	return( (off_t) result );
+}
+
+#endif /* defined( MOUNT_FUSE_HAVE_LSEEK ) */
+
 /* Releases a file entry
  * Returns 0 if successful or a negative errno value otherwise
  */
@@ -655,12 +799,22 @@ on_error:
 /* Reads a directory
  * Returns 0 if successful or a negative errno value otherwise
  */
+#if defined( HAVE_LIBFUSE3 )
+int mount_fuse_readdir(
+     const char *path,
+     void *buffer,
+     fuse_fill_dir_t filler,
+     off_t offset EWFTOOLS_ATTRIBUTE_UNUSED,
+     struct fuse_file_info *file_info EWFTOOLS_ATTRIBUTE_UNUSED,
+     enum fuse_readdir_flags flags EWFTOOLS_ATTRIBUTE_UNUSED )
+#else
 int mount_fuse_readdir(
      const char *path,
      void *buffer,
      fuse_fill_dir_t filler,
      off_t offset EWFTOOLS_ATTRIBUTE_UNUSED,
      struct fuse_file_info *file_info EWFTOOLS_ATTRIBUTE_UNUSED )
+#endif
 {
 	struct stat *stat_info                = NULL;
 	libcerror_error_t *error              = NULL;
@@ -675,6 +829,10 @@ int mount_fuse_readdir(
 
 	EWFTOOLS_UNREFERENCED_PARAMETER( offset )
 
+#if defined( HAVE_LIBFUSE3 )
+	EWFTOOLS_UNREFERENCED_PARAMETER( flags )
+#endif
+
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
 	{
@@ -1044,9 +1202,16 @@ on_error:
 /* Retrieves the file stat info
  * Returns 0 if successful or a negative errno value otherwise
  */
+#if defined( HAVE_LIBFUSE3 )
+int mount_fuse_getattr(
+     const char *path,
+     struct stat *stat_info,
+     struct fuse_file_info *file_info EWFTOOLS_ATTRIBUTE_UNUSED )
+#else
 int mount_fuse_getattr(
      const char *path,
      struct stat *stat_info )
+#endif
 {
 	libcerror_error_t *error       = NULL;
 	mount_file_entry_t *file_entry = NULL;
@@ -1058,6 +1223,10 @@ int mount_fuse_getattr(
 	uint16_t file_mode             = 0;
 	int result                     = 0;
 
+#if defined( HAVE_LIBFUSE3 )
+	EWFTOOLS_UNREFERENCED_PARAMETER( file_info )
+#endif
+
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
 	{
@@ -1267,6 +1436,40 @@ on_error:
 	return( result );
 }
 
+#if defined( HAVE_LIBFUSE3 )
+
+/* Initializes the connection and the configuration when fuse is started
+ * Returns the private data of the fuse context
+ */
+void *mount_fuse_init(
+       struct fuse_conn_info *connection_info,
+       struct fuse_config *configuration )
+{
+	if( connection_info != NULL )
+	{
+		/* The kernel splits reads into requests of at most max_read bytes,
+		 * the maximum number of pages per request is negotiated by libfuse
+		 */
+		connection_info->max_read = MOUNT_FUSE_MAXIMUM_READ_SIZE;
+
+		if( connection_info->max_readahead < MOUNT_FUSE_MAXIMUM_READ_SIZE )
+		{
+			connection_info->max_readahead = MOUNT_FUSE_MAXIMUM_READ_SIZE;
+		}
+	}
+	if( configuration != NULL )
+	{
+		/* The data of the image does not change, hence the kernel page cache
+		 * can retain the decompressed data for all file entries
+		 */
+		configuration->kernel_cache = 1;
+		configuration->auto_cache   = 0;
+	}
+	return( fuse_get_context()->private_data );
+}
+
+#endif /* defined( HAVE_LIBFUSE3 ) */
+
 /* Cleans up when fuse is done
  */
 void mount_fuse_destroy(
@@ -1314,5 +1517,5 @@ on_error:
 	return;
 }
 
-#endif /* defined( HAVE_LIBFUSE ) || defined( HAVE_LIBOSXFUSE ) */
+#endif /* defined( HAVE_LIBFUSE ) || defined( HAVE_LIBFUSE3 ) || defined( HAVE_LIBOSXFUSE ) */
 
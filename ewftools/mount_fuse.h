@@ -25,7 +25,12 @@
 #include <common.h>
 #include <types.h>
 
-#if defined( HAVE_LIBFUSE ) || defined( HAVE_LIBOSXFUSE )
+#if defined( HAVE_LIBFUSE3 )
+#define FUSE_USE_VERSION	31
+
+#include <fuse.h>
+
+#elif defined( HAVE_LIBFUSE ) || defined( HAVE_LIBOSXFUSE )
 #define FUSE_USE_VERSION	26
 
 #if defined( HAVE_LIBFUSE )
@@ -35,7 +40,30 @@
 #include <osxfuse/fuse.h>
 #endif
 
-#endif /* defined( HAVE_LIBFUSE ) || defined( HAVE_LIBOSXFUSE ) */
+#endif /* defined( HAVE_LIBFUSE3 ) */
+
+#if defined( HAVE_LIBFUSE ) || defined( HAVE_LIBFUSE3 ) || defined( HAVE_LIBOSXFUSE )
+
+/* The lseek operation, used for SEEK_DATA and SEEK_HOLE, was added in libfuse 3.8
+ * and is only available with the libfuse 3 API, with FUSE_USE_VERSION 26 it is not used
+ */
+#if defined( HAVE_LIBFUSE3 ) && defined( FUSE_MAJOR_VERSION ) && defined( FUSE_MINOR_VERSION ) && defined( SEEK_DATA ) && defined( SEEK_HOLE )
+#if ( FUSE_MAJOR_VERSION > 3 ) || ( ( FUSE_MAJOR_VERSION == 3 ) && ( FUSE_MINOR_VERSION >= 8 ) )
+#define MOUNT_FUSE_HAVE_LSEEK
+#endif
+#endif
+
+#if defined( HAVE_LIBFUSE3 )
+
+/* The maximum size of a read request, libfuse 3 negotiates a maximum number
+ * of pages with the kernel that allows for read requests of this size
+ */
+#define MOUNT_FUSE_MAXIMUM_READ_SIZE		1048576
+#define MOUNT_FUSE_MAXIMUM_READ_SIZE_OPTION	"max_read=1048576"
+
+#endif /* defined( HAVE_LIBFUSE3 ) */
+
+#endif /* defined( HAVE_LIBFUSE ) || defined( HAVE_LIBFUSE3 ) || defined( HAVE_LIBOSXFUSE ) */
 
 #include "ewftools_libcerror.h"
 #include "ewftools_libewf.h"
@@ -46,7 +74,7 @@
 extern "C" {
 #endif
 
-#if defined( HAVE_LIBFUSE ) || defined( HAVE_LIBOSXFUSE )
+#if defined( HAVE_LIBFUSE ) || defined( HAVE_LIBFUSE3 ) || defined( HAVE_LIBOSXFUSE )
 
 int mount_fuse_set_stat_info(
      struct stat *stat_info,
@@ -76,6 +104,16 @@ int mount_fuse_read(
      off_t offset,
      struct fuse_file_info *file_info );
 
+#if defined( MOUNT_FUSE_HAVE_LSEEK )
+
+off_t mount_fuse_lseek(
+       const char *path,
+       off_t offset,
+       int whence,
+       struct fuse_file_info *file_info );
+
+#endif /* defined( MOUNT_FUSE_HAVE_LSEEK ) */
+
 int mount_fuse_release(
      const char *path,
      struct fuse_file_info *file_info );
@@ -84,6 +122,18 @@ int mount_fuse_opendir(
      const char *path,
      struct fuse_file_info *file_info );
 
+#if defined( HAVE_LIBFUSE3 )
+
+int mount_fuse_readdir(
+     const char *path,
+     void *buffer,
+     fuse_fill_dir_t filler,
+     off_t offset,
+     struct fuse_file_info *file_info,
+     enum fuse_readdir_flags flags );
+
+#else
+
 int mount_fuse_readdir(
      const char *path,
      void *buffer,
@@ -91,18 +141,35 @@ int mount_fuse_readdir(
      off_t offset,
      struct fuse_file_info *file_info );
 
+#endif /* defined( HAVE_LIBFUSE3 ) */
+
 int mount_fuse_releasedir(
      const char *path,
      struct fuse_file_info *file_info );
 
+#if defined( HAVE_LIBFUSE3 )
+
+int mount_fuse_getattr(
+     const char *path,
+     struct stat *stat_info,
+     struct fuse_file_info *file_info );
+
+void *mount_fuse_init(
+       struct fuse_conn_info *connection_info,
+       struct fuse_config *configuration );
+
+#else
+
 int mount_fuse_getattr(
      const char *path,
      struct stat *stat_info );
 
+#endif /* defined( HAVE_LIBFUSE3 ) */
+
 void mount_fuse_destroy(
       void *private_data );
 
-#endif /* defined( HAVE_LIBFUSE ) || defined( HAVE_LIBOSXFUSE ) */
+#endif /* defined( HAVE_LIBFUSE ) || defined( HAVE_LIBFUSE3 ) || defined( HAVE_LIBOSXFUSE ) */
 
 #if defined( __cplusplus )
 }
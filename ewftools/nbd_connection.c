@@ -0,0 +1,2667 @@
+/*
+ * Network block device (NBD) connection
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#if defined( HAVE_ERRNO_H )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_SYS_SOCKET_H )
+#include <sys/socket.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcnotify.h"
+#include "ewftools_libcthreads.h"
+#include "ewftools_libewf.h"
+#include "nbd_connection.h"
+
+#if defined( HAVE_SYS_SOCKET_H ) && defined( HAVE_SYS_UN_H )
+
+/* The values of the fixed newstyle handshake
+ */
+#define NBD_MAGIC_PASSWORD				0x4e42444d41474943ULL
+#define NBD_MAGIC_OPTION				0x49484156454f5054ULL
+#define NBD_MAGIC_OPTION_REPLY				0x0003e889045565a9ULL
+#define NBD_MAGIC_REQUEST				0x25609513UL
+#define NBD_MAGIC_SIMPLE_REPLY				0x67446698UL
+#define NBD_MAGIC_STRUCTURED_REPLY			0x668e33efUL
+
+#define NBD_FLAG_FIXED_NEWSTYLE				0x0001
+#define NBD_FLAG_NO_ZEROES				0x0002
+
+#define NBD_FLAG_C_FIXED_NEWSTYLE			0x00000001UL
+#define NBD_FLAG_C_NO_ZEROES				0x00000002UL
+
+/* The transmission flags
+ */
+#define NBD_FLAG_HAS_FLAGS				0x0001
+#define NBD_FLAG_READ_ONLY				0x0002
+#define NBD_FLAG_SEND_FLUSH				0x0004
+#define NBD_FLAG_SEND_DF				0x0080
+#define NBD_FLAG_CAN_MULTI_CONN				0x0100
+
+/* The options
+ */
+#define NBD_OPT_EXPORT_NAME				1
+#define NBD_OPT_ABORT					2
+#define NBD_OPT_LIST					3
+#define NBD_OPT_INFO					6
+#define NBD_OPT_GO					7
+#define NBD_OPT_STRUCTURED_REPLY			8
+#define NBD_OPT_LIST_META_CONTEXT			9
+#define NBD_OPT_SET_META_CONTEXT			10
+
+/* The option reply types
+ */
+#define NBD_REP_ACK					1
+#define NBD_REP_SERVER					2
+#define NBD_REP_INFO					3
+#define NBD_REP_META_CONTEXT				4
+#define NBD_REP_ERR_UNSUP				0x80000001UL
+#define NBD_REP_ERR_INVALID				0x80000003UL
+
+#define NBD_INFO_EXPORT					0
+#define NBD_INFO_BLOCK_SIZE				3
+
+/* The commands
+ */
+#define NBD_CMD_READ					0
+#define NBD_CMD_WRITE					1
+#define NBD_CMD_DISC					2
+#define NBD_CMD_FLUSH					3
+#define NBD_CMD_TRIM					4
+#define NBD_CMD_WRITE_ZEROES				6
+#define NBD_CMD_BLOCK_STATUS				7
+
+#define NBD_CMD_FLAG_REQ_ONE				0x0008
+
+/* The structured reply types
+ */
+#define NBD_REPLY_FLAG_DONE				0x0001
+
+#define NBD_REPLY_TYPE_NONE				0
+#define NBD_REPLY_TYPE_OFFSET_DATA			1
+#define NBD_REPLY_TYPE_BLOCK_STATUS			5
+#define NBD_REPLY_TYPE_ERROR				0x8001
+
+/* The error values, these are defined by the protocol and not by the platform
+ */
+#define NBD_EPERM					1
+#define NBD_EIO						5
+#define NBD_ENOMEM					12
+#define NBD_EINVAL					22
+
+/* The base:allocation meta context
+ */
+#define NBD_META_CONTEXT_BASE_ALLOCATION		"base:allocation"
+#define NBD_META_CONTEXT_BASE_ALLOCATION_LENGTH		15
+#define NBD_META_CONTEXT_BASE_ALLOCATION_IDENTIFIER	1
+
+#define NBD_STATE_HOLE					0x00000001UL
+#define NBD_STATE_ZERO					0x00000002UL
+
+#if !defined( MSG_NOSIGNAL )
+#define MSG_NOSIGNAL					0
+#endif
+
+/* Creates a connection
+ * Make sure the value connection is referencing, is set to NULL
+ * The connection takes over the socket descriptor
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_initialize(
+     nbd_connection_t **connection,
+     libewf_handle_t *input_handle,
+     int socket_descriptor,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_connection_initialize";
+
+	if( connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( *connection != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid connection value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( input_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid input handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( socket_descriptor < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid socket descriptor value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_threads < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of threads value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	*connection = memory_allocate_structure(
+	               nbd_connection_t );
+
+	if( *connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create connection.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *connection,
+	     0,
+	     sizeof( nbd_connection_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear connection.",
+		 function );
+
+		memory_free(
+		 *connection );
+
+		*connection = NULL;
+
+		return( -1 );
+	}
+	( *connection )->socket_descriptor = -1;
+
+	if( libewf_handle_get_media_size(
+	     input_handle,
+	     &( ( *connection )->media_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_get_chunk_size(
+	     input_handle,
+	     &( ( *connection )->chunk_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve chunk size.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *connection )->write_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize write mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	( *connection )->input_handle      = input_handle;
+	( *connection )->socket_descriptor = socket_descriptor;
+	( *connection )->number_of_threads = number_of_threads;
+
+	return( 1 );
+
+on_error:
+	if( *connection != NULL )
+	{
+		memory_free(
+		 *connection );
+
+		*connection = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a connection
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_free(
+     nbd_connection_t **connection,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_connection_free";
+	int result            = 1;
+
+	if( connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( *connection != NULL )
+	{
+		/* The input handle is freed elsewhere
+		 */
+		if( ( *connection )->socket_descriptor != -1 )
+		{
+			if( close(
+			     ( *connection )->socket_descriptor ) != 0 )
+			{
+				libcerror_system_set_error(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 errno,
+				 "%s: unable to close socket.",
+				 function );
+
+				result = -1;
+			}
+		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_free(
+		     &( ( *connection )->write_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free write mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		memory_free(
+		 *connection );
+
+		*connection = NULL;
+	}
+	return( result );
+}
+
+/* Signals the connection to abort
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_signal_abort(
+     nbd_connection_t *connection,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_connection_signal_abort";
+
+	if( connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid connection.",
+		 function );
+
+		return( -1 );
+	}
+	connection->abort = 1;
+
+	/* Shut down the socket so that a blocking read returns
+	 */
+	if( connection->socket_descriptor != -1 )
+	{
+		shutdown(
+		 connection->socket_descriptor,
+		 SHUT_RDWR );
+	}
+	return( 1 );
+}
+
+/* Reads data from the connection
+ * Returns 1 if successful, 0 if the connection was closed before any data was read or -1 on error
+ */
+int nbd_connection_read_data(
+     nbd_connection_t *connection,
+     uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_connection_read_data";
+	size_t buffer_offset  = 0;
+	ssize_t read_count    = 0;
+
+	if( connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	while( buffer_offset < buffer_size )
+	{
+		read_count = recv(
+		              connection->socket_descriptor,
+		              &( buffer[ buffer_offset ] ),
+		              buffer_size - buffer_offset,
+		              0 );
+
+		if( read_count < 0 )
+		{
+			if( errno == EINTR )
+			{
+				continue;
+			}
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 errno,
+			 "%s: unable to read from socket.",
+			 function );
+
+			return( -1 );
+		}
+		else if( read_count == 0 )
+		{
+			if( buffer_offset == 0 )
+			{
+				return( 0 );
+			}
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unexpected end of stream.",
+			 function );
+
+			return( -1 );
+		}
+		buffer_offset += (size_t) read_count;
+	}
+	return( 1 );
+}
+
+/* Writes data to the connection
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_write_data(
+     nbd_connection_t *connection,
+     const uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_connection_write_data";
+	size_t buffer_offset  = 0;
+	ssize_t write_count   = 0;
+
+	if( connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	while( buffer_offset < buffer_size )
+	{
+		write_count = send(
+		               connection->socket_descriptor,
+		               &( buffer[ buffer_offset ] ),
+		               buffer_size - buffer_offset,
+		               MSG_NOSIGNAL );
+
+		if( write_count < 0 )
+		{
+			if( errno == EINTR )
+			{
+				continue;
+			}
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 errno,
+			 "%s: unable to write to socket.",
+			 function );
+
+			return( -1 );
+		}
+		buffer_offset += (size_t) write_count;
+	}
+	return( 1 );
+}
+
+/* Writes an option reply
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_write_option_reply(
+     nbd_connection_t *connection,
+     uint32_t option,
+     uint32_t reply_type,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	uint8_t reply_header[ 20 ];
+
+	static char *function = "nbd_connection_write_option_reply";
+
+	if( data_size > (size_t) UINT32_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint64_big_endian(
+	 &( reply_header[ 0 ] ),
+	 NBD_MAGIC_OPTION_REPLY );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( reply_header[ 8 ] ),
+	 option );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( reply_header[ 12 ] ),
+	 reply_type );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( reply_header[ 16 ] ),
+	 (uint32_t) data_size );
+
+	if( nbd_connection_write_data(
+	     connection,
+	     reply_header,
+	     20,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write option reply header.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > 0 )
+	{
+		if( nbd_connection_write_data(
+		     connection,
+		     data,
+		     data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write option reply data.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Writes the export information in reply to an export name, info or go option
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_write_export_information(
+     nbd_connection_t *connection,
+     uint32_t option,
+     libcerror_error_t **error )
+{
+	uint8_t information_data[ 134 ];
+
+	static char *function           = "nbd_connection_write_export_information";
+	size_t information_data_size    = 0;
+	uint32_t preferred_block_size   = 4096;
+	uint16_t transmission_flags     = 0;
+
+	if( connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid connection.",
+		 function );
+
+		return( -1 );
+	}
+	/* The image is exported read-only and hence can be shared by multiple connections
+	 */
+	transmission_flags = NBD_FLAG_HAS_FLAGS
+	                   | NBD_FLAG_READ_ONLY
+	                   | NBD_FLAG_SEND_FLUSH
+	                   | NBD_FLAG_CAN_MULTI_CONN;
+
+	/* Read replies are never fragmented
+	 */
+	if( connection->use_structured_replies != 0 )
+	{
+		transmission_flags |= NBD_FLAG_SEND_DF;
+	}
+	if( memory_set(
+	     information_data,
+	     0,
+	     134 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear information data.",
+		 function );
+
+		return( -1 );
+	}
+	if( option == NBD_OPT_EXPORT_NAME )
+	{
+		byte_stream_copy_from_uint64_big_endian(
+		 &( information_data[ 0 ] ),
+		 connection->media_size );
+
+		byte_stream_copy_from_uint16_big_endian(
+		 &( information_data[ 8 ] ),
+		 transmission_flags );
+
+		information_data_size = 10;
+
+		if( connection->no_zeroes == 0 )
+		{
+			information_data_size += 124;
+		}
+		if( nbd_connection_write_data(
+		     connection,
+		     information_data,
+		     information_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write export information.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+	byte_stream_copy_from_uint16_big_endian(
+	 &( information_data[ 0 ] ),
+	 NBD_INFO_EXPORT );
+
+	byte_stream_copy_from_uint64_big_endian(
+	 &( information_data[ 2 ] ),
+	 connection->media_size );
+
+	byte_stream_copy_from_uint16_big_endian(
+	 &( information_data[ 10 ] ),
+	 transmission_flags );
+
+	if( nbd_connection_write_option_reply(
+	     connection,
+	     option,
+	     NBD_REP_INFO,
+	     information_data,
+	     12,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write export information.",
+		 function );
+
+		return( -1 );
+	}
+	/* Prefer requests of the size of a chunk, the preferred block size must be a power of 2
+	 */
+	if( ( connection->chunk_size >= 512 )
+	 && ( connection->chunk_size <= NBD_CONNECTION_MAXIMUM_REQUEST_SIZE )
+	 && ( ( connection->chunk_size & ( connection->chunk_size - 1 ) ) == 0 ) )
+	{
+		preferred_block_size = connection->chunk_size;
+	}
+	byte_stream_copy_from_uint16_big_endian(
+	 &( information_data[ 0 ] ),
+	 NBD_INFO_BLOCK_SIZE );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( information_data[ 2 ] ),
+	 1 );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( information_data[ 6 ] ),
+	 preferred_block_size );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( information_data[ 10 ] ),
+	 NBD_CONNECTION_MAXIMUM_REQUEST_SIZE );
+
+	if( nbd_connection_write_option_reply(
+	     connection,
+	     option,
+	     NBD_REP_INFO,
+	     information_data,
+	     14,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write block size information.",
+		 function );
+
+		return( -1 );
+	}
+	if( nbd_connection_write_option_reply(
+	     connection,
+	     option,
+	     NBD_REP_ACK,
+	     NULL,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write acknowledgement.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Reads the option header data
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_read_option_header_data(
+     const uint8_t *data,
+     size_t data_size,
+     uint32_t *option,
+     uint32_t *option_data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_connection_read_option_header_data";
+	uint64_t magic        = 0;
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size < 16 )
+	 || ( data_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( option == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid option.",
+		 function );
+
+		return( -1 );
+	}
+	if( option_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid option data size.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_to_uint64_big_endian(
+	 &( data[ 0 ] ),
+	 magic );
+
+	if( magic != NBD_MAGIC_OPTION )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_INPUT,
+		 LIBCERROR_INPUT_ERROR_SIGNATURE_MISMATCH,
+		 "%s: unsupported option magic.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_to_uint32_big_endian(
+	 &( data[ 8 ] ),
+	 *option );
+
+	byte_stream_copy_to_uint32_big_endian(
+	 &( data[ 12 ] ),
+	 *option_data_size );
+
+	if( *option_data_size > NBD_CONNECTION_MAXIMUM_OPTION_DATA_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid option data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Checks the data of an info or go option
+ * The data consists of the export name followed by the requested information items
+ * Returns 1 if valid, 0 if not or -1 on error
+ */
+int nbd_connection_check_info_option_data(
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function     = "nbd_connection_check_info_option_data";
+	uint32_t export_name_size = 0;
+	uint16_t number_of_items  = 0;
+
+	if( ( data == NULL )
+	 && ( data_size > 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) NBD_CONNECTION_MAXIMUM_OPTION_DATA_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size < 6 )
+	{
+		return( 0 );
+	}
+	byte_stream_copy_to_uint32_big_endian(
+	 data,
+	 export_name_size );
+
+	if( (size_t) export_name_size > ( data_size - 6 ) )
+	{
+		return( 0 );
+	}
+	byte_stream_copy_to_uint16_big_endian(
+	 &( data[ 4 + export_name_size ] ),
+	 number_of_items );
+
+	if( ( 6 + (size_t) export_name_size + ( 2 * (size_t) number_of_items ) ) != data_size )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Reads the data of a list or set meta context option
+ * The data consists of the export name followed by the meta context queries
+ * Only the base:allocation meta context is supported, select context is set if the queries select it
+ * Returns 1 if valid, 0 if not or -1 on error
+ */
+int nbd_connection_read_meta_context_option_data(
+     uint32_t option,
+     const uint8_t *data,
+     size_t data_size,
+     uint8_t *select_context,
+     uint32_t *number_of_queries,
+     libcerror_error_t **error )
+{
+	static char *function       = "nbd_connection_read_meta_context_option_data";
+	size_t data_offset          = 0;
+	uint32_t export_name_length = 0;
+	uint32_t query_index        = 0;
+	uint32_t query_length       = 0;
+
+	if( ( data == NULL )
+	 && ( data_size > 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) NBD_CONNECTION_MAXIMUM_OPTION_DATA_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( select_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid select context.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_queries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of queries.",
+		 function );
+
+		return( -1 );
+	}
+	*select_context    = 0;
+	*number_of_queries = 0;
+
+	if( data_size < 8 )
+	{
+		return( 0 );
+	}
+	byte_stream_copy_to_uint32_big_endian(
+	 data,
+	 export_name_length );
+
+	if( (size_t) export_name_length > ( data_size - 8 ) )
+	{
+		return( 0 );
+	}
+	data_offset = 4 + (size_t) export_name_length;
+
+	byte_stream_copy_to_uint32_big_endian(
+	 &( data[ data_offset ] ),
+	 *number_of_queries );
+
+	data_offset += 4;
+
+	for( query_index = 0;
+	     query_index < *number_of_queries;
+	     query_index++ )
+	{
+		if( ( data_size - data_offset ) < 4 )
+		{
+			return( 0 );
+		}
+		byte_stream_copy_to_uint32_big_endian(
+		 &( data[ data_offset ] ),
+		 query_length );
+
+		data_offset += 4;
+
+		if( (size_t) query_length > ( data_size - data_offset ) )
+		{
+			return( 0 );
+		}
+		if( ( query_length == NBD_META_CONTEXT_BASE_ALLOCATION_LENGTH )
+		 && ( narrow_string_compare(
+		       (char *) &( data[ data_offset ] ),
+		       NBD_META_CONTEXT_BASE_ALLOCATION,
+		       NBD_META_CONTEXT_BASE_ALLOCATION_LENGTH ) == 0 ) )
+		{
+			*select_context = 1;
+		}
+		/* A list query for the namespace lists all the contexts in the namespace
+		 */
+		else if( ( option == NBD_OPT_LIST_META_CONTEXT )
+		      && ( query_length == 5 )
+		      && ( narrow_string_compare(
+		            (char *) &( data[ data_offset ] ),
+		            "base:",
+		            5 ) == 0 ) )
+		{
+			*select_context = 1;
+		}
+		data_offset += (size_t) query_length;
+	}
+	if( data_offset != data_size )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Handles a list or set meta context option
+ * Only the base:allocation meta context is supported
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_handle_meta_context_option(
+     nbd_connection_t *connection,
+     uint32_t option,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	uint8_t reply_data[ 4 + NBD_META_CONTEXT_BASE_ALLOCATION_LENGTH ];
+
+	static char *function       = "nbd_connection_handle_meta_context_option";
+	uint32_t context_identifier = 0;
+	uint32_t number_of_queries  = 0;
+	uint8_t select_context      = 0;
+	int result                  = 0;
+
+	if( connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid connection.",
+		 function );
+
+		return( -1 );
+	}
+	/* Meta contexts require structured replies
+	 */
+	if( connection->use_structured_replies != 0 )
+	{
+		result = nbd_connection_read_meta_context_option_data(
+		          option,
+		          data,
+		          data_size,
+		          &select_context,
+		          &number_of_queries,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to read meta context option data.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( result == 0 )
+	{
+		if( nbd_connection_write_option_reply(
+		     connection,
+		     option,
+		     NBD_REP_ERR_INVALID,
+		     NULL,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write error reply.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+	if( option == NBD_OPT_SET_META_CONTEXT )
+	{
+		connection->use_base_allocation = select_context;
+
+		context_identifier = NBD_META_CONTEXT_BASE_ALLOCATION_IDENTIFIER;
+	}
+	else if( number_of_queries == 0 )
+	{
+		select_context = 1;
+	}
+	if( select_context != 0 )
+	{
+		byte_stream_copy_from_uint32_big_endian(
+		 reply_data,
+		 context_identifier );
+
+		if( memory_copy(
+		     &( reply_data[ 4 ] ),
+		     NBD_META_CONTEXT_BASE_ALLOCATION,
+		     NBD_META_CONTEXT_BASE_ALLOCATION_LENGTH ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy meta context name.",
+			 function );
+
+			return( -1 );
+		}
+		if( nbd_connection_write_option_reply(
+		     connection,
+		     option,
+		     NBD_REP_META_CONTEXT,
+		     reply_data,
+		     4 + NBD_META_CONTEXT_BASE_ALLOCATION_LENGTH,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write meta context reply.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( nbd_connection_write_option_reply(
+	     connection,
+	     option,
+	     NBD_REP_ACK,
+	     NULL,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write acknowledgement.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Negotiates the connection using the fixed newstyle handshake
+ * Returns 1 if the transmission phase was entered, 0 if the client ended the connection or -1 on error
+ */
+int nbd_connection_negotiate(
+     nbd_connection_t *connection,
+     libcerror_error_t **error )
+{
+	uint8_t handshake_data[ 18 ];
+	uint8_t option_header[ 16 ];
+	uint8_t reply_data[ 4 ];
+
+	uint8_t *option_data      = NULL;
+	static char *function     = "nbd_connection_negotiate";
+	uint32_t client_flags     = 0;
+	uint32_t option           = 0;
+	uint32_t option_data_size = 0;
+	uint8_t is_negotiated     = 0;
+	int result                = 0;
+
+	if( connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid connection.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint64_big_endian(
+	 &( handshake_data[ 0 ] ),
+	 NBD_MAGIC_PASSWORD );
+
+	byte_stream_copy_from_uint64_big_endian(
+	 &( handshake_data[ 8 ] ),
+	 NBD_MAGIC_OPTION );
+
+	byte_stream_copy_from_uint16_big_endian(
+	 &( handshake_data[ 16 ] ),
+	 NBD_FLAG_FIXED_NEWSTYLE | NBD_FLAG_NO_ZEROES );
+
+	if( nbd_connection_write_data(
+	     connection,
+	     handshake_data,
+	     18,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write handshake.",
+		 function );
+
+		goto on_error;
+	}
+	result = nbd_connection_read_data(
+	          connection,
+	          reply_data,
+	          4,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read client flags.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	byte_stream_copy_to_uint32_big_endian(
+	 reply_data,
+	 client_flags );
+
+	if( ( client_flags & ~( NBD_FLAG_C_FIXED_NEWSTYLE | NBD_FLAG_C_NO_ZEROES ) ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported client flags: 0x%08" PRIx32 ".",
+		 function,
+		 client_flags );
+
+		goto on_error;
+	}
+	if( ( client_flags & NBD_FLAG_C_NO_ZEROES ) != 0 )
+	{
+		connection->no_zeroes = 1;
+	}
+	while( ( connection->abort == 0 )
+	    && ( is_negotiated == 0 ) )
+	{
+		result = nbd_connection_read_data(
+		          connection,
+		          option_header,
+		          16,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read option header.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			return( 0 );
+		}
+		if( nbd_connection_read_option_header_data(
+		     option_header,
+		     16,
+		     &option,
+		     &option_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to read option header.",
+			 function );
+
+			goto on_error;
+		}
+		if( option_data_size > 0 )
+		{
+			option_data = (uint8_t *) memory_allocate(
+			                           sizeof( uint8_t ) * option_data_size );
+
+			if( option_data == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to create option data.",
+				 function );
+
+				goto on_error;
+			}
+			if( nbd_connection_read_data(
+			     connection,
+			     option_data,
+			     (size_t) option_data_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read option data.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		switch( option )
+		{
+			case NBD_OPT_EXPORT_NAME:
+				/* Only a single export is provided hence the export name is ignored
+				 */
+				result = nbd_connection_write_export_information(
+				          connection,
+				          option,
+				          error );
+
+				is_negotiated = 1;
+
+				break;
+
+			case NBD_OPT_ABORT:
+				/* The client can close the connection without reading the acknowledgement
+				 */
+				nbd_connection_write_option_reply(
+				 connection,
+				 option,
+				 NBD_REP_ACK,
+				 NULL,
+				 0,
+				 NULL );
+
+				if( option_data != NULL )
+				{
+					memory_free(
+					 option_data );
+				}
+				return( 0 );
+
+			case NBD_OPT_LIST:
+				if( option_data_size != 0 )
+				{
+					result = nbd_connection_write_option_reply(
+					          connection,
+					          option,
+					          NBD_REP_ERR_INVALID,
+					          NULL,
+					          0,
+					          error );
+				}
+				else
+				{
+					/* The single export has an empty name
+					 */
+					byte_stream_copy_from_uint32_big_endian(
+					 reply_data,
+					 0 );
+
+					result = nbd_connection_write_option_reply(
+					          connection,
+					          option,
+					          NBD_REP_SERVER,
+					          reply_data,
+					          4,
+					          error );
+
+					if( result == 1 )
+					{
+						result = nbd_connection_write_option_reply(
+						          connection,
+						          option,
+						          NBD_REP_ACK,
+						          NULL,
+						          0,
+						          error );
+					}
+				}
+				break;
+
+			case NBD_OPT_INFO:
+			case NBD_OPT_GO:
+				result = nbd_connection_check_info_option_data(
+				          option_data,
+				          (size_t) option_data_size,
+				          error );
+
+				if( result == -1 )
+				{
+					break;
+				}
+				else if( result == 0 )
+				{
+					result = nbd_connection_write_option_reply(
+					          connection,
+					          option,
+					          NBD_REP_ERR_INVALID,
+					          NULL,
+					          0,
+					          error );
+				}
+				else
+				{
+					result = nbd_connection_write_export_information(
+					          connection,
+					          option,
+					          error );
+
+					if( option == NBD_OPT_GO )
+					{
+						is_negotiated = 1;
+					}
+				}
+				break;
+
+			case NBD_OPT_STRUCTURED_REPLY:
+				if( option_data_size != 0 )
+				{
+					result = nbd_connection_write_option_reply(
+					          connection,
+					          option,
+					          NBD_REP_ERR_INVALID,
+					          NULL,
+					          0,
+					          error );
+				}
+				else
+				{
+					connection->use_structured_replies = 1;
+
+					result = nbd_connection_write_option_reply(
+					          connection,
+					          option,
+					          NBD_REP_ACK,
+					          NULL,
+					          0,
+					          error );
+				}
+				break;
+
+			case NBD_OPT_LIST_META_CONTEXT:
+			case NBD_OPT_SET_META_CONTEXT:
+				result = nbd_connection_handle_meta_context_option(
+				          connection,
+				          option,
+				          option_data,
+				          (size_t) option_data_size,
+				          error );
+				break;
+
+			default:
+				result = nbd_connection_write_option_reply(
+				          connection,
+				          option,
+				          NBD_REP_ERR_UNSUP,
+				          NULL,
+				          0,
+				          error );
+				break;
+		}
+		if( option_data != NULL )
+		{
+			memory_free(
+			 option_data );
+
+			option_data = NULL;
+		}
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to handle option: %" PRIu32 ".",
+			 function,
+			 option );
+
+			goto on_error;
+		}
+	}
+	if( is_negotiated == 0 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+
+on_error:
+	if( option_data != NULL )
+	{
+		memory_free(
+		 option_data );
+	}
+	return( -1 );
+}
+
+/* Writes the reply of a request
+ * If structured replies were negotiated the reply consists of a single chunk of the reply type
+ * that contains the header data followed by the data, otherwise the header data is ignored
+ * An error code other than 0 replaces the reply with an error reply
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_write_reply(
+     nbd_connection_t *connection,
+     nbd_request_t *request,
+     uint32_t error_code,
+     uint16_t reply_type,
+     const uint8_t *header_data,
+     size_t header_data_size,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	uint8_t reply_header[ 28 ];
+
+	static char *function   = "nbd_connection_write_reply";
+	size_t reply_header_size = 0;
+	int result              = 1;
+
+	if( connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( request == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid request.",
+		 function );
+
+		return( -1 );
+	}
+	if( header_data_size > 8 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid header data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* An error reply contains no data, the data size of a rejected request
+	 * can exceed the maximum
+	 */
+	if( error_code != 0 )
+	{
+		data_size = 0;
+	}
+	if( data_size > (size_t) NBD_CONNECTION_MAXIMUM_REQUEST_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( connection->use_structured_replies == 0 )
+	{
+		byte_stream_copy_from_uint32_big_endian(
+		 &( reply_header[ 0 ] ),
+		 NBD_MAGIC_SIMPLE_REPLY );
+
+		byte_stream_copy_from_uint32_big_endian(
+		 &( reply_header[ 4 ] ),
+		 error_code );
+
+		byte_stream_copy_from_uint64_big_endian(
+		 &( reply_header[ 8 ] ),
+		 request->cookie );
+
+		reply_header_size = 16;
+	}
+	else
+	{
+		byte_stream_copy_from_uint32_big_endian(
+		 &( reply_header[ 0 ] ),
+		 NBD_MAGIC_STRUCTURED_REPLY );
+
+		byte_stream_copy_from_uint16_big_endian(
+		 &( reply_header[ 4 ] ),
+		 NBD_REPLY_FLAG_DONE );
+
+		byte_stream_copy_from_uint64_big_endian(
+		 &( reply_header[ 8 ] ),
+		 request->cookie );
+
+		if( error_code != 0 )
+		{
+			byte_stream_copy_from_uint16_big_endian(
+			 &( reply_header[ 6 ] ),
+			 NBD_REPLY_TYPE_ERROR );
+
+			byte_stream_copy_from_uint32_big_endian(
+			 &( reply_header[ 16 ] ),
+			 6 );
+
+			/* The error code followed by an empty message
+			 */
+			byte_stream_copy_from_uint32_big_endian(
+			 &( reply_header[ 20 ] ),
+			 error_code );
+
+			byte_stream_copy_from_uint16_big_endian(
+			 &( reply_header[ 24 ] ),
+			 0 );
+
+			reply_header_size = 26;
+		}
+		else
+		{
+			byte_stream_copy_from_uint16_big_endian(
+			 &( reply_header[ 6 ] ),
+			 reply_type );
+
+			byte_stream_copy_from_uint32_big_endian(
+			 &( reply_header[ 16 ] ),
+			 (uint32_t) ( header_data_size + data_size ) );
+
+			reply_header_size = 20;
+
+			if( header_data_size > 0 )
+			{
+				if( memory_copy(
+				     &( reply_header[ 20 ] ),
+				     header_data,
+				     header_data_size ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+					 "%s: unable to copy header data.",
+					 function );
+
+					return( -1 );
+				}
+				reply_header_size += header_data_size;
+			}
+		}
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     connection->write_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab write mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( nbd_connection_write_data(
+	     connection,
+	     reply_header,
+	     reply_header_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write reply header.",
+		 function );
+
+		result = -1;
+	}
+	else if( data_size > 0 )
+	{
+		if( nbd_connection_write_data(
+		     connection,
+		     data,
+		     data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write reply data.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     connection->write_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release write mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Processes a read request
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_process_read_request(
+     nbd_connection_t *connection,
+     nbd_request_t *request,
+     libcerror_error_t **error )
+{
+	uint8_t offset_data[ 8 ];
+
+	libcerror_error_t *read_error = NULL;
+	uint8_t *buffer               = NULL;
+	static char *function         = "nbd_connection_process_read_request";
+	ssize_t read_count            = 0;
+	uint32_t error_code           = 0;
+	uint16_t reply_type           = NBD_REPLY_TYPE_NONE;
+
+	if( connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( request == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid request.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( request->length > NBD_CONNECTION_MAXIMUM_REQUEST_SIZE )
+	 || ( request->offset > connection->media_size )
+	 || ( (size64_t) request->length > ( connection->media_size - request->offset ) ) )
+	{
+		error_code = NBD_EINVAL;
+	}
+	else if( request->length > 0 )
+	{
+		buffer = (uint8_t *) memory_allocate(
+		                      sizeof( uint8_t ) * request->length );
+
+		if( buffer == NULL )
+		{
+			error_code = NBD_ENOMEM;
+		}
+		else
+		{
+			read_count = libewf_handle_read_buffer_at_offset(
+			              connection->input_handle,
+			              buffer,
+			              (size_t) request->length,
+			              (off64_t) request->offset,
+			              &read_error );
+
+			if( read_count != (ssize_t) request->length )
+			{
+				if( libcnotify_verbose != 0 )
+				{
+					libcnotify_printf(
+					 "%s: unable to read: %" PRIu32 " bytes at offset: %" PRIu64 ".\n",
+					 function,
+					 request->length,
+					 request->offset );
+
+					if( read_error != NULL )
+					{
+						libcnotify_print_error_backtrace(
+						 read_error );
+					}
+				}
+				libcerror_error_free(
+				 &read_error );
+
+				error_code = NBD_EIO;
+			}
+		}
+		reply_type = NBD_REPLY_TYPE_OFFSET_DATA;
+	}
+	byte_stream_copy_from_uint64_big_endian(
+	 offset_data,
+	 request->offset );
+
+	/* The offset data is only part of a structured reply that contains data
+	 */
+	if( nbd_connection_write_reply(
+	     connection,
+	     request,
+	     error_code,
+	     reply_type,
+	     offset_data,
+	     ( reply_type == NBD_REPLY_TYPE_OFFSET_DATA ) ? 8 : 0,
+	     buffer,
+	     ( error_code == 0 ) ? (size_t) request->length : 0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write read reply.",
+		 function );
+
+		goto on_error;
+	}
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	return( 1 );
+
+on_error:
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	return( -1 );
+}
+
+/* Processes a block status request
+ * Chunks that only contain zero bytes are reported as holes that read as zeros
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_process_block_status_request(
+     nbd_connection_t *connection,
+     nbd_request_t *request,
+     libcerror_error_t **error )
+{
+	uint8_t context_data[ 4 ];
+
+	libcerror_error_t *fill_error = NULL;
+	uint8_t *extents_data         = NULL;
+	static char *function         = "nbd_connection_process_block_status_request";
+	size64_t extent_size          = 0;
+	size64_t range_size           = 0;
+	uint64_t chunk_index          = 0;
+	uint64_t current_offset       = 0;
+	uint64_t end_offset           = 0;
+	uint64_t fill_pattern         = 0;
+	uint32_t error_code           = 0;
+	uint32_t extent_flags         = 0;
+	uint32_t range_flags          = 0;
+	int number_of_extents         = 0;
+	int result                    = 0;
+
+	if( connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( request == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid request.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( connection->use_structured_replies == 0 )
+	 || ( connection->use_base_allocation == 0 )
+	 || ( request->length == 0 )
+	 || ( request->offset > connection->media_size )
+	 || ( (size64_t) request->length > ( connection->media_size - request->offset ) ) )
+	{
+		error_code = NBD_EINVAL;
+	}
+	else
+	{
+		extents_data = (uint8_t *) memory_allocate(
+		                            sizeof( uint8_t ) * 8 * NBD_CONNECTION_MAXIMUM_NUMBER_OF_EXTENTS );
+
+		if( extents_data == NULL )
+		{
+			error_code = NBD_ENOMEM;
+		}
+	}
+	if( error_code == 0 )
+	{
+		current_offset = request->offset;
+		end_offset     = request->offset + request->length;
+
+		while( current_offset < end_offset )
+		{
+			range_flags = 0;
+
+			if( connection->chunk_size == 0 )
+			{
+				range_size = end_offset - current_offset;
+			}
+			else
+			{
+				chunk_index = current_offset / connection->chunk_size;
+				range_size  = ( ( chunk_index + 1 ) * connection->chunk_size ) - current_offset;
+
+				if( range_size > ( end_offset - current_offset ) )
+				{
+					range_size = end_offset - current_offset;
+				}
+				result = libewf_handle_get_chunk_fill_info(
+				          connection->input_handle,
+				          chunk_index,
+				          &fill_pattern,
+				          &fill_error );
+
+				if( result == -1 )
+				{
+					if( libcnotify_verbose != 0 )
+					{
+						libcnotify_printf(
+						 "%s: unable to retrieve fill information of chunk: %" PRIu64 ".\n",
+						 function,
+						 chunk_index );
+
+						libcnotify_print_error_backtrace(
+						 fill_error );
+					}
+					libcerror_error_free(
+					 &fill_error );
+
+					error_code = NBD_EIO;
+
+					break;
+				}
+				else if( ( result != 0 )
+				      && ( fill_pattern == 0 ) )
+				{
+					range_flags = NBD_STATE_HOLE | NBD_STATE_ZERO;
+				}
+			}
+			if( ( number_of_extents > 0 )
+			 && ( range_flags == extent_flags )
+			 && ( ( extent_size + range_size ) <= (size64_t) UINT32_MAX ) )
+			{
+				extent_size += range_size;
+			}
+			else
+			{
+				if( ( number_of_extents == NBD_CONNECTION_MAXIMUM_NUMBER_OF_EXTENTS )
+				 || ( ( number_of_extents == 1 )
+				  && ( ( request->flags & NBD_CMD_FLAG_REQ_ONE ) != 0 ) ) )
+				{
+					break;
+				}
+				number_of_extents++;
+
+				extent_flags = range_flags;
+				extent_size  = range_size;
+			}
+			byte_stream_copy_from_uint32_big_endian(
+			 &( extents_data[ ( number_of_extents - 1 ) * 8 ] ),
+			 (uint32_t) extent_size );
+
+			byte_stream_copy_from_uint32_big_endian(
+			 &( extents_data[ ( ( number_of_extents - 1 ) * 8 ) + 4 ] ),
+			 extent_flags );
+
+			current_offset += range_size;
+		}
+	}
+	byte_stream_copy_from_uint32_big_endian(
+	 context_data,
+	 NBD_META_CONTEXT_BASE_ALLOCATION_IDENTIFIER );
+
+	if( nbd_connection_write_reply(
+	     connection,
+	     request,
+	     error_code,
+	     NBD_REPLY_TYPE_BLOCK_STATUS,
+	     context_data,
+	     4,
+	     extents_data,
+	     (size_t) number_of_extents * 8,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write block status reply.",
+		 function );
+
+		goto on_error;
+	}
+	if( extents_data != NULL )
+	{
+		memory_free(
+		 extents_data );
+	}
+	return( 1 );
+
+on_error:
+	if( extents_data != NULL )
+	{
+		memory_free(
+		 extents_data );
+	}
+	return( -1 );
+}
+
+/* Processes a request
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_process_request(
+     nbd_connection_t *connection,
+     nbd_request_t *request,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_connection_process_request";
+	uint32_t error_code   = 0;
+	int result            = 0;
+
+	if( request == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid request.",
+		 function );
+
+		return( -1 );
+	}
+	switch( request->type )
+	{
+		case NBD_CMD_READ:
+			result = nbd_connection_process_read_request(
+			          connection,
+			          request,
+			          error );
+			break;
+
+		case NBD_CMD_BLOCK_STATUS:
+			result = nbd_connection_process_block_status_request(
+			          connection,
+			          request,
+			          error );
+			break;
+
+		default:
+			/* The image is read-only hence there is nothing to flush
+			 */
+			if( request->type == NBD_CMD_FLUSH )
+			{
+				error_code = 0;
+			}
+			else if( ( request->type == NBD_CMD_WRITE )
+			      || ( request->type == NBD_CMD_TRIM )
+			      || ( request->type == NBD_CMD_WRITE_ZEROES ) )
+			{
+				error_code = NBD_EPERM;
+			}
+			else
+			{
+				error_code = NBD_EINVAL;
+			}
+			result = nbd_connection_write_reply(
+			          connection,
+			          request,
+			          error_code,
+			          NBD_REPLY_TYPE_NONE,
+			          NULL,
+			          0,
+			          NULL,
+			          0,
+			          error );
+			break;
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to process request of type: %" PRIu16 ".",
+		 function,
+		 request->type );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Processes a request
+ * Callback function for the request thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_process_request_callback(
+     nbd_request_t *request,
+     nbd_connection_t *connection )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "nbd_connection_process_request_callback";
+	int result               = 1;
+
+	if( request == NULL )
+	{
+		return( -1 );
+	}
+	if( connection->abort == 0 )
+	{
+		result = nbd_connection_process_request(
+		          connection,
+		          request,
+		          &error );
+	}
+	memory_free(
+	 request );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to process request.",
+		 function );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+
+		/* A reply could not be written hence the connection is no longer usable
+		 */
+		nbd_connection_signal_abort(
+		 connection,
+		 NULL );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+/* Reads the request data
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_read_request_data(
+     nbd_request_t *request,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_connection_read_request_data";
+	uint32_t magic        = 0;
+
+	if( request == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid request.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size < 28 )
+	 || ( data_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_to_uint32_big_endian(
+	 &( data[ 0 ] ),
+	 magic );
+
+	if( magic != NBD_MAGIC_REQUEST )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_INPUT,
+		 LIBCERROR_INPUT_ERROR_SIGNATURE_MISMATCH,
+		 "%s: unsupported request magic.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_to_uint16_big_endian(
+	 &( data[ 4 ] ),
+	 request->flags );
+
+	byte_stream_copy_to_uint16_big_endian(
+	 &( data[ 6 ] ),
+	 request->type );
+
+	byte_stream_copy_to_uint64_big_endian(
+	 &( data[ 8 ] ),
+	 request->cookie );
+
+	byte_stream_copy_to_uint64_big_endian(
+	 &( data[ 16 ] ),
+	 request->offset );
+
+	byte_stream_copy_to_uint32_big_endian(
+	 &( data[ 24 ] ),
+	 request->length );
+
+	return( 1 );
+}
+
+/* Handles requests until the client disconnects
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_transmit(
+     nbd_connection_t *connection,
+     libcerror_error_t **error )
+{
+	uint8_t discard_data[ 512 ];
+	uint8_t request_data[ 28 ];
+
+	nbd_request_t *request  = NULL;
+	static char *function   = "nbd_connection_transmit";
+	size_t discard_size     = 0;
+	uint32_t remaining_size = 0;
+	int result              = 0;
+
+	if( connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid connection.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( connection->number_of_threads > 0 )
+	{
+		if( libcthreads_thread_pool_create(
+		     &( connection->request_thread_pool ),
+		     NULL,
+		     connection->number_of_threads,
+		     NBD_CONNECTION_MAXIMUM_NUMBER_OF_QUEUED_REQUESTS,
+		     (int (*)(intptr_t *, void *)) &nbd_connection_process_request_callback,
+		     (void *) connection,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize request thread pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
+	while( connection->abort == 0 )
+	{
+		result = nbd_connection_read_data(
+		          connection,
+		          request_data,
+		          28,
+		          error );
+
+		if( result == -1 )
+		{
+			/* Reading fails when the socket is shut down
+			 */
+			if( connection->abort != 0 )
+			{
+				libcerror_error_free(
+				 error );
+
+				break;
+			}
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read request.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+		request = memory_allocate_structure(
+		           nbd_request_t );
+
+		if( request == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create request.",
+			 function );
+
+			goto on_error;
+		}
+		if( nbd_connection_read_request_data(
+		     request,
+		     request_data,
+		     28,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to read request.",
+			 function );
+
+			goto on_error;
+		}
+		if( request->type == NBD_CMD_DISC )
+		{
+			memory_free(
+			 request );
+
+			request = NULL;
+
+			break;
+		}
+		/* Discard the data of a write request, which is rejected
+		 */
+		if( request->type == NBD_CMD_WRITE )
+		{
+			remaining_size = request->length;
+
+			while( remaining_size > 0 )
+			{
+				discard_size = 512;
+
+				if( discard_size > (size_t) remaining_size )
+				{
+					discard_size = (size_t) remaining_size;
+				}
+				if( nbd_connection_read_data(
+				     connection,
+				     discard_data,
+				     discard_size,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read write request data.",
+					 function );
+
+					goto on_error;
+				}
+				remaining_size -= (uint32_t) discard_size;
+			}
+		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( connection->request_thread_pool != NULL )
+		{
+			if( libcthreads_thread_pool_push(
+			     connection->request_thread_pool,
+			     (intptr_t *) request,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to push request onto request thread pool queue.",
+				 function );
+
+				goto on_error;
+			}
+			request = NULL;
+
+			continue;
+		}
+#endif
+		result = nbd_connection_process_request(
+		          connection,
+		          request,
+		          error );
+
+		memory_free(
+		 request );
+
+		request = NULL;
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to process request.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* Joining the thread pool completes the queued requests
+	 */
+	if( connection->request_thread_pool != NULL )
+	{
+		if( libcthreads_thread_pool_join(
+		     &( connection->request_thread_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join request thread pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( request != NULL )
+	{
+		memory_free(
+		 request );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( connection->request_thread_pool != NULL )
+	{
+		connection->abort = 1;
+
+		libcthreads_thread_pool_join(
+		 &( connection->request_thread_pool ),
+		 NULL );
+	}
+#endif
+	return( -1 );
+}
+
+/* Serves the connection until the client disconnects
+ * Callback function for the connection thread
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_run(
+     nbd_connection_t *connection )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "nbd_connection_run";
+	int result               = 0;
+
+	if( connection == NULL )
+	{
+		return( -1 );
+	}
+	result = nbd_connection_negotiate(
+	          connection,
+	          &error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to negotiate connection.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result != 0 )
+	{
+		if( nbd_connection_transmit(
+		     connection,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to handle requests.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	connection->has_finished = 1;
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	connection->has_finished = 1;
+
+	return( -1 );
+}
+
+#endif /* defined( HAVE_SYS_SOCKET_H ) && defined( HAVE_SYS_UN_H ) */
+
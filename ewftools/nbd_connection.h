@@ -0,0 +1,259 @@
+/*
+ * Network block device (NBD) connection
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _NBD_CONNECTION_H )
+#define _NBD_CONNECTION_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
+#include "ewftools_libewf.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The maximum size of the data of a read request
+ */
+#define NBD_CONNECTION_MAXIMUM_REQUEST_SIZE		( 32 * 1024 * 1024 )
+
+/* The maximum size of the data of an option
+ */
+#define NBD_CONNECTION_MAXIMUM_OPTION_DATA_SIZE		4096
+
+/* The maximum number of extents in a block status reply
+ */
+#define NBD_CONNECTION_MAXIMUM_NUMBER_OF_EXTENTS	1024
+
+/* The maximum number of requests that are queued per connection
+ */
+#define NBD_CONNECTION_MAXIMUM_NUMBER_OF_QUEUED_REQUESTS	64
+
+typedef struct nbd_request nbd_request_t;
+
+struct nbd_request
+{
+	/* The command flags
+	 */
+	uint16_t flags;
+
+	/* The command type
+	 */
+	uint16_t type;
+
+	/* The cookie (or handle) that identifies the request
+	 */
+	uint64_t cookie;
+
+	/* The offset
+	 */
+	uint64_t offset;
+
+	/* The length
+	 */
+	uint32_t length;
+};
+
+typedef struct nbd_connection nbd_connection_t;
+
+struct nbd_connection
+{
+	/* The input handle
+	 */
+	libewf_handle_t *input_handle;
+
+	/* The media size
+	 */
+	size64_t media_size;
+
+	/* The chunk size
+	 */
+	size32_t chunk_size;
+
+	/* The socket descriptor
+	 */
+	int socket_descriptor;
+
+	/* Value to indicate the client does not want the zero padding of the export information
+	 */
+	uint8_t no_zeroes;
+
+	/* Value to indicate structured replies were negotiated
+	 */
+	uint8_t use_structured_replies;
+
+	/* Value to indicate the base:allocation meta context was negotiated
+	 */
+	uint8_t use_base_allocation;
+
+	/* The number of threads used to handle requests
+	 */
+	int number_of_threads;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The connection thread
+	 */
+	libcthreads_thread_t *thread;
+
+	/* The request thread pool
+	 */
+	libcthreads_thread_pool_t *request_thread_pool;
+
+	/* The mutex that serializes writing replies
+	 */
+	libcthreads_mutex_t *write_mutex;
+#endif
+
+	/* Value to indicate the connection has finished
+	 */
+	int has_finished;
+
+	/* Value to indicate the connection should abort
+	 */
+	int abort;
+};
+
+int nbd_connection_initialize(
+     nbd_connection_t **connection,
+     libewf_handle_t *input_handle,
+     int socket_descriptor,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+int nbd_connection_free(
+     nbd_connection_t **connection,
+     libcerror_error_t **error );
+
+int nbd_connection_signal_abort(
+     nbd_connection_t *connection,
+     libcerror_error_t **error );
+
+int nbd_connection_read_data(
+     nbd_connection_t *connection,
+     uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error );
+
+int nbd_connection_write_data(
+     nbd_connection_t *connection,
+     const uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error );
+
+int nbd_connection_write_option_reply(
+     nbd_connection_t *connection,
+     uint32_t option,
+     uint32_t reply_type,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int nbd_connection_write_export_information(
+     nbd_connection_t *connection,
+     uint32_t option,
+     libcerror_error_t **error );
+
+int nbd_connection_read_option_header_data(
+     const uint8_t *data,
+     size_t data_size,
+     uint32_t *option,
+     uint32_t *option_data_size,
+     libcerror_error_t **error );
+
+int nbd_connection_check_info_option_data(
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int nbd_connection_read_meta_context_option_data(
+     uint32_t option,
+     const uint8_t *data,
+     size_t data_size,
+     uint8_t *select_context,
+     uint32_t *number_of_queries,
+     libcerror_error_t **error );
+
+int nbd_connection_handle_meta_context_option(
+     nbd_connection_t *connection,
+     uint32_t option,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int nbd_connection_negotiate(
+     nbd_connection_t *connection,
+     libcerror_error_t **error );
+
+int nbd_connection_write_reply(
+     nbd_connection_t *connection,
+     nbd_request_t *request,
+     uint32_t error_code,
+     uint16_t reply_type,
+     const uint8_t *header_data,
+     size_t header_data_size,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int nbd_connection_process_read_request(
+     nbd_connection_t *connection,
+     nbd_request_t *request,
+     libcerror_error_t **error );
+
+int nbd_connection_process_block_status_request(
+     nbd_connection_t *connection,
+     nbd_request_t *request,
+     libcerror_error_t **error );
+
+int nbd_connection_process_request(
+     nbd_connection_t *connection,
+     nbd_request_t *request,
+     libcerror_error_t **error );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+int nbd_connection_process_request_callback(
+     nbd_request_t *request,
+     nbd_connection_t *connection );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+int nbd_connection_read_request_data(
+     nbd_request_t *request,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int nbd_connection_transmit(
+     nbd_connection_t *connection,
+     libcerror_error_t **error );
+
+int nbd_connection_run(
+     nbd_connection_t *connection );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _NBD_CONNECTION_H ) */
+
@@ -0,0 +1,125 @@
+/*
+ * Network block device (NBD) handle
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _NBD_HANDLE_H )
+#define _NBD_HANDLE_H
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libewf.h"
+#include "nbd_connection.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The maximum number of concurrent connections
+ */
+#define NBD_HANDLE_MAXIMUM_NUMBER_OF_CONNECTIONS	16
+
+typedef struct nbd_handle nbd_handle_t;
+
+struct nbd_handle
+{
+	/* The input handle
+	 */
+	libewf_handle_t *input_handle;
+
+	/* The maximum number of open handles
+	 */
+	int maximum_number_of_open_handles;
+
+	/* The number of threads used to handle the requests of a connection
+	 */
+	int number_of_threads;
+
+	/* The socket descriptor of the listening socket
+	 */
+	int socket_descriptor;
+
+	/* The connections
+	 */
+	nbd_connection_t *connections[ NBD_HANDLE_MAXIMUM_NUMBER_OF_CONNECTIONS ];
+
+	/* The notification output stream
+	 */
+	FILE *notify_stream;
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
+};
+
+int nbd_handle_initialize(
+     nbd_handle_t **nbd_handle,
+     libcerror_error_t **error );
+
+int nbd_handle_free(
+     nbd_handle_t **nbd_handle,
+     libcerror_error_t **error );
+
+int nbd_handle_signal_abort(
+     nbd_handle_t *nbd_handle,
+     libcerror_error_t **error );
+
+int nbd_handle_set_maximum_number_of_open_handles(
+     nbd_handle_t *nbd_handle,
+     int maximum_number_of_open_handles,
+     libcerror_error_t **error );
+
+int nbd_handle_set_number_of_threads(
+     nbd_handle_t *nbd_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int nbd_handle_open_input(
+     nbd_handle_t *nbd_handle,
+     system_character_t * const * filenames,
+     int number_of_filenames,
+     libcerror_error_t **error );
+
+int nbd_handle_close_input(
+     nbd_handle_t *nbd_handle,
+     libcerror_error_t **error );
+
+int nbd_handle_join_connections(
+     nbd_handle_t *nbd_handle,
+     uint8_t finished_only,
+     libcerror_error_t **error );
+
+#if defined( HAVE_SYS_SOCKET_H ) && defined( HAVE_SYS_UN_H )
+
+int nbd_handle_serve(
+     nbd_handle_t *nbd_handle,
+     const char *socket_path,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_SYS_SOCKET_H ) && defined( HAVE_SYS_UN_H ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _NBD_HANDLE_H ) */
+
@@ -0,0 +1,953 @@
+/*
+ * Output writer pool
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcnotify.h"
+#include "ewftools_libcthreads.h"
+#include "ewftools_libewf.h"
+#include "output_writer_pool.h"
+#include "storage_media_buffer.h"
+#include "storage_media_buffer_queue.h"
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Creates an output writer pool
+ * Make sure the value output_writer_pool is referencing, is set to NULL
+ *
+ * A thread is started for every output handle. The output handles and
+ * the storage media buffer queue are referenced by the pool and must
+ * remain available until the pool is joined or freed.
+ * Returns 1 if successful or -1 on error
+ */
+int output_writer_pool_initialize(
+     output_writer_pool_t **output_writer_pool,
+     libewf_handle_t **output_handles,
+     int number_of_output_handles,
+     libcthreads_queue_t *storage_media_buffer_queue,
+     libcerror_error_t **error )
+{
+	output_writer_pool_worker_t *worker = NULL;
+	static char *function               = "output_writer_pool_initialize";
+	int output_handle_index             = 0;
+
+	if( output_writer_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid output writer pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *output_writer_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid output writer pool value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_handles == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid output handles.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_output_handles <= 0 )
+	 || ( number_of_output_handles > OUTPUT_WRITER_POOL_MAXIMUM_NUMBER_OF_OUTPUT_HANDLES ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of output handles value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	for( output_handle_index = 0;
+	     output_handle_index < number_of_output_handles;
+	     output_handle_index++ )
+	{
+		if( output_handles[ output_handle_index ] == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid output handle: %d.",
+			 function,
+			 output_handle_index );
+
+			return( -1 );
+		}
+	}
+	if( storage_media_buffer_queue == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer queue.",
+		 function );
+
+		return( -1 );
+	}
+	*output_writer_pool = memory_allocate_structure(
+	                       output_writer_pool_t );
+
+	if( *output_writer_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create output writer pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *output_writer_pool,
+	     0,
+	     sizeof( output_writer_pool_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear output writer pool.",
+		 function );
+
+		memory_free(
+		 *output_writer_pool );
+
+		*output_writer_pool = NULL;
+
+		return( -1 );
+	}
+	( *output_writer_pool )->storage_media_buffer_queue = storage_media_buffer_queue;
+
+	if( libcthreads_mutex_initialize(
+	     &( ( *output_writer_pool )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *output_writer_pool )->condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create condition.",
+		 function );
+
+		goto on_error;
+	}
+	for( output_handle_index = 0;
+	     output_handle_index < number_of_output_handles;
+	     output_handle_index++ )
+	{
+		worker = &( ( *output_writer_pool )->workers[ output_handle_index ] );
+
+		worker->output_writer_pool  = *output_writer_pool;
+		worker->output_handle       = output_handles[ output_handle_index ];
+		worker->output_handle_index = output_handle_index;
+
+		if( libcthreads_thread_create(
+		     &( worker->thread ),
+		     NULL,
+		     (int (*)(void *)) &output_writer_pool_worker_callback,
+		     (void *) worker,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create output writer thread: %d.",
+			 function,
+			 output_handle_index );
+
+			goto on_error;
+		}
+		( *output_writer_pool )->number_of_workers += 1;
+	}
+	return( 1 );
+
+on_error:
+	if( *output_writer_pool != NULL )
+	{
+		output_writer_pool_free(
+		 output_writer_pool,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees an output writer pool
+ * Any thread that is still running is joined first
+ * Returns 1 if successful or -1 on error
+ */
+int output_writer_pool_free(
+     output_writer_pool_t **output_writer_pool,
+     libcerror_error_t **error )
+{
+	static char *function = "output_writer_pool_free";
+	int worker_index      = 0;
+	int result            = 1;
+
+	if( output_writer_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid output writer pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *output_writer_pool != NULL )
+	{
+		for( worker_index = 0;
+		     worker_index < ( *output_writer_pool )->number_of_workers;
+		     worker_index++ )
+		{
+			if( ( *output_writer_pool )->workers[ worker_index ].thread != NULL )
+			{
+				break;
+			}
+		}
+		if( worker_index < ( *output_writer_pool )->number_of_workers )
+		{
+			/* The status of the writes is irrelevant here
+			 */
+			if( output_writer_pool_join(
+			     *output_writer_pool,
+			     NULL ) != 1 )
+			{
+				for( worker_index = 0;
+				     worker_index < ( *output_writer_pool )->number_of_workers;
+				     worker_index++ )
+				{
+					if( ( *output_writer_pool )->workers[ worker_index ].thread != NULL )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+						 "%s: unable to join output writer thread: %d.",
+						 function,
+						 worker_index );
+
+						result = -1;
+
+						break;
+					}
+				}
+			}
+		}
+		if( ( *output_writer_pool )->condition != NULL )
+		{
+			if( libcthreads_condition_free(
+			     &( ( *output_writer_pool )->condition ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free condition.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *output_writer_pool )->mutex != NULL )
+		{
+			if( libcthreads_mutex_free(
+			     &( ( *output_writer_pool )->mutex ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free mutex.",
+				 function );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 *output_writer_pool );
+
+		*output_writer_pool = NULL;
+	}
+	return( result );
+}
+
+/* Pushes a storage media buffer onto the ring to be written to every output handle
+ * Blocks while all the buffers in the ring are still being written
+ * On success the pool takes over the storage media buffer and releases it
+ * onto the storage media buffer queue once it was written to every output handle
+ * Returns 1 if successful or -1 on error
+ */
+int output_writer_pool_push(
+     output_writer_pool_t *output_writer_pool,
+     storage_media_buffer_t *storage_media_buffer,
+     size_t write_size,
+     libcerror_error_t **error )
+{
+	static char *function = "output_writer_pool_push";
+	int buffer_index      = 0;
+	int status            = 0;
+
+	if( output_writer_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid output writer pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_writer_pool->finished != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid output writer pool - already finished.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_media_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage media buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( write_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid write size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     output_writer_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	/* Wait until the oldest buffer in the ring was written to every output handle
+	 */
+	do
+	{
+		status = output_writer_pool->status;
+
+		if( status != 0 )
+		{
+			break;
+		}
+		if( ( output_writer_pool->number_of_buffers - output_writer_pool->number_of_released_buffers ) < OUTPUT_WRITER_POOL_NUMBER_OF_BUFFERS )
+		{
+			break;
+		}
+		if( libcthreads_condition_wait(
+		     output_writer_pool->condition,
+		     output_writer_pool->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to wait for condition.",
+			 function );
+
+			libcthreads_mutex_release(
+			 output_writer_pool->mutex,
+			 NULL );
+
+			return( -1 );
+		}
+	}
+	while( 1 );
+
+	if( status == 0 )
+	{
+		buffer_index = (int) ( output_writer_pool->number_of_buffers % OUTPUT_WRITER_POOL_NUMBER_OF_BUFFERS );
+
+		output_writer_pool->buffers[ buffer_index ]     = storage_media_buffer;
+		output_writer_pool->write_sizes[ buffer_index ] = write_size;
+
+		output_writer_pool->number_of_buffers += 1;
+
+		if( libcthreads_condition_broadcast(
+		     output_writer_pool->condition,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to broadcast condition.",
+			 function );
+
+			libcthreads_mutex_release(
+			 output_writer_pool->mutex,
+			 NULL );
+
+			return( -1 );
+		}
+	}
+	if( libcthreads_mutex_release(
+	     output_writer_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( status != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write storage media buffer.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Waits for the threads to write the remaining buffers and joins them
+ * After the pool was joined every buffer has been released onto the storage media buffer queue
+ * Returns 1 if successful or -1 on error
+ */
+int output_writer_pool_join(
+     output_writer_pool_t *output_writer_pool,
+     libcerror_error_t **error )
+{
+	static char *function = "output_writer_pool_join";
+	int worker_index      = 0;
+	int result            = 1;
+
+	if( output_writer_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid output writer pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     output_writer_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	output_writer_pool->finished = 1;
+
+	if( libcthreads_condition_broadcast(
+	     output_writer_pool->condition,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to broadcast condition.",
+		 function );
+
+		libcthreads_mutex_release(
+		 output_writer_pool->mutex,
+		 NULL );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_release(
+	     output_writer_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	for( worker_index = 0;
+	     worker_index < output_writer_pool->number_of_workers;
+	     worker_index++ )
+	{
+		if( output_writer_pool->workers[ worker_index ].thread == NULL )
+		{
+			continue;
+		}
+		if( libcthreads_thread_join(
+		     &( output_writer_pool->workers[ worker_index ].thread ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join output writer thread: %d.",
+			 function,
+			 worker_index );
+
+			result = -1;
+		}
+	}
+	if( result != 1 )
+	{
+		return( -1 );
+	}
+	/* None of the threads references the remaining buffers at this point,
+	 * these were either written or abandoned after an error
+	 */
+	for( worker_index = 0;
+	     worker_index < output_writer_pool->number_of_workers;
+	     worker_index++ )
+	{
+		output_writer_pool->workers[ worker_index ].number_of_written_buffers = output_writer_pool->number_of_buffers;
+	}
+	if( output_writer_pool_release_buffers(
+	     output_writer_pool,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release buffers.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_writer_pool->status != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write storage media buffer.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Releases the buffers that were written to every output handle onto the storage media buffer queue
+ * Returns 1 if successful or -1 on error
+ */
+int output_writer_pool_release_buffers(
+     output_writer_pool_t *output_writer_pool,
+     libcerror_error_t **error )
+{
+	storage_media_buffer_t *buffers[ OUTPUT_WRITER_POOL_NUMBER_OF_BUFFERS ];
+
+	static char *function              = "output_writer_pool_release_buffers";
+	uint64_t number_of_written_buffers = 0;
+	int buffer_index                   = 0;
+	int number_of_buffers              = 0;
+	int result                         = 1;
+	int worker_index                   = 0;
+
+	if( output_writer_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid output writer pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     output_writer_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_written_buffers = output_writer_pool->number_of_buffers;
+
+	for( worker_index = 0;
+	     worker_index < output_writer_pool->number_of_workers;
+	     worker_index++ )
+	{
+		if( output_writer_pool->workers[ worker_index ].number_of_written_buffers < number_of_written_buffers )
+		{
+			number_of_written_buffers = output_writer_pool->workers[ worker_index ].number_of_written_buffers;
+		}
+	}
+	while( output_writer_pool->number_of_released_buffers < number_of_written_buffers )
+	{
+		buffer_index = (int) ( output_writer_pool->number_of_released_buffers % OUTPUT_WRITER_POOL_NUMBER_OF_BUFFERS );
+
+		buffers[ number_of_buffers ] = output_writer_pool->buffers[ buffer_index ];
+
+		output_writer_pool->buffers[ buffer_index ] = NULL;
+
+		output_writer_pool->number_of_released_buffers += 1;
+
+		number_of_buffers++;
+	}
+	if( number_of_buffers > 0 )
+	{
+		if( libcthreads_condition_broadcast(
+		     output_writer_pool->condition,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to broadcast condition.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     output_writer_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		result = -1;
+	}
+	/* The buffers are released outside the mutex since the queue can block
+	 */
+	for( buffer_index = 0;
+	     buffer_index < number_of_buffers;
+	     buffer_index++ )
+	{
+		if( storage_media_buffer_queue_release_buffer(
+		     output_writer_pool->storage_media_buffer_queue,
+		     buffers[ buffer_index ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to release storage media buffer onto queue.",
+			 function );
+
+			storage_media_buffer_free(
+			 &( buffers[ buffer_index ] ),
+			 NULL );
+
+			result = -1;
+		}
+	}
+	return( result );
+}
+
+/* Writes the buffers in the ring to a specific output handle
+ * Callback function for the output writer threads
+ * Returns 1 if successful or -1 on error
+ */
+int output_writer_pool_worker_callback(
+     output_writer_pool_worker_t *worker )
+{
+	output_writer_pool_t *output_writer_pool     = NULL;
+	libcerror_error_t *error                     = NULL;
+	storage_media_buffer_t *storage_media_buffer = NULL;
+	static char *function                        = "output_writer_pool_worker_callback";
+	size_t write_size                            = 0;
+	ssize_t write_count                          = 0;
+	int buffer_index                             = 0;
+
+	if( worker == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid worker.",
+		 function );
+
+		goto on_error;
+	}
+	output_writer_pool = worker->output_writer_pool;
+
+	if( output_writer_pool == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid worker - missing output writer pool.",
+		 function );
+
+		goto on_error;
+	}
+	do
+	{
+		if( libcthreads_mutex_grab(
+		     output_writer_pool->mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			goto on_error;
+		}
+		while( ( worker->number_of_written_buffers == output_writer_pool->number_of_buffers )
+		    && ( output_writer_pool->finished == 0 )
+		    && ( output_writer_pool->status == 0 ) )
+		{
+			if( libcthreads_condition_wait(
+			     output_writer_pool->condition,
+			     output_writer_pool->mutex,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to wait for condition.",
+				 function );
+
+				libcthreads_mutex_release(
+				 output_writer_pool->mutex,
+				 NULL );
+
+				goto on_error;
+			}
+		}
+		storage_media_buffer = NULL;
+
+		if( ( worker->number_of_written_buffers < output_writer_pool->number_of_buffers )
+		 && ( output_writer_pool->status == 0 ) )
+		{
+			buffer_index         = (int) ( worker->number_of_written_buffers % OUTPUT_WRITER_POOL_NUMBER_OF_BUFFERS );
+			storage_media_buffer = output_writer_pool->buffers[ buffer_index ];
+			write_size           = output_writer_pool->write_sizes[ buffer_index ];
+		}
+		if( libcthreads_mutex_release(
+		     output_writer_pool->mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			goto on_error;
+		}
+		if( storage_media_buffer == NULL )
+		{
+			break;
+		}
+		/* Writing a data chunk to an output handle does not modify it,
+		 * so the other threads can write the same storage media buffer
+		 * to their output handle at the same time
+		 */
+		write_count = storage_media_buffer_write_to_handle(
+		               storage_media_buffer,
+		               worker->output_handle,
+		               write_size,
+		               &error );
+
+		if( write_count < 0 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write storage media buffer to output handle: %d.",
+			 function,
+			 worker->output_handle_index );
+
+			goto on_error;
+		}
+		if( libcthreads_mutex_grab(
+		     output_writer_pool->mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			goto on_error;
+		}
+		worker->number_of_written_buffers += 1;
+
+		if( libcthreads_mutex_release(
+		     output_writer_pool->mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			goto on_error;
+		}
+		if( output_writer_pool_release_buffers(
+		     output_writer_pool,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release buffers.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	while( 1 );
+
+	return( 1 );
+
+on_error:
+	if( output_writer_pool != NULL )
+	{
+		/* Wake up the thread that is waiting for the ring to drain
+		 */
+		if( libcthreads_mutex_grab(
+		     output_writer_pool->mutex,
+		     NULL ) == 1 )
+		{
+			output_writer_pool->status = -1;
+
+			libcthreads_condition_broadcast(
+			 output_writer_pool->condition,
+			 NULL );
+
+			libcthreads_mutex_release(
+			 output_writer_pool->mutex,
+			 NULL );
+		}
+	}
+	if( error != NULL )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
@@ -0,0 +1,156 @@
+/*
+ * Output writer pool
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _OUTPUT_WRITER_POOL_H )
+#define _OUTPUT_WRITER_POOL_H
+
+#include <common.h>
+#include <types.h>
+
+#include "ewftools_libcerror.h"
+#include "ewftools_libcthreads.h"
+#include "ewftools_libewf.h"
+#include "storage_media_buffer.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The maximum number of output handles, the primary and secondary targets
+ */
+#define OUTPUT_WRITER_POOL_MAXIMUM_NUMBER_OF_OUTPUT_HANDLES	8
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* The number of buffers in the ring shared by the output writer threads
+ */
+#define OUTPUT_WRITER_POOL_NUMBER_OF_BUFFERS			16
+
+typedef struct output_writer_pool output_writer_pool_t;
+
+typedef struct output_writer_pool_worker output_writer_pool_worker_t;
+
+struct output_writer_pool_worker
+{
+	/* The output writer pool
+	 */
+	output_writer_pool_t *output_writer_pool;
+
+	/* The output handle
+	 */
+	libewf_handle_t *output_handle;
+
+	/* The index of the output handle
+	 */
+	int output_handle_index;
+
+	/* The thread
+	 */
+	libcthreads_thread_t *thread;
+
+	/* The number of buffers written by the thread
+	 */
+	uint64_t number_of_written_buffers;
+};
+
+struct output_writer_pool
+{
+	/* The workers, one per output handle
+	 */
+	output_writer_pool_worker_t workers[ OUTPUT_WRITER_POOL_MAXIMUM_NUMBER_OF_OUTPUT_HANDLES ];
+
+	/* The number of workers
+	 */
+	int number_of_workers;
+
+	/* The storage media buffer queue the written buffers are released onto
+	 */
+	libcthreads_queue_t *storage_media_buffer_queue;
+
+	/* The storage media buffers, used as a ring buffer in push order
+	 */
+	storage_media_buffer_t *buffers[ OUTPUT_WRITER_POOL_NUMBER_OF_BUFFERS ];
+
+	/* The write sizes of the storage media buffers
+	 */
+	size_t write_sizes[ OUTPUT_WRITER_POOL_NUMBER_OF_BUFFERS ];
+
+	/* The number of buffers pushed onto the ring
+	 */
+	uint64_t number_of_buffers;
+
+	/* The number of buffers released onto the storage media buffer queue
+	 */
+	uint64_t number_of_released_buffers;
+
+	/* Value to indicate no more buffers will be pushed
+	 */
+	uint8_t finished;
+
+	/* The status, 0 if the threads are running without error or -1 on error
+	 */
+	int status;
+
+	/* The mutex that protects the ring state
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The condition that is signalled when the ring state changes
+	 */
+	libcthreads_condition_t *condition;
+};
+
+int output_writer_pool_initialize(
+     output_writer_pool_t **output_writer_pool,
+     libewf_handle_t **output_handles,
+     int number_of_output_handles,
+     libcthreads_queue_t *storage_media_buffer_queue,
+     libcerror_error_t **error );
+
+int output_writer_pool_free(
+     output_writer_pool_t **output_writer_pool,
+     libcerror_error_t **error );
+
+int output_writer_pool_push(
+     output_writer_pool_t *output_writer_pool,
+     storage_media_buffer_t *storage_media_buffer,
+     size_t write_size,
+     libcerror_error_t **error );
+
+int output_writer_pool_join(
+     output_writer_pool_t *output_writer_pool,
+     libcerror_error_t **error );
+
+int output_writer_pool_release_buffers(
+     output_writer_pool_t *output_writer_pool,
+     libcerror_error_t **error );
+
+int output_writer_pool_worker_callback(
+     output_writer_pool_worker_t *worker );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _OUTPUT_WRITER_POOL_H ) */
+
@@ -64,7 +64,8 @@ int storage_media_buffer_initialize(
 		return( -1 );
 	}
 	if( ( mode != STORAGE_MEDIA_BUFFER_MODE_BUFFERED )
-	 && ( mode != STORAGE_MEDIA_BUFFER_MODE_CHUNK_DATA ) )
+	 && ( mode != STORAGE_MEDIA_BUFFER_MODE_CHUNK_DATA )
+	 && ( mode != STORAGE_MEDIA_BUFFER_MODE_PACKED_CHUNK_DATA ) )
 	{
 		libcerror_error_set(
 		 error,
@@ -156,7 +157,8 @@ int storage_media_buffer_initialize(
 
 		( *buffer )->raw_buffer_size = size;
 	}
-	if( mode == STORAGE_MEDIA_BUFFER_MODE_CHUNK_DATA )
+	if( ( mode == STORAGE_MEDIA_BUFFER_MODE_CHUNK_DATA )
+	 || ( mode == STORAGE_MEDIA_BUFFER_MODE_PACKED_CHUNK_DATA ) )
 	{
 		if( libewf_handle_get_data_chunk(
 		     handle,
@@ -379,6 +381,13 @@ ssize_t storage_media_buffer_read_from_handle(
 	                      storage_media_buffer->data_chunk,
 		              error );
 	}
+	else if( storage_media_buffer->mode == STORAGE_MEDIA_BUFFER_MODE_PACKED_CHUNK_DATA )
+	{
+		read_count = libewf_handle_read_packed_data_chunk(
+		              handle,
+		              storage_media_buffer->data_chunk,
+		              error );
+	}
 	else
 	{
 		read_count = libewf_handle_read_buffer(
@@ -428,7 +437,8 @@ ssize_t storage_media_buffer_read_process(
 
 		return( -1 );
 	}
-	if( storage_media_buffer->mode == STORAGE_MEDIA_BUFFER_MODE_CHUNK_DATA )
+	if( ( storage_media_buffer->mode == STORAGE_MEDIA_BUFFER_MODE_CHUNK_DATA )
+	 || ( storage_media_buffer->mode == STORAGE_MEDIA_BUFFER_MODE_PACKED_CHUNK_DATA ) )
 	{
 		process_count = libewf_data_chunk_read_buffer(
 		                 storage_media_buffer->data_chunk,
@@ -553,6 +563,13 @@ ssize_t storage_media_buffer_write_to_handle(
 		               storage_media_buffer->data_chunk,
 		               error );
 	}
+	else if( storage_media_buffer->mode == STORAGE_MEDIA_BUFFER_MODE_PACKED_CHUNK_DATA )
+	{
+		write_count = libewf_handle_write_packed_data_chunk(
+		               handle,
+		               storage_media_buffer->data_chunk,
+		               error );
+	}
 	else
 	{
 		write_count = libewf_handle_write_buffer(
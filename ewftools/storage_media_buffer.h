@@ -34,8 +34,9 @@ extern "C" {
 
 enum STORAGE_MEDIA_BUFFER_MODES
 {
-	STORAGE_MEDIA_BUFFER_MODE_BUFFERED	= 0,
-	STORAGE_MEDIA_BUFFER_MODE_CHUNK_DATA	= 1
+	STORAGE_MEDIA_BUFFER_MODE_BUFFERED		= 0,
+	STORAGE_MEDIA_BUFFER_MODE_CHUNK_DATA		= 1,
+	STORAGE_MEDIA_BUFFER_MODE_PACKED_CHUNK_DATA	= 2
 };
 
 typedef struct storage_media_buffer storage_media_buffer_t;
@@ -292,6 +292,24 @@ int verification_handle_free(
 
 			result = -1;
 		}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		if( ( *verification_handle )->digest_hash_pool != NULL )
+		{
+			if( digest_hash_pool_free(
+			     &( ( *verification_handle )->digest_hash_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free digest hash pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
 		if( ( *verification_handle )->md5_context != NULL )
 		{
 			if( libhmac_md5_free(
@@ -760,9 +778,39 @@ int verification_handle_initialize_integrity_hash(
 		}
 		verification_handle->sha256_context_initialized = 1;
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( ( verification_handle->number_of_threads != 0 )
+	 && ( ( verification_handle->md5_context != NULL )
+	  ||  ( verification_handle->sha1_context != NULL )
+	  ||  ( verification_handle->sha256_context != NULL ) ) )
+	{
+		if( digest_hash_pool_initialize(
+		     &( verification_handle->digest_hash_pool ),
+		     verification_handle->md5_context,
+		     verification_handle->sha1_context,
+		     verification_handle->sha256_context,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create digest hash pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
 	return( 1 );
 
 on_error:
+	if( verification_handle->sha256_context != NULL )
+	{
+		libhmac_sha256_free(
+		 &( verification_handle->sha256_context ),
+		 NULL );
+	}
 	if( verification_handle->sha1_context != NULL )
 	{
 		libhmac_sha1_free(
@@ -823,6 +871,27 @@ int verification_handle_update_integrity_hash(
 
 		return( -1 );
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( verification_handle->digest_hash_pool != NULL )
+	{
+		if( digest_hash_pool_update(
+		     verification_handle->digest_hash_pool,
+		     buffer,
+		     buffer_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to update digest hash pool.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+#endif
 	if( verification_handle->calculate_md5 != 0 )
 	{
 		if( libhmac_md5_update(
@@ -904,6 +973,37 @@ int verification_handle_finalize_integrity_hash(
 
 		return( -1 );
 	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( verification_handle->digest_hash_pool != NULL )
+	{
+		if( digest_hash_pool_join(
+		     verification_handle->digest_hash_pool,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join digest hash pool.",
+			 function );
+
+			return( -1 );
+		}
+		if( digest_hash_pool_free(
+		     &( verification_handle->digest_hash_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free digest hash pool.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
 	if( verification_handle->calculate_md5 != 0 )
 	{
 		if( verification_handle->calculated_md5_hash_string == NULL )
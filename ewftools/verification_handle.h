@@ -26,6 +26,7 @@
 #include <types.h>
 
 #include "digest_hash.h"
+#include "digest_hash_pool.h"
 #include "ewftools_libcdata.h"
 #include "ewftools_libcerror.h"
 #include "ewftools_libcthreads.h"
@@ -159,6 +160,10 @@ struct verification_handle
 	 */
 	libcthreads_queue_t *storage_media_buffer_queue;
 
+	/* The digest hash pool
+	 */
+	digest_hash_pool_t *digest_hash_pool;
+
 #endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
 
 	/* The libewf input handle
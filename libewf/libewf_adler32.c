@@ -0,0 +1,540 @@
+/*
+ * Adler-32 SIMD functions
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_adler32.h"
+
+#if defined( _MSC_VER )
+#include <intrin.h>
+#endif
+
+#if defined( LIBEWF_ADLER32_HAVE_SSSE3 ) || defined( LIBEWF_ADLER32_HAVE_AVX2 )
+#include <immintrin.h>
+#endif
+
+#if defined( LIBEWF_ADLER32_HAVE_NEON )
+#include <arm_neon.h>
+#endif
+
+#if defined( __GNUC__ ) || defined( __clang__ )
+#define LIBEWF_ADLER32_TARGET( instruction_set ) \
+	__attribute__ ((target( instruction_set )))
+#else
+#define LIBEWF_ADLER32_TARGET( instruction_set )
+#endif
+
+/* The largest prime smaller than 65536
+ */
+#define LIBEWF_ADLER32_BASE		65521
+
+/* The number of 32-byte blocks that can be processed before the 32-bit sums
+ * need to be reduced, which is the largest multitude of 32 smaller than 5552
+ */
+#define LIBEWF_ADLER32_MAXIMUM_NUMBER_OF_BLOCKS	173
+
+/* The detected CPU features, -1 if not yet detected
+ */
+static int libewf_adler32_cpu_features = -1;
+
+#if defined( LIBEWF_ADLER32_HAVE_SSSE3 ) || defined( LIBEWF_ADLER32_HAVE_AVX2 ) || defined( LIBEWF_ADLER32_HAVE_NEON )
+
+/* Calculates the Adler-32 of the remainder of a buffer that is smaller than a block
+ * Returns the Adler-32
+ */
+static uint32_t libewf_adler32_calculate_remainder(
+                 uint32_t lower_word,
+                 uint32_t upper_word,
+                 const uint8_t *buffer,
+                 size_t size )
+{
+	while( size > 0 )
+	{
+		lower_word += *buffer++;
+		upper_word += lower_word;
+
+		size--;
+	}
+	lower_word %= LIBEWF_ADLER32_BASE;
+	upper_word %= LIBEWF_ADLER32_BASE;
+
+	return( ( upper_word << 16 ) | lower_word );
+}
+
+#endif /* defined( LIBEWF_ADLER32_HAVE_SSSE3 ) || defined( LIBEWF_ADLER32_HAVE_AVX2 ) || defined( LIBEWF_ADLER32_HAVE_NEON ) */
+
+/* Determines the CPU features supported by the Adler-32 kernels
+ * The result is cached after the first call
+ * Returns the LIBEWF_ADLER32_CPU_FEATURES flags
+ */
+int libewf_adler32_get_cpu_features(
+     void )
+{
+	int cpu_features = 0;
+
+#if defined( _MSC_VER ) && defined( LIBEWF_ADLER32_HAVE_AVX2 )
+	int cpu_info[ 4 ];
+	int maximum_function_identifier = 0;
+#endif
+
+	if( libewf_adler32_cpu_features != -1 )
+	{
+		return( libewf_adler32_cpu_features );
+	}
+#if defined( LIBEWF_ADLER32_HAVE_SSSE3 ) && ( defined( __GNUC__ ) || defined( __clang__ ) )
+	__builtin_cpu_init();
+
+	if( __builtin_cpu_supports( "ssse3" ) )
+	{
+		cpu_features |= LIBEWF_ADLER32_CPU_FEATURE_SSSE3;
+	}
+	if( __builtin_cpu_supports( "avx2" ) )
+	{
+		cpu_features |= LIBEWF_ADLER32_CPU_FEATURE_AVX2;
+	}
+#elif defined( LIBEWF_ADLER32_HAVE_SSSE3 ) && defined( _MSC_VER )
+	__cpuid(
+	 cpu_info,
+	 0 );
+
+	maximum_function_identifier = cpu_info[ 0 ];
+
+	__cpuid(
+	 cpu_info,
+	 1 );
+
+	if( ( cpu_info[ 2 ] & 0x00000200UL ) != 0 )
+	{
+		cpu_features |= LIBEWF_ADLER32_CPU_FEATURE_SSSE3;
+	}
+	/* AVX2 requires the operating system to save the YMM registers (OSXSAVE and AVX)
+	 */
+	if( ( ( cpu_info[ 2 ] & 0x18000000UL ) == 0x18000000UL )
+	 && ( ( _xgetbv( 0 ) & 0x00000006UL ) == 0x00000006UL )
+	 && ( maximum_function_identifier >= 7 ) )
+	{
+		__cpuidex(
+		 cpu_info,
+		 7,
+		 0 );
+
+		if( ( cpu_info[ 1 ] & 0x00000020UL ) != 0 )
+		{
+			cpu_features |= LIBEWF_ADLER32_CPU_FEATURE_AVX2;
+		}
+	}
+#endif
+#if defined( LIBEWF_ADLER32_HAVE_NEON )
+	cpu_features |= LIBEWF_ADLER32_CPU_FEATURE_NEON;
+#endif
+	/* Concurrent callers detect the same value hence no locking is needed
+	 */
+	libewf_adler32_cpu_features = cpu_features;
+
+	return( cpu_features );
+}
+
+#if defined( LIBEWF_ADLER32_HAVE_SSSE3 )
+
+/* Calculates the Adler-32 of a buffer using SSSE3
+ * It uses the initial value to calculate a new Adler-32
+ * The caller must ensure the CPU supports SSSE3
+ * Returns the Adler-32
+ */
+LIBEWF_ADLER32_TARGET( "ssse3" )
+uint32_t libewf_adler32_calculate_ssse3(
+          uint32_t initial_value,
+          const uint8_t *buffer,
+          size_t size )
+{
+	__m128i block_sums;
+	__m128i lower_word_sums;
+	__m128i prefix_sums;
+	__m128i upper_word_sums;
+	__m128i values1;
+	__m128i values2;
+
+	const __m128i weights1 = _mm_setr_epi8( 32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17 );
+	const __m128i weights2 = _mm_setr_epi8( 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1 );
+	const __m128i ones     = _mm_set1_epi16( 1 );
+	const __m128i zeros    = _mm_setzero_si128();
+
+	size_t number_of_blocks = size / 32;
+	uint32_t lower_word     = initial_value & 0xffff;
+	uint32_t upper_word     = ( initial_value >> 16 ) & 0xffff;
+	int block_index         = 0;
+
+	size -= number_of_blocks * 32;
+
+	while( number_of_blocks > 0 )
+	{
+		block_index = LIBEWF_ADLER32_MAXIMUM_NUMBER_OF_BLOCKS;
+
+		if( (size_t) block_index > number_of_blocks )
+		{
+			block_index = (int) number_of_blocks;
+		}
+		number_of_blocks -= block_index;
+
+		/* Every block adds 32 times the lower word at the start of the block to the upper word
+		 */
+		prefix_sums     = _mm_set_epi32( 0, 0, 0, (int) ( lower_word * block_index ) );
+		upper_word_sums = _mm_set_epi32( 0, 0, 0, (int) upper_word );
+		lower_word_sums = zeros;
+
+		do
+		{
+			values1 = _mm_loadu_si128( (__m128i *) buffer );
+			values2 = _mm_loadu_si128( (__m128i *) &( buffer[ 16 ] ) );
+
+			prefix_sums = _mm_add_epi32( prefix_sums, lower_word_sums );
+
+			lower_word_sums = _mm_add_epi32( lower_word_sums, _mm_sad_epu8( values1, zeros ) );
+			block_sums      = _mm_maddubs_epi16( values1, weights1 );
+			upper_word_sums = _mm_add_epi32( upper_word_sums, _mm_madd_epi16( block_sums, ones ) );
+
+			lower_word_sums = _mm_add_epi32( lower_word_sums, _mm_sad_epu8( values2, zeros ) );
+			block_sums      = _mm_maddubs_epi16( values2, weights2 );
+			upper_word_sums = _mm_add_epi32( upper_word_sums, _mm_madd_epi16( block_sums, ones ) );
+
+			buffer += 32;
+		}
+		while( --block_index > 0 );
+
+		upper_word_sums = _mm_add_epi32( upper_word_sums, _mm_slli_epi32( prefix_sums, 5 ) );
+
+		lower_word_sums = _mm_add_epi32( lower_word_sums, _mm_shuffle_epi32( lower_word_sums, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+		lower_word_sums = _mm_add_epi32( lower_word_sums, _mm_shuffle_epi32( lower_word_sums, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+
+		upper_word_sums = _mm_add_epi32( upper_word_sums, _mm_shuffle_epi32( upper_word_sums, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+		upper_word_sums = _mm_add_epi32( upper_word_sums, _mm_shuffle_epi32( upper_word_sums, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+
+		lower_word += (uint32_t) _mm_cvtsi128_si32( lower_word_sums );
+		upper_word  = (uint32_t) _mm_cvtsi128_si32( upper_word_sums );
+
+		lower_word %= LIBEWF_ADLER32_BASE;
+		upper_word %= LIBEWF_ADLER32_BASE;
+	}
+	return( libewf_adler32_calculate_remainder(
+	         lower_word,
+	         upper_word,
+	         buffer,
+	         size ) );
+}
+
+#endif /* defined( LIBEWF_ADLER32_HAVE_SSSE3 ) */
+
+#if defined( LIBEWF_ADLER32_HAVE_AVX2 )
+
+/* Calculates the Adler-32 of a buffer using AVX2
+ * It uses the initial value to calculate a new Adler-32
+ * The caller must ensure the CPU supports AVX2
+ * Returns the Adler-32
+ */
+LIBEWF_ADLER32_TARGET( "avx2" )
+uint32_t libewf_adler32_calculate_avx2(
+          uint32_t initial_value,
+          const uint8_t *buffer,
+          size_t size )
+{
+	__m128i lower_word_sums_128bit;
+	__m128i upper_word_sums_128bit;
+	__m256i block_sums;
+	__m256i lower_word_sums;
+	__m256i prefix_sums;
+	__m256i upper_word_sums;
+	__m256i values;
+
+	const __m256i weights = _mm256_setr_epi8(
+	                         32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17,
+	                         16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1 );
+	const __m256i ones    = _mm256_set1_epi16( 1 );
+	const __m256i zeros   = _mm256_setzero_si256();
+
+	size_t number_of_blocks = size / 32;
+	uint32_t lower_word     = initial_value & 0xffff;
+	uint32_t upper_word     = ( initial_value >> 16 ) & 0xffff;
+	int block_index         = 0;
+
+	size -= number_of_blocks * 32;
+
+	while( number_of_blocks > 0 )
+	{
+		block_index = LIBEWF_ADLER32_MAXIMUM_NUMBER_OF_BLOCKS;
+
+		if( (size_t) block_index > number_of_blocks )
+		{
+			block_index = (int) number_of_blocks;
+		}
+		number_of_blocks -= block_index;
+
+		/* Every block adds 32 times the lower word at the start of the block to the upper word
+		 */
+		prefix_sums     = _mm256_set_epi32( 0, 0, 0, 0, 0, 0, 0, (int) ( lower_word * block_index ) );
+		upper_word_sums = _mm256_set_epi32( 0, 0, 0, 0, 0, 0, 0, (int) upper_word );
+		lower_word_sums = zeros;
+
+		do
+		{
+			values = _mm256_loadu_si256( (__m256i *) buffer );
+
+			prefix_sums = _mm256_add_epi32( prefix_sums, lower_word_sums );
+
+			lower_word_sums = _mm256_add_epi32( lower_word_sums, _mm256_sad_epu8( values, zeros ) );
+			block_sums      = _mm256_maddubs_epi16( values, weights );
+			upper_word_sums = _mm256_add_epi32( upper_word_sums, _mm256_madd_epi16( block_sums, ones ) );
+
+			buffer += 32;
+		}
+		while( --block_index > 0 );
+
+		upper_word_sums = _mm256_add_epi32( upper_word_sums, _mm256_slli_epi32( prefix_sums, 5 ) );
+
+		lower_word_sums_128bit = _mm_add_epi32( _mm256_castsi256_si128( lower_word_sums ), _mm256_extracti128_si256( lower_word_sums, 1 ) );
+		lower_word_sums_128bit = _mm_add_epi32( lower_word_sums_128bit, _mm_shuffle_epi32( lower_word_sums_128bit, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+		lower_word_sums_128bit = _mm_add_epi32( lower_word_sums_128bit, _mm_shuffle_epi32( lower_word_sums_128bit, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+
+		upper_word_sums_128bit = _mm_add_epi32( _mm256_castsi256_si128( upper_word_sums ), _mm256_extracti128_si256( upper_word_sums, 1 ) );
+		upper_word_sums_128bit = _mm_add_epi32( upper_word_sums_128bit, _mm_shuffle_epi32( upper_word_sums_128bit, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+		upper_word_sums_128bit = _mm_add_epi32( upper_word_sums_128bit, _mm_shuffle_epi32( upper_word_sums_128bit, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+
+		lower_word += (uint32_t) _mm_cvtsi128_si32( lower_word_sums_128bit );
+		upper_word  = (uint32_t) _mm_cvtsi128_si32( upper_word_sums_128bit );
+
+		lower_word %= LIBEWF_ADLER32_BASE;
+		upper_word %= LIBEWF_ADLER32_BASE;
+	}
+	return( libewf_adler32_calculate_remainder(
+	         lower_word,
+	         upper_word,
+	         buffer,
+	         size ) );
+}
+
+#endif /* defined( LIBEWF_ADLER32_HAVE_AVX2 ) */
+
+#if defined( LIBEWF_ADLER32_HAVE_NEON )
+
+/* Calculates the Adler-32 of a buffer using NEON
+ * It uses the initial value to calculate a new Adler-32
+ * Returns the Adler-32
+ */
+uint32_t libewf_adler32_calculate_neon(
+          uint32_t initial_value,
+          const uint8_t *buffer,
+          size_t size )
+{
+	static const uint16_t weights[ 32 ] = {
+		32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17,
+		16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1 };
+
+	uint8x16_t values1;
+	uint8x16_t values2;
+	uint16x8_t column_sums1;
+	uint16x8_t column_sums2;
+	uint16x8_t column_sums3;
+	uint16x8_t column_sums4;
+	uint32x2_t sums;
+	uint32x4_t lower_word_sums;
+	uint32x4_t upper_word_sums;
+
+	size_t number_of_blocks = size / 32;
+	uint32_t lower_word     = initial_value & 0xffff;
+	uint32_t upper_word     = ( initial_value >> 16 ) & 0xffff;
+	int block_index         = 0;
+
+	size -= number_of_blocks * 32;
+
+	while( number_of_blocks > 0 )
+	{
+		block_index = LIBEWF_ADLER32_MAXIMUM_NUMBER_OF_BLOCKS;
+
+		if( (size_t) block_index > number_of_blocks )
+		{
+			block_index = (int) number_of_blocks;
+		}
+		number_of_blocks -= block_index;
+
+		/* Every block adds 32 times the lower word at the start of the block to the upper word
+		 * the per column byte sums are weighted after the loop
+		 */
+		upper_word_sums = vsetq_lane_u32( lower_word * block_index, vdupq_n_u32( 0 ), 0 );
+		lower_word_sums = vdupq_n_u32( 0 );
+
+		column_sums1 = vdupq_n_u16( 0 );
+		column_sums2 = vdupq_n_u16( 0 );
+		column_sums3 = vdupq_n_u16( 0 );
+		column_sums4 = vdupq_n_u16( 0 );
+
+		do
+		{
+			values1 = vld1q_u8( buffer );
+			values2 = vld1q_u8( &( buffer[ 16 ] ) );
+
+			upper_word_sums = vaddq_u32( upper_word_sums, lower_word_sums );
+			lower_word_sums = vpadalq_u16( lower_word_sums, vpadalq_u8( vpaddlq_u8( values1 ), values2 ) );
+
+			column_sums1 = vaddw_u8( column_sums1, vget_low_u8( values1 ) );
+			column_sums2 = vaddw_u8( column_sums2, vget_high_u8( values1 ) );
+			column_sums3 = vaddw_u8( column_sums3, vget_low_u8( values2 ) );
+			column_sums4 = vaddw_u8( column_sums4, vget_high_u8( values2 ) );
+
+			buffer += 32;
+		}
+		while( --block_index > 0 );
+
+		upper_word_sums = vshlq_n_u32( upper_word_sums, 5 );
+
+		upper_word_sums = vmlal_u16( upper_word_sums, vget_low_u16( column_sums1 ), vld1_u16( &( weights[ 0 ] ) ) );
+		upper_word_sums = vmlal_u16( upper_word_sums, vget_high_u16( column_sums1 ), vld1_u16( &( weights[ 4 ] ) ) );
+		upper_word_sums = vmlal_u16( upper_word_sums, vget_low_u16( column_sums2 ), vld1_u16( &( weights[ 8 ] ) ) );
+		upper_word_sums = vmlal_u16( upper_word_sums, vget_high_u16( column_sums2 ), vld1_u16( &( weights[ 12 ] ) ) );
+		upper_word_sums = vmlal_u16( upper_word_sums, vget_low_u16( column_sums3 ), vld1_u16( &( weights[ 16 ] ) ) );
+		upper_word_sums = vmlal_u16( upper_word_sums, vget_high_u16( column_sums3 ), vld1_u16( &( weights[ 20 ] ) ) );
+		upper_word_sums = vmlal_u16( upper_word_sums, vget_low_u16( column_sums4 ), vld1_u16( &( weights[ 24 ] ) ) );
+		upper_word_sums = vmlal_u16( upper_word_sums, vget_high_u16( column_sums4 ), vld1_u16( &( weights[ 28 ] ) ) );
+
+		sums = vpadd_u32(
+		        vpadd_u32( vget_low_u32( lower_word_sums ), vget_high_u32( lower_word_sums ) ),
+		        vpadd_u32( vget_low_u32( upper_word_sums ), vget_high_u32( upper_word_sums ) ) );
+
+		lower_word += vget_lane_u32( sums, 0 );
+		upper_word += vget_lane_u32( sums, 1 );
+
+		lower_word %= LIBEWF_ADLER32_BASE;
+		upper_word %= LIBEWF_ADLER32_BASE;
+	}
+	return( libewf_adler32_calculate_remainder(
+	         lower_word,
+	         upper_word,
+	         buffer,
+	         size ) );
+}
+
+#endif /* defined( LIBEWF_ADLER32_HAVE_NEON ) */
+
+/* Calculates the Adler-32 of data that consists of a repeated 8-byte pattern
+ * The sums are determined arithmetically hence the data itself is not read
+ * It uses the initial value to calculate a new Adler-32
+ * The size must be a multiple of 8
+ * Returns the Adler-32
+ */
+uint32_t libewf_adler32_calculate_pattern_fill(
+          uint32_t initial_value,
+          const uint8_t *pattern,
+          size_t size )
+{
+	uint64_t lower_word           = initial_value & 0xffff;
+	uint64_t number_of_pairs      = 0;
+	uint64_t number_of_patterns   = (uint64_t) size / 8;
+	uint64_t pattern_sum          = 0;
+	uint64_t upper_word           = ( initial_value >> 16 ) & 0xffff;
+	uint64_t weighted_pattern_sum = 0;
+	uint64_t weighted_sum         = 0;
+	uint8_t pattern_index         = 0;
+
+	for( pattern_index = 0;
+	     pattern_index < 8;
+	     pattern_index++ )
+	{
+		pattern_sum          += pattern[ pattern_index ];
+		weighted_pattern_sum += (uint64_t) pattern_index * pattern[ pattern_index ];
+	}
+	/* Every byte adds its value times the number of bytes from its offset to the end to the upper word
+	 * which for m patterns of n bytes in total is: m * ( n * pattern sum - weighted pattern sum ) - 8 * m * ( m - 1 ) / 2 * pattern sum
+	 * where m * ( m - 1 ) / 2 is reduced by halving the even factor first to prevent an overflow
+	 */
+	if( ( number_of_patterns % 2 ) == 0 )
+	{
+		number_of_pairs = ( ( number_of_patterns / 2 ) % LIBEWF_ADLER32_BASE ) * ( ( number_of_patterns - 1 ) % LIBEWF_ADLER32_BASE );
+	}
+	else
+	{
+		number_of_pairs = ( number_of_patterns % LIBEWF_ADLER32_BASE ) * ( ( ( number_of_patterns - 1 ) / 2 ) % LIBEWF_ADLER32_BASE );
+	}
+	number_of_pairs    %= LIBEWF_ADLER32_BASE;
+	number_of_patterns %= LIBEWF_ADLER32_BASE;
+	size               %= LIBEWF_ADLER32_BASE;
+
+	weighted_sum = ( (uint64_t) size * pattern_sum ) % LIBEWF_ADLER32_BASE;
+	weighted_sum = ( weighted_sum + LIBEWF_ADLER32_BASE - ( weighted_pattern_sum % LIBEWF_ADLER32_BASE ) ) % LIBEWF_ADLER32_BASE;
+	weighted_sum = ( number_of_patterns * weighted_sum ) % LIBEWF_ADLER32_BASE;
+	weighted_sum = ( weighted_sum + LIBEWF_ADLER32_BASE - ( ( 8 * number_of_pairs * pattern_sum ) % LIBEWF_ADLER32_BASE ) ) % LIBEWF_ADLER32_BASE;
+
+	upper_word = ( upper_word + ( (uint64_t) size * lower_word ) + weighted_sum ) % LIBEWF_ADLER32_BASE;
+	lower_word = ( lower_word + ( number_of_patterns * pattern_sum ) ) % LIBEWF_ADLER32_BASE;
+
+	return( (uint32_t) ( ( upper_word << 16 ) | lower_word ) );
+}
+
+/* Calculates the Adler-32 of a buffer using the fastest kernel supported by the CPU
+ * It uses the initial value to calculate a new Adler-32
+ * Returns 1 if successful or 0 if no kernel is supported
+ */
+int libewf_adler32_calculate_simd(
+     uint32_t *checksum_value,
+     const uint8_t *buffer,
+     size_t size,
+     uint32_t initial_value )
+{
+	int cpu_features = libewf_adler32_get_cpu_features();
+
+	if( cpu_features == 0 )
+	{
+		return( 0 );
+	}
+#if defined( LIBEWF_ADLER32_HAVE_AVX2 )
+	if( ( cpu_features & LIBEWF_ADLER32_CPU_FEATURE_AVX2 ) != 0 )
+	{
+		*checksum_value = libewf_adler32_calculate_avx2(
+		                   initial_value,
+		                   buffer,
+		                   size );
+
+		return( 1 );
+	}
+#endif
+#if defined( LIBEWF_ADLER32_HAVE_SSSE3 )
+	if( ( cpu_features & LIBEWF_ADLER32_CPU_FEATURE_SSSE3 ) != 0 )
+	{
+		*checksum_value = libewf_adler32_calculate_ssse3(
+		                   initial_value,
+		                   buffer,
+		                   size );
+
+		return( 1 );
+	}
+#endif
+#if defined( LIBEWF_ADLER32_HAVE_NEON )
+	if( ( cpu_features & LIBEWF_ADLER32_CPU_FEATURE_NEON ) != 0 )
+	{
+		*checksum_value = libewf_adler32_calculate_neon(
+		                   initial_value,
+		                   buffer,
+		                   size );
+
+		return( 1 );
+	}
+#endif
+	return( 0 );
+}
+
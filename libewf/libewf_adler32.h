@@ -0,0 +1,108 @@
+/*
+ * Adler-32 SIMD functions
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_ADLER32_H )
+#define _LIBEWF_ADLER32_H
+
+#include <common.h>
+#include <types.h>
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The x86 kernels are compiled with function specific target attributes
+ * so that they do not require the whole library to be built for SSSE3 or AVX2
+ */
+#if ( defined( __x86_64__ ) || defined( __i386__ ) ) && ( defined( __clang__ ) || ( defined( __GNUC__ ) && ( __GNUC__ >= 5 ) ) )
+#define LIBEWF_ADLER32_HAVE_SSSE3	1
+#define LIBEWF_ADLER32_HAVE_AVX2	1
+
+#elif defined( _MSC_VER ) && ( _MSC_VER >= 1800 ) && ( defined( _M_X64 ) || defined( _M_IX86 ) )
+#define LIBEWF_ADLER32_HAVE_SSSE3	1
+#define LIBEWF_ADLER32_HAVE_AVX2	1
+
+#endif
+
+/* NEON is part of the aarch64 base architecture
+ */
+#if defined( __aarch64__ ) && defined( __ARM_NEON )
+#define LIBEWF_ADLER32_HAVE_NEON	1
+
+#elif defined( _MSC_VER ) && defined( _M_ARM64 )
+#define LIBEWF_ADLER32_HAVE_NEON	1
+
+#endif
+
+enum LIBEWF_ADLER32_CPU_FEATURES
+{
+	LIBEWF_ADLER32_CPU_FEATURE_SSSE3	= 0x00000001UL,
+	LIBEWF_ADLER32_CPU_FEATURE_AVX2		= 0x00000002UL,
+	LIBEWF_ADLER32_CPU_FEATURE_NEON		= 0x00000004UL
+};
+
+int libewf_adler32_get_cpu_features(
+     void );
+
+#if defined( LIBEWF_ADLER32_HAVE_SSSE3 )
+
+uint32_t libewf_adler32_calculate_ssse3(
+          uint32_t initial_value,
+          const uint8_t *buffer,
+          size_t size );
+
+#endif /* defined( LIBEWF_ADLER32_HAVE_SSSE3 ) */
+
+#if defined( LIBEWF_ADLER32_HAVE_AVX2 )
+
+uint32_t libewf_adler32_calculate_avx2(
+          uint32_t initial_value,
+          const uint8_t *buffer,
+          size_t size );
+
+#endif /* defined( LIBEWF_ADLER32_HAVE_AVX2 ) */
+
+#if defined( LIBEWF_ADLER32_HAVE_NEON )
+
+uint32_t libewf_adler32_calculate_neon(
+          uint32_t initial_value,
+          const uint8_t *buffer,
+          size_t size );
+
+#endif /* defined( LIBEWF_ADLER32_HAVE_NEON ) */
+
+uint32_t libewf_adler32_calculate_pattern_fill(
+          uint32_t initial_value,
+          const uint8_t *pattern,
+          size_t size );
+
+int libewf_adler32_calculate_simd(
+     uint32_t *checksum_value,
+     const uint8_t *buffer,
+     size_t size,
+     uint32_t initial_value );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_ADLER32_H ) */
+
@@ -0,0 +1,1779 @@
+/*
+ * Buffered file IO handle functions used to write segment files
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/* O_DIRECT, fallocate and sync_file_range are only defined by the GNU C library
+ * if _GNU_SOURCE is defined before any system header is included
+ */
+#if !defined( _GNU_SOURCE )
+#define _GNU_SOURCE 1
+#endif
+
+#include <common.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#if defined( HAVE_ERRNO_H )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_FCNTL_H )
+#include <fcntl.h>
+#endif
+
+#if defined( HAVE_STDLIB_H )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "libewf_buffered_file_io_handle.h"
+#include "libewf_definitions.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+
+#if defined( LIBEWF_HAVE_BUFFERED_FILE_IO )
+
+#if !defined( O_CLOEXEC )
+#define O_CLOEXEC	0
+#endif
+
+#if !defined( HAVE_POSIX_MEMALIGN )
+#undef O_DIRECT
+#endif
+
+/* Creates a buffered file IO handle
+ * Make sure the value file_io_handle is referencing, is set to NULL
+ * The buffer size is rounded up to a multiple of the write buffer alignment
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_buffered_file_io_handle_initialize(
+     libewf_buffered_file_io_handle_t **file_io_handle,
+     size_t buffer_size,
+     uint8_t write_flags,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_buffered_file_io_handle_initialize";
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *file_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file IO handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( buffer_size == 0 )
+	 || ( buffer_size > (size_t) LIBEWF_MAXIMUM_SEGMENT_WRITE_BUFFER_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*file_io_handle = memory_allocate_structure(
+	                   libewf_buffered_file_io_handle_t );
+
+	if( *file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *file_io_handle,
+	     0,
+	     sizeof( libewf_buffered_file_io_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( buffer_size % LIBEWF_SEGMENT_WRITE_BUFFER_ALIGNMENT ) != 0 )
+	{
+		buffer_size += LIBEWF_SEGMENT_WRITE_BUFFER_ALIGNMENT - ( buffer_size % LIBEWF_SEGMENT_WRITE_BUFFER_ALIGNMENT );
+	}
+	( *file_io_handle )->file_descriptor = -1;
+	( *file_io_handle )->buffer_size     = buffer_size;
+	( *file_io_handle )->write_flags     = write_flags;
+
+	return( 1 );
+
+on_error:
+	if( *file_io_handle != NULL )
+	{
+		memory_free(
+		 *file_io_handle );
+
+		*file_io_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Creates a buffered file handle
+ * Make sure the value handle is referencing, is set to NULL
+ * The pre-allocation size is only used if the pre-allocate write flag is set
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_buffered_file_initialize(
+     libbfio_handle_t **handle,
+     const char *name,
+     size_t name_size,
+     size_t buffer_size,
+     uint8_t write_flags,
+     size64_t preallocation_size,
+     libcerror_error_t **error )
+{
+	libewf_buffered_file_io_handle_t *file_io_handle = NULL;
+	static char *function                            = "libewf_buffered_file_initialize";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_buffered_file_io_handle_initialize(
+	     &file_io_handle,
+	     buffer_size,
+	     write_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_buffered_file_io_handle_set_name(
+	     file_io_handle,
+	     name,
+	     name_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set name in file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( write_flags & LIBEWF_WRITE_FLAG_PREALLOCATE ) != 0 )
+	{
+		if( libewf_buffered_file_io_handle_set_preallocation_size(
+		     file_io_handle,
+		     preallocation_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set pre-allocation size in file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libbfio_handle_initialize(
+	     handle,
+	     (intptr_t *) file_io_handle,
+	     (int (*)(intptr_t **, libcerror_error_t **)) libewf_buffered_file_io_handle_free,
+	     (int (*)(intptr_t **, intptr_t *, libcerror_error_t **)) libewf_buffered_file_io_handle_clone,
+	     (int (*)(intptr_t *, int, libcerror_error_t **)) libewf_buffered_file_io_handle_open,
+	     (int (*)(intptr_t *, libcerror_error_t **)) libewf_buffered_file_io_handle_close,
+	     (ssize_t (*)(intptr_t *, uint8_t *, size_t, libcerror_error_t **)) libewf_buffered_file_io_handle_read,
+	     (ssize_t (*)(intptr_t *, const uint8_t *, size_t, libcerror_error_t **)) libewf_buffered_file_io_handle_write,
+	     (off64_t (*)(intptr_t *, off64_t, int, libcerror_error_t **)) libewf_buffered_file_io_handle_seek_offset,
+	     (int (*)(intptr_t *, libcerror_error_t **)) libewf_buffered_file_io_handle_exists,
+	     (int (*)(intptr_t *, libcerror_error_t **)) libewf_buffered_file_io_handle_is_open,
+	     (int (*)(intptr_t *, size64_t *, libcerror_error_t **)) libewf_buffered_file_io_handle_get_size,
+	     LIBBFIO_FLAG_IO_HANDLE_MANAGED | LIBBFIO_FLAG_IO_HANDLE_CLONE_BY_FUNCTION,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libewf_buffered_file_io_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees a buffered file IO handle
+ * Buffered data that was not yet written is discarded, use close to write it
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_buffered_file_io_handle_free(
+     libewf_buffered_file_io_handle_t **file_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_buffered_file_io_handle_free";
+	int result            = 1;
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *file_io_handle != NULL )
+	{
+		if( ( *file_io_handle )->file_descriptor != -1 )
+		{
+			if( close(
+			     ( *file_io_handle )->file_descriptor ) != 0 )
+			{
+				libcerror_system_set_error(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 errno,
+				 "%s: unable to close file.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *file_io_handle )->buffer != NULL )
+		{
+			memory_free(
+			 ( *file_io_handle )->buffer );
+		}
+		if( ( *file_io_handle )->name != NULL )
+		{
+			memory_free(
+			 ( *file_io_handle )->name );
+		}
+		memory_free(
+		 *file_io_handle );
+
+		*file_io_handle = NULL;
+	}
+	return( result );
+}
+
+/* Clones (duplicates) the buffered file IO handle
+ * The name, write buffer and pre-allocation settings are copied, the clone is not opened
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_buffered_file_io_handle_clone(
+     libewf_buffered_file_io_handle_t **destination_file_io_handle,
+     libewf_buffered_file_io_handle_t *source_file_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_buffered_file_io_handle_clone";
+
+	if( destination_file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid destination file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *destination_file_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: destination file IO handle already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_file_io_handle == NULL )
+	{
+		*destination_file_io_handle = NULL;
+
+		return( 1 );
+	}
+	if( libewf_buffered_file_io_handle_initialize(
+	     destination_file_io_handle,
+	     source_file_io_handle->buffer_size,
+	     source_file_io_handle->write_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( source_file_io_handle->name != NULL )
+	{
+		if( libewf_buffered_file_io_handle_set_name(
+		     *destination_file_io_handle,
+		     source_file_io_handle->name,
+		     source_file_io_handle->name_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set name in destination file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	( *destination_file_io_handle )->preallocation_size = source_file_io_handle->preallocation_size;
+
+	return( 1 );
+
+on_error:
+	if( *destination_file_io_handle != NULL )
+	{
+		libewf_buffered_file_io_handle_free(
+		 destination_file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Sets the name
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_buffered_file_io_handle_set_name(
+     libewf_buffered_file_io_handle_t *file_io_handle,
+     const char *name,
+     size_t name_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_buffered_file_io_handle_set_name";
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle->file_descriptor != -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file IO handle - file already open.",
+		 function );
+
+		return( -1 );
+	}
+	if( name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( name_size <= 1 )
+	 || ( name_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid name size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle->name != NULL )
+	{
+		memory_free(
+		 file_io_handle->name );
+
+		file_io_handle->name      = NULL;
+		file_io_handle->name_size = 0;
+	}
+	file_io_handle->name = narrow_string_allocate(
+	                        name_size );
+
+	if( file_io_handle->name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create name.",
+		 function );
+
+		return( -1 );
+	}
+	if( narrow_string_copy(
+	     file_io_handle->name,
+	     name,
+	     name_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy name.",
+		 function );
+
+		memory_free(
+		 file_io_handle->name );
+
+		file_io_handle->name = NULL;
+
+		return( -1 );
+	}
+	file_io_handle->name[ name_size - 1 ] = 0;
+	file_io_handle->name_size             = name_size;
+
+	return( 1 );
+}
+
+/* Sets the pre-allocation size
+ * A value of 0 disables pre-allocation
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_buffered_file_io_handle_set_preallocation_size(
+     libewf_buffered_file_io_handle_t *file_io_handle,
+     size64_t preallocation_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_buffered_file_io_handle_set_preallocation_size";
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( preallocation_size > (size64_t) INT64_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid pre-allocation size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	file_io_handle->preallocation_size = preallocation_size;
+
+	return( 1 );
+}
+
+/* Pre-allocates the blocks of the file up to the pre-allocation size
+ * This reduces the fragmentation of a file that is grown by many small writes.
+ * Where supported the blocks are allocated without changing the file size,
+ * otherwise the file size is changed but the size of the data written is retained.
+ * The file is truncated to the size of the data written on close.
+ * Pre-allocation is advisory, if the file system does not support it or
+ * has insufficient space the blocks are allocated when the data is written.
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int libewf_buffered_file_io_handle_preallocate(
+     libewf_buffered_file_io_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_buffered_file_io_handle_preallocate";
+	int result            = 0;
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle->file_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file IO handle - file not open.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle->preallocation_size <= file_io_handle->size )
+	{
+		return( 0 );
+	}
+#if defined( HAVE_FALLOCATE ) && defined( FALLOC_FL_KEEP_SIZE )
+	/* posix_fallocate is not used here since the GNU C library emulates it
+	 * by writing every block if the file system does not support fallocate
+	 */
+	if( fallocate(
+	     file_io_handle->file_descriptor,
+	     FALLOC_FL_KEEP_SIZE,
+	     (off_t) file_io_handle->size,
+	     (off_t) ( file_io_handle->preallocation_size - file_io_handle->size ) ) == 0 )
+	{
+		result = 1;
+	}
+	/* A failed pre-allocation can leave part of the range allocated
+	 */
+	file_io_handle->is_preallocated = 1;
+
+#elif defined( HAVE_POSIX_FALLOCATE )
+	if( posix_fallocate(
+	     file_io_handle->file_descriptor,
+	     (off_t) file_io_handle->size,
+	     (off_t) ( file_io_handle->preallocation_size - file_io_handle->size ) ) == 0 )
+	{
+		result = 1;
+	}
+	file_io_handle->is_preallocated = 1;
+
+#endif
+	return( result );
+}
+
+/* Opens the buffered file IO handle
+ * If direct IO was requested and the file system does not support it the file is opened without it
+ * A file that is created or truncated is pre-allocated if a pre-allocation size was set
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_buffered_file_io_handle_open(
+     libewf_buffered_file_io_handle_t *file_io_handle,
+     int access_flags,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_buffered_file_io_handle_open";
+	off_t file_offset     = 0;
+	int file_io_flags     = 0;
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle->name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file IO handle - missing name.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle->file_descriptor != -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file IO handle - file already open.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( ( access_flags & LIBBFIO_ACCESS_FLAG_READ ) != 0 )
+	 && ( ( access_flags & LIBBFIO_ACCESS_FLAG_WRITE ) != 0 ) )
+	{
+		file_io_flags = O_RDWR | O_CREAT;
+	}
+	else if( ( access_flags & LIBBFIO_ACCESS_FLAG_WRITE ) != 0 )
+	{
+		file_io_flags = O_WRONLY | O_CREAT;
+	}
+	else if( ( access_flags & LIBBFIO_ACCESS_FLAG_READ ) != 0 )
+	{
+		file_io_flags = O_RDONLY;
+	}
+	else
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported access flags: 0x%02x.",
+		 function,
+		 access_flags );
+
+		return( -1 );
+	}
+	if( ( ( access_flags & LIBBFIO_ACCESS_FLAG_WRITE ) != 0 )
+	 && ( ( access_flags & LIBBFIO_ACCESS_FLAG_TRUNCATE ) != 0 ) )
+	{
+		file_io_flags |= O_TRUNC;
+	}
+	file_io_handle->direct_io_supported = 0;
+	file_io_handle->direct_io_enabled   = 0;
+
+#if defined( O_DIRECT )
+	if( ( ( access_flags & LIBBFIO_ACCESS_FLAG_WRITE ) != 0 )
+	 && ( ( file_io_handle->write_flags & LIBEWF_WRITE_FLAG_DIRECT_IO ) != 0 ) )
+	{
+		file_io_handle->file_descriptor = open(
+		                                   file_io_handle->name,
+		                                   file_io_flags | O_CLOEXEC | O_DIRECT,
+		                                   0644 );
+
+		/* Not all file systems support direct IO
+		 */
+		if( file_io_handle->file_descriptor != -1 )
+		{
+			file_io_handle->direct_io_supported = 1;
+			file_io_handle->direct_io_enabled   = 1;
+		}
+		else if( errno != EINVAL )
+		{
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 errno,
+			 "%s: unable to open file: %s.",
+			 function,
+			 file_io_handle->name );
+
+			return( -1 );
+		}
+	}
+#endif /* defined( O_DIRECT ) */
+
+	if( file_io_handle->file_descriptor == -1 )
+	{
+		file_io_handle->file_descriptor = open(
+		                                   file_io_handle->name,
+		                                   file_io_flags | O_CLOEXEC,
+		                                   0644 );
+
+		if( file_io_handle->file_descriptor == -1 )
+		{
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 errno,
+			 "%s: unable to open file: %s.",
+			 function,
+			 file_io_handle->name );
+
+			return( -1 );
+		}
+	}
+	file_offset = lseek(
+	               file_io_handle->file_descriptor,
+	               0,
+	               SEEK_END );
+
+	if( file_offset == (off_t) -1 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 errno,
+		 "%s: unable to determine size of file: %s.",
+		 function,
+		 file_io_handle->name );
+
+		goto on_error;
+	}
+	file_io_handle->access_flags     = access_flags;
+	file_io_handle->size             = (size64_t) file_offset;
+	file_io_handle->current_offset   = 0;
+	file_io_handle->buffer_offset    = 0;
+	file_io_handle->buffer_data_size = 0;
+	file_io_handle->release_offset   = 0;
+	file_io_handle->release_size     = 0;
+	file_io_handle->is_preallocated  = 0;
+
+	/* The file is reopened for reading and writing once the segment file has been
+	 * written, only pre-allocate when it is created
+	 */
+	if( ( ( access_flags & LIBBFIO_ACCESS_FLAG_WRITE ) != 0 )
+	 && ( ( access_flags & LIBBFIO_ACCESS_FLAG_TRUNCATE ) != 0 )
+	 && ( file_io_handle->preallocation_size > 0 ) )
+	{
+		if( libewf_buffered_file_io_handle_preallocate(
+		     file_io_handle,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_GENERIC,
+			 "%s: unable to pre-allocate file: %s.",
+			 function,
+			 file_io_handle->name );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	close(
+	 file_io_handle->file_descriptor );
+
+	file_io_handle->file_descriptor = -1;
+
+	return( -1 );
+}
+
+/* Closes the buffered file IO handle
+ * The buffered data is written before the file is closed and a pre-allocated file
+ * is truncated to the size of the data written
+ * Returns 0 if successful or -1 on error
+ */
+int libewf_buffered_file_io_handle_close(
+     libewf_buffered_file_io_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_buffered_file_io_handle_close";
+	int result            = 0;
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle->file_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file IO handle - file not open.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_buffered_file_io_handle_flush(
+	     file_io_handle,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to flush write buffer.",
+		 function );
+
+		result = -1;
+	}
+	if( file_io_handle->is_preallocated != 0 )
+	{
+		/* Release the blocks that were pre-allocated but not written
+		 */
+		if( ftruncate(
+		     file_io_handle->file_descriptor,
+		     (off_t) file_io_handle->size ) != 0 )
+		{
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 errno,
+			 "%s: unable to truncate file to size: %" PRIu64 ".",
+			 function,
+			 file_io_handle->size );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_POSIX_FADVISE )
+	if( ( file_io_handle->write_flags & LIBEWF_WRITE_FLAG_DONT_CACHE ) != 0 )
+	{
+		/* Release the cached pages of the range that was last written
+		 */
+#if defined( HAVE_SYNC_FILE_RANGE )
+		sync_file_range(
+		 file_io_handle->file_descriptor,
+		 (off_t) file_io_handle->release_offset,
+		 (off_t) file_io_handle->release_size,
+		 SYNC_FILE_RANGE_WAIT_BEFORE | SYNC_FILE_RANGE_WRITE | SYNC_FILE_RANGE_WAIT_AFTER );
+#endif
+		posix_fadvise(
+		 file_io_handle->file_descriptor,
+		 (off_t) file_io_handle->release_offset,
+		 (off_t) file_io_handle->release_size,
+		 POSIX_FADV_DONTNEED );
+	}
+#endif /* defined( HAVE_POSIX_FADVISE ) */
+
+	if( close(
+	     file_io_handle->file_descriptor ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 errno,
+		 "%s: unable to close file.",
+		 function );
+
+		result = -1;
+	}
+	file_io_handle->file_descriptor     = -1;
+	file_io_handle->direct_io_supported = 0;
+	file_io_handle->direct_io_enabled   = 0;
+	file_io_handle->access_flags        = 0;
+	file_io_handle->buffer_data_size    = 0;
+	file_io_handle->is_preallocated     = 0;
+
+	/* Segment files that were written are kept in the file IO pool after they are closed
+	 * so the write buffer is not retained
+	 */
+	if( file_io_handle->buffer != NULL )
+	{
+		memory_free(
+		 file_io_handle->buffer );
+
+		file_io_handle->buffer = NULL;
+	}
+	return( result );
+}
+
+/* Enables or disables direct IO on the file descriptor
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_buffered_file_io_handle_set_direct_io(
+     libewf_buffered_file_io_handle_t *file_io_handle,
+     uint8_t enable_direct_io,
+     libcerror_error_t **error )
+{
+#if defined( O_DIRECT )
+	static char *function = "libewf_buffered_file_io_handle_set_direct_io";
+	int file_status_flags = 0;
+
+	if( file_io_handle->direct_io_enabled == enable_direct_io )
+	{
+		return( 1 );
+	}
+	file_status_flags = fcntl(
+	                     file_io_handle->file_descriptor,
+	                     F_GETFL );
+
+	if( file_status_flags != -1 )
+	{
+		if( enable_direct_io != 0 )
+		{
+			file_status_flags |= O_DIRECT;
+		}
+		else
+		{
+			file_status_flags &= ~( O_DIRECT );
+		}
+		file_status_flags = fcntl(
+		                     file_io_handle->file_descriptor,
+		                     F_SETFL,
+		                     file_status_flags );
+	}
+	if( file_status_flags == -1 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 errno,
+		 "%s: unable to change direct IO file status flag.",
+		 function );
+
+		return( -1 );
+	}
+	file_io_handle->direct_io_enabled = enable_direct_io;
+#endif /* defined( O_DIRECT ) */
+
+	return( 1 );
+}
+
+/* Writes data to the file at a specific offset
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_buffered_file_io_handle_write_to_file(
+     libewf_buffered_file_io_handle_t *file_io_handle,
+     const uint8_t *buffer,
+     size_t size,
+     off64_t offset,
+     uint8_t use_direct_io,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_buffered_file_io_handle_write_to_file";
+	size_t buffer_offset  = 0;
+	ssize_t write_count   = 0;
+
+	if( libewf_buffered_file_io_handle_set_direct_io(
+	     file_io_handle,
+	     use_direct_io,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set direct IO.",
+		 function );
+
+		return( -1 );
+	}
+	while( buffer_offset < size )
+	{
+		write_count = pwrite(
+		               file_io_handle->file_descriptor,
+		               &( buffer[ buffer_offset ] ),
+		               size - buffer_offset,
+		               (off_t) ( offset + buffer_offset ) );
+
+		if( write_count == -1 )
+		{
+			if( errno == EINTR )
+			{
+				continue;
+			}
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 errno,
+			 "%s: unable to write: %" PRIzd " bytes at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 size - buffer_offset,
+			 offset + buffer_offset,
+			 offset + buffer_offset );
+
+			return( -1 );
+		}
+		if( write_count == 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write: %" PRIzd " bytes at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 size - buffer_offset,
+			 offset + buffer_offset,
+			 offset + buffer_offset );
+
+			return( -1 );
+		}
+		buffer_offset += (size_t) write_count;
+	}
+	if( (size64_t) ( offset + size ) > file_io_handle->size )
+	{
+		file_io_handle->size = (size64_t) ( offset + size );
+	}
+#if defined( HAVE_POSIX_FADVISE )
+	if( ( file_io_handle->write_flags & LIBEWF_WRITE_FLAG_DONT_CACHE ) != 0 )
+	{
+		/* Writeback of the range that was just written is started and the cached pages
+		 * of the range that was written before are released, once they have been written
+		 * back, so the page cache only holds the last 2 write buffers of the file.
+		 * The calls are advisory and their errors are ignored.
+		 */
+#if defined( HAVE_SYNC_FILE_RANGE )
+		sync_file_range(
+		 file_io_handle->file_descriptor,
+		 (off_t) offset,
+		 (off_t) size,
+		 SYNC_FILE_RANGE_WRITE );
+#endif
+		if( file_io_handle->release_size > 0 )
+		{
+#if defined( HAVE_SYNC_FILE_RANGE )
+			sync_file_range(
+			 file_io_handle->file_descriptor,
+			 (off_t) file_io_handle->release_offset,
+			 (off_t) file_io_handle->release_size,
+			 SYNC_FILE_RANGE_WAIT_BEFORE | SYNC_FILE_RANGE_WRITE | SYNC_FILE_RANGE_WAIT_AFTER );
+#endif
+			posix_fadvise(
+			 file_io_handle->file_descriptor,
+			 (off_t) file_io_handle->release_offset,
+			 (off_t) file_io_handle->release_size,
+			 POSIX_FADV_DONTNEED );
+		}
+		file_io_handle->release_offset = offset;
+		file_io_handle->release_size   = (size64_t) size;
+	}
+#endif /* defined( HAVE_POSIX_FADVISE ) */
+
+	return( 1 );
+}
+
+/* Writes the buffered data to the file
+ * With direct IO only whole aligned blocks are written unless flush all is set,
+ * the remainder is kept in the buffer. Data that is not aligned to a block
+ * is written without direct IO.
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_buffered_file_io_handle_flush(
+     libewf_buffered_file_io_handle_t *file_io_handle,
+     uint8_t flush_all,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_buffered_file_io_handle_flush";
+	size_t write_size     = 0;
+	uint8_t use_direct_io = 0;
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle->buffer_data_size == 0 )
+	{
+		return( 1 );
+	}
+#if defined( O_DIRECT )
+	use_direct_io = file_io_handle->direct_io_supported;
+
+	if( ( use_direct_io != 0 )
+	 && ( ( file_io_handle->buffer_offset % LIBEWF_SEGMENT_WRITE_BUFFER_ALIGNMENT ) != 0 ) )
+	{
+		/* Write the data up to the next block boundary without direct IO
+		 * so that the remainder of the buffer is aligned again
+		 */
+		write_size = (size_t) ( LIBEWF_SEGMENT_WRITE_BUFFER_ALIGNMENT - ( file_io_handle->buffer_offset % LIBEWF_SEGMENT_WRITE_BUFFER_ALIGNMENT ) );
+
+		if( write_size > file_io_handle->buffer_data_size )
+		{
+			write_size = file_io_handle->buffer_data_size;
+		}
+		if( libewf_buffered_file_io_handle_write_to_file(
+		     file_io_handle,
+		     file_io_handle->buffer,
+		     write_size,
+		     file_io_handle->buffer_offset,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write unaligned buffered data.",
+			 function );
+
+			return( -1 );
+		}
+		file_io_handle->buffer_offset    += write_size;
+		file_io_handle->buffer_data_size -= write_size;
+
+		if( file_io_handle->buffer_data_size > 0 )
+		{
+			/* The source and destination overlap
+			 */
+			memmove(
+			 file_io_handle->buffer,
+			 &( file_io_handle->buffer[ write_size ] ),
+			 file_io_handle->buffer_data_size );
+		}
+	}
+	if( use_direct_io != 0 )
+	{
+		write_size = file_io_handle->buffer_data_size - ( file_io_handle->buffer_data_size % LIBEWF_SEGMENT_WRITE_BUFFER_ALIGNMENT );
+	}
+	else
+#endif /* defined( O_DIRECT ) */
+	{
+		write_size = file_io_handle->buffer_data_size;
+	}
+	if( write_size > 0 )
+	{
+		if( libewf_buffered_file_io_handle_write_to_file(
+		     file_io_handle,
+		     file_io_handle->buffer,
+		     write_size,
+		     file_io_handle->buffer_offset,
+		     use_direct_io,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write buffered data.",
+			 function );
+
+			return( -1 );
+		}
+		file_io_handle->buffer_offset    += write_size;
+		file_io_handle->buffer_data_size -= write_size;
+
+		if( file_io_handle->buffer_data_size > 0 )
+		{
+			/* The source and destination overlap
+			 */
+			memmove(
+			 file_io_handle->buffer,
+			 &( file_io_handle->buffer[ write_size ] ),
+			 file_io_handle->buffer_data_size );
+		}
+	}
+	if( ( flush_all != 0 )
+	 && ( file_io_handle->buffer_data_size > 0 ) )
+	{
+		if( libewf_buffered_file_io_handle_write_to_file(
+		     file_io_handle,
+		     file_io_handle->buffer,
+		     file_io_handle->buffer_data_size,
+		     file_io_handle->buffer_offset,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write remaining buffered data.",
+			 function );
+
+			return( -1 );
+		}
+		file_io_handle->buffer_offset   += file_io_handle->buffer_data_size;
+		file_io_handle->buffer_data_size = 0;
+	}
+	return( 1 );
+}
+
+/* Reads a buffer from the buffered file IO handle
+ * The buffered data is written first so that it can be read back
+ * Returns the number of bytes read if successful, or -1 on error
+ */
+ssize_t libewf_buffered_file_io_handle_read(
+         libewf_buffered_file_io_handle_t *file_io_handle,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_buffered_file_io_handle_read";
+	size_t buffer_offset  = 0;
+	ssize_t read_count    = 0;
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle->file_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file IO handle - file not open.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_buffered_file_io_handle_flush(
+	     file_io_handle,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to flush write buffer.",
+		 function );
+
+		return( -1 );
+	}
+	/* The read buffer is not necessarily aligned
+	 */
+	if( libewf_buffered_file_io_handle_set_direct_io(
+	     file_io_handle,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set direct IO.",
+		 function );
+
+		return( -1 );
+	}
+	while( buffer_offset < size )
+	{
+		read_count = pread(
+		              file_io_handle->file_descriptor,
+		              &( buffer[ buffer_offset ] ),
+		              size - buffer_offset,
+		              (off_t) ( file_io_handle->current_offset + buffer_offset ) );
+
+		if( read_count == -1 )
+		{
+			if( errno == EINTR )
+			{
+				continue;
+			}
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 errno,
+			 "%s: unable to read from file.",
+			 function );
+
+			return( -1 );
+		}
+		if( read_count == 0 )
+		{
+			break;
+		}
+		buffer_offset += (size_t) read_count;
+	}
+	file_io_handle->current_offset += buffer_offset;
+
+	return( (ssize_t) buffer_offset );
+}
+
+/* Writes a buffer to the buffered file IO handle
+ * Data that is written contiguous to the buffered data is appended to the buffer,
+ * otherwise the buffered data is written first
+ * Returns the number of bytes written if successful, or -1 on error
+ */
+ssize_t libewf_buffered_file_io_handle_write(
+         libewf_buffered_file_io_handle_t *file_io_handle,
+         const uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_buffered_file_io_handle_write";
+	size_t buffer_offset  = 0;
+	size_t copy_size      = 0;
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle->file_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file IO handle - file not open.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( file_io_handle->access_flags & LIBBFIO_ACCESS_FLAG_WRITE ) == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid file IO handle - file not opened for writing.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle->buffer == NULL )
+	{
+#if defined( HAVE_POSIX_MEMALIGN )
+		if( posix_memalign(
+		     (void **) &( file_io_handle->buffer ),
+		     LIBEWF_SEGMENT_WRITE_BUFFER_ALIGNMENT,
+		     file_io_handle->buffer_size ) != 0 )
+		{
+			file_io_handle->buffer = NULL;
+		}
+#else
+		file_io_handle->buffer = (uint8_t *) memory_allocate(
+		                                      sizeof( uint8_t ) * file_io_handle->buffer_size );
+#endif
+		if( file_io_handle->buffer == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create write buffer.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( ( file_io_handle->buffer_data_size > 0 )
+	 && ( file_io_handle->current_offset != (off64_t) ( file_io_handle->buffer_offset + file_io_handle->buffer_data_size ) ) )
+	{
+		if( libewf_buffered_file_io_handle_flush(
+		     file_io_handle,
+		     1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to flush write buffer.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( file_io_handle->buffer_data_size == 0 )
+	{
+		file_io_handle->buffer_offset = file_io_handle->current_offset;
+	}
+	while( buffer_offset < size )
+	{
+		copy_size = file_io_handle->buffer_size - file_io_handle->buffer_data_size;
+
+		if( copy_size > ( size - buffer_offset ) )
+		{
+			copy_size = size - buffer_offset;
+		}
+		if( memory_copy(
+		     &( file_io_handle->buffer[ file_io_handle->buffer_data_size ] ),
+		     &( buffer[ buffer_offset ] ),
+		     copy_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy data to write buffer.",
+			 function );
+
+			return( -1 );
+		}
+		file_io_handle->buffer_data_size += copy_size;
+		buffer_offset                    += copy_size;
+
+		if( file_io_handle->buffer_data_size == file_io_handle->buffer_size )
+		{
+			if( libewf_buffered_file_io_handle_flush(
+			     file_io_handle,
+			     0,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to flush write buffer.",
+				 function );
+
+				return( -1 );
+			}
+		}
+	}
+	file_io_handle->current_offset += size;
+
+	return( (ssize_t) size );
+}
+
+/* Seeks a certain offset within the buffered file IO handle
+ * The buffered data is not written until data is written or read at another offset
+ * Returns the offset if the seek is successful or -1 on error
+ */
+off64_t libewf_buffered_file_io_handle_seek_offset(
+         libewf_buffered_file_io_handle_t *file_io_handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	static char *function = "libewf_buffered_file_io_handle_seek_offset";
+	size64_t size         = 0;
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle->file_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file IO handle - file not open.",
+		 function );
+
+		return( -1 );
+	}
+	if( whence == SEEK_CUR )
+	{
+		offset += file_io_handle->current_offset;
+	}
+	else if( whence == SEEK_END )
+	{
+		if( libewf_buffered_file_io_handle_get_size(
+		     file_io_handle,
+		     &size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve size.",
+			 function );
+
+			return( -1 );
+		}
+		offset += (off64_t) size;
+	}
+	else if( whence != SEEK_SET )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported whence.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	file_io_handle->current_offset = offset;
+
+	return( offset );
+}
+
+/* Function to determine if a file exists
+ * Returns 1 if file exists, 0 if not or -1 on error
+ */
+int libewf_buffered_file_io_handle_exists(
+     libewf_buffered_file_io_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_buffered_file_io_handle_exists";
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle->name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file IO handle - missing name.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle->file_descriptor != -1 )
+	{
+		return( 1 );
+	}
+	if( access(
+	     file_io_handle->name,
+	     F_OK ) != 0 )
+	{
+		if( errno == ENOENT )
+		{
+			return( 0 );
+		}
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 errno,
+		 "%s: unable to determine if file: %s exists.",
+		 function,
+		 file_io_handle->name );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Check if the file is open
+ * Returns 1 if open, 0 if not or -1 on error
+ */
+int libewf_buffered_file_io_handle_is_open(
+     libewf_buffered_file_io_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_buffered_file_io_handle_is_open";
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle->file_descriptor == -1 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the file size, including the buffered data
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_buffered_file_io_handle_get_size(
+     libewf_buffered_file_io_handle_t *file_io_handle,
+     size64_t *size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_buffered_file_io_handle_get_size";
+	size64_t buffer_end   = 0;
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle->file_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file IO handle - file not open.",
+		 function );
+
+		return( -1 );
+	}
+	if( size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid size.",
+		 function );
+
+		return( -1 );
+	}
+	buffer_end = (size64_t) file_io_handle->buffer_offset + file_io_handle->buffer_data_size;
+
+	if( buffer_end > file_io_handle->size )
+	{
+		*size = buffer_end;
+	}
+	else
+	{
+		*size = file_io_handle->size;
+	}
+	return( 1 );
+}
+
+#endif /* defined( LIBEWF_HAVE_BUFFERED_FILE_IO ) */
+
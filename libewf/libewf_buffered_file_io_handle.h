@@ -0,0 +1,219 @@
+/*
+ * Buffered file IO handle functions used to write segment files
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_BUFFERED_FILE_IO_HANDLE_H )
+#define _LIBEWF_BUFFERED_FILE_IO_HANDLE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libbfio.h"
+#include "libewf_libcerror.h"
+
+#if defined( HAVE_FCNTL_H ) && defined( HAVE_UNISTD_H ) && !defined( WINAPI ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+#define LIBEWF_HAVE_BUFFERED_FILE_IO	1
+#endif
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( LIBEWF_HAVE_BUFFERED_FILE_IO )
+
+typedef struct libewf_buffered_file_io_handle libewf_buffered_file_io_handle_t;
+
+struct libewf_buffered_file_io_handle
+{
+	/* The name
+	 */
+	char *name;
+
+	/* The name size
+	 */
+	size_t name_size;
+
+	/* The file descriptor
+	 */
+	int file_descriptor;
+
+	/* The access flags
+	 */
+	int access_flags;
+
+	/* The write flags
+	 */
+	uint8_t write_flags;
+
+	/* Value to indicate the file was opened with direct IO
+	 */
+	uint8_t direct_io_supported;
+
+	/* Value to indicate the file descriptor currently bypasses the page cache
+	 */
+	uint8_t direct_io_enabled;
+
+	/* The write buffer
+	 */
+	uint8_t *buffer;
+
+	/* The write buffer size
+	 */
+	size_t buffer_size;
+
+	/* The size of the data in the write buffer
+	 */
+	size_t buffer_data_size;
+
+	/* The file offset of the data in the write buffer
+	 */
+	off64_t buffer_offset;
+
+	/* The current offset
+	 */
+	off64_t current_offset;
+
+	/* The size of the file, excluding data that is still buffered
+	 */
+	size64_t size;
+
+	/* The offset of the range that was last written to the file
+	 * and of which the cached pages have not yet been released
+	 */
+	off64_t release_offset;
+
+	/* The size of the range that was last written to the file
+	 */
+	size64_t release_size;
+
+	/* The size to pre-allocate when the file is created
+	 */
+	size64_t preallocation_size;
+
+	/* Value to indicate the file was pre-allocated and must be truncated on close
+	 */
+	uint8_t is_preallocated;
+};
+
+int libewf_buffered_file_io_handle_initialize(
+     libewf_buffered_file_io_handle_t **file_io_handle,
+     size_t buffer_size,
+     uint8_t write_flags,
+     libcerror_error_t **error );
+
+int libewf_buffered_file_initialize(
+     libbfio_handle_t **handle,
+     const char *name,
+     size_t name_size,
+     size_t buffer_size,
+     uint8_t write_flags,
+     size64_t preallocation_size,
+     libcerror_error_t **error );
+
+int libewf_buffered_file_io_handle_free(
+     libewf_buffered_file_io_handle_t **file_io_handle,
+     libcerror_error_t **error );
+
+int libewf_buffered_file_io_handle_clone(
+     libewf_buffered_file_io_handle_t **destination_file_io_handle,
+     libewf_buffered_file_io_handle_t *source_file_io_handle,
+     libcerror_error_t **error );
+
+int libewf_buffered_file_io_handle_set_name(
+     libewf_buffered_file_io_handle_t *file_io_handle,
+     const char *name,
+     size_t name_size,
+     libcerror_error_t **error );
+
+int libewf_buffered_file_io_handle_set_preallocation_size(
+     libewf_buffered_file_io_handle_t *file_io_handle,
+     size64_t preallocation_size,
+     libcerror_error_t **error );
+
+int libewf_buffered_file_io_handle_preallocate(
+     libewf_buffered_file_io_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+int libewf_buffered_file_io_handle_open(
+     libewf_buffered_file_io_handle_t *file_io_handle,
+     int access_flags,
+     libcerror_error_t **error );
+
+int libewf_buffered_file_io_handle_close(
+     libewf_buffered_file_io_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+int libewf_buffered_file_io_handle_set_direct_io(
+     libewf_buffered_file_io_handle_t *file_io_handle,
+     uint8_t enable_direct_io,
+     libcerror_error_t **error );
+
+int libewf_buffered_file_io_handle_write_to_file(
+     libewf_buffered_file_io_handle_t *file_io_handle,
+     const uint8_t *buffer,
+     size_t size,
+     off64_t offset,
+     uint8_t use_direct_io,
+     libcerror_error_t **error );
+
+int libewf_buffered_file_io_handle_flush(
+     libewf_buffered_file_io_handle_t *file_io_handle,
+     uint8_t flush_all,
+     libcerror_error_t **error );
+
+ssize_t libewf_buffered_file_io_handle_read(
+         libewf_buffered_file_io_handle_t *file_io_handle,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error );
+
+ssize_t libewf_buffered_file_io_handle_write(
+         libewf_buffered_file_io_handle_t *file_io_handle,
+         const uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error );
+
+off64_t libewf_buffered_file_io_handle_seek_offset(
+         libewf_buffered_file_io_handle_t *file_io_handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error );
+
+int libewf_buffered_file_io_handle_exists(
+     libewf_buffered_file_io_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+int libewf_buffered_file_io_handle_is_open(
+     libewf_buffered_file_io_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+int libewf_buffered_file_io_handle_get_size(
+     libewf_buffered_file_io_handle_t *file_io_handle,
+     size64_t *size,
+     libcerror_error_t **error );
+
+#endif /* defined( LIBEWF_HAVE_BUFFERED_FILE_IO ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_BUFFERED_FILE_IO_HANDLE_H ) */
+
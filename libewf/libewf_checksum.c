@@ -27,6 +27,7 @@
 #include <zlib.h>
 #endif
 
+#include "libewf_adler32.h"
 #include "libewf_checksum.h"
 #include "libewf_libcerror.h"
 #include "libewf_types.h"
@@ -79,6 +80,16 @@ int libewf_checksum_calculate_adler32(
 
 		return( -1 );
 	}
+	/* The SIMD kernels are faster than the zlib implementation
+	 */
+	if( libewf_adler32_calculate_simd(
+	     checksum_value,
+	     buffer,
+	     size,
+	     initial_value ) == 1 )
+	{
+		return( 1 );
+	}
 	*checksum_value = adler32(
 	                   (uLong) initial_value,
 	                   (const Bytef *) buffer,
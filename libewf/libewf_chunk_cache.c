@@ -0,0 +1,1313 @@
+/*
+ * Chunk cache functions
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_chunk_cache.h"
+#include "libewf_chunk_data.h"
+#include "libewf_definitions.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+
+/* Creates a chunk cache
+ * Make sure the value chunk_cache is referencing, is set to NULL
+ *
+ * The cache is divided into shards that are selected by chunk index,
+ * each shard has its own lock so that concurrent readers of different
+ * chunks do not contend with each other
+ *
+ * The maximum cache size is the memory size of the cached chunk data
+ * that is divided over the shards, the chunk size is used to determine
+ * the number of entries of a shard
+ *
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_initialize(
+     libewf_chunk_cache_t **chunk_cache,
+     size64_t maximum_cache_size,
+     size32_t chunk_size,
+     libcerror_error_t **error )
+{
+	libewf_chunk_cache_shard_t *shard    = NULL;
+	static char *function                = "libewf_chunk_cache_initialize";
+	size64_t maximum_number_of_chunks    = 0;
+	size64_t maximum_shard_size          = 0;
+	int bucket_index                     = 0;
+	int maximum_number_of_shard_entries  = 0;
+	int number_of_buckets                = 0;
+	int number_of_shards                 = 0;
+	int shard_index                      = 0;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_cache != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid chunk cache value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_cache_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum cache size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid chunk size value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	maximum_number_of_chunks = maximum_cache_size / chunk_size;
+
+	if( maximum_number_of_chunks > (size64_t) ( INT_MAX / 4 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum cache size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_shards = LIBEWF_CHUNK_CACHE_NUMBER_OF_SHARDS;
+
+	if( maximum_number_of_chunks < (size64_t) number_of_shards )
+	{
+		number_of_shards = (int) maximum_number_of_chunks;
+	}
+	if( number_of_shards == 0 )
+	{
+		number_of_shards = 1;
+	}
+	maximum_shard_size = maximum_cache_size / number_of_shards;
+
+	/* Reserve an additional entry for chunks that are smaller than the chunk size
+	 */
+	maximum_number_of_shard_entries = (int) ( maximum_shard_size / chunk_size ) + 1;
+
+	number_of_buckets = 1;
+
+	while( number_of_buckets < maximum_number_of_shard_entries )
+	{
+		number_of_buckets <<= 1;
+	}
+	*chunk_cache = memory_allocate_structure(
+	                libewf_chunk_cache_t );
+
+	if( *chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create chunk cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *chunk_cache,
+	     0,
+	     sizeof( libewf_chunk_cache_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear chunk cache.",
+		 function );
+
+		memory_free(
+		 *chunk_cache );
+
+		*chunk_cache = NULL;
+
+		return( -1 );
+	}
+	( *chunk_cache )->shards = (libewf_chunk_cache_shard_t *) memory_allocate(
+	                                                           sizeof( libewf_chunk_cache_shard_t ) * number_of_shards );
+
+	if( ( *chunk_cache )->shards == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create shards.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *chunk_cache )->shards,
+	     0,
+	     sizeof( libewf_chunk_cache_shard_t ) * number_of_shards ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear shards.",
+		 function );
+
+		memory_free(
+		 ( *chunk_cache )->shards );
+
+		( *chunk_cache )->shards = NULL;
+
+		goto on_error;
+	}
+	( *chunk_cache )->number_of_shards = number_of_shards;
+	( *chunk_cache )->maximum_size     = maximum_cache_size;
+
+	for( shard_index = 0;
+	     shard_index < number_of_shards;
+	     shard_index++ )
+	{
+		shard = &( ( ( *chunk_cache )->shards )[ shard_index ] );
+
+		shard->entries = (libewf_chunk_cache_entry_t *) memory_allocate(
+		                                                 sizeof( libewf_chunk_cache_entry_t ) * maximum_number_of_shard_entries );
+
+		if( shard->entries == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create shard: %d entries.",
+			 function,
+			 shard_index );
+
+			goto on_error;
+		}
+		shard->buckets = (int *) memory_allocate(
+		                          sizeof( int ) * number_of_buckets );
+
+		if( shard->buckets == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create shard: %d buckets.",
+			 function,
+			 shard_index );
+
+			goto on_error;
+		}
+		for( bucket_index = 0;
+		     bucket_index < number_of_buckets;
+		     bucket_index++ )
+		{
+			shard->buckets[ bucket_index ] = -1;
+		}
+		shard->maximum_number_of_entries = maximum_number_of_shard_entries;
+		shard->number_of_buckets         = number_of_buckets;
+		shard->first_entry_index         = -1;
+		shard->last_entry_index          = -1;
+		shard->free_entry_index          = -1;
+		shard->maximum_size              = maximum_shard_size;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_initialize(
+		     &( shard->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize shard: %d mutex.",
+			 function,
+			 shard_index );
+
+			goto on_error;
+		}
+#endif
+	}
+	return( 1 );
+
+on_error:
+	if( *chunk_cache != NULL )
+	{
+		libewf_chunk_cache_free(
+		 chunk_cache,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees a chunk cache
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_free(
+     libewf_chunk_cache_t **chunk_cache,
+     libcerror_error_t **error )
+{
+	libewf_chunk_cache_shard_t *shard = NULL;
+	static char *function             = "libewf_chunk_cache_free";
+	int entry_index                   = 0;
+	int result                        = 1;
+	int shard_index                   = 0;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_cache != NULL )
+	{
+		if( ( *chunk_cache )->shards != NULL )
+		{
+			for( shard_index = 0;
+			     shard_index < ( *chunk_cache )->number_of_shards;
+			     shard_index++ )
+			{
+				shard = &( ( ( *chunk_cache )->shards )[ shard_index ] );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+				if( shard->mutex != NULL )
+				{
+					if( libcthreads_mutex_free(
+					     &( shard->mutex ),
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+						 "%s: unable to free shard: %d mutex.",
+						 function,
+						 shard_index );
+
+						result = -1;
+					}
+				}
+#endif
+				if( shard->entries != NULL )
+				{
+					for( entry_index = 0;
+					     entry_index < shard->number_of_entries;
+					     entry_index++ )
+					{
+						if( libewf_chunk_data_free(
+						     &( shard->entries[ entry_index ].chunk_data ),
+						     error ) != 1 )
+						{
+							libcerror_error_set(
+							 error,
+							 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+							 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+							 "%s: unable to free shard: %d entry: %d chunk data.",
+							 function,
+							 shard_index,
+							 entry_index );
+
+							result = -1;
+						}
+					}
+					memory_free(
+					 shard->entries );
+				}
+				if( shard->buckets != NULL )
+				{
+					memory_free(
+					 shard->buckets );
+				}
+			}
+			memory_free(
+			 ( *chunk_cache )->shards );
+		}
+		memory_free(
+		 *chunk_cache );
+
+		*chunk_cache = NULL;
+	}
+	return( result );
+}
+
+/* Empties a chunk cache shard
+ * This function is not multi-thread safe acquire the shard mutex before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_shard_empty(
+     libewf_chunk_cache_shard_t *shard,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_cache_shard_empty";
+	int bucket_index      = 0;
+	int entry_index       = 0;
+	int result            = 1;
+
+	if( shard == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid shard.",
+		 function );
+
+		return( -1 );
+	}
+	for( entry_index = 0;
+	     entry_index < shard->number_of_entries;
+	     entry_index++ )
+	{
+		if( libewf_chunk_data_free(
+		     &( shard->entries[ entry_index ].chunk_data ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free entry: %d chunk data.",
+			 function,
+			 entry_index );
+
+			result = -1;
+		}
+	}
+	for( bucket_index = 0;
+	     bucket_index < shard->number_of_buckets;
+	     bucket_index++ )
+	{
+		shard->buckets[ bucket_index ] = -1;
+	}
+	shard->number_of_entries = 0;
+	shard->first_entry_index = -1;
+	shard->last_entry_index  = -1;
+	shard->free_entry_index  = -1;
+	shard->size              = 0;
+
+	return( result );
+}
+
+/* Empties a chunk cache
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_empty(
+     libewf_chunk_cache_t *chunk_cache,
+     libcerror_error_t **error )
+{
+	libewf_chunk_cache_shard_t *shard = NULL;
+	static char *function             = "libewf_chunk_cache_empty";
+	int result                        = 1;
+	int shard_index                   = 0;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	for( shard_index = 0;
+	     shard_index < chunk_cache->number_of_shards;
+	     shard_index++ )
+	{
+		shard = &( ( chunk_cache->shards )[ shard_index ] );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_grab(
+		     shard->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab shard: %d mutex.",
+			 function,
+			 shard_index );
+
+			return( -1 );
+		}
+#endif
+		if( libewf_chunk_cache_shard_empty(
+		     shard,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to empty shard: %d.",
+			 function,
+			 shard_index );
+
+			result = -1;
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_release(
+		     shard->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release shard: %d mutex.",
+			 function,
+			 shard_index );
+
+			return( -1 );
+		}
+#endif
+	}
+	return( result );
+}
+
+/* Retrieves the chunk cache statistics
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_get_statistics(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     libcerror_error_t **error )
+{
+	libewf_chunk_cache_shard_t *shard = NULL;
+	static char *function             = "libewf_chunk_cache_get_statistics";
+	uint64_t safe_number_of_hits      = 0;
+	uint64_t safe_number_of_misses    = 0;
+	int shard_index                   = 0;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_hits == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of hits.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_misses == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of misses.",
+		 function );
+
+		return( -1 );
+	}
+	for( shard_index = 0;
+	     shard_index < chunk_cache->number_of_shards;
+	     shard_index++ )
+	{
+		shard = &( ( chunk_cache->shards )[ shard_index ] );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_grab(
+		     shard->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab shard: %d mutex.",
+			 function,
+			 shard_index );
+
+			return( -1 );
+		}
+#endif
+		safe_number_of_hits   += shard->number_of_hits;
+		safe_number_of_misses += shard->number_of_misses;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_release(
+		     shard->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release shard: %d mutex.",
+			 function,
+			 shard_index );
+
+			return( -1 );
+		}
+#endif
+	}
+	*number_of_hits   = safe_number_of_hits;
+	*number_of_misses = safe_number_of_misses;
+
+	return( 1 );
+}
+
+/* Determines the memory size of chunk data
+ * Unpacked compressed chunk data retains the buffer of the compressed data
+ * Returns the memory size
+ */
+size_t libewf_chunk_cache_get_chunk_data_memory_size(
+        libewf_chunk_data_t *chunk_data )
+{
+	size_t memory_size = 0;
+
+	if( chunk_data != NULL )
+	{
+		memory_size = sizeof( libewf_chunk_data_t ) + chunk_data->allocated_data_size;
+
+		if( chunk_data->compressed_data != NULL )
+		{
+			memory_size += chunk_data->allocated_compressed_data_size;
+		}
+		if( chunk_data->spare_data != NULL )
+		{
+			memory_size += chunk_data->allocated_spare_data_size;
+		}
+	}
+	return( memory_size );
+}
+
+/* Retrieves the index of the entry of a specific chunk in a chunk cache shard
+ * This function is not multi-thread safe acquire the shard mutex before call
+ * Returns 1 if successful, 0 if no such entry or -1 on error
+ */
+int libewf_chunk_cache_shard_get_entry_index(
+     libewf_chunk_cache_shard_t *shard,
+     int bucket_index,
+     uint64_t chunk_index,
+     int *entry_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_cache_shard_get_entry_index";
+	int safe_entry_index  = 0;
+
+	if( shard == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid shard.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( bucket_index < 0 )
+	 || ( bucket_index >= shard->number_of_buckets ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid bucket index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry index.",
+		 function );
+
+		return( -1 );
+	}
+	safe_entry_index = shard->buckets[ bucket_index ];
+
+	while( safe_entry_index != -1 )
+	{
+		if( shard->entries[ safe_entry_index ].chunk_index == chunk_index )
+		{
+			*entry_index = safe_entry_index;
+
+			return( 1 );
+		}
+		safe_entry_index = shard->entries[ safe_entry_index ].next_bucket_entry_index;
+	}
+	return( 0 );
+}
+
+/* Moves an entry to the front of the most recently used list of a chunk cache shard
+ * This function is not multi-thread safe acquire the shard mutex before call
+ */
+void libewf_chunk_cache_shard_touch_entry(
+      libewf_chunk_cache_shard_t *shard,
+      int entry_index )
+{
+	libewf_chunk_cache_entry_t *entry = NULL;
+
+	if( shard->first_entry_index == entry_index )
+	{
+		return;
+	}
+	entry = &( shard->entries[ entry_index ] );
+
+	/* Unlink the entry
+	 */
+	if( entry->previous_entry_index != -1 )
+	{
+		shard->entries[ entry->previous_entry_index ].next_entry_index = entry->next_entry_index;
+	}
+	if( entry->next_entry_index != -1 )
+	{
+		shard->entries[ entry->next_entry_index ].previous_entry_index = entry->previous_entry_index;
+	}
+	if( shard->last_entry_index == entry_index )
+	{
+		shard->last_entry_index = entry->previous_entry_index;
+	}
+	/* Link the entry at the front
+	 */
+	entry->previous_entry_index = -1;
+	entry->next_entry_index     = shard->first_entry_index;
+
+	if( shard->first_entry_index != -1 )
+	{
+		shard->entries[ shard->first_entry_index ].previous_entry_index = entry_index;
+	}
+	shard->first_entry_index = entry_index;
+
+	if( shard->last_entry_index == -1 )
+	{
+		shard->last_entry_index = entry_index;
+	}
+}
+
+/* Removes an entry from the hash bucket of a chunk cache shard
+ * This function is not multi-thread safe acquire the shard mutex before call
+ */
+void libewf_chunk_cache_shard_remove_bucket_entry(
+      libewf_chunk_cache_shard_t *shard,
+      int bucket_index,
+      int entry_index )
+{
+	int *next_entry_index = NULL;
+
+	next_entry_index = &( shard->buckets[ bucket_index ] );
+
+	while( *next_entry_index != -1 )
+	{
+		if( *next_entry_index == entry_index )
+		{
+			*next_entry_index = shard->entries[ entry_index ].next_bucket_entry_index;
+
+			break;
+		}
+		next_entry_index = &( shard->entries[ *next_entry_index ].next_bucket_entry_index );
+	}
+	shard->entries[ entry_index ].next_bucket_entry_index = -1;
+}
+
+/* Removes the least recently used entry of a chunk cache shard
+ * The chunk data of the entry is freed and the entry is added to the unused entries
+ * This function is not multi-thread safe acquire the shard mutex before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_shard_remove_last_entry(
+     libewf_chunk_cache_shard_t *shard,
+     int number_of_shards,
+     libcerror_error_t **error )
+{
+	libewf_chunk_cache_entry_t *entry = NULL;
+	static char *function             = "libewf_chunk_cache_shard_remove_last_entry";
+	int entry_index                   = 0;
+
+	if( shard == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid shard.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_shards <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid number of shards value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	entry_index = shard->last_entry_index;
+
+	if( entry_index == -1 )
+	{
+		return( 1 );
+	}
+	entry = &( shard->entries[ entry_index ] );
+
+	libewf_chunk_cache_shard_remove_bucket_entry(
+	 shard,
+	 (int) ( ( entry->chunk_index / number_of_shards ) & ( shard->number_of_buckets - 1 ) ),
+	 entry_index );
+
+	shard->last_entry_index = entry->previous_entry_index;
+
+	if( shard->last_entry_index != -1 )
+	{
+		shard->entries[ shard->last_entry_index ].next_entry_index = -1;
+	}
+	else
+	{
+		shard->first_entry_index = -1;
+	}
+	shard->size -= entry->memory_size;
+
+	entry->previous_entry_index = -1;
+	entry->next_entry_index     = shard->free_entry_index;
+	entry->memory_size          = 0;
+
+	shard->free_entry_index = entry_index;
+
+	if( libewf_chunk_data_free(
+	     &( entry->chunk_data ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free entry: %d chunk data.",
+		 function,
+		 entry_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Determines if a specific chunk is cached
+ * This function does not update the cache statistics or the most recently used entry
+ * Returns 1 if cached, 0 if not or -1 on error
+ */
+int libewf_chunk_cache_chunk_exists(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t chunk_index,
+     libcerror_error_t **error )
+{
+	libewf_chunk_cache_shard_t *shard = NULL;
+	static char *function             = "libewf_chunk_cache_chunk_exists";
+	int bucket_index                  = 0;
+	int entry_index                   = 0;
+	int result                        = 0;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	shard        = &( ( chunk_cache->shards )[ chunk_index % chunk_cache->number_of_shards ] );
+	bucket_index = (int) ( ( chunk_index / chunk_cache->number_of_shards ) & ( shard->number_of_buckets - 1 ) );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     shard->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab shard mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libewf_chunk_cache_shard_get_entry_index(
+	          shard,
+	          bucket_index,
+	          chunk_index,
+	          &entry_index,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve entry of chunk: %" PRIu64 ".",
+		 function,
+		 chunk_index );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     shard->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release shard mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Reads chunk data from the chunk cache
+ * The data is copied into the buffer while the shard is locked
+ * Returns 1 if successful, 0 if the chunk is not cached or -1 on error
+ */
+int libewf_chunk_cache_read_chunk_data(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t chunk_index,
+     size_t chunk_data_offset,
+     uint8_t *buffer,
+     size_t buffer_size,
+     size_t *read_size,
+     libcerror_error_t **error )
+{
+	libewf_chunk_cache_shard_t *shard = NULL;
+	libewf_chunk_data_t *chunk_data   = NULL;
+	static char *function             = "libewf_chunk_cache_read_chunk_data";
+	size_t safe_read_size             = 0;
+	int bucket_index                  = 0;
+	int entry_index                   = 0;
+	int result                        = 0;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read size.",
+		 function );
+
+		return( -1 );
+	}
+	shard        = &( ( chunk_cache->shards )[ chunk_index % chunk_cache->number_of_shards ] );
+	bucket_index = (int) ( ( chunk_index / chunk_cache->number_of_shards ) & ( shard->number_of_buckets - 1 ) );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     shard->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab shard mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libewf_chunk_cache_shard_get_entry_index(
+	          shard,
+	          bucket_index,
+	          chunk_index,
+	          &entry_index,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve entry of chunk: %" PRIu64 ".",
+		 function,
+		 chunk_index );
+
+		goto on_error;
+	}
+	else if( result != 0 )
+	{
+		chunk_data = shard->entries[ entry_index ].chunk_data;
+
+		if( chunk_data_offset < chunk_data->data_size )
+		{
+			safe_read_size = chunk_data->data_size - chunk_data_offset;
+
+			if( safe_read_size > buffer_size )
+			{
+				safe_read_size = buffer_size;
+			}
+			if( memory_copy(
+			     buffer,
+			     &( ( chunk_data->data )[ chunk_data_offset ] ),
+			     safe_read_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy chunk: %" PRIu64 " data to buffer.",
+				 function,
+				 chunk_index );
+
+				goto on_error;
+			}
+		}
+		libewf_chunk_cache_shard_touch_entry(
+		 shard,
+		 entry_index );
+
+		shard->number_of_hits += 1;
+	}
+	else
+	{
+		shard->number_of_misses += 1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     shard->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release shard mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*read_size = safe_read_size;
+
+	return( result );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_mutex_release(
+	 shard->mutex,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Sets chunk data in the chunk cache
+ * The chunk cache takes over management of the chunk data and sets chunk_data to NULL,
+ * if the chunk was already cached by another reader the chunk data is freed
+ * Least recently used entries are removed to keep the shard within its maximum size,
+ * a single chunk is always cached even if it exceeds the maximum size
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_cache_set_chunk_data(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t chunk_index,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error )
+{
+	libewf_chunk_cache_entry_t *entry = NULL;
+	libewf_chunk_cache_shard_t *shard = NULL;
+	libewf_chunk_data_t *free_data    = NULL;
+	static char *function             = "libewf_chunk_cache_set_chunk_data";
+	size_t memory_size                = 0;
+	int bucket_index                  = 0;
+	int entry_index                   = 0;
+	int result                        = 0;
+
+	if( chunk_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: missing chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	shard        = &( ( chunk_cache->shards )[ chunk_index % chunk_cache->number_of_shards ] );
+	bucket_index = (int) ( ( chunk_index / chunk_cache->number_of_shards ) & ( shard->number_of_buckets - 1 ) );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     shard->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab shard mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libewf_chunk_cache_shard_get_entry_index(
+	          shard,
+	          bucket_index,
+	          chunk_index,
+	          &entry_index,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve entry of chunk: %" PRIu64 ".",
+		 function,
+		 chunk_index );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		libcthreads_mutex_release(
+		 shard->mutex,
+		 NULL );
+#endif
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		/* Another reader already cached the chunk
+		 */
+		free_data = *chunk_data;
+	}
+	else
+	{
+		memory_size = libewf_chunk_cache_get_chunk_data_memory_size(
+		               *chunk_data );
+
+		/* Remove the least recently used entries until the chunk data fits
+		 */
+		while( ( shard->last_entry_index != -1 )
+		    && ( ( ( shard->size + memory_size ) > shard->maximum_size )
+		      || ( ( shard->free_entry_index == -1 )
+		       &&  ( shard->number_of_entries >= shard->maximum_number_of_entries ) ) ) )
+		{
+			if( libewf_chunk_cache_shard_remove_last_entry(
+			     shard,
+			     chunk_cache->number_of_shards,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+				 "%s: unable to remove least recently used entry.",
+				 function );
+
+				result = -1;
+
+				break;
+			}
+		}
+		if( result == -1 )
+		{
+			free_data = *chunk_data;
+		}
+		else
+		{
+			if( shard->free_entry_index != -1 )
+			{
+				entry_index = shard->free_entry_index;
+
+				shard->free_entry_index = shard->entries[ entry_index ].next_entry_index;
+			}
+			else
+			{
+				entry_index = shard->number_of_entries;
+
+				shard->number_of_entries += 1;
+			}
+			entry = &( shard->entries[ entry_index ] );
+
+			entry->chunk_index             = chunk_index;
+			entry->chunk_data              = *chunk_data;
+			entry->memory_size             = memory_size;
+			entry->previous_entry_index    = -1;
+			entry->next_entry_index        = -1;
+			entry->next_bucket_entry_index = shard->buckets[ bucket_index ];
+
+			shard->buckets[ bucket_index ] = entry_index;
+			shard->size                   += memory_size;
+
+			libewf_chunk_cache_shard_touch_entry(
+			 shard,
+			 entry_index );
+		}
+	}
+	*chunk_data = NULL;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     shard->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release shard mutex.",
+		 function );
+
+		result = -1;
+	}
+#endif
+	/* Free the duplicate chunk data outside the lock
+	 */
+	if( free_data != NULL )
+	{
+		if( libewf_chunk_data_free(
+		     &free_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk data.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( result == -1 )
+	{
+		return( -1 );
+	}
+	return( 1 );
+}
+
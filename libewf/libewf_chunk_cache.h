@@ -0,0 +1,214 @@
+/*
+ * Chunk cache functions
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_CHUNK_CACHE_H )
+#define _LIBEWF_CHUNK_CACHE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_chunk_data.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_chunk_cache_entry libewf_chunk_cache_entry_t;
+
+struct libewf_chunk_cache_entry
+{
+	/* The chunk index
+	 */
+	uint64_t chunk_index;
+
+	/* The (unpacked) chunk data
+	 */
+	libewf_chunk_data_t *chunk_data;
+
+	/* The memory size of the chunk data
+	 */
+	size_t memory_size;
+
+	/* The index of the previous (more recently used) entry
+	 */
+	int previous_entry_index;
+
+	/* The index of the next (less recently used) entry
+	 */
+	int next_entry_index;
+
+	/* The index of the next entry in the same hash bucket
+	 */
+	int next_bucket_entry_index;
+};
+
+typedef struct libewf_chunk_cache_shard libewf_chunk_cache_shard_t;
+
+struct libewf_chunk_cache_shard
+{
+	/* The entries
+	 */
+	libewf_chunk_cache_entry_t *entries;
+
+	/* The maximum number of entries
+	 */
+	int maximum_number_of_entries;
+
+	/* The number of entries
+	 */
+	int number_of_entries;
+
+	/* The index of the first unused entry or -1
+	 */
+	int free_entry_index;
+
+	/* The maximum memory size of the cached chunk data
+	 */
+	size64_t maximum_size;
+
+	/* The memory size of the cached chunk data
+	 */
+	size64_t size;
+
+	/* The number of cache hits
+	 */
+	uint64_t number_of_hits;
+
+	/* The number of cache misses
+	 */
+	uint64_t number_of_misses;
+
+	/* The hash buckets, contains the index of the first entry or -1
+	 */
+	int *buckets;
+
+	/* The number of hash buckets, which is a power of 2
+	 */
+	int number_of_buckets;
+
+	/* The index of the most recently used entry
+	 */
+	int first_entry_index;
+
+	/* The index of the least recently used entry
+	 */
+	int last_entry_index;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+#endif
+};
+
+typedef struct libewf_chunk_cache libewf_chunk_cache_t;
+
+struct libewf_chunk_cache
+{
+	/* The shards
+	 */
+	libewf_chunk_cache_shard_t *shards;
+
+	/* The number of shards
+	 */
+	int number_of_shards;
+
+	/* The maximum memory size of the cached chunk data
+	 */
+	size64_t maximum_size;
+};
+
+int libewf_chunk_cache_initialize(
+     libewf_chunk_cache_t **chunk_cache,
+     size64_t maximum_cache_size,
+     size32_t chunk_size,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_free(
+     libewf_chunk_cache_t **chunk_cache,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_empty(
+     libewf_chunk_cache_t *chunk_cache,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_shard_empty(
+     libewf_chunk_cache_shard_t *shard,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_get_statistics(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     libcerror_error_t **error );
+
+size_t libewf_chunk_cache_get_chunk_data_memory_size(
+        libewf_chunk_data_t *chunk_data );
+
+int libewf_chunk_cache_shard_get_entry_index(
+     libewf_chunk_cache_shard_t *shard,
+     int bucket_index,
+     uint64_t chunk_index,
+     int *entry_index,
+     libcerror_error_t **error );
+
+void libewf_chunk_cache_shard_touch_entry(
+      libewf_chunk_cache_shard_t *shard,
+      int entry_index );
+
+void libewf_chunk_cache_shard_remove_bucket_entry(
+      libewf_chunk_cache_shard_t *shard,
+      int bucket_index,
+      int entry_index );
+
+int libewf_chunk_cache_shard_remove_last_entry(
+     libewf_chunk_cache_shard_t *shard,
+     int number_of_shards,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_chunk_exists(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t chunk_index,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_read_chunk_data(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t chunk_index,
+     size_t chunk_data_offset,
+     uint8_t *buffer,
+     size_t buffer_size,
+     size_t *read_size,
+     libcerror_error_t **error );
+
+int libewf_chunk_cache_set_chunk_data(
+     libewf_chunk_cache_t *chunk_cache,
+     uint64_t chunk_index,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_CHUNK_CACHE_H ) */
+
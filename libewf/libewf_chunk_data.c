@@ -24,6 +24,7 @@
 #include <memory.h>
 #include <types.h>
 
+#include "libewf_adler32.h"
 #include "libewf_checksum.h"
 #include "libewf_chunk_data.h"
 #include "libewf_compression.h"
@@ -32,6 +33,7 @@
 #include "libewf_libcerror.h"
 #include "libewf_libcnotify.h"
 #include "libewf_libfdata.h"
+#include "libewf_pattern_fill.h"
 #include "libewf_types.h"
 #include "libewf_unused.h"
 
@@ -223,6 +225,11 @@ int libewf_chunk_data_free(
 			memory_free(
 			 ( *chunk_data )->compressed_data );
 		}
+		if( ( *chunk_data )->spare_data != NULL )
+		{
+			memory_free(
+			 ( *chunk_data )->spare_data );
+		}
 		memory_free(
 		 *chunk_data );
 
@@ -302,8 +309,11 @@ int libewf_chunk_data_clone(
 
 		return( -1 );
 	}
-	( *destination_chunk_data )->data            = NULL;
-	( *destination_chunk_data )->compressed_data = NULL;
+	( *destination_chunk_data )->data                           = NULL;
+	( *destination_chunk_data )->compressed_data                = NULL;
+	( *destination_chunk_data )->allocated_compressed_data_size = 0;
+	( *destination_chunk_data )->spare_data                     = NULL;
+	( *destination_chunk_data )->allocated_spare_data_size      = 0;
 
 	if( source_chunk_data->data != NULL )
 	{
@@ -336,7 +346,10 @@ int libewf_chunk_data_clone(
 			goto on_error;
 		}
 	}
-	if( source_chunk_data->compressed_data != NULL )
+	/* The spare data is not cloned
+	 */
+	if( ( source_chunk_data->compressed_data != NULL )
+	 && ( source_chunk_data->compressed_data_size > 0 ) )
 	{
 		( *destination_chunk_data )->compressed_data = (uint8_t *) memory_allocate(
 		                                                            sizeof( uint8_t ) * source_chunk_data->compressed_data_size );
@@ -366,6 +379,7 @@ int libewf_chunk_data_clone(
 
 			goto on_error;
 		}
+		( *destination_chunk_data )->allocated_compressed_data_size = source_chunk_data->compressed_data_size;
 	}
 	return( 1 );
 
@@ -560,18 +574,25 @@ ssize_t libewf_chunk_data_write_buffer(
 
 /* Packs the chunk data
  * This function either adds the checksum or compresses the chunk data
+ * The IO handle is not modified, hence chunk data can be packed by multiple threads
  * Returns 1 if successful or -1 on error
  */
 int libewf_chunk_data_pack(
      libewf_chunk_data_t *chunk_data,
-     libewf_io_handle_t *io_handle,
+     const libewf_io_handle_t *io_handle,
+     int8_t compression_level,
      const uint8_t *compressed_zero_byte_empty_block,
      size_t compressed_zero_byte_empty_block_size,
      uint8_t pack_flags,
      libcerror_error_t **error )
 {
+	uint8_t fill_pattern_data[ 8 ];
+
 	static char *function            = "libewf_chunk_data_pack";
+	uint8_t *spare_data              = NULL;
+	size_t fill_pattern_prefix_size  = 0;
 	size_t safe_compressed_data_size = 0;
+	size_t spare_data_size           = 0;
 	uint64_t fill_pattern            = 0;
 	int result                       = 0;
 
@@ -631,27 +652,39 @@ int libewf_chunk_data_pack(
 	if( ( ( io_handle->compression_flags & LIBEWF_COMPRESS_FLAG_USE_EMPTY_BLOCK_COMPRESSION ) != 0 )
 	 || ( ( io_handle->compression_flags & LIBEWF_COMPRESS_FLAG_USE_PATTERN_FILL_COMPRESSION ) != 0 ) )
 	{
+		/* The size of the prefix of the data that matches the fill pattern is retained
+		 * so that the checksum calculation does not need to read the prefix again
+		 */
 		if( ( chunk_data->data_size % 8 ) == 0 )
 		{
-			result = libewf_chunk_data_check_for_64_bit_pattern_fill(
-				  chunk_data->data,
-				  chunk_data->data_size,
-				  &fill_pattern,
-				  error );
-
-			if( result == -1 )
+			if( chunk_data->data_size > 8 )
 			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to determine if chunk data contains a fill pattern.",
-				 function );
+				if( memory_copy(
+				     fill_pattern_data,
+				     chunk_data->data,
+				     8 ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+					 "%s: unable to copy fill pattern.",
+					 function );
 
-				goto on_error;
+					goto on_error;
+				}
+				fill_pattern_prefix_size = libewf_pattern_fill_get_prefix_size(
+				                            chunk_data->data,
+				                            chunk_data->data_size,
+				                            fill_pattern_data );
 			}
-			else if( result != 0 )
+			if( ( fill_pattern_prefix_size != 0 )
+			 && ( fill_pattern_prefix_size == chunk_data->data_size ) )
 			{
+				byte_stream_copy_to_uint64_little_endian(
+				 fill_pattern_data,
+				 fill_pattern );
+
 				if( ( ( io_handle->compression_flags & LIBEWF_COMPRESS_FLAG_USE_PATTERN_FILL_COMPRESSION ) != 0 )
 				 || ( fill_pattern == 0 ) )
 				{
@@ -670,25 +703,28 @@ int libewf_chunk_data_pack(
 			}
 		}
 		else if( ( ( io_handle->compression_flags & LIBEWF_COMPRESS_FLAG_USE_EMPTY_BLOCK_COMPRESSION ) != 0 )
-		      || ( io_handle->compression_level != LIBEWF_COMPRESSION_NONE ) )
+		      || ( compression_level != LIBEWF_COMPRESSION_NONE ) )
 		{
-			result = libewf_chunk_data_check_for_empty_block(
-				  chunk_data->data,
-				  chunk_data->data_size,
-				  error );
-
-			if( result == -1 )
+			if( memory_set(
+			     fill_pattern_data,
+			     chunk_data->data[ 0 ],
+			     8 ) == NULL )
 			{
 				libcerror_error_set(
 				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to determine if chunk data is an empty block.",
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+				 "%s: unable to set fill pattern.",
 				 function );
 
 				goto on_error;
 			}
-			else if( result != 0 )
+			fill_pattern_prefix_size = libewf_pattern_fill_get_prefix_size(
+			                            chunk_data->data,
+			                            chunk_data->data_size,
+			                            fill_pattern_data );
+
+			if( fill_pattern_prefix_size == chunk_data->data_size )
 			{
 				if( chunk_data->data[ 0 ] == 0 )
 				{
@@ -703,7 +739,7 @@ int libewf_chunk_data_pack(
 	 */
 	chunk_data->range_flags = 0;
 
-	if( ( io_handle->compression_level != LIBEWF_COMPRESSION_NONE )
+	if( ( compression_level != LIBEWF_COMPRESSION_NONE )
 	 || ( ( pack_flags & LIBEWF_PACK_FLAG_FORCE_COMPRESSION ) != 0 ) )
 	{
 		if( ( pack_flags & LIBEWF_PACK_FLAG_FORCE_COMPRESSION ) == 0 )
@@ -731,19 +767,43 @@ int libewf_chunk_data_pack(
 		{
 			chunk_data->compressed_data_size = 2 * chunk_data->chunk_size;
 		}
-		chunk_data->compressed_data = (uint8_t *) memory_allocate(
-		                                           sizeof( uint8_t ) * chunk_data->compressed_data_size );
+		/* Reuse the spare data buffer of a previous chunk when it is large enough
+		 */
+		if( ( chunk_data->compressed_data == NULL )
+		 && ( chunk_data->spare_data != NULL ) )
+		{
+			chunk_data->compressed_data                = chunk_data->spare_data;
+			chunk_data->allocated_compressed_data_size = chunk_data->allocated_spare_data_size;
+
+			chunk_data->spare_data                = NULL;
+			chunk_data->allocated_spare_data_size = 0;
+		}
+		if( ( chunk_data->compressed_data != NULL )
+		 && ( chunk_data->allocated_compressed_data_size < chunk_data->compressed_data_size ) )
+		{
+			memory_free(
+			 chunk_data->compressed_data );
 
+			chunk_data->compressed_data                = NULL;
+			chunk_data->allocated_compressed_data_size = 0;
+		}
 		if( chunk_data->compressed_data == NULL )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-			 "%s: unable to create compressed data.",
-			 function );
+			chunk_data->compressed_data = (uint8_t *) memory_allocate(
+			                                           sizeof( uint8_t ) * chunk_data->compressed_data_size );
 
-			goto on_error;
+			if( chunk_data->compressed_data == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to create compressed data.",
+				 function );
+
+				goto on_error;
+			}
+			chunk_data->allocated_compressed_data_size = chunk_data->compressed_data_size;
 		}
 		if( ( ( pack_flags & LIBEWF_PACK_FLAG_USE_PATTERN_FILL_COMPRESSION ) != 0 )
 		 && ( chunk_data->data_size == (size_t) chunk_data->chunk_size ) )
@@ -810,22 +870,79 @@ int libewf_chunk_data_pack(
 		{
 			/* If compression was forced but no compression level provided use the default
 			 */
-			if( io_handle->compression_level == LIBEWF_COMPRESSION_NONE )
+			if( compression_level == LIBEWF_COMPRESSION_NONE )
 			{
-				io_handle->compression_level = LIBEWF_COMPRESSION_DEFAULT;
+				compression_level = LIBEWF_COMPRESSION_DEFAULT;
 			}
 			safe_compressed_data_size = chunk_data->compressed_data_size;
 
-/* TODO add a light weight entropy test */
-			result = libewf_compress_data(
-				  chunk_data->compressed_data,
-				  &safe_compressed_data_size,
-				  io_handle->compression_method,
-				  io_handle->compression_level,
-				  chunk_data->data,
-				  chunk_data->data_size,
-				  error );
+			result = 1;
+
+			if( ( ( pack_flags & LIBEWF_PACK_FLAG_USE_TRIAL_COMPRESSION ) != 0 )
+			 && ( ( pack_flags & LIBEWF_PACK_FLAG_FORCE_COMPRESSION ) == 0 )
+			 && ( chunk_data->data_size > LIBEWF_TRIAL_COMPRESSION_DATA_SIZE ) )
+			{
+				/* The chunk data is considered incompressible if the start of the chunk data
+				 * does not compress to less than 15/16 of its size
+				 */
+				safe_compressed_data_size = LIBEWF_TRIAL_COMPRESSION_DATA_SIZE - ( LIBEWF_TRIAL_COMPRESSION_DATA_SIZE / 16 );
+
+				result = libewf_compress_data(
+					  io_handle->compression_cache,
+					  chunk_data->compressed_data,
+					  &safe_compressed_data_size,
+					  io_handle->compression_method,
+					  LIBEWF_COMPRESSION_FAST,
+					  chunk_data->data,
+					  LIBEWF_TRIAL_COMPRESSION_DATA_SIZE,
+					  error );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+					 LIBCERROR_COMPRESSION_ERROR_COMPRESS_FAILED,
+					 "%s: unable to trial compress chunk data.",
+					 function );
 
+					goto on_error;
+				}
+				else if( result == 0 )
+				{
+#if defined( HAVE_DEBUG_OUTPUT )
+					if( libcnotify_verbose != 0 )
+					{
+						libcnotify_printf(
+						 "%s: trial compression indicates chunk data is incompressible.\n",
+						 function );
+					}
+#endif
+					/* Store the chunk data uncompressed
+					 */
+					safe_compressed_data_size = chunk_data->data_size;
+				}
+				else
+				{
+					safe_compressed_data_size = chunk_data->compressed_data_size;
+				}
+			}
+			if( result != 0 )
+			{
+				result = libewf_compress_data(
+					  io_handle->compression_cache,
+					  chunk_data->compressed_data,
+					  &safe_compressed_data_size,
+					  io_handle->compression_method,
+					  compression_level,
+					  chunk_data->data,
+					  chunk_data->data_size,
+					  error );
+			}
+			else
+			{
+				result = 1;
+			}
 			if( result == -1 )
 			{
 				libcerror_error_set(
@@ -942,11 +1059,25 @@ int libewf_chunk_data_pack(
 	if( ( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED ) == 0 )
 	 && ( ( pack_flags & LIBEWF_PACK_FLAG_CALCULATE_CHECKSUM ) != 0 ) )
 	{
+		/* The checksum of the prefix that matches the fill pattern is calculated from the pattern
+		 */
+		fill_pattern_prefix_size -= fill_pattern_prefix_size % 8;
+
+		chunk_data->checksum = 1;
+
+		if( fill_pattern_prefix_size != 0 )
+		{
+			chunk_data->checksum = libewf_adler32_calculate_pattern_fill(
+			                        1,
+			                        fill_pattern_data,
+			                        fill_pattern_prefix_size );
+		}
+
 		if( libewf_checksum_calculate_adler32(
 		     &( chunk_data->checksum ),
-		     chunk_data->data,
-		     chunk_data->data_size,
-		     1,
+		     &( chunk_data->data[ fill_pattern_prefix_size ] ),
+		     chunk_data->data_size - fill_pattern_prefix_size,
+		     chunk_data->checksum,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
@@ -1010,18 +1141,41 @@ int libewf_chunk_data_pack(
 	}
 	chunk_data->data_size = chunk_data->compressed_data_size;
 
+	/* The compressed data buffer never remains set after packing, either it becomes
+	 * the data buffer or it is retained as the spare data buffer
+	 */
+	spare_data      = chunk_data->compressed_data;
+	spare_data_size = chunk_data->allocated_compressed_data_size;
+
 	if( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED ) != 0 )
 	{
+		/* Swap the buffers and retain the uncompressed data buffer for reuse
+		 */
+		spare_data      = NULL;
+		spare_data_size = 0;
+
 		if( ( chunk_data->flags & LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA ) != 0 )
 		{
-			memory_free(
-			 chunk_data->data );
+			spare_data      = chunk_data->data;
+			spare_data_size = chunk_data->allocated_data_size;
 		}
-		chunk_data->data  = chunk_data->compressed_data;
-		chunk_data->flags = LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA;
+		chunk_data->data                = chunk_data->compressed_data;
+		chunk_data->allocated_data_size = chunk_data->allocated_compressed_data_size;
+		chunk_data->flags               = LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA;
+	}
+	chunk_data->compressed_data                = NULL;
+	chunk_data->compressed_data_size           = 0;
+	chunk_data->allocated_compressed_data_size = 0;
 
-		chunk_data->compressed_data      = NULL;
-		chunk_data->compressed_data_size = 0;
+	if( spare_data != NULL )
+	{
+		if( chunk_data->spare_data != NULL )
+		{
+			memory_free(
+			 chunk_data->spare_data );
+		}
+		chunk_data->spare_data                = spare_data;
+		chunk_data->allocated_spare_data_size = spare_data_size;
 	}
 	chunk_data->range_flags |= LIBEWF_RANGE_FLAG_IS_PACKED;
 
@@ -1035,7 +1189,8 @@ on_error:
 
 		chunk_data->compressed_data = NULL;
 	}
-	chunk_data->compressed_data_size = 0;
+	chunk_data->compressed_data_size           = 0;
+	chunk_data->allocated_compressed_data_size = 0;
 
 	return( -1 );
 }
@@ -1050,8 +1205,11 @@ int libewf_chunk_data_unpack(
      libcerror_error_t **error )
 {
 	static char *function        = "libewf_chunk_data_unpack";
+	uint8_t *spare_data          = NULL;
 	size_t remaining_chunk_size  = 0;
+	size_t spare_data_size       = 0;
 	uint32_t calculated_checksum = 0;
+	uint8_t restore_packed_data  = 0;
 
 	if( chunk_data == NULL )
 	{
@@ -1106,19 +1264,25 @@ int libewf_chunk_data_unpack(
 	{
 		if( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED ) != 0 )
 		{
+			/* Reuse the uncompressed data buffer retained by pack
+			 */
+			spare_data      = chunk_data->spare_data;
+			spare_data_size = chunk_data->allocated_spare_data_size;
+
+			chunk_data->spare_data                = NULL;
+			chunk_data->allocated_spare_data_size = 0;
+
 			if( chunk_data->compressed_data != NULL )
 			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-				 "%s: invalid chunk data - compressed data value already set.",
-				 function );
-
-				goto on_error;
+				memory_free(
+				 chunk_data->compressed_data );
 			}
-			chunk_data->compressed_data      = chunk_data->data;
-			chunk_data->compressed_data_size = chunk_data->data_size;
+			chunk_data->compressed_data                = chunk_data->data;
+			chunk_data->compressed_data_size           = chunk_data->data_size;
+			chunk_data->allocated_compressed_data_size = chunk_data->allocated_data_size;
+
+			chunk_data->data    = NULL;
+			restore_packed_data = 1;
 
 			/* Reserve 4 bytes for the checksum
 			 */
@@ -1132,19 +1296,33 @@ int libewf_chunk_data_unpack(
 			}
 			chunk_data->allocated_data_size = ( chunk_data->allocated_data_size / 16 ) * 16;
 
-			chunk_data->data = (uint8_t *) memory_allocate(
-			                                sizeof( uint8_t ) * chunk_data->allocated_data_size );
-
-			if( chunk_data->data == NULL )
+			if( ( spare_data != NULL )
+			 && ( spare_data_size >= chunk_data->allocated_data_size ) )
 			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_MEMORY,
-				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-				 "%s: unable to create data.",
-				 function );
+				chunk_data->data                = spare_data;
+				chunk_data->allocated_data_size = spare_data_size;
+			}
+			else
+			{
+				if( spare_data != NULL )
+				{
+					memory_free(
+					 spare_data );
+				}
+				chunk_data->data = (uint8_t *) memory_allocate(
+				                                sizeof( uint8_t ) * chunk_data->allocated_data_size );
 
-				goto on_error;
+				if( chunk_data->data == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+					 "%s: unable to create data.",
+					 function );
+
+					goto on_error;
+				}
 			}
 			if( memory_set(
 			     chunk_data->data,
@@ -1222,6 +1400,7 @@ int libewf_chunk_data_unpack(
 			else
 			{
 				if( libewf_decompress_data(
+				     io_handle->compression_cache,
 				     chunk_data->compressed_data,
 				     chunk_data->compressed_data_size,
 				     io_handle->compression_method,
@@ -1344,18 +1523,32 @@ int libewf_chunk_data_unpack(
 	return( 1 );
 
 on_error:
-	if( chunk_data->compressed_data != NULL )
+	/* Only restore the packed data if it was moved to the compressed data buffer
+	 */
+	if( restore_packed_data != 0 )
 	{
 		if( chunk_data->data != NULL )
 		{
-			memory_free(
-			 chunk_data->data );
+			/* Retain the uncompressed data buffer for reuse
+			 */
+			if( chunk_data->spare_data == NULL )
+			{
+				chunk_data->spare_data                = chunk_data->data;
+				chunk_data->allocated_spare_data_size = chunk_data->allocated_data_size;
+			}
+			else
+			{
+				memory_free(
+				 chunk_data->data );
+			}
 		}
-		chunk_data->data      = chunk_data->compressed_data;
-		chunk_data->data_size = chunk_data->compressed_data_size;
+		chunk_data->data                = chunk_data->compressed_data;
+		chunk_data->data_size           = chunk_data->compressed_data_size;
+		chunk_data->allocated_data_size = chunk_data->allocated_compressed_data_size;
 
-		chunk_data->compressed_data      = NULL;
-		chunk_data->compressed_data_size = 0;
+		chunk_data->compressed_data                = NULL;
+		chunk_data->compressed_data_size           = 0;
+		chunk_data->allocated_compressed_data_size = 0;
 	}
 	return( -1 );
 }
@@ -1368,11 +1561,9 @@ int libewf_chunk_data_check_for_empty_block(
      size_t data_size,
      libcerror_error_t **error )
 {
-	libewf_aligned_t *aligned_data_index = NULL;
-	libewf_aligned_t *aligned_data_start = NULL;
-	uint8_t *data_index                  = NULL;
-	uint8_t *data_start                  = NULL;
-	static char *function                = "libewf_chunk_data_check_for_empty_block";
+	uint8_t fill_pattern_data[ 8 ];
+
+	static char *function = "libewf_chunk_data_check_for_empty_block";
 
 	if( data == NULL )
 	{
@@ -1400,65 +1591,26 @@ int libewf_chunk_data_check_for_empty_block(
 	{
 		return( 0 );
 	}
-	else if( data_size == 1 )
-	{
-		return( 1 );
-	}
-	data_start = (uint8_t *) data;
-	data_index = (uint8_t *) data + 1;
-
-	data_size--;
-
-	/* Only optimize for data larger than the alignment
-	 */
-	if( data_size > ( sizeof( libewf_aligned_t ) + sizeof( libewf_aligned_t ) ) )
+	if( memory_set(
+	     fill_pattern_data,
+	     data[ 0 ],
+	     8 ) == NULL )
 	{
-		/* Align the data start
-		 */
-		while( ( (intptr_t) data_start % sizeof( libewf_aligned_t ) ) != 0 )
-		{
-			if( *data_start != *data_index )
-			{
-				return( 0 );
-			}
-			data_start++;
-			data_index++;
-			data_size--;
-		}
-		/* Align the data index
-		 */
-		while( ( (intptr_t) data_index % sizeof( libewf_aligned_t ) ) != 0 )
-		{
-			if( *data_start != *data_index )
-			{
-				return( 0 );
-			}
-			data_index++;
-			data_size--;
-		}
-		aligned_data_start = (libewf_aligned_t *) data_start;
-		aligned_data_index = (libewf_aligned_t *) data_index;
-
-		while( data_size > sizeof( libewf_aligned_t ) )
-		{
-			if( *aligned_data_start != *aligned_data_index )
-			{
-				return( 0 );
-			}
-			aligned_data_index++;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to set fill pattern.",
+		 function );
 
-			data_size -= sizeof( libewf_aligned_t );
-		}
-		data_index = (uint8_t *) aligned_data_index;
+		return( -1 );
 	}
-	while( data_size != 0 )
+	if( libewf_pattern_fill_get_prefix_size(
+	     data,
+	     data_size,
+	     fill_pattern_data ) != data_size )
 	{
-		if( *data_start != *data_index )
-		{
-			return( 0 );
-		}
-		data_index++;
-		data_size--;
+		return( 0 );
 	}
 	return( 1 );
 }
@@ -1472,11 +1624,7 @@ int libewf_chunk_data_check_for_64_bit_pattern_fill(
      uint64_t *pattern,
      libcerror_error_t **error )
 {
-	libewf_aligned_t *aligned_data_index = NULL;
-	libewf_aligned_t *aligned_data_start = NULL;
-	uint8_t *data_index                  = NULL;
-	uint8_t *data_start                  = NULL;
-	static char *function                = "libewf_chunk_data_check_for_64_bit_pattern_fill";
+	static char *function = "libewf_chunk_data_check_for_64_bit_pattern_fill";
 
 	if( data == NULL )
 	{
@@ -1516,63 +1664,14 @@ int libewf_chunk_data_check_for_64_bit_pattern_fill(
 	{
 		return( 0 );
 	}
-	data_start = (uint8_t *) data;
-	data_index = (uint8_t *) data + 8;
-	data_size -= 8;
-
-	/* Only optimize for data larger than the alignment
+	/* The first 8 bytes of the data are the pattern
 	 */
-	if( data_size > ( sizeof( libewf_aligned_t ) + sizeof( libewf_aligned_t ) ) )
-	{
-		/* Align the data start
-		 */
-		while( ( (intptr_t) data_start % sizeof( libewf_aligned_t ) ) != 0 )
-		{
-			if( *data_start != *data_index )
-			{
-				return( 0 );
-			}
-			data_start++;
-			data_index++;
-			data_size--;
-		}
-		/* Align the data index
-		 */
-		while( ( (intptr_t) data_index % sizeof( libewf_aligned_t ) ) != 0 )
-		{
-			if( *data_start != *data_index )
-			{
-				return( 0 );
-			}
-			data_index++;
-			data_size--;
-		}
-		aligned_data_start = (libewf_aligned_t *) data_start;
-		aligned_data_index = (libewf_aligned_t *) data_index;
-
-		while( data_size > sizeof( libewf_aligned_t ) )
-		{
-			if( *aligned_data_start != *aligned_data_index )
-			{
-				return( 0 );
-			}
-			aligned_data_start++;
-			aligned_data_index++;
-
-			data_size -= sizeof( libewf_aligned_t );
-		}
-		data_start = (uint8_t *) aligned_data_start;
-		data_index = (uint8_t *) aligned_data_index;
-	}
-	while( data_size != 0 )
+	if( libewf_pattern_fill_get_prefix_size(
+	     &( data[ 8 ] ),
+	     data_size - 8,
+	     data ) != ( data_size - 8 ) )
 	{
-		if( *data_start != *data_index )
-		{
-			return( 0 );
-		}
-		data_start++;
-		data_index++;
-		data_size--;
+		return( 0 );
 	}
 	byte_stream_copy_to_uint64_little_endian(
 	 data,
@@ -1959,6 +2058,86 @@ ssize_t libewf_chunk_data_read_from_file_io_pool(
 	return( read_count );
 }
 
+/* Reads chunk data from a buffer
+ * The buffer contains the stored (packed) chunk data, for example as part of a read of multiple chunks
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_data_read_from_buffer(
+     libewf_chunk_data_t *chunk_data,
+     const uint8_t *buffer,
+     size_t buffer_size,
+     uint32_t chunk_data_flags,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_data_read_from_buffer";
+
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data->data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid chunk data - missing data.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( buffer_size == 0 )
+	 || ( buffer_size > chunk_data->allocated_data_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     chunk_data->data,
+	     buffer,
+	     buffer_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_data->data_size = buffer_size;
+
+	chunk_data->range_flags = ( chunk_data_flags | LIBEWF_RANGE_FLAG_IS_PACKED )
+	                        & ~( LIBEWF_RANGE_FLAG_IS_TAINTED | LIBEWF_RANGE_FLAG_IS_CORRUPTED );
+
+	return( 1 );
+}
+
 /* Reads chunk data
  * Callback function for the chunks list
  * Returns 1 if successful or -1 on error
@@ -66,6 +66,18 @@ struct libewf_chunk_data
 	 */
 	size_t compressed_data_size;
 
+	/* The allocated compressed data size
+	 */
+	size_t allocated_compressed_data_size;
+
+	/* The spare data, an unused buffer retained for reuse
+	 */
+	uint8_t *spare_data;
+
+	/* The allocated spare data size
+	 */
+	size_t allocated_spare_data_size;
+
 	/* The padding size
 	 */
 	size_t padding_size;
@@ -116,7 +128,8 @@ ssize_t libewf_chunk_data_write_buffer(
 
 int libewf_chunk_data_pack(
      libewf_chunk_data_t *chunk_data,
-     libewf_io_handle_t *io_handle,
+     const libewf_io_handle_t *io_handle,
+     int8_t compression_level,
      const uint8_t *compressed_zero_byte_empty_block,
      size_t compressed_zero_byte_empty_block_size,
      uint8_t pack_flags,
@@ -164,6 +177,13 @@ ssize_t libewf_chunk_data_read_from_file_io_pool(
          uint32_t chunk_data_flags,
          libcerror_error_t **error );
 
+int libewf_chunk_data_read_from_buffer(
+     libewf_chunk_data_t *chunk_data,
+     const uint8_t *buffer,
+     size_t buffer_size,
+     uint32_t chunk_data_flags,
+     libcerror_error_t **error );
+
 int libewf_chunk_data_read_element_data(
      libewf_io_handle_t *io_handle,
      libbfio_pool_t *file_io_pool,
@@ -0,0 +1,397 @@
+/*
+ * Chunk data pool functions
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_chunk_data.h"
+#include "libewf_chunk_data_pool.h"
+#include "libewf_definitions.h"
+#include "libewf_libcerror.h"
+
+/* Creates a chunk data pool
+ * Make sure the value chunk_data_pool is referencing, is set to NULL
+ *
+ * The chunk data pool retains the chunk data of written chunks, including
+ * their data buffers, so that they can be reused by subsequent chunks.
+ * The pool is not multi-thread safe
+ *
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_data_pool_initialize(
+     libewf_chunk_data_pool_t **chunk_data_pool,
+     size32_t chunk_size,
+     int maximum_number_of_free_chunk_data,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_data_pool_initialize";
+	size_t array_size     = 0;
+
+	if( chunk_data_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_data_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid chunk data pool value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunk_size == 0 )
+	 || ( chunk_size > (size32_t) ( INT32_MAX - 16 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( maximum_number_of_free_chunk_data <= 0 )
+	 || ( (size_t) maximum_number_of_free_chunk_data > ( (size_t) SSIZE_MAX / sizeof( libewf_chunk_data_t * ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of free chunk data value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*chunk_data_pool = memory_allocate_structure(
+	                    libewf_chunk_data_pool_t );
+
+	if( *chunk_data_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create chunk data pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *chunk_data_pool,
+	     0,
+	     sizeof( libewf_chunk_data_pool_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear chunk data pool.",
+		 function );
+
+		memory_free(
+		 *chunk_data_pool );
+
+		*chunk_data_pool = NULL;
+
+		return( -1 );
+	}
+	array_size = sizeof( libewf_chunk_data_t * ) * maximum_number_of_free_chunk_data;
+
+	( *chunk_data_pool )->free_chunk_data = (libewf_chunk_data_t **) memory_allocate(
+	                                                                  array_size );
+
+	if( ( *chunk_data_pool )->free_chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create free chunk data.",
+		 function );
+
+		goto on_error;
+	}
+	( *chunk_data_pool )->chunk_size                        = chunk_size;
+	( *chunk_data_pool )->maximum_number_of_free_chunk_data = maximum_number_of_free_chunk_data;
+
+	return( 1 );
+
+on_error:
+	if( *chunk_data_pool != NULL )
+	{
+		memory_free(
+		 *chunk_data_pool );
+
+		*chunk_data_pool = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a chunk data pool
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_data_pool_free(
+     libewf_chunk_data_pool_t **chunk_data_pool,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_data_pool_free";
+	int chunk_data_index  = 0;
+	int result            = 1;
+
+	if( chunk_data_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_data_pool != NULL )
+	{
+		for( chunk_data_index = 0;
+		     chunk_data_index < ( *chunk_data_pool )->number_of_free_chunk_data;
+		     chunk_data_index++ )
+		{
+			if( libewf_chunk_data_free(
+			     &( ( ( *chunk_data_pool )->free_chunk_data )[ chunk_data_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free chunk data: %d.",
+				 function,
+				 chunk_data_index );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 ( *chunk_data_pool )->free_chunk_data );
+
+		memory_free(
+		 *chunk_data_pool );
+
+		*chunk_data_pool = NULL;
+	}
+	return( result );
+}
+
+/* Retrieves chunk data from the pool
+ * Reuses previously released chunk data if available otherwise new chunk data is created
+ * The data of the chunk data is not cleared
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_data_pool_get_chunk_data(
+     libewf_chunk_data_pool_t *chunk_data_pool,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_chunk_data_pool_get_chunk_data";
+
+	if( chunk_data_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid chunk data value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data_pool->number_of_free_chunk_data > 0 )
+	{
+		chunk_data_pool->number_of_free_chunk_data -= 1;
+
+		*chunk_data = chunk_data_pool->free_chunk_data[ chunk_data_pool->number_of_free_chunk_data ];
+
+		chunk_data_pool->free_chunk_data[ chunk_data_pool->number_of_free_chunk_data ] = NULL;
+
+		return( 1 );
+	}
+	if( libewf_chunk_data_initialize(
+	     chunk_data,
+	     chunk_data_pool->chunk_size,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Releases chunk data back into the pool
+ * The chunk data is freed if its buffers cannot be reused or the pool is full
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_chunk_data_pool_release_chunk_data(
+     libewf_chunk_data_pool_t *chunk_data_pool,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error )
+{
+	libewf_chunk_data_t *safe_chunk_data = NULL;
+	uint8_t *spare_data                  = NULL;
+	static char *function                = "libewf_chunk_data_pool_release_chunk_data";
+	size_t required_data_size            = 0;
+	size_t spare_data_size               = 0;
+
+	if( chunk_data_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_data == NULL )
+	{
+		return( 1 );
+	}
+	safe_chunk_data = *chunk_data;
+	*chunk_data     = NULL;
+
+	/* Reserve 4 bytes for the chunk checksum, rounded to the next 16-byte increment
+	 * as in libewf_chunk_data_initialize
+	 */
+	required_data_size = (size_t) chunk_data_pool->chunk_size + 4;
+
+	if( ( required_data_size % 16 ) != 0 )
+	{
+		required_data_size += 16;
+	}
+	required_data_size = ( required_data_size / 16 ) * 16;
+
+	if( ( safe_chunk_data->flags & LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA ) == 0 )
+	{
+		safe_chunk_data->data                = NULL;
+		safe_chunk_data->allocated_data_size = 0;
+		safe_chunk_data->flags              |= LIBEWF_CHUNK_DATA_ITEM_FLAG_MANAGED_DATA;
+	}
+	/* After packing compressed chunk data the data buffer contains the compressed data
+	 * and the spare data buffer the former data buffer
+	 */
+	if( ( safe_chunk_data->allocated_data_size < required_data_size )
+	 && ( safe_chunk_data->spare_data != NULL ) )
+	{
+		spare_data      = safe_chunk_data->data;
+		spare_data_size = safe_chunk_data->allocated_data_size;
+
+		safe_chunk_data->data                = safe_chunk_data->spare_data;
+		safe_chunk_data->allocated_data_size = safe_chunk_data->allocated_spare_data_size;
+
+		safe_chunk_data->spare_data                = spare_data;
+		safe_chunk_data->allocated_spare_data_size = spare_data_size;
+	}
+	if( ( safe_chunk_data->chunk_size != chunk_data_pool->chunk_size )
+	 || ( safe_chunk_data->data == NULL )
+	 || ( safe_chunk_data->allocated_data_size < required_data_size )
+	 || ( chunk_data_pool->number_of_free_chunk_data >= chunk_data_pool->maximum_number_of_free_chunk_data ) )
+	{
+		if( libewf_chunk_data_free(
+		     &safe_chunk_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk data.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+	safe_chunk_data->data_size              = 0;
+	safe_chunk_data->compressed_data_offset = 0;
+	safe_chunk_data->compressed_data_size   = 0;
+	safe_chunk_data->padding_size           = 0;
+	safe_chunk_data->range_flags            = 0;
+	safe_chunk_data->checksum               = 0;
+	safe_chunk_data->chunk_io_flags         = 0;
+
+	chunk_data_pool->free_chunk_data[ chunk_data_pool->number_of_free_chunk_data ] = safe_chunk_data;
+
+	chunk_data_pool->number_of_free_chunk_data += 1;
+
+	return( 1 );
+}
+
@@ -0,0 +1,81 @@
+/*
+ * Chunk data pool functions
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_CHUNK_DATA_POOL_H )
+#define _LIBEWF_CHUNK_DATA_POOL_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_chunk_data.h"
+#include "libewf_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_chunk_data_pool libewf_chunk_data_pool_t;
+
+struct libewf_chunk_data_pool
+{
+	/* The chunk size
+	 */
+	size32_t chunk_size;
+
+	/* The free chunk data
+	 */
+	libewf_chunk_data_t **free_chunk_data;
+
+	/* The number of free chunk data
+	 */
+	int number_of_free_chunk_data;
+
+	/* The maximum number of free chunk data
+	 */
+	int maximum_number_of_free_chunk_data;
+};
+
+int libewf_chunk_data_pool_initialize(
+     libewf_chunk_data_pool_t **chunk_data_pool,
+     size32_t chunk_size,
+     int maximum_number_of_free_chunk_data,
+     libcerror_error_t **error );
+
+int libewf_chunk_data_pool_free(
+     libewf_chunk_data_pool_t **chunk_data_pool,
+     libcerror_error_t **error );
+
+int libewf_chunk_data_pool_get_chunk_data(
+     libewf_chunk_data_pool_t *chunk_data_pool,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error );
+
+int libewf_chunk_data_pool_release_chunk_data(
+     libewf_chunk_data_pool_t *chunk_data_pool,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_CHUNK_DATA_POOL_H ) */
+
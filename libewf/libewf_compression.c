@@ -34,7 +34,12 @@
 #include <zlib.h>
 #endif
 
+#if defined( HAVE_LIBDEFLATE )
+#include <libdeflate.h>
+#endif
+
 #include "libewf_compression.h"
+#include "libewf_compression_cache.h"
 #include "libewf_definitions.h"
 #include "libewf_deflate.h"
 #include "libewf_libcerror.h"
@@ -44,6 +49,7 @@
  * Returns 1 on success, 0 if buffer is too small or -1 on error
  */
 int libewf_compress_data(
+     libewf_compression_cache_t *compression_cache,
      uint8_t *compressed_data,
      size_t *compressed_data_size,
      uint16_t compression_method,
@@ -59,7 +65,10 @@ int libewf_compress_data(
 	unsigned int bzip2_compressed_data_size = 0;
 	int bzip2_compression_level             = 0;
 #endif
-#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) ) || defined( ZLIB_DLL )
+#if defined( HAVE_LIBDEFLATE )
+	struct libdeflate_compressor *libdeflate_compressor = NULL;
+	size_t libdeflate_compressed_data_size              = 0;
+#elif ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) ) || defined( ZLIB_DLL )
 	uLongf zlib_compressed_data_size        = 0;
 	int zlib_compression_level              = 0;
 #endif
@@ -110,7 +119,108 @@ int libewf_compress_data(
 	}
 	if( compression_method == LIBEWF_COMPRESSION_METHOD_DEFLATE )
 	{
-#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) ) || defined( ZLIB_DLL )
+#if defined( HAVE_LIBDEFLATE )
+		if( ( compression_level != LIBEWF_COMPRESSION_DEFAULT )
+		 && ( compression_level != LIBEWF_COMPRESSION_NONE )
+		 && ( compression_level != LIBEWF_COMPRESSION_FAST )
+		 && ( compression_level != LIBEWF_COMPRESSION_BEST ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported compression level.",
+			 function );
+
+			return( -1 );
+		}
+		if( *compressed_data_size > (size_t) SSIZE_MAX )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid compressed data size value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		if( uncompressed_data_size > (size_t) SSIZE_MAX )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid uncompressed data size value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		/* A compressor is not thread-safe hence it is used by one call at a time
+		 */
+		if( libewf_compression_cache_get_compressor(
+		     compression_cache,
+		     compression_level,
+		     &libdeflate_compressor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve libdeflate compressor.",
+			 function );
+
+			return( -1 );
+		}
+		/* The zlib variant of the compressor produces the same stream format as compress2
+		 */
+		libdeflate_compressed_data_size = libdeflate_zlib_compress(
+		                                   libdeflate_compressor,
+		                                   (const void *) uncompressed_data,
+		                                   uncompressed_data_size,
+		                                   (void *) compressed_data,
+		                                   *compressed_data_size );
+
+		if( libdeflate_compressed_data_size != 0 )
+		{
+			*compressed_data_size = libdeflate_compressed_data_size;
+
+			result = 1;
+		}
+		else
+		{
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: unable to write compressed data: target buffer too small.\n",
+				 function );
+			}
+#endif
+			*compressed_data_size = libdeflate_zlib_compress_bound(
+			                         libdeflate_compressor,
+			                         uncompressed_data_size );
+
+			result = 0;
+		}
+		if( libewf_compression_cache_release_compressor(
+		     compression_cache,
+		     compression_level,
+		     &libdeflate_compressor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release libdeflate compressor.",
+			 function );
+
+			return( -1 );
+		}
+
+#elif ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) ) || defined( ZLIB_DLL )
 		if( compression_level == LIBEWF_COMPRESSION_DEFAULT )
 		{
 			zlib_compression_level = Z_DEFAULT_COMPRESSION;
@@ -241,7 +351,7 @@ int libewf_compress_data(
 		 function );
 
 		return( -1 );
-#endif /* ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) ) || defined( ZLIB_DLL ) */
+#endif /* defined( HAVE_LIBDEFLATE ) */
 	}
 	else if( compression_method == LIBEWF_COMPRESSION_METHOD_BZIP2 )
 	{
@@ -377,6 +487,7 @@ int libewf_compress_data(
  * Returns 1 on success, 0 on failure or -1 on error
  */
 int libewf_decompress_data(
+     libewf_compression_cache_t *compression_cache,
      const uint8_t *compressed_data,
      size_t compressed_data_size,
      uint16_t compression_method,
@@ -390,7 +501,10 @@ int libewf_decompress_data(
 #if defined( HAVE_LIBBZ2 ) || defined( BZIP2_DLL )
 	unsigned int bzip2_uncompressed_data_size = 0;
 #endif
-#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_UNCOMPRESS ) ) || defined( ZLIB_DLL )
+#if defined( HAVE_LIBDEFLATE )
+	struct libdeflate_decompressor *libdeflate_decompressor = NULL;
+	size_t libdeflate_uncompressed_data_size                = 0;
+#elif ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_UNCOMPRESS ) ) || defined( ZLIB_DLL )
 	uLongf zlib_uncompressed_data_size        = 0;
 #endif
 
@@ -440,7 +554,117 @@ int libewf_decompress_data(
 	}
 	if( compression_method == LIBEWF_COMPRESSION_METHOD_DEFLATE )
 	{
-#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_UNCOMPRESS ) ) || defined( ZLIB_DLL )
+#if defined( HAVE_LIBDEFLATE )
+		if( compressed_data_size > (size_t) SSIZE_MAX )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid compressed data size value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		if( *uncompressed_data_size > (size_t) SSIZE_MAX )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid uncompressed data size value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		if( libewf_compression_cache_get_decompressor(
+		     compression_cache,
+		     &libdeflate_decompressor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve libdeflate decompressor.",
+			 function );
+
+			return( -1 );
+		}
+		result = (int) libdeflate_zlib_decompress(
+		                libdeflate_decompressor,
+		                (const void *) compressed_data,
+		                compressed_data_size,
+		                (void *) uncompressed_data,
+		                *uncompressed_data_size,
+		                &libdeflate_uncompressed_data_size );
+
+		if( libewf_compression_cache_release_decompressor(
+		     compression_cache,
+		     &libdeflate_decompressor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release libdeflate decompressor.",
+			 function );
+
+			return( -1 );
+		}
+
+		if( result == LIBDEFLATE_SUCCESS )
+		{
+			*uncompressed_data_size = libdeflate_uncompressed_data_size;
+
+			result = 1;
+		}
+		else if( result == LIBDEFLATE_BAD_DATA )
+		{
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: unable to read compressed data: data error.\n",
+				 function );
+			}
+#endif
+			*uncompressed_data_size = 0;
+
+			result = -1;
+		}
+		else if( result == LIBDEFLATE_INSUFFICIENT_SPACE )
+		{
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				"%s: unable to read compressed data: target buffer too small.\n",
+				 function );
+			}
+#endif
+			/* Estimate that a factor 2 enlargement should suffice
+			 */
+			*uncompressed_data_size *= 2;
+
+			result = 0;
+		}
+		else
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+			 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+			 "%s: libdeflate returned undefined error: %d.",
+			 function,
+			 result );
+
+			*uncompressed_data_size = 0;
+
+			result = -1;
+		}
+#elif ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_UNCOMPRESS ) ) || defined( ZLIB_DLL )
 #if ULONG_MAX < SSIZE_MAX
 		if( compressed_data_size > (size_t) ULONG_MAX )
 #else
@@ -543,7 +767,7 @@ int libewf_decompress_data(
 			result = -1;
 		}
 #else
-		result = libewf_deflate_decompress(
+		result = libewf_deflate_decompress_zlib(
 		          compressed_data,
 		          compressed_data_size,
 		          uncompressed_data,
@@ -561,7 +785,7 @@ int libewf_decompress_data(
 
 			return( -1 );
 		}
-#endif /* ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_UNCOMPRESS ) ) || defined( ZLIB_DLL ) */
+#endif /* defined( HAVE_LIBDEFLATE ) */
 	}
 	else if( compression_method == LIBEWF_COMPRESSION_METHOD_BZIP2 )
 	{
@@ -25,6 +25,7 @@
 #include <common.h>
 #include <types.h>
 
+#include "libewf_compression_cache.h"
 #include "libewf_libcerror.h"
 
 #if defined( __cplusplus )
@@ -32,6 +33,7 @@ extern "C" {
 #endif
 
 int libewf_compress_data(
+     libewf_compression_cache_t *compression_cache,
      uint8_t *compressed_data,
      size_t *compressed_data_size,
      uint16_t compression_method,
@@ -41,6 +43,7 @@ int libewf_compress_data(
      libcerror_error_t **error );
 
 int libewf_decompress_data(
+     libewf_compression_cache_t *compression_cache,
      const uint8_t *compressed_data,
      size_t compressed_data_size,
      uint16_t compression_method,
@@ -0,0 +1,672 @@
+/*
+ * Compression cache functions
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_LIBDEFLATE )
+#include <libdeflate.h>
+#endif
+
+#include "libewf_compression_cache.h"
+#include "libewf_definitions.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+
+/* Creates a compression cache
+ * Make sure the value compression_cache is referencing, is set to NULL
+ *
+ * The compression cache retains the (de)compressors of the compression
+ * library so that they are not created for every chunk. A (de)compressor
+ * is used by one thread at a time, the cache itself is multi-thread safe
+ *
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_cache_initialize(
+     libewf_compression_cache_t **compression_cache,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_cache_initialize";
+
+	if( compression_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *compression_cache != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid compression cache value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*compression_cache = memory_allocate_structure(
+	                      libewf_compression_cache_t );
+
+	if( *compression_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create compression cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *compression_cache,
+	     0,
+	     sizeof( libewf_compression_cache_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear compression cache.",
+		 function );
+
+		memory_free(
+		 *compression_cache );
+
+		*compression_cache = NULL;
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *compression_cache )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( *compression_cache != NULL )
+	{
+		memory_free(
+		 *compression_cache );
+
+		*compression_cache = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a compression cache
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_cache_free(
+     libewf_compression_cache_t **compression_cache,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_cache_free";
+	int result            = 1;
+
+	if( compression_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *compression_cache != NULL )
+	{
+		if( libewf_compression_cache_empty(
+		     *compression_cache,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to empty compression cache.",
+			 function );
+
+			result = -1;
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_free(
+		     &( ( *compression_cache )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		memory_free(
+		 *compression_cache );
+
+		*compression_cache = NULL;
+	}
+	return( result );
+}
+
+/* Empties a compression cache
+ * Frees the retained (de)compressors
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_cache_empty(
+     libewf_compression_cache_t *compression_cache,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_cache_empty";
+
+#if defined( HAVE_LIBDEFLATE )
+	int entry_index       = 0;
+	int level_index       = 0;
+#endif
+
+	if( compression_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compression cache.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     compression_cache->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+#if defined( HAVE_LIBDEFLATE )
+	for( level_index = 0;
+	     level_index < LIBEWF_COMPRESSION_CACHE_NUMBER_OF_LEVELS;
+	     level_index++ )
+	{
+		for( entry_index = 0;
+		     entry_index < compression_cache->number_of_compressors[ level_index ];
+		     entry_index++ )
+		{
+			libdeflate_free_compressor(
+			 compression_cache->compressors[ level_index ][ entry_index ] );
+
+			compression_cache->compressors[ level_index ][ entry_index ] = NULL;
+		}
+		compression_cache->number_of_compressors[ level_index ] = 0;
+	}
+	for( entry_index = 0;
+	     entry_index < compression_cache->number_of_decompressors;
+	     entry_index++ )
+	{
+		libdeflate_free_decompressor(
+		 compression_cache->decompressors[ entry_index ] );
+
+		compression_cache->decompressors[ entry_index ] = NULL;
+	}
+	compression_cache->number_of_decompressors = 0;
+#endif
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     compression_cache->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+#if defined( HAVE_LIBDEFLATE )
+
+/* Retrieves a compressor for a specific compression level
+ * A compressor is created if the cache has no unused compressor for the level
+ * If compression_cache is NULL the compressor is always created
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_cache_get_compressor(
+     libewf_compression_cache_t *compression_cache,
+     int8_t compression_level,
+     struct libdeflate_compressor **compressor,
+     libcerror_error_t **error )
+{
+	static char *function            = "libewf_compression_cache_get_compressor";
+	int level_index                  = 0;
+	int libdeflate_compression_level = 0;
+
+	if( ( compression_level < LIBEWF_COMPRESSION_DEFAULT )
+	 || ( compression_level > LIBEWF_COMPRESSION_BEST ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported compression level.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressor.",
+		 function );
+
+		return( -1 );
+	}
+	level_index = (int) compression_level - LIBEWF_COMPRESSION_DEFAULT;
+
+	*compressor = NULL;
+
+	if( compression_cache != NULL )
+	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_grab(
+		     compression_cache->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+		if( compression_cache->number_of_compressors[ level_index ] > 0 )
+		{
+			compression_cache->number_of_compressors[ level_index ] -= 1;
+
+			*compressor = compression_cache->compressors[ level_index ][ compression_cache->number_of_compressors[ level_index ] ];
+
+			compression_cache->compressors[ level_index ][ compression_cache->number_of_compressors[ level_index ] ] = NULL;
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_release(
+		     compression_cache->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			if( *compressor != NULL )
+			{
+				libdeflate_free_compressor(
+				 *compressor );
+
+				*compressor = NULL;
+			}
+			return( -1 );
+		}
+#endif
+	}
+	if( *compressor == NULL )
+	{
+		/* libdeflate supports levels 0 to 12, levels above 9 are considerably
+		 * slower than zlib and are therefore not used
+		 */
+		if( compression_level == LIBEWF_COMPRESSION_DEFAULT )
+		{
+			libdeflate_compression_level = 6;
+		}
+		else if( compression_level == LIBEWF_COMPRESSION_FAST )
+		{
+			libdeflate_compression_level = 1;
+		}
+		else if( compression_level == LIBEWF_COMPRESSION_BEST )
+		{
+			libdeflate_compression_level = 9;
+		}
+		else
+		{
+			libdeflate_compression_level = 0;
+		}
+		*compressor = libdeflate_alloc_compressor(
+		               libdeflate_compression_level );
+
+		if( *compressor == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create compressor.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Releases a compressor retrieved by libewf_compression_cache_get_compressor
+ * The compressor is freed if the cache is full or compression_cache is NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_cache_release_compressor(
+     libewf_compression_cache_t *compression_cache,
+     int8_t compression_level,
+     struct libdeflate_compressor **compressor,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_cache_release_compressor";
+	int level_index       = 0;
+
+	if( ( compression_level < LIBEWF_COMPRESSION_DEFAULT )
+	 || ( compression_level > LIBEWF_COMPRESSION_BEST ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported compression level.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressor.",
+		 function );
+
+		return( -1 );
+	}
+	if( *compressor == NULL )
+	{
+		return( 1 );
+	}
+	level_index = (int) compression_level - LIBEWF_COMPRESSION_DEFAULT;
+
+	if( compression_cache != NULL )
+	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_grab(
+		     compression_cache->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+		if( compression_cache->number_of_compressors[ level_index ] < LIBEWF_COMPRESSION_CACHE_MAXIMUM_NUMBER_OF_ENTRIES )
+		{
+			compression_cache->compressors[ level_index ][ compression_cache->number_of_compressors[ level_index ] ] = *compressor;
+
+			compression_cache->number_of_compressors[ level_index ] += 1;
+
+			*compressor = NULL;
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_release(
+		     compression_cache->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+	}
+	if( *compressor != NULL )
+	{
+		libdeflate_free_compressor(
+		 *compressor );
+
+		*compressor = NULL;
+	}
+	return( 1 );
+}
+
+/* Retrieves a decompressor
+ * A decompressor is created if the cache has no unused decompressor
+ * If compression_cache is NULL the decompressor is always created
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_cache_get_decompressor(
+     libewf_compression_cache_t *compression_cache,
+     struct libdeflate_decompressor **decompressor,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_cache_get_decompressor";
+
+	if( decompressor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid decompressor.",
+		 function );
+
+		return( -1 );
+	}
+	*decompressor = NULL;
+
+	if( compression_cache != NULL )
+	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_grab(
+		     compression_cache->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+		if( compression_cache->number_of_decompressors > 0 )
+		{
+			compression_cache->number_of_decompressors -= 1;
+
+			*decompressor = compression_cache->decompressors[ compression_cache->number_of_decompressors ];
+
+			compression_cache->decompressors[ compression_cache->number_of_decompressors ] = NULL;
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_release(
+		     compression_cache->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			if( *decompressor != NULL )
+			{
+				libdeflate_free_decompressor(
+				 *decompressor );
+
+				*decompressor = NULL;
+			}
+			return( -1 );
+		}
+#endif
+	}
+	if( *decompressor == NULL )
+	{
+		*decompressor = libdeflate_alloc_decompressor();
+
+		if( *decompressor == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create decompressor.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Releases a decompressor retrieved by libewf_compression_cache_get_decompressor
+ * The decompressor is freed if the cache is full or compression_cache is NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_compression_cache_release_decompressor(
+     libewf_compression_cache_t *compression_cache,
+     struct libdeflate_decompressor **decompressor,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_compression_cache_release_decompressor";
+
+	if( decompressor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid decompressor.",
+		 function );
+
+		return( -1 );
+	}
+	if( *decompressor == NULL )
+	{
+		return( 1 );
+	}
+	if( compression_cache != NULL )
+	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_grab(
+		     compression_cache->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab mutex.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+		if( compression_cache->number_of_decompressors < LIBEWF_COMPRESSION_CACHE_MAXIMUM_NUMBER_OF_ENTRIES )
+		{
+			compression_cache->decompressors[ compression_cache->number_of_decompressors ] = *decompressor;
+
+			compression_cache->number_of_decompressors += 1;
+
+			*decompressor = NULL;
+		}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_release(
+		     compression_cache->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release mutex.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+	}
+	if( *decompressor != NULL )
+	{
+		libdeflate_free_decompressor(
+		 *decompressor );
+
+		*decompressor = NULL;
+	}
+	return( 1 );
+}
+
+#endif /* defined( HAVE_LIBDEFLATE ) */
+
@@ -0,0 +1,123 @@
+/*
+ * Compression cache functions
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_COMPRESSION_CACHE_H )
+#define _LIBEWF_COMPRESSION_CACHE_H
+
+#include <common.h>
+#include <types.h>
+
+#if defined( HAVE_LIBDEFLATE )
+#include <libdeflate.h>
+#endif
+
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The number of compression levels: default, none, fast and best
+ */
+#define LIBEWF_COMPRESSION_CACHE_NUMBER_OF_LEVELS		4
+
+/* The maximum number of (de)compressors retained per compression level
+ */
+#define LIBEWF_COMPRESSION_CACHE_MAXIMUM_NUMBER_OF_ENTRIES	16
+
+typedef struct libewf_compression_cache libewf_compression_cache_t;
+
+struct libewf_compression_cache
+{
+#if defined( HAVE_LIBDEFLATE )
+	/* The unused compressors per compression level
+	 */
+	struct libdeflate_compressor *compressors[ LIBEWF_COMPRESSION_CACHE_NUMBER_OF_LEVELS ][ LIBEWF_COMPRESSION_CACHE_MAXIMUM_NUMBER_OF_ENTRIES ];
+
+	/* The number of unused compressors per compression level
+	 */
+	int number_of_compressors[ LIBEWF_COMPRESSION_CACHE_NUMBER_OF_LEVELS ];
+
+	/* The unused decompressors
+	 */
+	struct libdeflate_decompressor *decompressors[ LIBEWF_COMPRESSION_CACHE_MAXIMUM_NUMBER_OF_ENTRIES ];
+
+	/* The number of unused decompressors
+	 */
+	int number_of_decompressors;
+#endif
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+#endif
+
+	/* Dummy value to prevent an empty structure
+	 */
+	int dummy;
+};
+
+int libewf_compression_cache_initialize(
+     libewf_compression_cache_t **compression_cache,
+     libcerror_error_t **error );
+
+int libewf_compression_cache_free(
+     libewf_compression_cache_t **compression_cache,
+     libcerror_error_t **error );
+
+int libewf_compression_cache_empty(
+     libewf_compression_cache_t *compression_cache,
+     libcerror_error_t **error );
+
+#if defined( HAVE_LIBDEFLATE )
+
+int libewf_compression_cache_get_compressor(
+     libewf_compression_cache_t *compression_cache,
+     int8_t compression_level,
+     struct libdeflate_compressor **compressor,
+     libcerror_error_t **error );
+
+int libewf_compression_cache_release_compressor(
+     libewf_compression_cache_t *compression_cache,
+     int8_t compression_level,
+     struct libdeflate_compressor **compressor,
+     libcerror_error_t **error );
+
+int libewf_compression_cache_get_decompressor(
+     libewf_compression_cache_t *compression_cache,
+     struct libdeflate_decompressor **decompressor,
+     libcerror_error_t **error );
+
+int libewf_compression_cache_release_decompressor(
+     libewf_compression_cache_t *compression_cache,
+     struct libdeflate_decompressor **decompressor,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBDEFLATE ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_COMPRESSION_CACHE_H ) */
+
@@ -133,6 +133,14 @@ int libewf_data_chunk_initialize(
 on_error:
 	if( internal_data_chunk != NULL )
 	{
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+		if( internal_data_chunk->read_write_lock != NULL )
+		{
+			libcthreads_read_write_lock_free(
+			 &( internal_data_chunk->read_write_lock ),
+			 NULL );
+		}
+#endif
 		memory_free(
 		 internal_data_chunk );
 	}
@@ -308,6 +316,103 @@ on_error:
 	return( -1 );
 }
 
+/* Sets the chunk data in the data chunk without copying it
+ * The data chunk takes over management of the chunk data
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_internal_data_chunk_take_chunk_data(
+     libewf_internal_data_chunk_t *internal_data_chunk,
+     uint64_t chunk_index,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_internal_data_chunk_take_chunk_data";
+
+	if( internal_data_chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data chunk.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunk_data == NULL )
+	 || ( *chunk_data == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_data_chunk->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_data_chunk->chunk_data != NULL )
+	{
+		if( libewf_chunk_data_free(
+		     &( internal_data_chunk->chunk_data ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk data.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	internal_data_chunk->chunk_data  = *chunk_data;
+	internal_data_chunk->chunk_index = chunk_index;
+
+	*chunk_data = NULL;
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_data_chunk->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_data_chunk->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
 /* Reads a buffer from the data chunk
  * It applies decompression if necessary and validates the chunk checksum
  * This function should be used after libewf_handle_read_data_chunk
@@ -439,6 +544,7 @@ ssize_t libewf_data_chunk_write_buffer(
 	libewf_internal_data_chunk_t *internal_data_chunk = NULL;
 	static char *function                             = "libewf_data_chunk_write_buffer";
 	ssize_t write_count                               = 0;
+	uint8_t pack_flags                                = 0;
 
 	if( data_chunk == NULL )
 	{
@@ -540,12 +646,32 @@ ssize_t libewf_data_chunk_write_buffer(
 	}
 	internal_data_chunk->data_size = buffer_size;
 
+	/* The pack flags are retrieved when the chunk is packed, since adaptive
+	 * compression can change them after the data chunk was created.
+	 * Only the write IO handle of the handle that created the data chunk
+	 * determines how it is packed, writing the data chunk does not change it.
+	 */
+	if( libewf_write_io_handle_get_pack_flags(
+	     internal_data_chunk->write_io_handle,
+	     &pack_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve pack flags.",
+		 function );
+
+		goto on_error;
+	}
 	if( libewf_chunk_data_pack(
 	     internal_data_chunk->chunk_data,
 	     internal_data_chunk->io_handle,
+	     internal_data_chunk->io_handle->compression_level,
 	     internal_data_chunk->write_io_handle->compressed_zero_byte_empty_block,
 	     internal_data_chunk->write_io_handle->compressed_zero_byte_empty_block_size,
-	     internal_data_chunk->write_io_handle->pack_flags,
+	     pack_flags,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
@@ -584,3 +710,78 @@ on_error:
 	return( -1 );
 }
 
+
+/* Determines if the data chunk is corrupted
+ * The data chunk is marked as corrupted when the chunk is missing or
+ * when its checksum does not match after it was read with libewf_data_chunk_read_buffer
+ * Returns 1 if the data chunk is corrupted, 0 if not or -1 on error
+ */
+int libewf_data_chunk_is_corrupted(
+     libewf_data_chunk_t *data_chunk,
+     libcerror_error_t **error )
+{
+	libewf_internal_data_chunk_t *internal_data_chunk = NULL;
+	static char *function                             = "libewf_data_chunk_is_corrupted";
+	int result                                        = 0;
+
+	if( data_chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data chunk.",
+		 function );
+
+		return( -1 );
+	}
+	internal_data_chunk = (libewf_internal_data_chunk_t *) data_chunk;
+
+	if( internal_data_chunk->chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid data chunk - missing chunk data.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_data_chunk->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( ( internal_data_chunk->chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ) != 0 )
+	{
+		result = 1;
+	}
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_data_chunk->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
@@ -85,6 +85,12 @@ int libewf_internal_data_chunk_set_chunk_data(
      libewf_chunk_data_t *chunk_data,
      libcerror_error_t **error );
 
+int libewf_internal_data_chunk_take_chunk_data(
+     libewf_internal_data_chunk_t *internal_data_chunk,
+     uint64_t chunk_index,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 ssize_t libewf_data_chunk_read_buffer(
          libewf_data_chunk_t *data_chunk,
@@ -99,6 +105,11 @@ ssize_t libewf_data_chunk_write_buffer(
          size_t buffer_size,
          libcerror_error_t **error );
 
+LIBEWF_EXTERN \
+int libewf_data_chunk_is_corrupted(
+     libewf_data_chunk_t *data_chunk,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -24,6 +24,7 @@
 #include <memory.h>
 #include <types.h>
 
+#include "libewf_adler32.h"
 #include "libewf_deflate.h"
 #include "libewf_libcerror.h"
 
@@ -42,6 +43,7 @@ int libewf_deflate_bit_stream_get_value(
      libcerror_error_t **error )
 {
 	static char *function     = "libewf_deflate_bit_stream_get_value";
+	uint64_t safe_value_64bit = 0;
 	uint32_t safe_value_32bit = 0;
 
 	if( bit_stream == NULL )
@@ -96,28 +98,23 @@ int libewf_deflate_bit_stream_get_value(
 
 			return( -1 );
 		}
-		safe_value_32bit   = bit_stream->byte_stream[ bit_stream->byte_stream_offset++ ];
-		safe_value_32bit <<= bit_stream->bit_buffer_size;
+		safe_value_64bit   = bit_stream->byte_stream[ bit_stream->byte_stream_offset++ ];
+		safe_value_64bit <<= bit_stream->bit_buffer_size;
 
-		bit_stream->bit_buffer      |= safe_value_32bit;
+		bit_stream->bit_buffer      |= safe_value_64bit;
 		bit_stream->bit_buffer_size += 8;
 	}
-	safe_value_32bit = bit_stream->bit_buffer;
+	safe_value_32bit = (uint32_t) bit_stream->bit_buffer;
 
 	if( number_of_bits < 32 )
 	{
 		/* On VS 2008 32-bit "~( 0xfffffffUL << 32 )" does not behave as expected
 		 */
 		safe_value_32bit &= ~( 0xffffffffUL << number_of_bits );
-
-		bit_stream->bit_buffer     >>= number_of_bits;
-		bit_stream->bit_buffer_size -= number_of_bits;
-	}
-	else
-	{
-		bit_stream->bit_buffer      = 0;
-		bit_stream->bit_buffer_size = 0;
 	}
+	bit_stream->bit_buffer     >>= number_of_bits;
+	bit_stream->bit_buffer_size -= number_of_bits;
+
 	*value_32bit = safe_value_32bit;
 
 	return( 1 );
@@ -176,6 +173,7 @@ int libewf_deflate_huffman_table_construct(
 	}
 /* TODO hardcoded for now */
 	table->maximum_number_of_bits = 15;
+	table->lookup_table_bits      = 0;
 
 	if( table->maximum_number_of_bits > 15 )
 	{
@@ -322,6 +320,298 @@ int libewf_deflate_huffman_table_construct(
 		return( -1 );
 	}
 */
+	if( libewf_deflate_huffman_table_construct_lookup_table(
+	     table,
+	     code_sizes_array,
+	     number_of_code_sizes,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to construct lookup table.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Constructs the lookup table of the Huffman table
+ * The lookup table consists of a root table indexed by the first (least significant) bits
+ * of the bit stream and sub tables for codes that are larger than the root
+ * so that a Huffman encoded value can be decoded with a single table probe
+ * If the codes do not fit in the lookup table it is not used
+ * Returns 1 on success or -1 on error
+ */
+int libewf_deflate_huffman_table_construct_lookup_table(
+     libewf_deflate_huffman_table_t *table,
+     const uint16_t *code_sizes_array,
+     int number_of_code_sizes,
+     libcerror_error_t **error )
+{
+	uint16_t first_codes_array[ 16 ];
+	uint16_t next_codes_array[ 16 ];
+	uint8_t sub_table_bits_array[ 1 << LIBEWF_DEFLATE_HUFFMAN_LOOKUP_TABLE_ROOT_BITS ];
+
+	static char *function          = "libewf_deflate_huffman_table_construct_lookup_table";
+	uint32_t lookup_entry          = 0;
+	uint16_t code                  = 0;
+	uint16_t code_size             = 0;
+	uint16_t reversed_code         = 0;
+	uint8_t bit_index              = 0;
+	uint8_t lookup_table_bits      = 0;
+	uint8_t maximum_code_size      = 0;
+	uint8_t sub_table_bits         = 0;
+	int lookup_table_index         = 0;
+	int lookup_table_size          = 0;
+	int root_table_size            = 0;
+	int sub_table_offset           = 0;
+	int symbol                     = 0;
+
+	if( table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid table.",
+		 function );
+
+		return( -1 );
+	}
+	if( code_sizes_array == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid code sizes array.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_code_sizes < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of code sizes value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	table->lookup_table_bits = 0;
+
+	for( bit_index = 1;
+	     bit_index <= table->maximum_number_of_bits;
+	     bit_index++ )
+	{
+		if( table->code_counts_array[ bit_index ] > 0 )
+		{
+			maximum_code_size = bit_index;
+		}
+	}
+	if( maximum_code_size == 0 )
+	{
+		return( 1 );
+	}
+	lookup_table_bits = LIBEWF_DEFLATE_HUFFMAN_LOOKUP_TABLE_ROOT_BITS;
+
+	if( lookup_table_bits > maximum_code_size )
+	{
+		lookup_table_bits = maximum_code_size;
+	}
+	root_table_size = 1 << lookup_table_bits;
+
+	/* Determine the first canonical code of every code size
+	 */
+	code = 0;
+
+	first_codes_array[ 0 ] = 0;
+
+	for( bit_index = 1;
+	     bit_index <= table->maximum_number_of_bits;
+	     bit_index++ )
+	{
+		if( bit_index > 1 )
+		{
+			code += (uint16_t) table->code_counts_array[ bit_index - 1 ];
+		}
+		code <<= 1;
+
+		first_codes_array[ bit_index ] = code;
+	}
+	if( memory_set(
+	     table->lookup_table,
+	     0,
+	     sizeof( uint32_t ) * root_table_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear lookup table.",
+		 function );
+
+		return( -1 );
+	}
+	lookup_table_size = root_table_size;
+
+	/* Determine the number of bits of the sub tables
+	 */
+	if( maximum_code_size > lookup_table_bits )
+	{
+		if( memory_set(
+		     sub_table_bits_array,
+		     0,
+		     sizeof( uint8_t ) * root_table_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear sub table bits array.",
+			 function );
+
+			return( -1 );
+		}
+		if( memory_copy(
+		     next_codes_array,
+		     first_codes_array,
+		     sizeof( uint16_t ) * 16 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy first codes array.",
+			 function );
+
+			return( -1 );
+		}
+		for( symbol = 0;
+		     symbol < number_of_code_sizes;
+		     symbol++ )
+		{
+			code_size = code_sizes_array[ symbol ];
+
+			if( code_size <= lookup_table_bits )
+			{
+				continue;
+			}
+			code = next_codes_array[ code_size ]++;
+
+			reversed_code = 0;
+
+			for( bit_index = 0;
+			     bit_index < code_size;
+			     bit_index++ )
+			{
+				reversed_code <<= 1;
+				reversed_code  |= code & 0x0001;
+				code          >>= 1;
+			}
+			lookup_table_index = reversed_code & ( root_table_size - 1 );
+			sub_table_bits     = (uint8_t) ( code_size - lookup_table_bits );
+
+			if( sub_table_bits_array[ lookup_table_index ] < sub_table_bits )
+			{
+				sub_table_bits_array[ lookup_table_index ] = sub_table_bits;
+			}
+		}
+		for( lookup_table_index = 0;
+		     lookup_table_index < root_table_size;
+		     lookup_table_index++ )
+		{
+			sub_table_bits = sub_table_bits_array[ lookup_table_index ];
+
+			if( sub_table_bits == 0 )
+			{
+				continue;
+			}
+			sub_table_offset = lookup_table_size;
+
+			lookup_table_size += 1 << sub_table_bits;
+
+			/* The codes do not fit in the lookup table, which can only happen
+			 * for incomplete codes, hence fall back to the canonical decoding
+			 */
+			if( lookup_table_size > LIBEWF_DEFLATE_HUFFMAN_LOOKUP_TABLE_SIZE )
+			{
+				return( 1 );
+			}
+			if( memory_set(
+			     &( table->lookup_table[ sub_table_offset ] ),
+			     0,
+			     sizeof( uint32_t ) * ( 1 << sub_table_bits ) ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+				 "%s: unable to clear lookup sub table.",
+				 function );
+
+				return( -1 );
+			}
+			table->lookup_table[ lookup_table_index ] = LIBEWF_DEFLATE_HUFFMAN_LOOKUP_ENTRY_SUB_TABLE
+			                                          | ( (uint32_t) sub_table_bits << 16 )
+			                                          | (uint32_t) sub_table_offset;
+		}
+	}
+	/* Fill the root and sub tables
+	 */
+	for( symbol = 0;
+	     symbol < number_of_code_sizes;
+	     symbol++ )
+	{
+		code_size = code_sizes_array[ symbol ];
+
+		if( code_size == 0 )
+		{
+			continue;
+		}
+		code = first_codes_array[ code_size ]++;
+
+		reversed_code = 0;
+
+		for( bit_index = 0;
+		     bit_index < code_size;
+		     bit_index++ )
+		{
+			reversed_code <<= 1;
+			reversed_code  |= code & 0x0001;
+			code          >>= 1;
+		}
+		lookup_entry = ( (uint32_t) code_size << 16 ) | (uint32_t) symbol;
+
+		if( code_size <= lookup_table_bits )
+		{
+			for( lookup_table_index = reversed_code;
+			     lookup_table_index < root_table_size;
+			     lookup_table_index += 1 << code_size )
+			{
+				table->lookup_table[ lookup_table_index ] = lookup_entry;
+			}
+		}
+		else
+		{
+			sub_table_offset = (int) ( table->lookup_table[ reversed_code & ( root_table_size - 1 ) ] & LIBEWF_DEFLATE_HUFFMAN_LOOKUP_ENTRY_VALUE_MASK );
+			sub_table_bits   = (uint8_t) ( ( table->lookup_table[ reversed_code & ( root_table_size - 1 ) ] >> 16 ) & 0xff );
+
+			for( lookup_table_index = reversed_code >> lookup_table_bits;
+			     lookup_table_index < ( 1 << sub_table_bits );
+			     lookup_table_index += 1 << ( code_size - lookup_table_bits ) )
+			{
+				table->lookup_table[ sub_table_offset + lookup_table_index ] = lookup_entry;
+			}
+		}
+	}
+	table->lookup_table_bits = lookup_table_bits;
+
 	return( 1 );
 }
 
@@ -335,7 +625,9 @@ int libewf_deflate_bit_stream_get_huffman_encoded_value(
      libcerror_error_t **error )
 {
 	static char *function     = "libewf_deflate_bit_stream_get_huffman_encoded_value";
-	uint32_t bit_buffer       = 0;
+	uint64_t bit_buffer       = 0;
+	uint64_t safe_value_64bit = 0;
+	uint32_t lookup_entry     = 0;
 	uint32_t safe_value_32bit = 0;
 	uint8_t bit_index         = 0;
 	uint8_t number_of_bits    = 0;
@@ -386,43 +678,71 @@ int libewf_deflate_bit_stream_get_huffman_encoded_value(
 		{
 			break;
 		}
-		safe_value_32bit   = bit_stream->byte_stream[ bit_stream->byte_stream_offset++ ];
-		safe_value_32bit <<= bit_stream->bit_buffer_size;
+		safe_value_64bit   = bit_stream->byte_stream[ bit_stream->byte_stream_offset++ ];
+		safe_value_64bit <<= bit_stream->bit_buffer_size;
 
-		bit_stream->bit_buffer      |= safe_value_32bit;
+		bit_stream->bit_buffer      |= safe_value_64bit;
 		bit_stream->bit_buffer_size += 8;
 	}
-	if( table->maximum_number_of_bits < bit_stream->bit_buffer_size )
-	{
-		number_of_bits = table->maximum_number_of_bits;
-	}
-	else
-	{
-		number_of_bits = bit_stream->bit_buffer_size;
-	}
 	bit_buffer = bit_stream->bit_buffer;
 
-	for( bit_index = 1;
-	     bit_index <= number_of_bits;
-	     bit_index++ )
+	if( table->lookup_table_bits > 0 )
 	{
-		huffman_code <<= 1;
-		huffman_code  |= (int) bit_buffer & 0x00000001UL;
-		bit_buffer   >>= 1;
+		/* Bits beyond the end of the byte stream are 0 and the code size
+		 * of the looked up entry is checked against the available bits
+		 */
+		lookup_entry = table->lookup_table[ bit_buffer & ( ( (uint64_t) 1 << table->lookup_table_bits ) - 1 ) ];
 
-		code_size_count = table->code_counts_array[ bit_index ];
+		if( ( lookup_entry & LIBEWF_DEFLATE_HUFFMAN_LOOKUP_ENTRY_SUB_TABLE ) != 0 )
+		{
+			bit_buffer >>= table->lookup_table_bits;
+
+			lookup_entry = table->lookup_table[ ( lookup_entry & LIBEWF_DEFLATE_HUFFMAN_LOOKUP_ENTRY_VALUE_MASK )
+			                                  + ( bit_buffer & ( ( (uint64_t) 1 << ( ( lookup_entry >> 16 ) & 0xff ) ) - 1 ) ) ];
+		}
+		number_of_bits = (uint8_t) ( ( lookup_entry >> 16 ) & 0xff );
 
-		if( ( huffman_code - code_size_count ) < first_huffman_code )
+		if( ( number_of_bits > 0 )
+		 && ( number_of_bits <= bit_stream->bit_buffer_size ) )
 		{
-			safe_value_32bit = table->codes_array[ first_index + ( huffman_code - first_huffman_code ) ];
+			safe_value_32bit = lookup_entry & LIBEWF_DEFLATE_HUFFMAN_LOOKUP_ENTRY_VALUE_MASK;
+			bit_index        = number_of_bits;
 
 			result = 1;
+		}
+	}
+	else
+	{
+		if( table->maximum_number_of_bits < bit_stream->bit_buffer_size )
+		{
+			number_of_bits = table->maximum_number_of_bits;
+		}
+		else
+		{
+			number_of_bits = bit_stream->bit_buffer_size;
+		}
+		for( bit_index = 1;
+		     bit_index <= number_of_bits;
+		     bit_index++ )
+		{
+			huffman_code <<= 1;
+			huffman_code  |= (int) bit_buffer & 0x00000001UL;
+			bit_buffer   >>= 1;
 
-			break;
+			code_size_count = table->code_counts_array[ bit_index ];
+
+			if( ( huffman_code - code_size_count ) < first_huffman_code )
+			{
+				safe_value_32bit = table->codes_array[ first_index + ( huffman_code - first_huffman_code ) ];
+
+				result = 1;
+
+				break;
+			}
+			first_huffman_code  += code_size_count;
+			first_huffman_code <<= 1;
+			first_index         += code_size_count;
 		}
-		first_huffman_code  += code_size_count;
-		first_huffman_code <<= 1;
-		first_index         += code_size_count;
 	}
 	if( result != 0 )
 	{
@@ -837,12 +1157,21 @@ int libewf_deflate_decode_huffman(
 		7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
 
 	static char *function         = "libewf_deflate_decode_huffman";
+	size_t byte_stream_offset     = 0;
 	size_t data_offset            = 0;
+	uint64_t bit_buffer           = 0;
+	uint64_t distances_mask       = 0;
+	uint64_t literals_mask        = 0;
+	uint64_t value_64bit          = 0;
 	uint32_t code_value           = 0;
 	uint32_t extra_bits           = 0;
+	uint32_t lookup_entry         = 0;
 	uint16_t compression_offset   = 0;
 	uint16_t compression_size     = 0;
 	uint16_t number_of_extra_bits = 0;
+	uint8_t bit_buffer_size       = 0;
+	uint8_t number_of_bits        = 0;
+	int end_of_block              = 0;
 
 	if( uncompressed_data == NULL )
 	{
@@ -879,7 +1208,154 @@ int libewf_deflate_decode_huffman(
 	}
 	data_offset = *uncompressed_data_offset;
 
-	do
+	/* The fast loop decodes a literal or a match per iteration using the lookup tables.
+	 * The bit buffer is refilled in bulk to at least 56 bits per iteration, which fits
+	 * the largest literal and distance codes and their extra bits. Per symbol bounds
+	 * checks are not needed while the byte stream contains at least 8 more bytes
+	 * and the uncompressed data can contain the largest match.
+	 */
+	if( ( bit_stream != NULL )
+	 && ( literals_table != NULL )
+	 && ( distances_table != NULL )
+	 && ( literals_table->lookup_table_bits > 0 )
+	 && ( distances_table->lookup_table_bits > 0 ) )
+	{
+		bit_buffer         = bit_stream->bit_buffer;
+		bit_buffer_size    = bit_stream->bit_buffer_size;
+		byte_stream_offset = bit_stream->byte_stream_offset;
+
+		literals_mask  = ( (uint64_t) 1 << literals_table->lookup_table_bits ) - 1;
+		distances_mask = ( (uint64_t) 1 << distances_table->lookup_table_bits ) - 1;
+
+		while( ( ( bit_stream->byte_stream_size - byte_stream_offset ) >= 8 )
+		    && ( ( uncompressed_data_size - data_offset ) >= 258 ) )
+		{
+			byte_stream_copy_to_uint64_little_endian(
+			 &( bit_stream->byte_stream[ byte_stream_offset ] ),
+			 value_64bit );
+
+			bit_buffer         |= value_64bit << bit_buffer_size;
+			byte_stream_offset += ( 63 - bit_buffer_size ) >> 3;
+			bit_buffer_size    |= 56;
+
+			lookup_entry = literals_table->lookup_table[ bit_buffer & literals_mask ];
+
+			if( ( lookup_entry & LIBEWF_DEFLATE_HUFFMAN_LOOKUP_ENTRY_SUB_TABLE ) != 0 )
+			{
+				lookup_entry = literals_table->lookup_table[ ( lookup_entry & LIBEWF_DEFLATE_HUFFMAN_LOOKUP_ENTRY_VALUE_MASK )
+				                                           + ( ( bit_buffer >> literals_table->lookup_table_bits ) & ( ( (uint64_t) 1 << ( ( lookup_entry >> 16 ) & 0xff ) ) - 1 ) ) ];
+			}
+			number_of_bits = (uint8_t) ( ( lookup_entry >> 16 ) & 0xff );
+
+			if( number_of_bits == 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid literal huffman encoded value.",
+				 function );
+
+				return( -1 );
+			}
+			bit_buffer     >>= number_of_bits;
+			bit_buffer_size -= number_of_bits;
+
+			code_value = lookup_entry & LIBEWF_DEFLATE_HUFFMAN_LOOKUP_ENTRY_VALUE_MASK;
+
+			if( code_value < 256 )
+			{
+				uncompressed_data[ data_offset++ ] = (uint8_t) code_value;
+
+				continue;
+			}
+			if( code_value == 256 )
+			{
+				end_of_block = 1;
+
+				break;
+			}
+			if( code_value >= 286 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: invalid code value: %" PRIu32 ".",
+				 function,
+				 code_value );
+
+				return( -1 );
+			}
+			code_value -= 257;
+
+			number_of_extra_bits = literal_codes_number_of_extra_bits[ code_value ];
+
+			compression_size = literal_codes_base[ code_value ]
+			                 + (uint16_t) ( bit_buffer & ( ( (uint64_t) 1 << number_of_extra_bits ) - 1 ) );
+
+			bit_buffer     >>= number_of_extra_bits;
+			bit_buffer_size -= (uint8_t) number_of_extra_bits;
+
+			lookup_entry = distances_table->lookup_table[ bit_buffer & distances_mask ];
+
+			if( ( lookup_entry & LIBEWF_DEFLATE_HUFFMAN_LOOKUP_ENTRY_SUB_TABLE ) != 0 )
+			{
+				lookup_entry = distances_table->lookup_table[ ( lookup_entry & LIBEWF_DEFLATE_HUFFMAN_LOOKUP_ENTRY_VALUE_MASK )
+				                                            + ( ( bit_buffer >> distances_table->lookup_table_bits ) & ( ( (uint64_t) 1 << ( ( lookup_entry >> 16 ) & 0xff ) ) - 1 ) ) ];
+			}
+			number_of_bits = (uint8_t) ( ( lookup_entry >> 16 ) & 0xff );
+			code_value     = lookup_entry & LIBEWF_DEFLATE_HUFFMAN_LOOKUP_ENTRY_VALUE_MASK;
+
+			if( ( number_of_bits == 0 )
+			 || ( code_value >= 30 ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid distance huffman encoded value.",
+				 function );
+
+				return( -1 );
+			}
+			bit_buffer     >>= number_of_bits;
+			bit_buffer_size -= number_of_bits;
+
+			number_of_extra_bits = distance_codes_number_of_extra_bits[ code_value ];
+
+			compression_offset = distance_codes_base[ code_value ]
+			                   + (uint16_t) ( bit_buffer & ( ( (uint64_t) 1 << number_of_extra_bits ) - 1 ) );
+
+			bit_buffer     >>= number_of_extra_bits;
+			bit_buffer_size -= (uint8_t) number_of_extra_bits;
+
+			if( compression_offset > data_offset )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid compression offset value out of bounds.",
+				 function );
+
+				return( -1 );
+			}
+			while( compression_size > 0 )
+			{
+				uncompressed_data[ data_offset ] = uncompressed_data[ data_offset - compression_offset ];
+
+				data_offset++;
+				compression_size--;
+			}
+		}
+		/* Clear the bits of the partially consumed bytes beyond the bit buffer size
+		 */
+		bit_stream->bit_buffer         = bit_buffer & ( ( (uint64_t) 1 << bit_buffer_size ) - 1 );
+		bit_stream->bit_buffer_size    = bit_buffer_size;
+		bit_stream->byte_stream_offset = byte_stream_offset;
+	}
+	while( end_of_block == 0 )
 	{
 		if( libewf_deflate_bit_stream_get_huffman_encoded_value(
 		     bit_stream,
@@ -1011,9 +1487,11 @@ int libewf_deflate_decode_huffman(
 
 			return( -1 );
 		}
+		if( code_value == 256 )
+		{
+			end_of_block = 1;
+		}
 	}
-	while( code_value != 256 );
-
 	*uncompressed_data_offset = data_offset;
 
 	return( 1 );
@@ -1070,6 +1548,14 @@ int libewf_deflate_calculate_adler32(
 
 		return( -1 );
 	}
+	if( libewf_adler32_calculate_simd(
+	     checksum_value,
+	     buffer,
+	     size,
+	     initial_value ) == 1 )
+	{
+		return( 1 );
+	}
 	lower_word = initial_value & 0xffff;
 	upper_word = ( initial_value >> 16 ) & 0xffff;
 
@@ -1532,6 +2018,15 @@ int libewf_deflate_read_block(
 					return( -1 );
 				}
 			}
+			/* Return the whole bytes in the bit buffer to the byte stream
+			 */
+			while( bit_stream->bit_buffer_size >= 8 )
+			{
+				bit_stream->byte_stream_offset -= 1;
+				bit_stream->bit_buffer_size    -= 8;
+			}
+			bit_stream->bit_buffer = 0;
+
 			if( libewf_deflate_bit_stream_get_value(
 			     bit_stream,
 			     32,
@@ -31,6 +31,20 @@
 extern "C" {
 #endif
 
+/* The number of bits of the Huffman lookup table root
+ */
+#define LIBEWF_DEFLATE_HUFFMAN_LOOKUP_TABLE_ROOT_BITS	9
+
+/* The number of entries of the Huffman lookup table
+ * this fits the root and sub tables of any complete literals or distances code
+ */
+#define LIBEWF_DEFLATE_HUFFMAN_LOOKUP_TABLE_SIZE	1024
+
+/* The Huffman lookup table entry flags and masks
+ */
+#define LIBEWF_DEFLATE_HUFFMAN_LOOKUP_ENTRY_VALUE_MASK	0x0000ffffUL
+#define LIBEWF_DEFLATE_HUFFMAN_LOOKUP_ENTRY_SUB_TABLE	0x01000000UL
+
 /* The block types
  */
 enum LIBEWF_DEFLATE_BLOCK_TYPES
@@ -59,7 +73,7 @@ struct libewf_deflate_bit_stream
 
 	/* The bit buffer
 	 */
-	uint32_t bit_buffer;
+	uint64_t bit_buffer;
 
 	/* The number of bits remaining in the bit buffer
 	 */
@@ -86,6 +100,18 @@ struct libewf_deflate_huffman_table
 	/* The number of codes
 	 */
 	int number_of_codes;
+
+	/* The number of bits of the lookup table root
+	 * 0 if the lookup table is not used
+	 */
+	uint8_t lookup_table_bits;
+
+	/* The lookup table
+	 * an entry contains the symbol or sub table offset in the lower 16 bits,
+	 * the code size or sub table number of bits in bits 16 - 23 and the sub table flag
+	 * an entry of 0 represents an invalid code
+	 */
+	uint32_t lookup_table[ LIBEWF_DEFLATE_HUFFMAN_LOOKUP_TABLE_SIZE ];
 };
 
 int libewf_deflate_bit_stream_get_value(
@@ -100,6 +126,12 @@ int libewf_deflate_huffman_table_construct(
      int number_of_code_sizes,
      libcerror_error_t **error );
 
+int libewf_deflate_huffman_table_construct_lookup_table(
+     libewf_deflate_huffman_table_t *table,
+     const uint16_t *code_sizes_array,
+     int number_of_code_sizes,
+     libcerror_error_t **error );
+
 int libewf_deflate_bit_stream_get_huffman_encoded_value(
      libewf_deflate_bit_stream_t *bit_stream,
      libewf_deflate_huffman_table_t *table,
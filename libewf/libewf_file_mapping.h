@@ -0,0 +1,80 @@
+/*
+ * Memory mapped file functions
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_FILE_MAPPING_H )
+#define _LIBEWF_FILE_MAPPING_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_MMAP ) && defined( HAVE_MUNMAP ) && defined( HAVE_SYS_MMAN_H ) && !defined( WINAPI )
+#define LIBEWF_HAVE_FILE_MAPPING	1
+#endif
+
+typedef struct libewf_file_mapping libewf_file_mapping_t;
+
+struct libewf_file_mapping
+{
+	/* The mapped data
+	 */
+	uint8_t *data;
+
+	/* The mapped data size
+	 */
+	size64_t data_size;
+};
+
+int libewf_file_mapping_initialize(
+     libewf_file_mapping_t **file_mapping,
+     libcerror_error_t **error );
+
+int libewf_file_mapping_free(
+     libewf_file_mapping_t **file_mapping,
+     libcerror_error_t **error );
+
+int libewf_file_mapping_open(
+     libewf_file_mapping_t *file_mapping,
+     const char *filename,
+     libcerror_error_t **error );
+
+int libewf_file_mapping_close(
+     libewf_file_mapping_t *file_mapping,
+     libcerror_error_t **error );
+
+int libewf_file_mapping_get_data_at_offset(
+     libewf_file_mapping_t *file_mapping,
+     off64_t offset,
+     size64_t size,
+     const uint8_t **data,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_FILE_MAPPING_H ) */
+
@@ -25,12 +25,16 @@
 #include <common.h>
 #include <types.h>
 
+#include "libewf_chunk_cache.h"
 #include "libewf_chunk_data.h"
+#include "libewf_chunk_data_pool.h"
 #include "libewf_chunk_group.h"
 #include "libewf_chunk_table.h"
 #include "libewf_data_chunk.h"
 #include "libewf_extern.h"
+#include "libewf_file_mapping.h"
 #include "libewf_hash_sections.h"
+#include "libewf_index_file.h"
 #include "libewf_libbfio.h"
 #include "libewf_libcdata.h"
 #include "libewf_libcerror.h"
@@ -39,12 +43,15 @@
 #include "libewf_libfdata.h"
 #include "libewf_libfvalue.h"
 #include "libewf_io_handle.h"
+#include "libewf_io_uring.h"
 #include "libewf_media_values.h"
 #include "libewf_read_io_handle.h"
 #include "libewf_segment_table.h"
 #include "libewf_single_files.h"
 #include "libewf_types.h"
+#include "libewf_unpack_pool.h"
 #include "libewf_write_io_handle.h"
+#include "libewf_write_pipeline.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -94,6 +101,14 @@ struct libewf_internal_handle
 	 */
 	int maximum_number_of_open_handles;
 
+	/* The maximum memory size of the chunks cache
+	 */
+	size64_t maximum_chunks_cache_size;
+
+	/* The maximum memory size of the chunk groups cache
+	 */
+	size64_t maximum_chunk_groups_cache_size;
+
 	/* The current (storage media) offset
 	 */
 	off64_t current_offset;
@@ -118,10 +133,42 @@ struct libewf_internal_handle
 	 */
 	libfcache_cache_t *chunks_cache;
 
+	/* The chunk cache used by reads of read-only handles
+	 */
+	libewf_chunk_cache_t *chunk_cache;
+
+	/* The maximum number of chunks to read ahead of sequential reads
+	 */
+	int maximum_number_of_read_ahead_chunks;
+
+	/* The offset of the end of the previous read, used to detect sequential reads
+	 */
+	off64_t read_ahead_offset;
+
+	/* The index of the next chunk to read ahead
+	 */
+	uint64_t read_ahead_chunk_index;
+
+	/* The index of the chunk after the last chunk to read ahead
+	 */
+	uint64_t read_ahead_end_chunk_index;
+
+	/* The number of read-ahead tasks that have not completed
+	 */
+	int number_of_read_ahead_tasks;
+
+	/* The number of threads that compress chunks written by write buffer
+	 */
+	int number_of_compression_threads;
+
 	/* The current chunk data
 	 */
 	libewf_chunk_data_t *chunk_data;
 
+	/* The pool of chunk data reused by written chunks
+	 */
+	libewf_chunk_data_pool_t *chunk_data_pool;
+
 	/* The date format for certain header values
 	 */
 	int date_format;
@@ -150,10 +197,47 @@ struct libewf_internal_handle
 	 */
 	libewf_single_files_t *single_files;
 
+	/* The index file IO handle
+	 */
+	libbfio_handle_t *index_file_io_handle;
+
+	/* The index file
+	 */
+	libewf_index_file_t *index_file;
+
+	/* The memory mappings of the segment files, by file IO pool entry
+	 */
+	libcdata_array_t *segment_file_mappings;
+
+	/* The io_uring used to read the segment files asynchronously
+	 */
+	libewf_io_uring_t *io_uring;
+
+	/* Value to indicate io_uring cannot be used
+	 */
+	uint8_t io_uring_is_unavailable;
+
 #if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
 	/* The read/write lock
 	 */
 	libcthreads_read_write_lock_t *read_write_lock;
+
+	/* The mutex that serializes access to the file IO pool
+	 * and the segment and chunk tables by concurrent reads
+	 */
+	libcthreads_mutex_t *concurrent_read_mutex;
+
+	/* The thread pool that reads ahead
+	 */
+	libcthreads_thread_pool_t *read_ahead_thread_pool;
+
+	/* The write pipeline that compresses chunks written by write buffer
+	 */
+	libewf_write_pipeline_t *write_pipeline;
+
+	/* The unpack pool that unpacks chunks read by read data chunks
+	 */
+	libewf_unpack_pool_t *unpack_pool;
 #endif
 };
 
@@ -211,6 +295,15 @@ int libewf_internal_handle_open_read_segment_files(
      libewf_segment_table_t *segment_table,
      libcerror_error_t **error );
 
+int libewf_internal_handle_open_read_index_file(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_open_write_index_file(
+     libewf_internal_handle_t *internal_handle,
+     libewf_index_file_t *index_file,
+     libcerror_error_t **error );
+
 int libewf_internal_handle_open_file_io_pool(
      libewf_internal_handle_t *internal_handle,
      libbfio_pool_t *file_io_pool,
@@ -237,6 +330,45 @@ ssize_t libewf_internal_handle_read_buffer_from_file_io_pool(
          size_t buffer_size,
          libcerror_error_t **error );
 
+int libewf_internal_handle_get_chunk_data_for_concurrent_read(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     uint64_t chunk_index,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error );
+
+ssize_t libewf_internal_handle_read_buffer_at_offset_from_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+ssize_t libewf_internal_handle_concurrent_read_buffer_at_offset(
+         libewf_internal_handle_t *internal_handle,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+int libewf_internal_handle_start_read_ahead(
+     libewf_internal_handle_t *internal_handle,
+     off64_t offset,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_stop_read_ahead(
+     libewf_internal_handle_t *internal_handle,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_read_ahead_callback(
+     libewf_internal_handle_t *internal_handle,
+     void *arguments );
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
 LIBEWF_EXTERN \
 ssize_t libewf_handle_read_buffer(
          libewf_handle_t *handle,
@@ -252,6 +384,33 @@ ssize_t libewf_handle_read_buffer_at_offset(
          off64_t offset,
          libcerror_error_t **error );
 
+int libewf_internal_handle_get_segment_filename_by_file_io_pool_entry(
+     libewf_internal_handle_t *internal_handle,
+     int file_io_pool_entry,
+     char **filename,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_get_segment_file_mapping(
+     libewf_internal_handle_t *internal_handle,
+     int file_io_pool_entry,
+     libewf_file_mapping_t **file_mapping,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_get_chunk_view(
+     libewf_internal_handle_t *internal_handle,
+     uint64_t chunk_index,
+     const uint8_t **chunk_data,
+     size_t *chunk_data_size,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_chunk_view(
+     libewf_handle_t *handle,
+     uint64_t chunk_index,
+     const uint8_t **chunk_data,
+     size_t *chunk_data_size,
+     libcerror_error_t **error );
+
 ssize_t libewf_internal_handle_write_buffer_to_file_io_pool(
          libewf_internal_handle_t *internal_handle,
          libbfio_pool_t *file_io_pool,
@@ -259,6 +418,22 @@ ssize_t libewf_internal_handle_write_buffer_to_file_io_pool(
          size_t buffer_size,
          libcerror_error_t **error );
 
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+int libewf_internal_handle_push_chunk_onto_write_pipeline(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     uint64_t chunk_index,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_write_packed_chunks(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     int maximum_number_of_pending_jobs,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
 LIBEWF_EXTERN \
 ssize_t libewf_handle_write_buffer(
          libewf_handle_t *handle,
@@ -292,6 +467,71 @@ ssize_t libewf_handle_read_data_chunk(
          libewf_data_chunk_t *data_chunk,
          libcerror_error_t **error );
 
+int libewf_internal_handle_get_io_uring(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_io_request_t *requests,
+     int number_of_requests,
+     libewf_io_uring_t **io_uring,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_read_io_requests_from_file_io_pool(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     libewf_io_request_t *requests,
+     int number_of_requests,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_read_packed_chunks_from_file_io_pool(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     uint64_t first_chunk_index,
+     int number_of_chunks,
+     libewf_chunk_data_t **chunk_data_array,
+     libcerror_error_t **error );
+
+int libewf_internal_handle_read_data_chunks_from_file_io_pool(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     uint64_t first_chunk_index,
+     int number_of_chunks,
+     libewf_internal_data_chunk_t **internal_data_chunks,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_read_data_chunks(
+     libewf_handle_t *handle,
+     uint64_t first_chunk_index,
+     int number_of_chunks,
+     libewf_data_chunk_t **data_chunks,
+     libcerror_error_t **error );
+
+ssize_t libewf_internal_handle_read_packed_data_chunk_from_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         libewf_internal_data_chunk_t *internal_data_chunk,
+         libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+ssize_t libewf_handle_read_packed_data_chunk(
+         libewf_handle_t *handle,
+         libewf_data_chunk_t *data_chunk,
+         libcerror_error_t **error );
+
+int libewf_internal_handle_get_chunk_fill_info_from_file_io_pool(
+     libewf_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     uint64_t chunk_index,
+     uint64_t *fill_pattern,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_chunk_fill_info(
+     libewf_handle_t *handle,
+     uint64_t chunk_index,
+     uint64_t *fill_pattern,
+     libcerror_error_t **error );
+
 ssize_t libewf_internal_handle_write_data_chunk_to_file_io_pool(
          libewf_internal_handle_t *internal_handle,
          libbfio_pool_t *file_io_pool,
@@ -304,6 +544,18 @@ ssize_t libewf_handle_write_data_chunk(
          libewf_data_chunk_t *data_chunk,
          libcerror_error_t **error );
 
+ssize_t libewf_internal_handle_write_packed_data_chunk_to_file_io_pool(
+         libewf_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         libewf_internal_data_chunk_t *internal_data_chunk,
+         libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+ssize_t libewf_handle_write_packed_data_chunk(
+         libewf_handle_t *handle,
+         libewf_data_chunk_t *data_chunk,
+         libcerror_error_t **error );
+
 ssize_t libewf_internal_handle_write_finalize_file_io_pool(
          libewf_internal_handle_t *internal_handle,
          libbfio_pool_t *file_io_pool,
@@ -339,6 +591,39 @@ int libewf_handle_set_maximum_number_of_open_handles(
      int maximum_number_of_open_handles,
      libcerror_error_t **error );
 
+LIBEWF_EXTERN \
+int libewf_handle_set_cache_limits(
+     libewf_handle_t *handle,
+     size64_t maximum_chunks_cache_size,
+     size64_t maximum_chunk_groups_cache_size,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_maximum_number_of_read_ahead_chunks(
+     libewf_handle_t *handle,
+     int maximum_number_of_read_ahead_chunks,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_number_of_compression_threads(
+     libewf_handle_t *handle,
+     int number_of_compression_threads,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_set_write_buffer_values(
+     libewf_handle_t *handle,
+     size_t write_buffer_size,
+     uint8_t write_flags,
+     libcerror_error_t **error );
+
+LIBEWF_EXTERN \
+int libewf_handle_get_cache_statistics(
+     libewf_handle_t *handle,
+     uint64_t *number_of_cache_hits,
+     uint64_t *number_of_cache_misses,
+     libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 int libewf_handle_segment_files_corrupted(
      libewf_handle_t *handle,
@@ -405,6 +690,24 @@ int libewf_handle_set_maximum_segment_size(
      size64_t maximum_segment_size,
      libcerror_error_t **error );
 
+LIBEWF_EXTERN \
+int libewf_handle_set_index_filename(
+     libewf_handle_t *handle,
+     const char *filename,
+     size_t filename_length,
+     libcerror_error_t **error );
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+LIBEWF_EXTERN \
+int libewf_handle_set_index_filename_wide(
+     libewf_handle_t *handle,
+     const wchar_t *filename,
+     size_t filename_length,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
 LIBEWF_EXTERN \
 int libewf_handle_get_filename_size(
      libewf_handle_t *handle,
@@ -671,6 +974,12 @@ int libewf_handle_set_read_zero_chunk_on_error(
      uint8_t zero_on_error,
      libcerror_error_t **error );
 
+LIBEWF_EXTERN \
+int libewf_handle_set_read_tables_on_demand(
+     libewf_handle_t *handle,
+     uint8_t read_on_demand,
+     libcerror_error_t **error );
+
 LIBEWF_EXTERN \
 int libewf_handle_copy_media_values(
      libewf_handle_t *destination_handle,
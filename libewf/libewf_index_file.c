@@ -0,0 +1,1333 @@
+/*
+ * Index file functions
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_checksum.h"
+#include "libewf_index_file.h"
+#include "libewf_libbfio.h"
+#include "libewf_libcdata.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcnotify.h"
+
+#include "ewf_index_file.h"
+
+/* The maximum number of segments and chunk groups in an index file
+ */
+#define LIBEWF_INDEX_FILE_MAXIMUM_NUMBER_OF_ENTRIES	(uint32_t) ( INT_MAX / sizeof( ewf_index_file_segment_t ) )
+
+const uint8_t ewf_index_file_signature[ 8 ] = { 0x45, 0x57, 0x46, 0x49, 0x4e, 0x44, 0x45, 0x58 };
+
+/* Creates an index file segment
+ * Make sure the value segment is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_file_segment_initialize(
+     libewf_index_file_segment_t **segment,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_index_file_segment_initialize";
+
+	if( segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment.",
+		 function );
+
+		return( -1 );
+	}
+	if( *segment != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid segment value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*segment = memory_allocate_structure(
+	            libewf_index_file_segment_t );
+
+	if( *segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create segment.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *segment,
+	     0,
+	     sizeof( libewf_index_file_segment_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear segment.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *segment != NULL )
+	{
+		memory_free(
+		 *segment );
+
+		*segment = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees an index file segment
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_file_segment_free(
+     libewf_index_file_segment_t **segment,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_index_file_segment_free";
+
+	if( segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment.",
+		 function );
+
+		return( -1 );
+	}
+	if( *segment != NULL )
+	{
+		if( ( *segment )->chunk_groups != NULL )
+		{
+			memory_free(
+			 ( *segment )->chunk_groups );
+		}
+		memory_free(
+		 *segment );
+
+		*segment = NULL;
+	}
+	return( 1 );
+}
+
+/* Appends a chunk group to an index file segment
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_file_segment_append_chunk_group(
+     libewf_index_file_segment_t *segment,
+     off64_t data_offset,
+     size64_t data_size,
+     size64_t mapped_size,
+     uint32_t range_flags,
+     libcerror_error_t **error )
+{
+	libewf_index_file_chunk_group_t *chunk_group = NULL;
+	void *reallocation                           = NULL;
+	static char *function                        = "libewf_index_file_segment_append_chunk_group";
+	int maximum_number_of_chunk_groups           = 0;
+
+	if( segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment->number_of_chunk_groups >= (int) LIBEWF_INDEX_FILE_MAXIMUM_NUMBER_OF_ENTRIES )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid segment - number of chunk groups value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment->number_of_chunk_groups >= segment->maximum_number_of_chunk_groups )
+	{
+		maximum_number_of_chunk_groups = segment->maximum_number_of_chunk_groups * 2;
+
+		if( maximum_number_of_chunk_groups < 16 )
+		{
+			maximum_number_of_chunk_groups = 16;
+		}
+		reallocation = memory_reallocate(
+		                segment->chunk_groups,
+		                sizeof( libewf_index_file_chunk_group_t ) * maximum_number_of_chunk_groups );
+
+		if( reallocation == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize chunk groups.",
+			 function );
+
+			return( -1 );
+		}
+		segment->chunk_groups                   = (libewf_index_file_chunk_group_t *) reallocation;
+		segment->maximum_number_of_chunk_groups = maximum_number_of_chunk_groups;
+	}
+	chunk_group = &( segment->chunk_groups[ segment->number_of_chunk_groups ] );
+
+	chunk_group->data_offset = data_offset;
+	chunk_group->data_size   = data_size;
+	chunk_group->mapped_size = mapped_size;
+	chunk_group->range_flags = range_flags;
+
+	segment->number_of_chunk_groups += 1;
+
+	return( 1 );
+}
+
+/* Creates an index file
+ * Make sure the value index_file is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_file_initialize(
+     libewf_index_file_t **index_file,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_index_file_initialize";
+
+	if( index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( *index_file != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid index file value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*index_file = memory_allocate_structure(
+	               libewf_index_file_t );
+
+	if( *index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create index file.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *index_file,
+	     0,
+	     sizeof( libewf_index_file_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear index file.",
+		 function );
+
+		memory_free(
+		 *index_file );
+
+		*index_file = NULL;
+
+		return( -1 );
+	}
+	if( libcdata_array_initialize(
+	     &( ( *index_file )->segments_array ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create segments array.",
+		 function );
+
+		goto on_error;
+	}
+	( *index_file )->is_stale = 1;
+
+	return( 1 );
+
+on_error:
+	if( *index_file != NULL )
+	{
+		memory_free(
+		 *index_file );
+
+		*index_file = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees an index file
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_file_free(
+     libewf_index_file_t **index_file,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_index_file_free";
+	int result            = 1;
+
+	if( index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( *index_file != NULL )
+	{
+		if( libcdata_array_free(
+		     &( ( *index_file )->segments_array ),
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_index_file_segment_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free segments array.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *index_file );
+
+		*index_file = NULL;
+	}
+	return( result );
+}
+
+/* Retrieves the number of segments
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_file_get_number_of_segments(
+     libewf_index_file_t *index_file,
+     int *number_of_segments,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_index_file_get_number_of_segments";
+
+	if( index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     index_file->segments_array,
+	     number_of_segments,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of entries from segments array.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves a specific segment
+ * Returns 1 if successful, 0 if no such segment or -1 on error
+ */
+int libewf_index_file_get_segment_by_number(
+     libewf_index_file_t *index_file,
+     uint32_t segment_number,
+     libewf_index_file_segment_t **segment,
+     libcerror_error_t **error )
+{
+	static char *function  = "libewf_index_file_get_segment_by_number";
+	int number_of_segments = 0;
+
+	if( index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     index_file->segments_array,
+	     &number_of_segments,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of entries from segments array.",
+		 function );
+
+		return( -1 );
+	}
+	/* The segments are stored in segment number order starting with 1
+	 */
+	if( ( segment_number == 0 )
+	 || ( segment_number > (uint32_t) number_of_segments ) )
+	{
+		return( 0 );
+	}
+	if( libcdata_array_get_entry_by_index(
+	     index_file->segments_array,
+	     (int) segment_number - 1,
+	     (intptr_t **) segment,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment: %" PRIu32 " from array.",
+		 function,
+		 segment_number );
+
+		return( -1 );
+	}
+	if( *segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing segment: %" PRIu32 ".",
+		 function,
+		 segment_number );
+
+		return( -1 );
+	}
+	if( ( *segment )->segment_number != segment_number )
+	{
+		*segment = NULL;
+
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Appends a segment
+ * The index file takes over management of the segment
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_file_append_segment(
+     libewf_index_file_t *index_file,
+     libewf_index_file_segment_t *segment,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_index_file_append_segment";
+	int entry_index       = 0;
+
+	if( index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment->number_of_chunk_groups > ( (int) LIBEWF_INDEX_FILE_MAXIMUM_NUMBER_OF_ENTRIES - index_file->number_of_chunk_groups ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid segment - number of chunk groups value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_append_entry(
+	     index_file->segments_array,
+	     &entry_index,
+	     (intptr_t *) segment,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append segment: %" PRIu32 " to array.",
+		 function,
+		 segment->segment_number );
+
+		return( -1 );
+	}
+	index_file->number_of_chunk_groups += segment->number_of_chunk_groups;
+
+	return( 1 );
+}
+
+/* Reads an index file
+ * The file IO handle must be opened for reading
+ * Returns 1 if successful, 0 if the data is not a valid index file or -1 on error
+ */
+int libewf_index_file_read_file_io_handle(
+     libewf_index_file_t *index_file,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	ewf_index_file_header_t file_header;
+
+	ewf_index_file_chunk_group_t *chunk_group_data = NULL;
+	ewf_index_file_segment_t *segment_data         = NULL;
+	libewf_index_file_segment_t *segment           = NULL;
+	uint8_t *index_data                            = NULL;
+	static char *function                          = "libewf_index_file_read_file_io_handle";
+	size64_t file_size                             = 0;
+	size_t index_data_offset                       = 0;
+	size_t index_data_size                         = 0;
+	ssize_t read_count                             = 0;
+	uint64_t value_64bit                           = 0;
+	uint32_t calculated_checksum                   = 0;
+	uint32_t chunk_group_index                     = 0;
+	uint32_t format_version                        = 0;
+	uint32_t number_of_chunk_groups                = 0;
+	uint32_t number_of_segments                    = 0;
+	uint32_t segment_index                         = 0;
+	uint32_t segment_number_of_chunk_groups        = 0;
+	uint32_t stored_checksum                       = 0;
+	uint32_t total_number_of_chunk_groups          = 0;
+	uint32_t value_32bit                           = 0;
+
+	if( index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_empty(
+	     index_file->segments_array,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_index_file_segment_free,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty segments array.",
+		 function );
+
+		return( -1 );
+	}
+	index_file->number_of_chunk_groups = 0;
+	index_file->is_stale               = 1;
+
+	if( libbfio_handle_get_size(
+	     file_io_handle,
+	     &file_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to retrieve file size.",
+		 function );
+
+		goto on_error;
+	}
+	if( file_size < (size64_t) sizeof( ewf_index_file_header_t ) )
+	{
+		return( 0 );
+	}
+	if( libbfio_handle_seek_offset(
+	     file_io_handle,
+	     0,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek file header offset: 0.",
+		 function );
+
+		goto on_error;
+	}
+	read_count = libbfio_handle_read_buffer(
+	              file_io_handle,
+	              (uint8_t *) &file_header,
+	              sizeof( ewf_index_file_header_t ),
+	              error );
+
+	if( read_count != (ssize_t) sizeof( ewf_index_file_header_t ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read file header.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_compare(
+	     file_header.signature,
+	     ewf_index_file_signature,
+	     8 ) != 0 )
+	{
+		return( 0 );
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 file_header.format_version,
+	 format_version );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 file_header.number_of_segments,
+	 number_of_segments );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 file_header.number_of_chunk_groups,
+	 number_of_chunk_groups );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 file_header.checksum,
+	 stored_checksum );
+
+	if( libewf_checksum_calculate_adler32(
+	     &calculated_checksum,
+	     (uint8_t *) &file_header,
+	     sizeof( ewf_index_file_header_t ) - 4,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate header checksum.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: format version\t\t\t: %" PRIu32 "\n",
+		 function,
+		 format_version );
+
+		libcnotify_printf(
+		 "%s: number of segments\t\t: %" PRIu32 "\n",
+		 function,
+		 number_of_segments );
+
+		libcnotify_printf(
+		 "%s: number of chunk groups\t\t: %" PRIu32 "\n",
+		 function,
+		 number_of_chunk_groups );
+
+		libcnotify_printf(
+		 "\n" );
+	}
+#endif
+	if( ( format_version != 1 )
+	 || ( stored_checksum != calculated_checksum ) )
+	{
+		return( 0 );
+	}
+	if( ( number_of_segments > LIBEWF_INDEX_FILE_MAXIMUM_NUMBER_OF_ENTRIES )
+	 || ( number_of_chunk_groups > LIBEWF_INDEX_FILE_MAXIMUM_NUMBER_OF_ENTRIES ) )
+	{
+		return( 0 );
+	}
+	index_data_size = ( sizeof( ewf_index_file_segment_t ) * number_of_segments )
+	                + ( sizeof( ewf_index_file_chunk_group_t ) * number_of_chunk_groups );
+
+	if( ( index_data_size == 0 )
+	 || ( (size64_t) index_data_size != ( file_size - sizeof( ewf_index_file_header_t ) ) ) )
+	{
+		return( 0 );
+	}
+	index_data = (uint8_t *) memory_allocate(
+	                          sizeof( uint8_t ) * index_data_size );
+
+	if( index_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create index data.",
+		 function );
+
+		goto on_error;
+	}
+	read_count = libbfio_handle_read_buffer(
+	              file_io_handle,
+	              index_data,
+	              index_data_size,
+	              error );
+
+	if( read_count != (ssize_t) index_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read index data.",
+		 function );
+
+		goto on_error;
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 file_header.data_checksum,
+	 stored_checksum );
+
+	if( libewf_checksum_calculate_adler32(
+	     &calculated_checksum,
+	     index_data,
+	     index_data_size,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate data checksum.",
+		 function );
+
+		goto on_error;
+	}
+	if( stored_checksum != calculated_checksum )
+	{
+		memory_free(
+		 index_data );
+
+		return( 0 );
+	}
+	/* Each segment entry is followed by the entries of its chunk groups
+	 */
+	for( segment_index = 0;
+	     segment_index < number_of_segments;
+	     segment_index++ )
+	{
+		if( ( index_data_size - index_data_offset ) < sizeof( ewf_index_file_segment_t ) )
+		{
+			goto on_invalid_data;
+		}
+		segment_data = (ewf_index_file_segment_t *) &( index_data[ index_data_offset ] );
+
+		index_data_offset += sizeof( ewf_index_file_segment_t );
+
+		if( libewf_index_file_segment_initialize(
+		     &segment,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create segment.",
+			 function );
+
+			goto on_error;
+		}
+		byte_stream_copy_to_uint32_little_endian(
+		 segment_data->segment_number,
+		 segment->segment_number );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 segment_data->number_of_sections,
+		 value_32bit );
+
+		if( value_32bit > (uint32_t) INT_MAX )
+		{
+			goto on_invalid_data;
+		}
+		segment->number_of_sections = (int) value_32bit;
+
+		byte_stream_copy_to_uint64_little_endian(
+		 segment_data->segment_file_size,
+		 segment->segment_file_size );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 segment_data->last_section_offset,
+		 value_64bit );
+
+		if( value_64bit > (uint64_t) INT64_MAX )
+		{
+			goto on_invalid_data;
+		}
+		segment->last_section_offset = (off64_t) value_64bit;
+
+		byte_stream_copy_to_uint64_little_endian(
+		 segment_data->storage_media_size,
+		 segment->storage_media_size );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 segment_data->number_of_chunks,
+		 segment->number_of_chunks );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 segment_data->last_chunk_filled,
+		 value_64bit );
+
+		segment->last_chunk_filled = (int64_t) value_64bit;
+
+		byte_stream_copy_to_uint32_little_endian(
+		 segment_data->number_of_chunk_groups,
+		 segment_number_of_chunk_groups );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 segment_data->flags,
+		 value_32bit );
+
+		segment->flags = (uint8_t) value_32bit;
+
+		if( ( segment->segment_number != ( segment_index + 1 ) )
+		 || ( segment_number_of_chunk_groups > ( number_of_chunk_groups - total_number_of_chunk_groups ) ) )
+		{
+			goto on_invalid_data;
+		}
+		for( chunk_group_index = 0;
+		     chunk_group_index < segment_number_of_chunk_groups;
+		     chunk_group_index++ )
+		{
+			chunk_group_data = (ewf_index_file_chunk_group_t *) &( index_data[ index_data_offset ] );
+
+			index_data_offset += sizeof( ewf_index_file_chunk_group_t );
+
+			byte_stream_copy_to_uint64_little_endian(
+			 chunk_group_data->data_offset,
+			 value_64bit );
+
+			if( value_64bit > (uint64_t) INT64_MAX )
+			{
+				goto on_invalid_data;
+			}
+			byte_stream_copy_to_uint32_little_endian(
+			 chunk_group_data->range_flags,
+			 value_32bit );
+
+			if( libewf_index_file_segment_append_chunk_group(
+			     segment,
+			     (off64_t) value_64bit,
+			     0,
+			     0,
+			     value_32bit,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append chunk group: %" PRIu32 " to segment: %" PRIu32 ".",
+				 function,
+				 chunk_group_index,
+				 segment->segment_number );
+
+				goto on_error;
+			}
+			byte_stream_copy_to_uint64_little_endian(
+			 chunk_group_data->data_size,
+			 segment->chunk_groups[ chunk_group_index ].data_size );
+
+			byte_stream_copy_to_uint64_little_endian(
+			 chunk_group_data->mapped_size,
+			 segment->chunk_groups[ chunk_group_index ].mapped_size );
+		}
+		total_number_of_chunk_groups += segment_number_of_chunk_groups;
+
+		if( libewf_index_file_append_segment(
+		     index_file,
+		     segment,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append segment: %" PRIu32 ".",
+			 function,
+			 segment_index + 1 );
+
+			goto on_error;
+		}
+		segment = NULL;
+	}
+	if( index_data_offset != index_data_size )
+	{
+		goto on_invalid_data;
+	}
+	memory_free(
+	 index_data );
+
+	index_file->is_stale = 0;
+
+	return( 1 );
+
+on_invalid_data:
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: invalid index data.\n",
+		 function );
+	}
+#endif
+	if( segment != NULL )
+	{
+		libewf_index_file_segment_free(
+		 &segment,
+		 NULL );
+	}
+	memory_free(
+	 index_data );
+
+	if( libcdata_array_empty(
+	     index_file->segments_array,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libewf_index_file_segment_free,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty segments array.",
+		 function );
+
+		return( -1 );
+	}
+	index_file->number_of_chunk_groups = 0;
+
+	return( 0 );
+
+on_error:
+	if( segment != NULL )
+	{
+		libewf_index_file_segment_free(
+		 &segment,
+		 NULL );
+	}
+	if( index_data != NULL )
+	{
+		memory_free(
+		 index_data );
+	}
+	libcdata_array_empty(
+	 index_file->segments_array,
+	 (int (*)(intptr_t **, libcerror_error_t **)) &libewf_index_file_segment_free,
+	 NULL );
+
+	index_file->number_of_chunk_groups = 0;
+
+	return( -1 );
+}
+
+/* Writes an index file
+ * The file IO handle must be opened for writing
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_index_file_write_file_io_handle(
+     libewf_index_file_t *index_file,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	ewf_index_file_chunk_group_t *chunk_group_data = NULL;
+	ewf_index_file_header_t *file_header           = NULL;
+	ewf_index_file_segment_t *segment_data         = NULL;
+	libewf_index_file_chunk_group_t *chunk_group   = NULL;
+	libewf_index_file_segment_t *segment           = NULL;
+	uint8_t *index_data                            = NULL;
+	static char *function                          = "libewf_index_file_write_file_io_handle";
+	size_t index_data_offset                       = 0;
+	size_t index_data_size                         = 0;
+	ssize_t write_count                            = 0;
+	uint32_t checksum                              = 0;
+	int chunk_group_index                          = 0;
+	int number_of_segments                         = 0;
+	int segment_index                              = 0;
+
+	if( index_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid index file.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     index_file->segments_array,
+	     &number_of_segments,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of entries from segments array.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_segments <= 0 )
+	 || ( (uint32_t) number_of_segments > LIBEWF_INDEX_FILE_MAXIMUM_NUMBER_OF_ENTRIES ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of segments value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	index_data_size = sizeof( ewf_index_file_header_t )
+	                + ( sizeof( ewf_index_file_segment_t ) * (size_t) number_of_segments )
+	                + ( sizeof( ewf_index_file_chunk_group_t ) * (size_t) index_file->number_of_chunk_groups );
+
+	index_data = (uint8_t *) memory_allocate(
+	                          sizeof( uint8_t ) * index_data_size );
+
+	if( index_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create index data.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     index_data,
+	     0,
+	     index_data_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear index data.",
+		 function );
+
+		goto on_error;
+	}
+	index_data_offset = sizeof( ewf_index_file_header_t );
+
+	for( segment_index = 0;
+	     segment_index < number_of_segments;
+	     segment_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     index_file->segments_array,
+		     segment_index,
+		     (intptr_t **) &segment,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment: %d from array.",
+			 function,
+			 segment_index );
+
+			goto on_error;
+		}
+		if( segment == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing segment: %d.",
+			 function,
+			 segment_index );
+
+			goto on_error;
+		}
+		segment_data = (ewf_index_file_segment_t *) &( index_data[ index_data_offset ] );
+
+		index_data_offset += sizeof( ewf_index_file_segment_t );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 segment_data->segment_number,
+		 segment->segment_number );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 segment_data->number_of_sections,
+		 (uint32_t) segment->number_of_sections );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 segment_data->segment_file_size,
+		 segment->segment_file_size );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 segment_data->last_section_offset,
+		 (uint64_t) segment->last_section_offset );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 segment_data->storage_media_size,
+		 segment->storage_media_size );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 segment_data->number_of_chunks,
+		 segment->number_of_chunks );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 segment_data->last_chunk_filled,
+		 (uint64_t) segment->last_chunk_filled );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 segment_data->number_of_chunk_groups,
+		 (uint32_t) segment->number_of_chunk_groups );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 segment_data->flags,
+		 (uint32_t) segment->flags );
+
+		for( chunk_group_index = 0;
+		     chunk_group_index < segment->number_of_chunk_groups;
+		     chunk_group_index++ )
+		{
+			chunk_group      = &( segment->chunk_groups[ chunk_group_index ] );
+			chunk_group_data = (ewf_index_file_chunk_group_t *) &( index_data[ index_data_offset ] );
+
+			index_data_offset += sizeof( ewf_index_file_chunk_group_t );
+
+			byte_stream_copy_from_uint64_little_endian(
+			 chunk_group_data->data_offset,
+			 (uint64_t) chunk_group->data_offset );
+
+			byte_stream_copy_from_uint64_little_endian(
+			 chunk_group_data->data_size,
+			 chunk_group->data_size );
+
+			byte_stream_copy_from_uint64_little_endian(
+			 chunk_group_data->mapped_size,
+			 chunk_group->mapped_size );
+
+			byte_stream_copy_from_uint32_little_endian(
+			 chunk_group_data->range_flags,
+			 chunk_group->range_flags );
+		}
+	}
+	if( libewf_checksum_calculate_adler32(
+	     &checksum,
+	     &( index_data[ sizeof( ewf_index_file_header_t ) ] ),
+	     index_data_size - sizeof( ewf_index_file_header_t ),
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate data checksum.",
+		 function );
+
+		goto on_error;
+	}
+	file_header = (ewf_index_file_header_t *) index_data;
+
+	if( memory_copy(
+	     file_header->signature,
+	     ewf_index_file_signature,
+	     8 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy signature.",
+		 function );
+
+		goto on_error;
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 file_header->format_version,
+	 1 );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 file_header->number_of_segments,
+	 (uint32_t) number_of_segments );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 file_header->number_of_chunk_groups,
+	 (uint32_t) index_file->number_of_chunk_groups );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 file_header->data_checksum,
+	 checksum );
+
+	if( libewf_checksum_calculate_adler32(
+	     &checksum,
+	     index_data,
+	     sizeof( ewf_index_file_header_t ) - 4,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate header checksum.",
+		 function );
+
+		goto on_error;
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 file_header->checksum,
+	 checksum );
+
+	if( libbfio_handle_seek_offset(
+	     file_io_handle,
+	     0,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek file header offset: 0.",
+		 function );
+
+		goto on_error;
+	}
+	write_count = libbfio_handle_write_buffer(
+	               file_io_handle,
+	               index_data,
+	               index_data_size,
+	               error );
+
+	if( write_count != (ssize_t) index_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write index data.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 index_data );
+
+	return( 1 );
+
+on_error:
+	if( index_data != NULL )
+	{
+		memory_free(
+		 index_data );
+	}
+	return( -1 );
+}
+
@@ -0,0 +1,180 @@
+/*
+ * Index file functions
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_INDEX_FILE_H )
+#define _LIBEWF_INDEX_FILE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_libbfio.h"
+#include "libewf_libcdata.h"
+#include "libewf_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+extern const uint8_t ewf_index_file_signature[ 8 ];
+
+typedef struct libewf_index_file_chunk_group libewf_index_file_chunk_group_t;
+
+struct libewf_index_file_chunk_group
+{
+	/* The data offset
+	 */
+	off64_t data_offset;
+
+	/* The data size
+	 */
+	size64_t data_size;
+
+	/* The mapped size
+	 */
+	size64_t mapped_size;
+
+	/* The range flags
+	 */
+	uint32_t range_flags;
+};
+
+typedef struct libewf_index_file_segment libewf_index_file_segment_t;
+
+struct libewf_index_file_segment
+{
+	/* The segment number
+	 */
+	uint32_t segment_number;
+
+	/* The number of sections
+	 */
+	int number_of_sections;
+
+	/* The segment file size
+	 */
+	size64_t segment_file_size;
+
+	/* The last section offset
+	 */
+	off64_t last_section_offset;
+
+	/* The storage media size
+	 */
+	size64_t storage_media_size;
+
+	/* The number of chunks
+	 */
+	uint64_t number_of_chunks;
+
+	/* The last chunk filled
+	 */
+	int64_t last_chunk_filled;
+
+	/* The segment file flags
+	 */
+	uint8_t flags;
+
+	/* The chunk groups
+	 */
+	libewf_index_file_chunk_group_t *chunk_groups;
+
+	/* The number of chunk groups
+	 */
+	int number_of_chunk_groups;
+
+	/* The number of allocated chunk groups
+	 */
+	int maximum_number_of_chunk_groups;
+};
+
+typedef struct libewf_index_file libewf_index_file_t;
+
+struct libewf_index_file
+{
+	/* The segments array
+	 */
+	libcdata_array_t *segments_array;
+
+	/* The total number of chunk groups
+	 */
+	int number_of_chunk_groups;
+
+	/* Value to indicate the index file does not match the segment files
+	 */
+	uint8_t is_stale;
+};
+
+int libewf_index_file_segment_initialize(
+     libewf_index_file_segment_t **segment,
+     libcerror_error_t **error );
+
+int libewf_index_file_segment_free(
+     libewf_index_file_segment_t **segment,
+     libcerror_error_t **error );
+
+int libewf_index_file_segment_append_chunk_group(
+     libewf_index_file_segment_t *segment,
+     off64_t data_offset,
+     size64_t data_size,
+     size64_t mapped_size,
+     uint32_t range_flags,
+     libcerror_error_t **error );
+
+int libewf_index_file_initialize(
+     libewf_index_file_t **index_file,
+     libcerror_error_t **error );
+
+int libewf_index_file_free(
+     libewf_index_file_t **index_file,
+     libcerror_error_t **error );
+
+int libewf_index_file_get_number_of_segments(
+     libewf_index_file_t *index_file,
+     int *number_of_segments,
+     libcerror_error_t **error );
+
+int libewf_index_file_get_segment_by_number(
+     libewf_index_file_t *index_file,
+     uint32_t segment_number,
+     libewf_index_file_segment_t **segment,
+     libcerror_error_t **error );
+
+int libewf_index_file_append_segment(
+     libewf_index_file_t *index_file,
+     libewf_index_file_segment_t *segment,
+     libcerror_error_t **error );
+
+int libewf_index_file_read_file_io_handle(
+     libewf_index_file_t *index_file,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+int libewf_index_file_write_file_io_handle(
+     libewf_index_file_t *index_file,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_INDEX_FILE_H ) */
+
@@ -24,6 +24,7 @@
 #include <types.h>
 
 #include "libewf_codepage.h"
+#include "libewf_compression_cache.h"
 #include "libewf_definitions.h"
 #include "libewf_io_handle.h"
 #include "libewf_libcerror.h"
@@ -88,15 +89,29 @@ int libewf_io_handle_initialize(
 
 		goto on_error;
 	}
-	( *io_handle )->segment_file_type  = LIBEWF_SEGMENT_FILE_TYPE_UNDEFINED;
-	( *io_handle )->format             = LIBEWF_FORMAT_ENCASE6;
-	( *io_handle )->major_version      = 1;
-	( *io_handle )->minor_version      = 0;
-	( *io_handle )->compression_method = LIBEWF_COMPRESSION_METHOD_DEFLATE;
-	( *io_handle )->compression_level  = LIBEWF_COMPRESSION_NONE;
-	( *io_handle )->zero_on_error      = 1;
-	( *io_handle )->header_codepage    = LIBEWF_CODEPAGE_ASCII;
+	( *io_handle )->segment_file_type         = LIBEWF_SEGMENT_FILE_TYPE_UNDEFINED;
+	( *io_handle )->format                    = LIBEWF_FORMAT_ENCASE6;
+	( *io_handle )->major_version             = 1;
+	( *io_handle )->minor_version             = 0;
+	( *io_handle )->compression_method        = LIBEWF_COMPRESSION_METHOD_DEFLATE;
+	( *io_handle )->compression_level         = LIBEWF_COMPRESSION_NONE;
+	( *io_handle )->zero_on_error             = 1;
+	( *io_handle )->segment_write_buffer_size = LIBEWF_DEFAULT_SEGMENT_WRITE_BUFFER_SIZE;
+	( *io_handle )->header_codepage           = LIBEWF_CODEPAGE_ASCII;
+
+	if( libewf_compression_cache_initialize(
+	     &( ( *io_handle )->compression_cache ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create compression cache.",
+		 function );
 
+		goto on_error;
+	}
 	return( 1 );
 
 on_error:
@@ -146,6 +161,19 @@ int libewf_io_handle_free(
 
 			result = -1;
 		}
+		if( libewf_compression_cache_free(
+		     &( ( *io_handle )->compression_cache ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free compression cache.",
+			 function );
+
+			result = -1;
+		}
 		memory_free(
 		 *io_handle );
 
@@ -161,7 +189,8 @@ int libewf_io_handle_clear(
      libewf_io_handle_t *io_handle,
      libcerror_error_t **error )
 {
-	static char *function = "libewf_io_handle_clear";
+	libewf_compression_cache_t *compression_cache = NULL;
+	static char *function                         = "libewf_io_handle_clear";
 
 	if( io_handle == NULL )
 	{
@@ -174,6 +203,26 @@ int libewf_io_handle_clear(
 
 		return( -1 );
 	}
+	/* The compression cache is retained but its (de)compressors are freed
+	 */
+	if( io_handle->compression_cache != NULL )
+	{
+		if( libewf_compression_cache_empty(
+		     io_handle->compression_cache,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to empty compression cache.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	compression_cache = io_handle->compression_cache;
+
 	if( memory_set(
 	     io_handle,
 	     0,
@@ -188,14 +237,16 @@ int libewf_io_handle_clear(
 
 		return( -1 );
 	}
-	io_handle->segment_file_type  = LIBEWF_SEGMENT_FILE_TYPE_UNDEFINED;
-	io_handle->format             = LIBEWF_FORMAT_ENCASE6;
-	io_handle->major_version      = 1;
-	io_handle->minor_version      = 0;
-	io_handle->compression_method = LIBEWF_COMPRESSION_METHOD_DEFLATE;
-	io_handle->compression_level  = LIBEWF_COMPRESSION_NONE;
-	io_handle->zero_on_error      = 1;
-	io_handle->header_codepage    = LIBEWF_CODEPAGE_ASCII;
+	io_handle->compression_cache         = compression_cache;
+	io_handle->segment_file_type         = LIBEWF_SEGMENT_FILE_TYPE_UNDEFINED;
+	io_handle->format                    = LIBEWF_FORMAT_ENCASE6;
+	io_handle->major_version             = 1;
+	io_handle->minor_version             = 0;
+	io_handle->compression_method        = LIBEWF_COMPRESSION_METHOD_DEFLATE;
+	io_handle->compression_level         = LIBEWF_COMPRESSION_NONE;
+	io_handle->zero_on_error             = 1;
+	io_handle->segment_write_buffer_size = LIBEWF_DEFAULT_SEGMENT_WRITE_BUFFER_SIZE;
+	io_handle->header_codepage           = LIBEWF_CODEPAGE_ASCII;
 
 	return( 1 );
 }
@@ -266,8 +317,23 @@ int libewf_io_handle_clone(
 
 		goto on_error;
 	}
-	( *destination_io_handle )->zero_on_error = source_io_handle->zero_on_error;
+	( *destination_io_handle )->zero_on_error     = source_io_handle->zero_on_error;
+	( *destination_io_handle )->index_file        = NULL;
+	( *destination_io_handle )->compression_cache = NULL;
 
+	if( libewf_compression_cache_initialize(
+	     &( ( *destination_io_handle )->compression_cache ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination compression cache.",
+		 function );
+
+		goto on_error;
+	}
 	return( 1 );
 
 on_error:
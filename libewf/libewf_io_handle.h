@@ -25,6 +25,8 @@
 #include <common.h>
 #include <types.h>
 
+#include "libewf_compression_cache.h"
+#include "libewf_index_file.h"
 #include "libewf_libcerror.h"
 
 #if defined( __cplusplus )
@@ -79,6 +81,20 @@ struct libewf_io_handle
 	 */
 	uint8_t zero_on_error;
 
+	/* Value to indicate if the table sections of the segment files
+	 * other than the first should be read on demand
+	 */
+	uint8_t read_tables_on_demand;
+
+	/* The size of the buffer used to coalesce the writes to a segment file
+	 * a value of 0 disables the buffer
+	 */
+	size_t segment_write_buffer_size;
+
+	/* The segment file write flags
+	 */
+	uint8_t segment_write_flags;
+
 	/* The header codepage
 	 */
 	int header_codepage;
@@ -86,6 +102,15 @@ struct libewf_io_handle
 	/* Value to indicate if abort was signalled
 	 */
 	int abort;
+
+	/* The index file used to read the chunk groups of segment files
+	 * this is a reference to the index file of the handle
+	 */
+	libewf_index_file_t *index_file;
+
+	/* The compression cache
+	 */
+	libewf_compression_cache_t *compression_cache;
 };
 
 int libewf_io_handle_initialize(
@@ -0,0 +1,669 @@
+/*
+ * Asynchronous file IO functions using io_uring
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_ERRNO_H )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_FCNTL_H )
+#include <fcntl.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "libewf_definitions.h"
+#include "libewf_io_uring.h"
+#include "libewf_libcerror.h"
+
+#if defined( LIBEWF_HAVE_IO_URING ) && !defined( O_CLOEXEC )
+#define O_CLOEXEC	0
+#endif
+
+/* Creates an io_uring
+ * Make sure the value io_uring is referencing, is set to NULL
+ * Returns 1 if successful, 0 if io_uring is not supported or -1 on error
+ */
+int libewf_io_uring_initialize(
+     libewf_io_uring_t **io_uring,
+     unsigned int queue_depth,
+     libcerror_error_t **error )
+{
+#if defined( LIBEWF_HAVE_IO_URING )
+	libewf_io_uring_t *safe_io_uring = NULL;
+#endif
+	static char *function            = "libewf_io_uring_initialize";
+
+	if( io_uring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid io_uring.",
+		 function );
+
+		return( -1 );
+	}
+	if( *io_uring != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid io_uring value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( queue_depth == 0 )
+	 || ( queue_depth > 4096 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid queue depth value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( LIBEWF_HAVE_IO_URING )
+	safe_io_uring = memory_allocate_structure(
+	                 libewf_io_uring_t );
+
+	if( safe_io_uring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create io_uring.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     safe_io_uring,
+	     0,
+	     sizeof( libewf_io_uring_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear io_uring.",
+		 function );
+
+		memory_free(
+		 safe_io_uring );
+
+		return( -1 );
+	}
+	/* The kernel can lack io_uring support or deny its use, e.g. by a seccomp
+	 * policy, in which case the caller falls back to synchronous reads
+	 */
+	if( io_uring_queue_init(
+	     queue_depth,
+	     &( safe_io_uring->ring ),
+	     0 ) != 0 )
+	{
+		memory_free(
+		 safe_io_uring );
+
+		return( 0 );
+	}
+	safe_io_uring->queue_depth = queue_depth;
+
+	*io_uring = safe_io_uring;
+
+	return( 1 );
+#else
+	return( 0 );
+#endif /* defined( LIBEWF_HAVE_IO_URING ) */
+}
+
+/* Frees an io_uring
+ * The opened files are closed
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_io_uring_free(
+     libewf_io_uring_t **io_uring,
+     libcerror_error_t **error )
+{
+	static char *function  = "libewf_io_uring_free";
+	int file_io_pool_entry = 0;
+	int result             = 1;
+
+	if( io_uring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid io_uring.",
+		 function );
+
+		return( -1 );
+	}
+	if( *io_uring != NULL )
+	{
+		if( ( *io_uring )->file_descriptors != NULL )
+		{
+			for( file_io_pool_entry = 0;
+			     file_io_pool_entry < ( *io_uring )->number_of_file_descriptors;
+			     file_io_pool_entry++ )
+			{
+#if defined( LIBEWF_HAVE_IO_URING )
+				if( ( *io_uring )->file_descriptors[ file_io_pool_entry ] != -1 )
+				{
+					if( close(
+					     ( *io_uring )->file_descriptors[ file_io_pool_entry ] ) != 0 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_IO,
+						 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+						 "%s: unable to close file: %d.",
+						 function,
+						 file_io_pool_entry );
+
+						result = -1;
+					}
+				}
+#endif
+			}
+			memory_free(
+			 ( *io_uring )->file_descriptors );
+		}
+#if defined( LIBEWF_HAVE_IO_URING )
+		io_uring_queue_exit(
+		 &( ( *io_uring )->ring ) );
+#endif
+		memory_free(
+		 *io_uring );
+
+		*io_uring = NULL;
+	}
+	return( result );
+}
+
+/* Determines if the file of a specific file IO pool entry was opened
+ * Returns 1 if opened, 0 if not or -1 on error
+ */
+int libewf_io_uring_has_file(
+     libewf_io_uring_t *io_uring,
+     int file_io_pool_entry,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_io_uring_has_file";
+
+	if( io_uring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid io_uring.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_pool_entry < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid file IO pool entry value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_pool_entry >= io_uring->number_of_file_descriptors )
+	{
+		return( 0 );
+	}
+	if( io_uring->file_descriptors[ file_io_pool_entry ] == -1 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Opens the file of a specific file IO pool entry read-only
+ * Returns 1 if successful, 0 if the file cannot be opened or -1 on error
+ */
+int libewf_io_uring_open_file(
+     libewf_io_uring_t *io_uring,
+     int file_io_pool_entry,
+     const char *filename,
+     libcerror_error_t **error )
+{
+#if defined( LIBEWF_HAVE_IO_URING )
+	int *reallocation     = NULL;
+	int entry_index       = 0;
+	int file_descriptor   = -1;
+#endif
+	static char *function = "libewf_io_uring_open_file";
+
+	if( io_uring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid io_uring.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( file_io_pool_entry < 0 )
+	 || ( (size_t) file_io_pool_entry >= (size_t) ( SSIZE_MAX / sizeof( int ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid file IO pool entry value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( LIBEWF_HAVE_IO_URING )
+	if( file_io_pool_entry >= io_uring->number_of_file_descriptors )
+	{
+		reallocation = (int *) memory_reallocate(
+		                        io_uring->file_descriptors,
+		                        sizeof( int ) * ( file_io_pool_entry + 1 ) );
+
+		if( reallocation == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize file descriptors.",
+			 function );
+
+			return( -1 );
+		}
+		io_uring->file_descriptors = reallocation;
+
+		for( entry_index = io_uring->number_of_file_descriptors;
+		     entry_index <= file_io_pool_entry;
+		     entry_index++ )
+		{
+			io_uring->file_descriptors[ entry_index ] = -1;
+		}
+		io_uring->number_of_file_descriptors = file_io_pool_entry + 1;
+	}
+	if( io_uring->file_descriptors[ file_io_pool_entry ] != -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid io_uring - file: %d already opened.",
+		 function,
+		 file_io_pool_entry );
+
+		return( -1 );
+	}
+	file_descriptor = open(
+	                   filename,
+	                   O_RDONLY | O_CLOEXEC );
+
+	if( file_descriptor == -1 )
+	{
+		return( 0 );
+	}
+	io_uring->file_descriptors[ file_io_pool_entry ] = file_descriptor;
+
+	return( 1 );
+#else
+	return( 0 );
+#endif /* defined( LIBEWF_HAVE_IO_URING ) */
+}
+
+/* Reads the data of multiple requests
+ * Up to queue depth requests are kept in flight, short reads are resubmitted for the remaining data
+ * All requests that were submitted are completed before the function returns, also on error
+ * If the requests cannot be submitted the io_uring can no longer be used, since prepared requests
+ * would remain in the submission queue, and the caller should fall back to synchronous reads
+ * Returns 1 if successful, 0 if the io_uring can no longer be used or -1 on error
+ */
+int libewf_io_uring_read_requests(
+     libewf_io_uring_t *io_uring,
+     libewf_io_request_t *requests,
+     int number_of_requests,
+     libcerror_error_t **error )
+{
+#if defined( LIBEWF_HAVE_IO_URING )
+	struct io_uring_cqe *completion_queue_entry = NULL;
+	struct io_uring_sqe *submission_queue_entry = NULL;
+	libewf_io_request_t *request                = NULL;
+	unsigned int number_of_queued_requests      = 0;
+	unsigned int number_of_requests_in_flight   = 0;
+	unsigned int number_of_wait_failures        = 0;
+	int completion_result                       = 0;
+	int request_index                           = 0;
+	int result                                  = 1;
+#endif
+	static char *function                       = "libewf_io_uring_read_requests";
+
+	if( io_uring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid io_uring.",
+		 function );
+
+		return( -1 );
+	}
+	if( requests == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid requests.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_requests < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of requests value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( LIBEWF_HAVE_IO_URING )
+	if( io_uring->is_unusable != 0 )
+	{
+		return( 0 );
+	}
+	for( request_index = 0;
+	     request_index < number_of_requests;
+	     request_index++ )
+	{
+		request = &( requests[ request_index ] );
+
+		if( ( request->file_io_pool_entry < 0 )
+		 || ( request->file_io_pool_entry >= io_uring->number_of_file_descriptors )
+		 || ( io_uring->file_descriptors[ request->file_io_pool_entry ] == -1 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid request: %d - missing file: %d.",
+			 function,
+			 request_index,
+			 request->file_io_pool_entry );
+
+			return( -1 );
+		}
+		if( ( request->offset < 0 )
+		 || ( request->buffer == NULL )
+		 || ( request->size == 0 )
+		 || ( request->size > (size_t) UINT32_MAX ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid request: %d value out of bounds.",
+			 function,
+			 request_index );
+
+			return( -1 );
+		}
+		request->read_count = 0;
+	}
+	request_index = 0;
+
+	while( ( request_index < number_of_requests )
+	    || ( number_of_requests_in_flight > 0 ) )
+	{
+		/* No new requests are submitted after an error, but the requests
+		 * in flight are completed since they reference the buffers
+		 */
+		number_of_queued_requests = 0;
+
+		while( ( result == 1 )
+		    && ( io_uring->is_unusable == 0 )
+		    && ( request_index < number_of_requests )
+		    && ( number_of_requests_in_flight < io_uring->queue_depth ) )
+		{
+			submission_queue_entry = io_uring_get_sqe(
+			                          &( io_uring->ring ) );
+
+			if( submission_queue_entry == NULL )
+			{
+				break;
+			}
+			request = &( requests[ request_index++ ] );
+
+			io_uring_prep_read(
+			 submission_queue_entry,
+			 io_uring->file_descriptors[ request->file_io_pool_entry ],
+			 request->buffer,
+			 (unsigned int) request->size,
+			 (uint64_t) request->offset );
+
+			io_uring_sqe_set_data(
+			 submission_queue_entry,
+			 (void *) request );
+
+			number_of_queued_requests++;
+			number_of_requests_in_flight++;
+		}
+		if( number_of_queued_requests > 0 )
+		{
+			completion_result = io_uring_submit(
+			                     &( io_uring->ring ) );
+
+			/* The requests that were not submitted remain in the submission queue
+			 * and would be submitted by a next read, hence the ring is no longer used
+			 */
+			if( completion_result < (int) number_of_queued_requests )
+			{
+				if( completion_result < 0 )
+				{
+					completion_result = 0;
+				}
+				number_of_requests_in_flight -= number_of_queued_requests - (unsigned int) completion_result;
+
+				io_uring->is_unusable = 1;
+			}
+		}
+		if( number_of_requests_in_flight == 0 )
+		{
+			if( ( result != 1 )
+			 || ( io_uring->is_unusable != 0 ) )
+			{
+				break;
+			}
+			continue;
+		}
+		completion_result = io_uring_wait_cqe(
+		                     &( io_uring->ring ),
+		                     &completion_queue_entry );
+
+		if( completion_result < 0 )
+		{
+			if( ( completion_result == -EINTR )
+			 || ( completion_result == -EAGAIN ) )
+			{
+				continue;
+			}
+			/* The requests in flight reference the buffers, hence waiting
+			 * for their completion is retried before giving up
+			 */
+			io_uring->is_unusable = 1;
+
+			number_of_wait_failures++;
+
+			if( number_of_wait_failures >= LIBEWF_IO_URING_MAXIMUM_NUMBER_OF_WAIT_FAILURES )
+			{
+				libcerror_system_set_error(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 -completion_result,
+				 "%s: unable to wait for read completion.",
+				 function );
+
+				return( -1 );
+			}
+			continue;
+		}
+		number_of_wait_failures = 0;
+
+		request           = (libewf_io_request_t *) io_uring_cqe_get_data( completion_queue_entry );
+		completion_result = completion_queue_entry->res;
+
+		io_uring_cqe_seen(
+		 &( io_uring->ring ),
+		 completion_queue_entry );
+
+		number_of_requests_in_flight--;
+
+		if( result != 1 )
+		{
+			continue;
+		}
+		if( completion_result < 0 )
+		{
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 -completion_result,
+			 "%s: unable to read data at offset: %" PRIi64 " from file: %d.",
+			 function,
+			 (int64_t) ( request->offset + request->read_count ),
+			 request->file_io_pool_entry );
+
+			result = -1;
+		}
+		else if( completion_result == 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unexpected end of file at offset: %" PRIi64 " in file: %d.",
+			 function,
+			 (int64_t) ( request->offset + request->read_count ),
+			 request->file_io_pool_entry );
+
+			result = -1;
+		}
+		else
+		{
+			request->read_count += (size_t) completion_result;
+
+			/* A short read is resubmitted for the remaining data
+			 */
+			if( ( request->read_count < request->size )
+			 && ( io_uring->is_unusable == 0 ) )
+			{
+				submission_queue_entry = io_uring_get_sqe(
+				                          &( io_uring->ring ) );
+
+				if( submission_queue_entry == NULL )
+				{
+					io_uring->is_unusable = 1;
+				}
+				else
+				{
+					io_uring_prep_read(
+					 submission_queue_entry,
+					 io_uring->file_descriptors[ request->file_io_pool_entry ],
+					 &( request->buffer[ request->read_count ] ),
+					 (unsigned int) ( request->size - request->read_count ),
+					 (uint64_t) ( request->offset + request->read_count ) );
+
+					io_uring_sqe_set_data(
+					 submission_queue_entry,
+					 (void *) request );
+
+					completion_result = io_uring_submit(
+					                     &( io_uring->ring ) );
+
+					if( completion_result == 1 )
+					{
+						number_of_requests_in_flight++;
+					}
+					else
+					{
+						io_uring->is_unusable = 1;
+					}
+				}
+			}
+		}
+	}
+	if( result != 1 )
+	{
+		return( -1 );
+	}
+	if( io_uring->is_unusable != 0 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+#else
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: io_uring not supported.",
+	 function );
+
+	return( -1 );
+#endif /* defined( LIBEWF_HAVE_IO_URING ) */
+}
+
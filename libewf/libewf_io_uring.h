@@ -0,0 +1,126 @@
+/*
+ * Asynchronous file IO functions using io_uring
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_IO_URING_H )
+#define _LIBEWF_IO_URING_H
+
+#include <common.h>
+#include <types.h>
+
+#if defined( HAVE_LIBURING ) && defined( HAVE_FCNTL_H ) && defined( HAVE_UNISTD_H ) && !defined( WINAPI )
+#define LIBEWF_HAVE_IO_URING	1
+#endif
+
+#if defined( LIBEWF_HAVE_IO_URING )
+#include <liburing.h>
+#endif
+
+#include "libewf_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libewf_io_request libewf_io_request_t;
+
+struct libewf_io_request
+{
+	/* The file IO pool entry
+	 */
+	int file_io_pool_entry;
+
+	/* The offset
+	 */
+	off64_t offset;
+
+	/* The buffer
+	 */
+	uint8_t *buffer;
+
+	/* The size
+	 */
+	size_t size;
+
+	/* The number of bytes read
+	 */
+	size_t read_count;
+};
+
+typedef struct libewf_io_uring libewf_io_uring_t;
+
+struct libewf_io_uring
+{
+#if defined( LIBEWF_HAVE_IO_URING )
+	/* The submission and completion ring
+	 */
+	struct io_uring ring;
+#endif
+
+	/* The maximum number of requests in flight
+	 */
+	unsigned int queue_depth;
+
+	/* The file descriptors, by file IO pool entry
+	 * -1 if the file was not opened
+	 */
+	int *file_descriptors;
+
+	/* The number of file descriptors
+	 */
+	int number_of_file_descriptors;
+
+	/* Value to indicate the ring can no longer be used, e.g. after submitting failed
+	 */
+	uint8_t is_unusable;
+};
+
+int libewf_io_uring_initialize(
+     libewf_io_uring_t **io_uring,
+     unsigned int queue_depth,
+     libcerror_error_t **error );
+
+int libewf_io_uring_free(
+     libewf_io_uring_t **io_uring,
+     libcerror_error_t **error );
+
+int libewf_io_uring_has_file(
+     libewf_io_uring_t *io_uring,
+     int file_io_pool_entry,
+     libcerror_error_t **error );
+
+int libewf_io_uring_open_file(
+     libewf_io_uring_t *io_uring,
+     int file_io_pool_entry,
+     const char *filename,
+     libcerror_error_t **error );
+
+int libewf_io_uring_read_requests(
+     libewf_io_uring_t *io_uring,
+     libewf_io_request_t *requests,
+     int number_of_requests,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_IO_URING_H ) */
+
@@ -0,0 +1,215 @@
+/*
+ * Pattern fill SIMD functions
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_adler32.h"
+#include "libewf_pattern_fill.h"
+
+#if defined( LIBEWF_ADLER32_HAVE_AVX2 )
+#include <immintrin.h>
+#endif
+
+#if defined( LIBEWF_ADLER32_HAVE_NEON )
+#include <arm_neon.h>
+#endif
+
+#if defined( __GNUC__ ) || defined( __clang__ )
+#define LIBEWF_PATTERN_FILL_TARGET( instruction_set ) \
+	__attribute__ ((target( instruction_set )))
+#else
+#define LIBEWF_PATTERN_FILL_TARGET( instruction_set )
+#endif
+
+#if defined( LIBEWF_ADLER32_HAVE_AVX2 )
+
+/* Determines the size of the prefix of the data that consists of a repeated 8-byte pattern using AVX2
+ * The data is compared in blocks of 32 bytes, the remainder is not compared
+ * The caller must ensure the CPU supports AVX2
+ * Returns the size of the prefix, which is a multiple of 32
+ */
+LIBEWF_PATTERN_FILL_TARGET( "avx2" )
+size_t libewf_pattern_fill_get_prefix_size_avx2(
+        const uint8_t *data,
+        size_t data_size,
+        const uint8_t *pattern )
+{
+	__m256i differences;
+	__m256i pattern_values;
+
+	size_t data_offset     = 0;
+	uint64_t pattern_value = 0;
+
+	byte_stream_copy_to_uint64_little_endian(
+	 pattern,
+	 pattern_value );
+
+	pattern_values = _mm256_set1_epi64x( (long long) pattern_value );
+
+	/* Compare 128 bytes per iteration, a mismatch is refined per 32 bytes below
+	 */
+	while( ( data_size - data_offset ) >= 128 )
+	{
+		differences = _mm256_or_si256(
+		               _mm256_xor_si256( _mm256_loadu_si256( (__m256i *) &( data[ data_offset ] ) ), pattern_values ),
+		               _mm256_xor_si256( _mm256_loadu_si256( (__m256i *) &( data[ data_offset + 32 ] ) ), pattern_values ) );
+
+		differences = _mm256_or_si256(
+		               differences,
+		               _mm256_xor_si256( _mm256_loadu_si256( (__m256i *) &( data[ data_offset + 64 ] ) ), pattern_values ) );
+
+		differences = _mm256_or_si256(
+		               differences,
+		               _mm256_xor_si256( _mm256_loadu_si256( (__m256i *) &( data[ data_offset + 96 ] ) ), pattern_values ) );
+
+		if( _mm256_testz_si256( differences, differences ) == 0 )
+		{
+			break;
+		}
+		data_offset += 128;
+	}
+	while( ( data_size - data_offset ) >= 32 )
+	{
+		differences = _mm256_xor_si256(
+		               _mm256_loadu_si256( (__m256i *) &( data[ data_offset ] ) ),
+		               pattern_values );
+
+		if( _mm256_testz_si256( differences, differences ) == 0 )
+		{
+			break;
+		}
+		data_offset += 32;
+	}
+	return( data_offset );
+}
+
+#endif /* defined( LIBEWF_ADLER32_HAVE_AVX2 ) */
+
+#if defined( LIBEWF_ADLER32_HAVE_NEON )
+
+/* Determines the size of the prefix of the data that consists of a repeated 8-byte pattern using NEON
+ * The data is compared in blocks of 16 bytes, the remainder is not compared
+ * Returns the size of the prefix, which is a multiple of 16
+ */
+size_t libewf_pattern_fill_get_prefix_size_neon(
+        const uint8_t *data,
+        size_t data_size,
+        const uint8_t *pattern )
+{
+	uint8x16_t differences;
+	uint8x16_t pattern_values;
+
+	size_t data_offset = 0;
+
+	pattern_values = vcombine_u8(
+	                  vld1_u8( pattern ),
+	                  vld1_u8( pattern ) );
+
+	/* Compare 64 bytes per iteration, a mismatch is refined per 16 bytes below
+	 */
+	while( ( data_size - data_offset ) >= 64 )
+	{
+		differences = vorrq_u8(
+		               veorq_u8( vld1q_u8( &( data[ data_offset ] ) ), pattern_values ),
+		               veorq_u8( vld1q_u8( &( data[ data_offset + 16 ] ) ), pattern_values ) );
+
+		differences = vorrq_u8(
+		               differences,
+		               veorq_u8( vld1q_u8( &( data[ data_offset + 32 ] ) ), pattern_values ) );
+
+		differences = vorrq_u8(
+		               differences,
+		               veorq_u8( vld1q_u8( &( data[ data_offset + 48 ] ) ), pattern_values ) );
+
+		if( vmaxvq_u8( differences ) != 0 )
+		{
+			break;
+		}
+		data_offset += 64;
+	}
+	while( ( data_size - data_offset ) >= 16 )
+	{
+		differences = veorq_u8(
+		               vld1q_u8( &( data[ data_offset ] ) ),
+		               pattern_values );
+
+		if( vmaxvq_u8( differences ) != 0 )
+		{
+			break;
+		}
+		data_offset += 16;
+	}
+	return( data_offset );
+}
+
+#endif /* defined( LIBEWF_ADLER32_HAVE_NEON ) */
+
+/* Determines the size of the prefix of the data that consists of a repeated 8-byte pattern
+ * The SIMD kernels are used for the bulk of the data if supported by the CPU
+ * Returns the size of the prefix, which is a multiple of 8 or the data size if all the data matches
+ */
+size_t libewf_pattern_fill_get_prefix_size(
+        const uint8_t *data,
+        size_t data_size,
+        const uint8_t *pattern )
+{
+	size_t data_offset   = 0;
+	size_t pattern_index = 0;
+
+#if defined( LIBEWF_ADLER32_HAVE_AVX2 )
+	if( ( libewf_adler32_get_cpu_features() & LIBEWF_ADLER32_CPU_FEATURE_AVX2 ) != 0 )
+	{
+		data_offset = libewf_pattern_fill_get_prefix_size_avx2(
+		               data,
+		               data_size,
+		               pattern );
+	}
+#elif defined( LIBEWF_ADLER32_HAVE_NEON )
+	data_offset = libewf_pattern_fill_get_prefix_size_neon(
+	               data,
+	               data_size,
+	               pattern );
+#endif
+	while( ( data_size - data_offset ) >= 8 )
+	{
+		if( memory_compare(
+		     &( data[ data_offset ] ),
+		     pattern,
+		     8 ) != 0 )
+		{
+			return( data_offset );
+		}
+		data_offset += 8;
+	}
+	while( ( data_offset + pattern_index ) < data_size )
+	{
+		if( data[ data_offset + pattern_index ] != pattern[ pattern_index ] )
+		{
+			return( data_offset );
+		}
+		pattern_index++;
+	}
+	return( data_size );
+}
+
@@ -0,0 +1,62 @@
+/*
+ * Pattern fill SIMD functions
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_PATTERN_FILL_H )
+#define _LIBEWF_PATTERN_FILL_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_adler32.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( LIBEWF_ADLER32_HAVE_AVX2 )
+
+size_t libewf_pattern_fill_get_prefix_size_avx2(
+        const uint8_t *data,
+        size_t data_size,
+        const uint8_t *pattern );
+
+#endif /* defined( LIBEWF_ADLER32_HAVE_AVX2 ) */
+
+#if defined( LIBEWF_ADLER32_HAVE_NEON )
+
+size_t libewf_pattern_fill_get_prefix_size_neon(
+        const uint8_t *data,
+        size_t data_size,
+        const uint8_t *pattern );
+
+#endif /* defined( LIBEWF_ADLER32_HAVE_NEON ) */
+
+size_t libewf_pattern_fill_get_prefix_size(
+        const uint8_t *data,
+        size_t data_size,
+        const uint8_t *pattern );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_PATTERN_FILL_H ) */
+
@@ -1628,6 +1628,7 @@ ssize_t libewf_section_compressed_string_read(
 		goto on_error;
 	}
 	result = libewf_decompress_data(
+	          NULL,
 	          section_data,
 	          section_data_size,
 	          compression_method,
@@ -1658,6 +1659,7 @@ ssize_t libewf_section_compressed_string_read(
 		*uncompressed_string = (uint8_t *) reallocation;
 
 		result = libewf_decompress_data(
+		          NULL,
 		          section_data,
 		          section_data_size,
 		          compression_method,
@@ -1845,6 +1847,7 @@ ssize_t libewf_section_write_compressed_string(
 		goto on_error;
 	}
 	result = libewf_compress_data(
+	          NULL,
 	          compressed_string,
 	          &compressed_string_size,
 	          compression_method,
@@ -1908,6 +1911,7 @@ ssize_t libewf_section_write_compressed_string(
 			goto on_error;
 		}
 		result = libewf_compress_data(
+		          NULL,
 		          compressed_string,
 		          &compressed_string_size,
 		          compression_method,
@@ -43,6 +43,7 @@
 #include "libewf_error2_section.h"
 #include "libewf_hash_values.h"
 #include "libewf_header_values.h"
+#include "libewf_index_file.h"
 #include "libewf_io_handle.h"
 #include "libewf_libbfio.h"
 #include "libewf_libcdata.h"
@@ -5145,6 +5146,7 @@ ssize_t libewf_segment_file_write_close(
 	segment_file->number_of_chunks = number_of_chunks_written_to_segment_file;
 
 	/* Make sure the next time the file is opened it is not truncated
+	 * Reopening the file also releases the pre-allocated blocks that were not written
 	 */
 	if( libbfio_pool_reopen(
 	     file_io_pool,
@@ -5968,10 +5970,578 @@ on_error:
 	return( -1 );
 }
 
+/* Reads the chunk groups from an index file instead of the table sections
+ * Returns 1 if successful, 0 if the index file does not match the segment file or -1 on error
+ */
+int libewf_segment_file_read_index_file(
+     libewf_segment_file_t *segment_file,
+     libewf_index_file_t *index_file,
+     int file_io_pool_entry,
+     size64_t segment_file_size,
+     libcerror_error_t **error )
+{
+	libewf_index_file_chunk_group_t *chunk_group = NULL;
+	libewf_index_file_segment_t *segment         = NULL;
+	static char *function                        = "libewf_segment_file_read_index_file";
+	int chunk_group_index                        = 0;
+	int number_of_chunk_groups                   = 0;
+	int number_of_sections                       = 0;
+	int result                                   = 0;
+
+	if( segment_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_file->chunk_groups_list == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid segment file - missing chunk groups list.",
+		 function );
+
+		return( -1 );
+	}
+	result = libewf_index_file_get_segment_by_number(
+	          index_file,
+	          segment_file->segment_number,
+	          &segment,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve segment: %" PRIu32 " from index file.",
+		 function,
+		 segment_file->segment_number );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	if( libfdata_list_get_number_of_elements(
+	     segment_file->sections_list,
+	     &number_of_sections,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve the number of elements from sections list.",
+		 function );
+
+		return( -1 );
+	}
+	/* The index file is only used if the segment file size and section layout
+	 * are the same as when the index file was created
+	 */
+	if( ( segment->segment_file_size != segment_file_size )
+	 || ( segment->number_of_sections != number_of_sections )
+	 || ( segment->last_section_offset != segment_file->last_section_offset ) )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: index file does not match segment file: %" PRIu32 ".\n",
+			 function,
+			 segment_file->segment_number );
+		}
+#endif
+		return( 0 );
+	}
+	if( libfdata_list_get_number_of_elements(
+	     segment_file->chunk_groups_list,
+	     &number_of_chunk_groups,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve the number of elements from chunk groups list.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_chunk_groups != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid segment file - chunk groups list value already set.",
+		 function );
+
+		return( -1 );
+	}
+	for( chunk_group_index = 0;
+	     chunk_group_index < segment->number_of_chunk_groups;
+	     chunk_group_index++ )
+	{
+		chunk_group = &( segment->chunk_groups[ chunk_group_index ] );
+
+		if( libfdata_list_append_element_with_mapped_size(
+		     segment_file->chunk_groups_list,
+		     &( segment_file->chunk_groups_index ),
+		     file_io_pool_entry,
+		     chunk_group->data_offset,
+		     chunk_group->data_size,
+		     chunk_group->range_flags,
+		     chunk_group->mapped_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append element with mapped size to chunk groups list.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	segment_file->storage_media_size         = segment->storage_media_size;
+	segment_file->number_of_chunks           = segment->number_of_chunks;
+	segment_file->previous_last_chunk_filled = segment->last_chunk_filled;
+	segment_file->last_chunk_filled          = segment->last_chunk_filled;
+	segment_file->flags                     |= segment->flags & LIBEWF_SEGMENT_FILE_FLAG_IS_CORRUPTED;
+
+	return( 1 );
+}
+
+/* Appends the chunk groups of the segment file to an index file
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_file_append_to_index_file(
+     libewf_segment_file_t *segment_file,
+     libewf_index_file_t *index_file,
+     size64_t segment_file_size,
+     libcerror_error_t **error )
+{
+	libewf_index_file_segment_t *segment = NULL;
+	static char *function                = "libewf_segment_file_append_to_index_file";
+	size64_t chunk_group_data_size       = 0;
+	size64_t mapped_size                 = 0;
+	off64_t chunk_group_data_offset      = 0;
+	uint32_t range_flags                 = 0;
+	int chunk_group_file_io_pool_entry   = 0;
+	int chunk_group_index                = 0;
+	int number_of_chunk_groups           = 0;
+
+	if( segment_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_index_file_segment_initialize(
+	     &segment,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create index file segment.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfdata_list_get_number_of_elements(
+	     segment_file->sections_list,
+	     &( segment->number_of_sections ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve the number of elements from sections list.",
+		 function );
+
+		goto on_error;
+	}
+	segment->segment_number      = segment_file->segment_number;
+	segment->segment_file_size   = segment_file_size;
+	segment->last_section_offset = segment_file->last_section_offset;
+	segment->storage_media_size  = segment_file->storage_media_size;
+	segment->number_of_chunks    = segment_file->number_of_chunks;
+	segment->last_chunk_filled   = segment_file->last_chunk_filled;
+	segment->flags               = segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_IS_CORRUPTED;
+
+	if( libfdata_list_get_number_of_elements(
+	     segment_file->chunk_groups_list,
+	     &number_of_chunk_groups,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve the number of elements from chunk groups list.",
+		 function );
+
+		goto on_error;
+	}
+	for( chunk_group_index = 0;
+	     chunk_group_index < number_of_chunk_groups;
+	     chunk_group_index++ )
+	{
+		if( libfdata_list_get_element_by_index(
+		     segment_file->chunk_groups_list,
+		     chunk_group_index,
+		     &chunk_group_file_io_pool_entry,
+		     &chunk_group_data_offset,
+		     &chunk_group_data_size,
+		     &range_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve element: %d from chunk groups list.",
+			 function,
+			 chunk_group_index );
+
+			goto on_error;
+		}
+		if( libfdata_list_get_mapped_size_by_index(
+		     segment_file->chunk_groups_list,
+		     chunk_group_index,
+		     &mapped_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve mapped size: %d from chunk groups list.",
+			 function,
+			 chunk_group_index );
+
+			goto on_error;
+		}
+		if( libewf_index_file_segment_append_chunk_group(
+		     segment,
+		     chunk_group_data_offset,
+		     chunk_group_data_size,
+		     mapped_size,
+		     range_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append chunk group: %d to index file segment.",
+			 function,
+			 chunk_group_index );
+
+			goto on_error;
+		}
+	}
+	if( libewf_index_file_append_segment(
+	     index_file,
+	     segment,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append segment: %" PRIu32 " to index file.",
+		 function,
+		 segment_file->segment_number );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( segment != NULL )
+	{
+		libewf_index_file_segment_free(
+		 &segment,
+		 NULL );
+	}
+	return( -1 );
+}
+
 /* Reads a segment file
  * Callback function for the segment files list
  * Returns 1 if successful or -1 on error
  */
+/* Reads the chunk groups from the table and table2 sections of the segment file
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_file_read_chunk_groups(
+     libewf_segment_file_t *segment_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     libcerror_error_t **error )
+{
+	libewf_section_descriptor_t *section_descriptor = NULL;
+	libfcache_cache_t *sections_cache               = NULL;
+	static char *function                           = "libewf_segment_file_read_chunk_groups";
+	ssize_t read_count                              = 0;
+	off64_t section_data_offset                     = 0;
+	int number_of_sections                          = 0;
+	int result                                      = 0;
+	int section_index                               = 0;
+
+	if( segment_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment file.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_file->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid segment file - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_segment_file_get_number_of_sections(
+	     segment_file,
+	     &number_of_sections,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of sections.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfcache_cache_initialize(
+	     &sections_cache,
+	     LIBEWF_MAXIMUM_CACHE_ENTRIES_SECTIONS,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create section descriptor cache.",
+		 function );
+
+		goto on_error;
+	}
+	for( section_index = 0;
+	     section_index < number_of_sections;
+	     section_index++ )
+	{
+		if( libfdata_list_get_element_value_by_index(
+		     segment_file->sections_list,
+		     (intptr_t *) file_io_pool,
+		     (libfdata_cache_t *) sections_cache,
+		     section_index,
+		     (intptr_t **) &section_descriptor,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve section: %d from sections list.",
+			 function,
+			 section_index );
+
+			goto on_error;
+		}
+		result = libewf_section_get_data_offset(
+		          section_descriptor,
+		          segment_file->major_version,
+		          &section_data_offset,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve section: %d data offset.",
+			 function,
+			 section_index );
+
+			goto on_error;
+		}
+		if( section_descriptor->type == LIBEWF_SECTION_TYPE_SECTOR_TABLE )
+		{
+			if( result == 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+				 "%s: missing section: %d data offset.",
+				 function,
+				 section_index );
+
+				goto on_error;
+			}
+			if( libewf_segment_file_seek_offset(
+			     segment_file,
+			     file_io_pool,
+			     file_io_pool_entry,
+			     section_data_offset,
+			     error ) == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_OPEN_FAILED,
+				 "%s: unable to seek section: %d data offset: %" PRIu64 ".",
+				 function,
+				 section_index,
+				 section_data_offset );
+
+				goto on_error;
+			}
+			read_count = libewf_segment_file_read_table_section(
+				      segment_file,
+				      section_descriptor,
+				      file_io_pool,
+				      file_io_pool_entry,
+				      segment_file->io_handle->chunk_size,
+				      error );
+
+			if( read_count == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read section: 0x%08" PRIx32 ".",
+				 function,
+				 section_descriptor->type );
+
+				section_descriptor = NULL;
+
+				goto on_error;
+			}
+		}
+		else if( ( segment_file->major_version == 1 )
+		      && ( ( section_descriptor->type_string_length == 6 )
+		      && ( memory_compare(
+		            (void *) section_descriptor->type_string,
+		            (void *) "table2",
+		            6 ) == 0 ) ) )
+		{
+			if( result == 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+				 "%s: missing section: %d data offset.",
+				 function,
+				 section_index );
+
+				goto on_error;
+			}
+			if( libewf_segment_file_seek_offset(
+			     segment_file,
+			     file_io_pool,
+			     file_io_pool_entry,
+			     section_data_offset,
+			     error ) == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_OPEN_FAILED,
+				 "%s: unable to seek section: %d data offset: %" PRIu64 ".",
+				 function,
+				 section_index,
+				 section_data_offset );
+
+				goto on_error;
+			}
+			read_count = libewf_segment_file_read_table2_section(
+				      segment_file,
+				      section_descriptor,
+				      file_io_pool,
+				      file_io_pool_entry,
+				      error );
+
+			if( read_count == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read section: %s.",
+				 function,
+				 section_descriptor->type_string );
+
+				section_descriptor = NULL;
+
+				goto on_error;
+			}
+		}
+		section_descriptor = NULL;
+	}
+	if( libfcache_cache_free(
+	     &sections_cache,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free sections cache.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( sections_cache != NULL )
+	{
+		libfcache_cache_free(
+		 &sections_cache,
+		 NULL );
+	}
+	return( -1 );
+}
+
 int libewf_segment_file_read_element_data(
      libewf_io_handle_t *io_handle,
      libbfio_pool_t *file_io_pool,
@@ -5986,13 +6556,10 @@ int libewf_segment_file_read_element_data(
 {
 	libewf_section_descriptor_t *section_descriptor = NULL;
 	libewf_segment_file_t *segment_file             = NULL;
-	libfcache_cache_t *sections_cache               = NULL;
 	static char *function                           = "libewf_segment_file_read_element_data";
 	ssize_t read_count                              = 0;
-	off64_t section_data_offset                     = 0;
 	int element_index                               = 0;
 	int last_section                                = 0;
-	int number_of_sections                          = 0;
 	int result                                      = 0;
 	int section_index                               = 0;
 
@@ -6250,8 +6817,6 @@ int libewf_segment_file_read_element_data(
 			break;
 		}
 	}
-	number_of_sections = section_index;
-
 	if( libewf_section_descriptor_free(
 	     &section_descriptor,
 	     error ) != 1 )
@@ -6328,188 +6893,49 @@ int libewf_segment_file_read_element_data(
 			                                               - segment_file->device_information_section_index;
 		}
 	}
-	if( io_handle->chunk_size != 0 )
+	/* The chunk groups are read from the index file if it matches the segment file
+	 */
+	result = 0;
+
+	if( io_handle->index_file != NULL )
 	{
-		if( libfcache_cache_initialize(
-		     &sections_cache,
-		     LIBEWF_MAXIMUM_CACHE_ENTRIES_SECTIONS,
-		     error ) != 1 )
+		result = libewf_segment_file_read_index_file(
+		          segment_file,
+		          io_handle->index_file,
+		          file_io_pool_entry,
+		          segment_file_size,
+		          error );
+
+		if( result == -1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create section descriptor cache.",
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read chunk groups from index file.",
 			 function );
 
 			goto on_error;
 		}
-		for( section_index = 0;
-		     section_index < number_of_sections;
-		     section_index++ )
+		else if( result == 0 )
 		{
-			if( libfdata_list_get_element_value_by_index(
-			     segment_file->sections_list,
-			     (intptr_t *) file_io_pool,
-			     (libfdata_cache_t *) sections_cache,
-			     section_index,
-			     (intptr_t **) &section_descriptor,
-			     0,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve section: %d from sections list.",
-				 function,
-				 section_index );
-
-				goto on_error;
-			}
-			result = libewf_section_get_data_offset(
-			          section_descriptor,
-			          segment_file->major_version,
-			          &section_data_offset,
-			          error );
-
-			if( result == -1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve section: %d data offset.",
-				 function,
-				 section_index );
-
-				goto on_error;
-			}
-			if( section_descriptor->type == LIBEWF_SECTION_TYPE_SECTOR_TABLE )
-			{
-				if( result == 0 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-					 "%s: missing section: %d data offset.",
-					 function,
-					 section_index );
-
-					goto on_error;
-				}
-				if( libewf_segment_file_seek_offset(
-				     segment_file,
-				     file_io_pool,
-				     file_io_pool_entry,
-				     section_data_offset,
-				     error ) == -1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_IO,
-					 LIBCERROR_IO_ERROR_OPEN_FAILED,
-					 "%s: unable to seek section: %d data offset: %" PRIu64 ".",
-					 function,
-					 section_index,
-					 section_data_offset );
-
-					goto on_error;
-				}
-				read_count = libewf_segment_file_read_table_section(
-					      segment_file,
-					      section_descriptor,
-					      file_io_pool,
-					      file_io_pool_entry,
-					      io_handle->chunk_size,
-					      error );
-
-				if( read_count == -1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_IO,
-					 LIBCERROR_IO_ERROR_READ_FAILED,
-					 "%s: unable to read section: 0x%08" PRIx32 ".",
-					 function,
-					 section_descriptor->type );
-
-					section_descriptor = NULL;
-
-					goto on_error;
-				}
-			}
-			else if( ( segment_file->major_version == 1 )
-			      && ( ( section_descriptor->type_string_length == 6 )
-			      && ( memory_compare(
-			            (void *) section_descriptor->type_string,
-			            (void *) "table2",
-			            6 ) == 0 ) ) )
-			{
-				if( result == 0 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-					 "%s: missing section: %d data offset.",
-					 function,
-					 section_index );
-
-					goto on_error;
-				}
-				if( libewf_segment_file_seek_offset(
-				     segment_file,
-				     file_io_pool,
-				     file_io_pool_entry,
-				     section_data_offset,
-				     error ) == -1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_IO,
-					 LIBCERROR_IO_ERROR_OPEN_FAILED,
-					 "%s: unable to seek section: %d data offset: %" PRIu64 ".",
-					 function,
-					 section_index,
-					 section_data_offset );
-
-					goto on_error;
-				}
-				read_count = libewf_segment_file_read_table2_section(
-					      segment_file,
-					      section_descriptor,
-					      file_io_pool,
-					      file_io_pool_entry,
-					      error );
-
-				if( read_count == -1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_IO,
-					 LIBCERROR_IO_ERROR_READ_FAILED,
-					 "%s: unable to read section: %s.",
-					 function,
-					 section_descriptor->type_string );
-
-					section_descriptor = NULL;
-
-					goto on_error;
-				}
-			}
-			section_descriptor = NULL;
+			io_handle->index_file->is_stale = 1;
 		}
-		if( libfcache_cache_free(
-		     &sections_cache,
+	}
+	if( ( result == 0 )
+	 && ( io_handle->chunk_size != 0 ) )
+	{
+		if( libewf_segment_file_read_chunk_groups(
+		     segment_file,
+		     file_io_pool,
+		     file_io_pool_entry,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free sections cache.",
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read chunk groups.",
 			 function );
 
 			goto on_error;
@@ -6536,12 +6962,6 @@ int libewf_segment_file_read_element_data(
 	return( 1 );
 
 on_error:
-	if( sections_cache != NULL )
-	{
-		libfcache_cache_free(
-		 &sections_cache,
-		 NULL );
-	}
 	if( section_descriptor != NULL )
 	{
 		libewf_section_descriptor_free(
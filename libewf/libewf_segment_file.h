@@ -38,6 +38,7 @@
 #include "libewf_chunk_group.h"
 #include "libewf_hash_sections.h"
 #include "libewf_header_sections.h"
+#include "libewf_index_file.h"
 #include "libewf_io_handle.h"
 #include "libewf_libbfio.h"
 #include "libewf_libcdata.h"
@@ -372,6 +373,25 @@ int libewf_segment_file_write_sections_correction(
      ewf_data_t **data_section,
      libcerror_error_t **error );
 
+int libewf_segment_file_read_index_file(
+     libewf_segment_file_t *segment_file,
+     libewf_index_file_t *index_file,
+     int file_io_pool_entry,
+     size64_t segment_file_size,
+     libcerror_error_t **error );
+
+int libewf_segment_file_append_to_index_file(
+     libewf_segment_file_t *segment_file,
+     libewf_index_file_t *index_file,
+     size64_t segment_file_size,
+     libcerror_error_t **error );
+
+int libewf_segment_file_read_chunk_groups(
+     libewf_segment_file_t *segment_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     libcerror_error_t **error );
+
 int libewf_segment_file_read_element_data(
      libewf_io_handle_t *io_handle,
      libbfio_pool_t *file_io_pool,
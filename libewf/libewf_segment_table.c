@@ -292,9 +292,11 @@ int libewf_segment_table_clear(
 
 		return( -1 );
 	}
-	segment_table->maximum_segment_size = 0;
-	segment_table->number_of_segments   = 0;
-	segment_table->flags                = 0;
+	segment_table->maximum_segment_size      = 0;
+	segment_table->number_of_segments        = 0;
+	segment_table->number_of_mapped_segments = 0;
+	segment_table->mapped_storage_media_size = 0;
+	segment_table->flags                     = 0;
 
 	return( 1 );
 }
@@ -510,7 +512,9 @@ int libewf_segment_table_empty(
 
 		result = -1;
 	}
-	segment_table->number_of_segments = 0;
+	segment_table->number_of_segments        = 0;
+	segment_table->number_of_mapped_segments = 0;
+	segment_table->mapped_storage_media_size = 0;
 
 	return( result );
 }
@@ -1761,6 +1765,188 @@ int libewf_segment_table_set_segment_storage_media_size_by_index(
 	return( 1 );
 }
 
+/* Maps the storage media of the segment files up to a specific offset
+ * The chunk groups of a segment file are read when its storage media is mapped
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_segment_table_map_segment_files_to_offset(
+     libewf_segment_table_t *segment_table,
+     libbfio_pool_t *file_io_pool,
+     off64_t offset,
+     libcerror_error_t **error )
+{
+	libewf_segment_file_t *segment_file = NULL;
+	static char *function               = "libewf_segment_table_map_segment_files_to_offset";
+	size64_t segment_file_size          = 0;
+	uint32_t segment_number             = 0;
+	int file_io_pool_entry              = 0;
+
+	if( segment_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment table.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( segment_table->flags & LIBEWF_SEGMENT_TABLE_FLAG_HAS_UNMAPPED_SEGMENTS ) == 0 )
+	{
+		return( 1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	while( ( segment_table->number_of_mapped_segments < segment_table->number_of_segments )
+	    && ( (size64_t) offset >= segment_table->mapped_storage_media_size ) )
+	{
+		segment_number = segment_table->number_of_mapped_segments;
+
+		if( libewf_segment_table_get_segment_by_index(
+		     segment_table,
+		     segment_number,
+		     &file_io_pool_entry,
+		     &segment_file_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment: %" PRIu32 ".",
+			 function,
+			 segment_number );
+
+			return( -1 );
+		}
+		if( libewf_segment_table_get_segment_file_by_index(
+		     segment_table,
+		     segment_number,
+		     file_io_pool,
+		     &segment_file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve segment file: %" PRIu32 ".",
+			 function,
+			 segment_number );
+
+			return( -1 );
+		}
+		if( segment_file == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing segment file: %" PRIu32 ".",
+			 function,
+			 segment_number );
+
+			return( -1 );
+		}
+		if( segment_file->io_handle == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid segment file: %" PRIu32 " - missing IO handle.",
+			 function,
+			 segment_number );
+
+			return( -1 );
+		}
+		if( segment_file->segment_number != ( segment_number + 1 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_INPUT,
+			 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+			 "%s: segment number mismatch ( stored: %" PRIu32 ", expected: %" PRIu32 " ).",
+			 function,
+			 segment_file->segment_number,
+			 segment_number + 1 );
+
+			return( -1 );
+		}
+		if( ( segment_file->major_version != segment_file->io_handle->major_version )
+		 || ( segment_file->minor_version != segment_file->io_handle->minor_version ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_INPUT,
+			 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+			 "%s: segment file format version value mismatch.",
+			 function );
+
+			return( -1 );
+		}
+		/* The chunk groups of a segment file that was read before the chunk size
+		 * was known, such as the last segment file on open, are read here
+		 */
+		if( segment_file->number_of_chunks == 0 )
+		{
+			if( libewf_segment_file_read_chunk_groups(
+			     segment_file,
+			     file_io_pool,
+			     file_io_pool_entry,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read chunk groups of segment file: %" PRIu32 ".",
+				 function,
+				 segment_number );
+
+				return( -1 );
+			}
+		}
+		if( ( segment_file->flags & LIBEWF_SEGMENT_FILE_FLAG_IS_CORRUPTED ) != 0 )
+		{
+			segment_table->flags |= LIBEWF_SEGMENT_TABLE_FLAG_IS_CORRUPTED;
+		}
+		if( libewf_segment_table_set_segment_storage_media_size_by_index(
+		     segment_table,
+		     segment_number,
+		     segment_file->storage_media_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set storage media size of segment: %" PRIu32 ".",
+			 function,
+			 segment_number );
+
+			return( -1 );
+		}
+		segment_table->mapped_storage_media_size += segment_file->storage_media_size;
+		segment_table->number_of_mapped_segments += 1;
+	}
+	if( segment_table->number_of_mapped_segments >= segment_table->number_of_segments )
+	{
+		segment_table->flags &= ~( LIBEWF_SEGMENT_TABLE_FLAG_HAS_UNMAPPED_SEGMENTS );
+	}
+	return( 1 );
+}
+
 /* Retrieves a specific segment file from the segment table
  * Returns 1 if successful or -1 on error
  */
@@ -1857,6 +2043,22 @@ int libewf_segment_table_get_segment_file_at_offset(
 
 		return( -1 );
 	}
+	if( libewf_segment_table_map_segment_files_to_offset(
+	     segment_table,
+	     file_io_pool,
+	     offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to map segment files to offset: 0x%08" PRIx64 ".",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
 	result = libfdata_list_get_element_value_at_offset(
 	          segment_table->segment_files_list,
 	          (intptr_t *) file_io_pool,
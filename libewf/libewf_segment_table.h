@@ -64,6 +64,14 @@ struct libewf_segment_table
 	 */
 	libfcache_cache_t *segment_files_cache;
 
+	/* The number of segments of which the storage media has been mapped
+	 */
+	uint32_t number_of_mapped_segments;
+
+	/* The storage media size of the mapped segments
+	 */
+	size64_t mapped_storage_media_size;
+
 	/* Flags
 	 */
 	uint8_t flags;
@@ -166,6 +174,12 @@ int libewf_segment_table_set_segment_storage_media_size_by_index(
      size64_t storage_media_size,
      libcerror_error_t **error );
 
+int libewf_segment_table_map_segment_files_to_offset(
+     libewf_segment_table_t *segment_table,
+     libbfio_pool_t *file_io_pool,
+     off64_t offset,
+     libcerror_error_t **error );
+
 int libewf_segment_table_get_segment_file_by_index(
      libewf_segment_table_t *segment_table,
      uint32_t segment_number,
@@ -0,0 +1,559 @@
+/*
+ * Unpack pool functions
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_chunk_data.h"
+#include "libewf_definitions.h"
+#include "libewf_io_handle.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcnotify.h"
+#include "libewf_libcthreads.h"
+#include "libewf_unpack_pool.h"
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+/* Creates an unpack pool
+ * Make sure the value unpack_pool is referencing, is set to NULL
+ *
+ * The chunk data is unpacked by a pool of threads, the jobs are owned
+ * by the caller of unpack which waits for all its jobs to complete,
+ * hence multiple threads can unpack with the same pool
+ *
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_unpack_pool_initialize(
+     libewf_unpack_pool_t **unpack_pool,
+     int number_of_threads,
+     libewf_io_handle_t *io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_unpack_pool_initialize";
+
+	if( unpack_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid unpack pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *unpack_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid unpack pool value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_threads <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	*unpack_pool = memory_allocate_structure(
+	                libewf_unpack_pool_t );
+
+	if( *unpack_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create unpack pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *unpack_pool,
+	     0,
+	     sizeof( libewf_unpack_pool_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear unpack pool.",
+		 function );
+
+		memory_free(
+		 *unpack_pool );
+
+		*unpack_pool = NULL;
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_initialize(
+	     &( ( *unpack_pool )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *unpack_pool )->condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create condition.",
+		 function );
+
+		goto on_error;
+	}
+	/* Pushing a job blocks while the thread pool queue is full
+	 */
+	if( libcthreads_thread_pool_create(
+	     &( ( *unpack_pool )->thread_pool ),
+	     NULL,
+	     number_of_threads,
+	     2 * number_of_threads,
+	     (int (*)(intptr_t *, void *)) &libewf_unpack_pool_unpack_callback,
+	     (void *) *unpack_pool,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create thread pool.",
+		 function );
+
+		goto on_error;
+	}
+	( *unpack_pool )->io_handle = io_handle;
+
+	return( 1 );
+
+on_error:
+	if( *unpack_pool != NULL )
+	{
+		if( ( *unpack_pool )->condition != NULL )
+		{
+			libcthreads_condition_free(
+			 &( ( *unpack_pool )->condition ),
+			 NULL );
+		}
+		if( ( *unpack_pool )->mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *unpack_pool )->mutex ),
+			 NULL );
+		}
+		memory_free(
+		 *unpack_pool );
+
+		*unpack_pool = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees an unpack pool
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_unpack_pool_free(
+     libewf_unpack_pool_t **unpack_pool,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_unpack_pool_free";
+	int result            = 1;
+
+	if( unpack_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid unpack pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *unpack_pool != NULL )
+	{
+		if( ( *unpack_pool )->thread_pool != NULL )
+		{
+			if( libcthreads_thread_pool_join(
+			     &( ( *unpack_pool )->thread_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join thread pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( libcthreads_condition_free(
+		     &( ( *unpack_pool )->condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *unpack_pool )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *unpack_pool );
+
+		*unpack_pool = NULL;
+	}
+	return( result );
+}
+
+/* Unpacks multiple chunk data in parallel
+ * Entries in the chunk data array that are NULL are ignored
+ * The function returns when all the chunk data has been unpacked
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_unpack_pool_unpack(
+     libewf_unpack_pool_t *unpack_pool,
+     libewf_chunk_data_t **chunk_data_array,
+     int number_of_chunk_data,
+     libcerror_error_t **error )
+{
+	libewf_unpack_pool_job_t *jobs = NULL;
+	static char *function          = "libewf_unpack_pool_unpack";
+	int job_index                  = 0;
+	int number_of_jobs             = 0;
+	int number_of_pending_jobs     = 0;
+	int result                     = 1;
+
+	if( unpack_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid unpack pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data_array == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data array.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_chunk_data < 0 )
+	 || ( (size_t) number_of_chunk_data > (size_t) ( SSIZE_MAX / sizeof( libewf_unpack_pool_job_t ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of chunk data value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_chunk_data == 0 )
+	{
+		return( 1 );
+	}
+	jobs = (libewf_unpack_pool_job_t *) memory_allocate(
+	                                     sizeof( libewf_unpack_pool_job_t ) * number_of_chunk_data );
+
+	if( jobs == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create jobs.",
+		 function );
+
+		return( -1 );
+	}
+	for( job_index = 0;
+	     job_index < number_of_chunk_data;
+	     job_index++ )
+	{
+		if( chunk_data_array[ job_index ] == NULL )
+		{
+			continue;
+		}
+		jobs[ number_of_jobs ].unpack_pool = unpack_pool;
+		jobs[ number_of_jobs ].chunk_data  = chunk_data_array[ job_index ];
+		jobs[ number_of_jobs ].status      = 0;
+
+		if( libcthreads_thread_pool_push(
+		     unpack_pool->thread_pool,
+		     (intptr_t *) &( jobs[ number_of_jobs ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push job onto thread pool queue.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+		number_of_jobs++;
+	}
+	/* The jobs that were pushed must complete before the jobs can be freed
+	 */
+	if( libcthreads_mutex_grab(
+	     unpack_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		goto on_error;
+	}
+	do
+	{
+		number_of_pending_jobs = 0;
+
+		for( job_index = 0;
+		     job_index < number_of_jobs;
+		     job_index++ )
+		{
+			if( jobs[ job_index ].status == 0 )
+			{
+				number_of_pending_jobs++;
+			}
+		}
+		if( number_of_pending_jobs > 0 )
+		{
+			if( libcthreads_condition_wait(
+			     unpack_pool->condition,
+			     unpack_pool->mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to wait for condition.",
+				 function );
+
+				libcthreads_mutex_release(
+				 unpack_pool->mutex,
+				 NULL );
+
+				goto on_error;
+			}
+		}
+	}
+	while( number_of_pending_jobs > 0 );
+
+	if( libcthreads_mutex_release(
+	     unpack_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		goto on_error;
+	}
+	for( job_index = 0;
+	     job_index < number_of_jobs;
+	     job_index++ )
+	{
+		if( ( result == 1 )
+		 && ( jobs[ job_index ].status != 1 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to unpack chunk data of job: %d.",
+			 function,
+			 job_index );
+
+			result = -1;
+		}
+	}
+	memory_free(
+	 jobs );
+
+	return( result );
+
+on_error:
+	/* The jobs are leaked when waiting for them failed since a worker can still reference them
+	 */
+	return( -1 );
+}
+
+/* Unpacks the chunk data of a job
+ * Callback function for the unpack pool thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_unpack_pool_unpack_callback(
+     libewf_unpack_pool_job_t *job,
+     libewf_unpack_pool_t *unpack_pool )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "libewf_unpack_pool_unpack_callback";
+	int status               = -1;
+
+	if( job == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid job.",
+		 function );
+
+		goto on_error;
+	}
+	if( unpack_pool == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid unpack pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_chunk_data_unpack(
+	     job->chunk_data,
+	     unpack_pool->io_handle,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to unpack chunk data.",
+		 function );
+	}
+	else
+	{
+		status = 1;
+	}
+	/* The job status is always set so that a waiting unpack does not block indefinitely
+	 */
+	if( libcthreads_mutex_grab(
+	     unpack_pool->mutex,
+	     NULL ) == 1 )
+	{
+		job->status = status;
+
+		libcthreads_condition_broadcast(
+		 unpack_pool->condition,
+		 NULL );
+
+		libcthreads_mutex_release(
+		 unpack_pool->mutex,
+		 NULL );
+	}
+	if( status != 1 )
+	{
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
@@ -0,0 +1,104 @@
+/*
+ * Unpack pool functions
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_UNPACK_POOL_H )
+#define _LIBEWF_UNPACK_POOL_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_chunk_data.h"
+#include "libewf_io_handle.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+typedef struct libewf_unpack_pool libewf_unpack_pool_t;
+
+typedef struct libewf_unpack_pool_job libewf_unpack_pool_job_t;
+
+struct libewf_unpack_pool_job
+{
+	/* The unpack pool
+	 */
+	libewf_unpack_pool_t *unpack_pool;
+
+	/* The chunk data
+	 */
+	libewf_chunk_data_t *chunk_data;
+
+	/* The status, 0 if pending, 1 if unpacked or -1 on error
+	 */
+	int status;
+};
+
+struct libewf_unpack_pool
+{
+	/* The IO handle
+	 */
+	libewf_io_handle_t *io_handle;
+
+	/* The thread pool that unpacks the chunk data
+	 */
+	libcthreads_thread_pool_t *thread_pool;
+
+	/* The mutex that protects the job status
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The condition that is signalled when a job has completed
+	 */
+	libcthreads_condition_t *condition;
+};
+
+int libewf_unpack_pool_initialize(
+     libewf_unpack_pool_t **unpack_pool,
+     int number_of_threads,
+     libewf_io_handle_t *io_handle,
+     libcerror_error_t **error );
+
+int libewf_unpack_pool_free(
+     libewf_unpack_pool_t **unpack_pool,
+     libcerror_error_t **error );
+
+int libewf_unpack_pool_unpack(
+     libewf_unpack_pool_t *unpack_pool,
+     libewf_chunk_data_t **chunk_data_array,
+     int number_of_chunk_data,
+     libcerror_error_t **error );
+
+int libewf_unpack_pool_unpack_callback(
+     libewf_unpack_pool_job_t *job,
+     libewf_unpack_pool_t *unpack_pool );
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_UNPACK_POOL_H ) */
+
@@ -34,8 +34,8 @@
 #include <time.h>
 #endif
 
+#include "libewf_buffered_file_io_handle.h"
 #include "libewf_chunk_data.h"
-#include "libewf_chunk_group.h"
 #include "libewf_chunk_table.h"
 #include "libewf_compression.h"
 #include "libewf_definitions.h"
@@ -139,20 +139,6 @@ int libewf_write_io_handle_initialize(
 
 		return( -1 );
 	}
-	if( libewf_chunk_group_initialize(
-	     &( ( *write_io_handle )->chunk_group ),
-	     io_handle,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create chunk group.",
-		 function );
-
-		goto on_error;
-	}
 	( *write_io_handle )->pack_flags                  = LIBEWF_PACK_FLAG_CALCULATE_CHECKSUM;
 	( *write_io_handle )->section_descriptor_size     = sizeof( ewf_section_descriptor_v1_t );
 	( *write_io_handle )->table_header_size           = sizeof( ewf_table_header_v1_t );
@@ -223,19 +209,6 @@ int libewf_write_io_handle_free(
 			memory_free(
 			 ( *write_io_handle )->compressed_zero_byte_empty_block );
 		}
-		if( libewf_chunk_group_free(
-		     &( ( *write_io_handle )->chunk_group ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free chunk group.",
-			 function );
-
-			result = -1;
-		}
 		memory_free(
 		 *write_io_handle );
 
@@ -320,7 +293,6 @@ int libewf_write_io_handle_clone(
 	( *destination_write_io_handle )->table_entries_data      = NULL;
 	( *destination_write_io_handle )->table_entries_data_size = 0;
 	( *destination_write_io_handle )->number_of_table_entries = 0;
-	( *destination_write_io_handle )->chunk_group             = NULL;
 
 	if( source_write_io_handle->case_data != NULL )
 	{
@@ -451,20 +423,7 @@ int libewf_write_io_handle_clone(
 		                                                     + ( *destination_write_io_handle )->table_header_size;
 
 		( *destination_write_io_handle )->table_entries_data_size = source_write_io_handle->table_entries_data_size;
-	}
-	if( libewf_chunk_group_clone(
-	     &( ( *destination_write_io_handle )->chunk_group ),
-	     source_write_io_handle->chunk_group,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create destination chunk group.",
-		 function );
-
-		goto on_error;
+		( *destination_write_io_handle )->number_of_table_entries = source_write_io_handle->number_of_table_entries;
 	}
 	return( 1 );
 
@@ -589,7 +548,9 @@ int libewf_write_io_handle_initialize_values(
 	{
 		segment_table->maximum_segment_size = write_io_handle->maximum_segment_file_size;
 	}
-	write_io_handle->pack_flags = LIBEWF_PACK_FLAG_CALCULATE_CHECKSUM;
+	write_io_handle->pack_flags                      = LIBEWF_PACK_FLAG_CALCULATE_CHECKSUM;
+	write_io_handle->use_trial_compression           = 0;
+	write_io_handle->number_of_incompressible_chunks = 0;
 
 	if( ( io_handle->format == LIBEWF_FORMAT_EWF )
 	 || ( io_handle->format == LIBEWF_FORMAT_SMART ) )
@@ -783,6 +744,7 @@ int libewf_write_io_handle_initialize_values(
 				compression_level = LIBEWF_COMPRESSION_DEFAULT;
 			}
 			result = libewf_compress_data(
+				  io_handle->compression_cache,
 				  compressed_zero_byte_empty_block,
 				  &( write_io_handle->compressed_zero_byte_empty_block_size ),
 				  io_handle->compression_method,
@@ -839,6 +801,7 @@ int libewf_write_io_handle_initialize_values(
 				compressed_zero_byte_empty_block = (uint8_t *) reallocation;
 
 				result = libewf_compress_data(
+					  io_handle->compression_cache,
 					  compressed_zero_byte_empty_block,
 					  &( write_io_handle->compressed_zero_byte_empty_block_size ),
 					  io_handle->compression_method,
@@ -1743,6 +1706,178 @@ int libewf_write_io_handle_resize_table_entries(
 	return( 1 );
 }
 
+/* Sets a table entry of the current chunks section
+ * The table entries are grown in blocks and reused by subsequent chunks sections
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_write_io_handle_set_table_entry(
+     libewf_write_io_handle_t *write_io_handle,
+     uint8_t format_version,
+     uint32_t table_entry_index,
+     off64_t chunk_data_offset,
+     size64_t chunk_data_size,
+     uint32_t range_flags,
+     off64_t base_offset,
+     libcerror_error_t **error )
+{
+	uint8_t *table_entry_data        = NULL;
+	static char *function            = "libewf_write_io_handle_set_table_entry";
+	size_t table_entry_data_size     = 0;
+	uint32_t chunk_data_flags        = 0;
+	uint32_t number_of_table_entries = 0;
+	uint32_t table_offset            = 0;
+
+	if( write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( format_version == 1 )
+	{
+		table_entry_data_size = sizeof( ewf_table_entry_v1_t );
+	}
+	else if( format_version == 2 )
+	{
+		table_entry_data_size = sizeof( ewf_table_entry_v2_t );
+	}
+	else
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported format version.",
+		 function );
+
+		return( -1 );
+	}
+	if( write_io_handle->table_entry_size != table_entry_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid write IO handle - table entry size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( table_entry_index >= ( UINT32_MAX - LIBEWF_WRITE_IO_HANDLE_TABLE_ENTRIES_BLOCK_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid table entry index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( base_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid base offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( table_entry_index >= write_io_handle->number_of_table_entries )
+	{
+		number_of_table_entries = ( ( table_entry_index / LIBEWF_WRITE_IO_HANDLE_TABLE_ENTRIES_BLOCK_SIZE ) + 1 )
+		                        * LIBEWF_WRITE_IO_HANDLE_TABLE_ENTRIES_BLOCK_SIZE;
+
+		if( libewf_write_io_handle_resize_table_entries(
+		     write_io_handle,
+		     number_of_table_entries,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize table entries.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	table_entry_data = &( write_io_handle->table_entries_data[ table_entry_index * table_entry_data_size ] );
+
+	if( format_version == 1 )
+	{
+		chunk_data_offset -= base_offset;
+
+		if( ( chunk_data_offset < 0 )
+		 || ( chunk_data_offset > (off64_t) INT32_MAX ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid chunk data offset value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		table_offset = (uint32_t) chunk_data_offset;
+
+		if( ( range_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED ) != 0 )
+		{
+			table_offset |= 0x80000000UL;
+		}
+		byte_stream_copy_from_uint32_little_endian(
+		 ( (ewf_table_entry_v1_t *) table_entry_data )->chunk_data_offset,
+		 table_offset );
+	}
+	else if( format_version == 2 )
+	{
+		if( chunk_data_size > (size64_t) UINT32_MAX )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid chunk data size value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		if( ( range_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED ) != 0 )
+		{
+			chunk_data_flags |= LIBEWF_CHUNK_DATA_FLAG_IS_COMPRESSED;
+		}
+		if( ( range_flags & LIBEWF_RANGE_FLAG_HAS_CHECKSUM ) != 0 )
+		{
+			chunk_data_flags |= LIBEWF_CHUNK_DATA_FLAG_HAS_CHECKSUM;
+		}
+		if( ( range_flags & LIBEWF_RANGE_FLAG_USES_PATTERN_FILL ) != 0 )
+		{
+			chunk_data_flags |= LIBEWF_CHUNK_DATA_FLAG_USES_PATTERN_FILL;
+		}
+		byte_stream_copy_from_uint64_little_endian(
+		 ( (ewf_table_entry_v2_t *) table_entry_data )->chunk_data_offset,
+		 chunk_data_offset );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 ( (ewf_table_entry_v2_t *) table_entry_data )->chunk_data_size,
+		 (uint32_t) chunk_data_size );
+
+		byte_stream_copy_from_uint32_little_endian(
+		 ( (ewf_table_entry_v2_t *) table_entry_data )->chunk_data_flags,
+		 chunk_data_flags );
+	}
+	return( 1 );
+}
+
 /* Calculates an estimate of the number of chunks that fit within a segment file
  * Returns 1 if successful or -1 on error
  */
@@ -2417,41 +2552,70 @@ int libewf_write_io_handle_create_segment_file(
 		 filename );
 	}
 #endif
-	if( libbfio_file_initialize(
-	     &file_io_handle,
-	     error ) != 1 )
+#if defined( LIBEWF_HAVE_BUFFERED_FILE_IO )
+	if( io_handle->segment_write_buffer_size > 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create file IO handle.",
-		 function );
+		/* Coalesce the chunk and section writes into large writes
+		 * and pre-allocate the segment file to the maximum segment size if requested
+		 */
+		if( libewf_buffered_file_initialize(
+		     &file_io_handle,
+		     filename,
+		     filename_size,
+		     io_handle->segment_write_buffer_size,
+		     io_handle->segment_write_flags,
+		     segment_table->maximum_segment_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create buffered file IO handle.",
+			 function );
 
-		goto on_error;
+			goto on_error;
+		}
 	}
+	else
+#endif /* defined( LIBEWF_HAVE_BUFFERED_FILE_IO ) */
+	{
+		if( libbfio_file_initialize(
+		     &file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create file IO handle.",
+			 function );
+
+			goto on_error;
+		}
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	if( libbfio_file_set_name_wide(
-	     file_io_handle,
-	     filename,
-	     filename_size,
-	     error ) != 1 )
+		if( libbfio_file_set_name_wide(
+		     file_io_handle,
+		     filename,
+		     filename_size,
+		     error ) != 1 )
 #else
-	if( libbfio_file_set_name(
-	     file_io_handle,
-	     filename,
-	     filename_size,
-	     error ) != 1 )
+		if( libbfio_file_set_name(
+		     file_io_handle,
+		     filename,
+		     filename_size,
+		     error ) != 1 )
 #endif
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set filename in file IO handle.",
-		 function );
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set filename in file IO handle.",
+			 function );
 
-		goto on_error;
+			goto on_error;
+		}
 	}
 	memory_free(
 	 filename );
@@ -2792,28 +2956,10 @@ ssize_t libewf_write_io_handle_write_chunks_section_end(
 	{
 		base_offset = write_io_handle->chunks_section_offset;
 	}
+	/* The table entries were set when the chunks were written
+	 */
 	first_chunk_index = write_io_handle->number_of_chunks_written
 	                  - write_io_handle->number_of_chunks_written_to_section;
-
-	if( libewf_chunk_group_generate_table_entries_data(
-	     write_io_handle->chunk_group,
-	     first_chunk_index,
-	     segment_file->major_version,
-	     write_io_handle->table_entries_data,
-	     write_io_handle->table_entries_data_size,
-	     write_io_handle->number_of_chunks_written_to_section,
-	     base_offset,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set table entries data.",
-		 function );
-
-		return( -1 );
-	}
 	write_count = libewf_segment_file_write_chunks_section_end(
 		       segment_file,
 		       file_io_pool,
@@ -2841,20 +2987,121 @@ ssize_t libewf_write_io_handle_write_chunks_section_end(
 
 		return( -1 );
 	}
-	if( libewf_chunk_group_empty(
-	     write_io_handle->chunk_group,
-	     error ) != 1 )
+	return( write_count );
+}
+
+/* Retrieves the flags used for chunk packing
+ * The pack flags include the trial compression flag when adaptive compression
+ * determined the chunks are likely incompressible
+ * This function is not multi-thread safe acquire the handle lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_write_io_handle_get_pack_flags(
+     libewf_write_io_handle_t *write_io_handle,
+     uint8_t *pack_flags,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_write_io_handle_get_pack_flags";
+
+	if( write_io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
-		 "%s: unable to empty chunk group.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write IO handle.",
 		 function );
 
 		return( -1 );
 	}
-	return( write_count );
+	if( pack_flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid pack flags.",
+		 function );
+
+		return( -1 );
+	}
+	*pack_flags = write_io_handle->pack_flags;
+
+	if( write_io_handle->use_trial_compression != 0 )
+	{
+		*pack_flags |= LIBEWF_PACK_FLAG_USE_TRIAL_COMPRESSION;
+	}
+	return( 1 );
+}
+
+/* Updates the adaptive compression state after a chunk was written
+ * Chunks are written in order, so the number of consecutive incompressible chunks
+ * determines if the chunks that are packed next are first trial compressed
+ * This function is not multi-thread safe acquire the handle lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_write_io_handle_update_adaptive_compression(
+     libewf_write_io_handle_t *write_io_handle,
+     libewf_io_handle_t *io_handle,
+     libewf_chunk_data_t *chunk_data,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_write_io_handle_update_adaptive_compression";
+
+	if( write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( ( io_handle->compression_flags & LIBEWF_COMPRESS_FLAG_USE_ADAPTIVE_COMPRESSION ) == 0 )
+	 || ( io_handle->compression_level == LIBEWF_COMPRESSION_NONE )
+	 || ( ( write_io_handle->pack_flags & LIBEWF_PACK_FLAG_FORCE_COMPRESSION ) != 0 ) )
+	{
+		return( 1 );
+	}
+	if( ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED ) != 0 )
+	{
+		write_io_handle->number_of_incompressible_chunks = 0;
+		write_io_handle->use_trial_compression           = 0;
+	}
+	else if( write_io_handle->number_of_incompressible_chunks < LIBEWF_ADAPTIVE_COMPRESSION_NUMBER_OF_INCOMPRESSIBLE_CHUNKS )
+	{
+		write_io_handle->number_of_incompressible_chunks += 1;
+
+		if( write_io_handle->number_of_incompressible_chunks >= LIBEWF_ADAPTIVE_COMPRESSION_NUMBER_OF_INCOMPRESSIBLE_CHUNKS )
+		{
+			write_io_handle->use_trial_compression = 1;
+		}
+	}
+	return( 1 );
 }
 
 /* Writes a new chunk of data in EWF format at the current offset
@@ -2880,13 +3127,13 @@ ssize_t libewf_write_io_handle_write_new_chunk(
 {
 	libewf_segment_file_t *segment_file = NULL;
 	static char *function               = "libewf_write_io_handle_write_new_chunk";
+	off64_t base_offset                 = 0;
 	off64_t chunk_offset                = 0;
 	size64_t segment_file_size          = 0;
 	uint32_t number_of_segments         = 0;
 	uint32_t segment_number             = 0;
 	ssize_t total_write_count           = 0;
 	ssize_t write_count                 = 0;
-	int element_index                   = 0;
 	int file_io_pool_entry              = -1;
 	int result                          = 0;
 
@@ -3342,21 +3589,32 @@ ssize_t libewf_write_io_handle_write_new_chunk(
 	}
 	total_write_count += write_count;
 
-/* TODO re-implement using set by index instead of append ? */
-	if( libfdata_list_append_element(
-	     write_io_handle->chunk_group->chunks_list,
-	     &element_index,
-	     file_io_pool_entry,
+	/* The table entry offsets are relative to the base offset that
+	 * libewf_write_io_handle_write_chunks_section_end stores in the table
+	 * header. Only the EnCase 6 and 7 formats use the chunks section offset
+	 * as base offset, which allows segment files larger than 2 GiB, the other
+	 * formats store a base offset of 0.
+	 */
+	if( ( io_handle->format == LIBEWF_FORMAT_ENCASE6 )
+	 || ( io_handle->format == LIBEWF_FORMAT_ENCASE7 ) )
+	{
+		base_offset = write_io_handle->chunks_section_offset;
+	}
+	if( libewf_write_io_handle_set_table_entry(
+	     write_io_handle,
+	     segment_file->major_version,
+	     write_io_handle->number_of_chunks_written_to_section,
 	     chunk_offset,
 	     (size64_t) write_count - chunk_data->padding_size,
 	     chunk_data->range_flags,
+	     base_offset,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-		 "%s: unable to append chunk: %" PRIu64 " in chunks list.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set table entry of chunk: %" PRIu64 ".",
 		 function,
 		 chunk_index );
 
@@ -3370,6 +3628,21 @@ ssize_t libewf_write_io_handle_write_new_chunk(
 	write_io_handle->number_of_chunks_written_to_section      += 1;
 	write_io_handle->number_of_chunks_written                 += 1;
 
+	if( libewf_write_io_handle_update_adaptive_compression(
+	     write_io_handle,
+	     io_handle,
+	     chunk_data,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update adaptive compression.",
+		 function );
+
+		return( -1 );
+	}
 	/* Reserve space in the segment file for the chunk table entries
 	 */
 	write_io_handle->remaining_segment_file_size -= write_io_handle->chunk_table_entries_reserved_size;
@@ -35,7 +35,6 @@
 #endif
 
 #include "libewf_chunk_data.h"
-#include "libewf_chunk_group.h"
 #include "libewf_chunk_table.h"
 #include "libewf_io_handle.h"
 #include "libewf_libbfio.h"
@@ -56,14 +55,26 @@
 extern "C" {
 #endif
 
+/* The number of table entries the table entries are grown by
+ */
+#define LIBEWF_WRITE_IO_HANDLE_TABLE_ENTRIES_BLOCK_SIZE	4096
+
 typedef struct libewf_write_io_handle libewf_write_io_handle_t;
 
 struct libewf_write_io_handle
 {
-	/* Flags used for chunk packing
+	/* Flags used for chunk packing, these do not change after the write values are initialized
 	 */
 	uint8_t pack_flags;
 
+	/* Value to indicate the chunks are first trial compressed, used for adaptive compression
+	 */
+	uint8_t use_trial_compression;
+
+	/* The number of consecutive incompressible chunks, used for adaptive compression
+	 */
+	uint32_t number_of_incompressible_chunks;
+
 	/* The size of a section descriptor
 	 */
 	size_t section_descriptor_size;
@@ -144,10 +155,6 @@ struct libewf_write_io_handle
 	 */
 	uint32_t maximum_number_of_segments;
 
-	/* The group of chunks written to the current chunks section
-	 */
-	libewf_chunk_group_t *chunk_group;
-
 	/* The number of bytes written to a section containing chunks
 	 */
 	ssize64_t chunks_section_write_count;
@@ -246,6 +253,16 @@ int libewf_write_io_handle_resize_table_entries(
      uint32_t number_of_entries,
      libcerror_error_t **error );
 
+int libewf_write_io_handle_set_table_entry(
+     libewf_write_io_handle_t *write_io_handle,
+     uint8_t format_version,
+     uint32_t table_entry_index,
+     off64_t chunk_data_offset,
+     size64_t chunk_data_size,
+     uint32_t range_flags,
+     off64_t base_offset,
+     libcerror_error_t **error );
+
 int libewf_write_io_handle_calculate_chunks_per_segment_file(
      libewf_write_io_handle_t *write_io_handle,
      libewf_media_values_t *media_values,
@@ -300,6 +317,17 @@ ssize_t libewf_write_io_handle_write_chunks_section_end(
          libewf_segment_file_t *segment_file,
          libcerror_error_t **error );
 
+int libewf_write_io_handle_get_pack_flags(
+     libewf_write_io_handle_t *write_io_handle,
+     uint8_t *pack_flags,
+     libcerror_error_t **error );
+
+int libewf_write_io_handle_update_adaptive_compression(
+     libewf_write_io_handle_t *write_io_handle,
+     libewf_io_handle_t *io_handle,
+     libewf_chunk_data_t *chunk_data,
+     libcerror_error_t **error );
+
 ssize_t libewf_write_io_handle_write_new_chunk(
          libewf_write_io_handle_t *write_io_handle,
          libewf_io_handle_t *io_handle,
@@ -0,0 +1,743 @@
+/*
+ * Write pipeline functions
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libewf_chunk_data.h"
+#include "libewf_chunk_data_pool.h"
+#include "libewf_definitions.h"
+#include "libewf_io_handle.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcnotify.h"
+#include "libewf_libcthreads.h"
+#include "libewf_write_pipeline.h"
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+/* Creates a write pipeline
+ * Make sure the value write_pipeline is referencing, is set to NULL
+ *
+ * The chunk data is packed by a pool of threads, the packed chunk data
+ * is returned in chunk index order so that it can be written sequentially.
+ * The number of jobs is limited to twice the number of threads, this bounds
+ * the amount of chunk data held by the pipeline
+ * The chunk data of jobs that could not be packed is released to the chunk data pool
+ *
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_write_pipeline_initialize(
+     libewf_write_pipeline_t **write_pipeline,
+     int number_of_threads,
+     libewf_io_handle_t *io_handle,
+     libewf_chunk_data_pool_t *chunk_data_pool,
+     const uint8_t *compressed_zero_byte_empty_block,
+     size_t compressed_zero_byte_empty_block_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_write_pipeline_initialize";
+	size_t jobs_size      = 0;
+
+	if( write_pipeline == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write pipeline.",
+		 function );
+
+		return( -1 );
+	}
+	if( *write_pipeline != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid write pipeline value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_threads <= 0 )
+	 || ( number_of_threads > LIBEWF_MAXIMUM_NUMBER_OF_COMPRESSION_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	*write_pipeline = memory_allocate_structure(
+	                   libewf_write_pipeline_t );
+
+	if( *write_pipeline == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create write pipeline.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *write_pipeline,
+	     0,
+	     sizeof( libewf_write_pipeline_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear write pipeline.",
+		 function );
+
+		memory_free(
+		 *write_pipeline );
+
+		*write_pipeline = NULL;
+
+		return( -1 );
+	}
+	( *write_pipeline )->maximum_number_of_jobs = 2 * number_of_threads;
+
+	jobs_size = sizeof( libewf_write_pipeline_job_t ) * ( *write_pipeline )->maximum_number_of_jobs;
+
+	( *write_pipeline )->jobs = (libewf_write_pipeline_job_t *) memory_allocate(
+	                                                             jobs_size );
+
+	if( ( *write_pipeline )->jobs == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create jobs.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *write_pipeline )->jobs,
+	     0,
+	     jobs_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear jobs.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_initialize(
+	     &( ( *write_pipeline )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( ( *write_pipeline )->condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create condition.",
+		 function );
+
+		goto on_error;
+	}
+	/* The thread pool queue can hold all the jobs hence pushing a job does not block
+	 */
+	if( libcthreads_thread_pool_create(
+	     &( ( *write_pipeline )->thread_pool ),
+	     NULL,
+	     number_of_threads,
+	     ( *write_pipeline )->maximum_number_of_jobs,
+	     (int (*)(intptr_t *, void *)) &libewf_write_pipeline_pack_callback,
+	     (void *) *write_pipeline,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create thread pool.",
+		 function );
+
+		goto on_error;
+	}
+	( *write_pipeline )->io_handle                             = io_handle;
+	( *write_pipeline )->chunk_data_pool                       = chunk_data_pool;
+	( *write_pipeline )->compressed_zero_byte_empty_block      = compressed_zero_byte_empty_block;
+	( *write_pipeline )->compressed_zero_byte_empty_block_size = compressed_zero_byte_empty_block_size;
+
+	return( 1 );
+
+on_error:
+	if( *write_pipeline != NULL )
+	{
+		if( ( *write_pipeline )->condition != NULL )
+		{
+			libcthreads_condition_free(
+			 &( ( *write_pipeline )->condition ),
+			 NULL );
+		}
+		if( ( *write_pipeline )->mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *write_pipeline )->mutex ),
+			 NULL );
+		}
+		if( ( *write_pipeline )->jobs != NULL )
+		{
+			memory_free(
+			 ( *write_pipeline )->jobs );
+		}
+		memory_free(
+		 *write_pipeline );
+
+		*write_pipeline = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a write pipeline
+ * Waits for the pending jobs to complete and releases their chunk data
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_write_pipeline_free(
+     libewf_write_pipeline_t **write_pipeline,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_write_pipeline_free";
+	int job_index         = 0;
+	int result            = 1;
+
+	if( write_pipeline == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write pipeline.",
+		 function );
+
+		return( -1 );
+	}
+	if( *write_pipeline != NULL )
+	{
+		if( ( *write_pipeline )->thread_pool != NULL )
+		{
+			if( libcthreads_thread_pool_join(
+			     &( ( *write_pipeline )->thread_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join thread pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+		for( job_index = 0;
+		     job_index < ( *write_pipeline )->maximum_number_of_jobs;
+		     job_index++ )
+		{
+			if( ( *write_pipeline )->jobs[ job_index ].chunk_data != NULL )
+			{
+				if( libewf_write_pipeline_release_chunk_data(
+				     *write_pipeline,
+				     &( ( *write_pipeline )->jobs[ job_index ].chunk_data ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to release chunk data of job: %d.",
+					 function,
+					 job_index );
+
+					result = -1;
+				}
+			}
+		}
+		if( libcthreads_condition_free(
+		     &( ( *write_pipeline )->condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *write_pipeline )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 ( *write_pipeline )->jobs );
+
+		memory_free(
+		 *write_pipeline );
+
+		*write_pipeline = NULL;
+	}
+	return( result );
+}
+
+/* Releases chunk data to the chunk data pool or frees it if the write pipeline has no pool
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_write_pipeline_release_chunk_data(
+     libewf_write_pipeline_t *write_pipeline,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error )
+{
+	static char *function = "libewf_write_pipeline_release_chunk_data";
+
+	if( write_pipeline == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write pipeline.",
+		 function );
+
+		return( -1 );
+	}
+	if( write_pipeline->chunk_data_pool == NULL )
+	{
+		if( libewf_chunk_data_free(
+		     chunk_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunk data.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	else
+	{
+		if( libewf_chunk_data_pool_release_chunk_data(
+		     write_pipeline->chunk_data_pool,
+		     chunk_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to release chunk data.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Pushes chunk data onto the write pipeline to be packed
+ * The write pipeline takes over management of the chunk data if successful,
+ * on error the caller retains management of the chunk data
+ * The chunk index must follow the chunk index of the previously pushed chunk data
+ * The chunk data is packed using the compression level and pack flags of the job
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_write_pipeline_push(
+     libewf_write_pipeline_t *write_pipeline,
+     uint64_t chunk_index,
+     libewf_chunk_data_t *chunk_data,
+     size_t input_data_size,
+     int8_t compression_level,
+     uint8_t pack_flags,
+     libcerror_error_t **error )
+{
+	libewf_write_pipeline_job_t *job = NULL;
+	static char *function            = "libewf_write_pipeline_push";
+	int job_index                    = 0;
+
+	if( write_pipeline == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write pipeline.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( write_pipeline->number_of_jobs >= write_pipeline->maximum_number_of_jobs )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid write pipeline - maximum number of jobs reached.",
+		 function );
+
+		return( -1 );
+	}
+	job_index = ( write_pipeline->first_job_index + write_pipeline->number_of_jobs ) % write_pipeline->maximum_number_of_jobs;
+
+	job = &( write_pipeline->jobs[ job_index ] );
+
+	job->write_pipeline    = write_pipeline;
+	job->chunk_index       = chunk_index;
+	job->chunk_data        = chunk_data;
+	job->input_data_size   = input_data_size;
+	job->compression_level = compression_level;
+	job->pack_flags        = pack_flags;
+	job->status            = 0;
+
+	if( libcthreads_thread_pool_push(
+	     write_pipeline->thread_pool,
+	     (intptr_t *) job,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push job onto thread pool queue.",
+		 function );
+
+		/* The job was not queued, hence the caller still manages the chunk data
+		 */
+		job->chunk_data      = NULL;
+		job->input_data_size = 0;
+
+		return( -1 );
+	}
+	write_pipeline->number_of_jobs += 1;
+
+	return( 1 );
+}
+
+/* Pops the oldest job from the write pipeline if its chunk data has been packed
+ * If wait for job is set the function waits for the oldest job to complete
+ * The caller takes over management of the chunk data, the chunk data of a job
+ * that could not be packed is released to the chunk data pool
+ * Returns 1 if successful, 0 if no packed chunk data is available or -1 on error
+ */
+int libewf_write_pipeline_pop(
+     libewf_write_pipeline_t *write_pipeline,
+     uint64_t *chunk_index,
+     libewf_chunk_data_t **chunk_data,
+     size_t *input_data_size,
+     uint8_t wait_for_job,
+     libcerror_error_t **error )
+{
+	libewf_write_pipeline_job_t *job = NULL;
+	static char *function            = "libewf_write_pipeline_pop";
+	int status                       = 0;
+
+	if( write_pipeline == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write pipeline.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk index.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( input_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid input data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( write_pipeline->number_of_jobs == 0 )
+	{
+		return( 0 );
+	}
+	job = &( write_pipeline->jobs[ write_pipeline->first_job_index ] );
+
+	if( libcthreads_mutex_grab(
+	     write_pipeline->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	while( ( job->status == 0 )
+	    && ( wait_for_job != 0 ) )
+	{
+		if( libcthreads_condition_wait(
+		     write_pipeline->condition,
+		     write_pipeline->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to wait for condition.",
+			 function );
+
+			libcthreads_mutex_release(
+			 write_pipeline->mutex,
+			 NULL );
+
+			return( -1 );
+		}
+	}
+	status = job->status;
+
+	if( libcthreads_mutex_release(
+	     write_pipeline->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( status == 0 )
+	{
+		return( 0 );
+	}
+	write_pipeline->first_job_index = ( write_pipeline->first_job_index + 1 ) % write_pipeline->maximum_number_of_jobs;
+	write_pipeline->number_of_jobs -= 1;
+
+	if( status != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to pack chunk: %" PRIu64 " data.",
+		 function,
+		 job->chunk_index );
+
+		libewf_write_pipeline_release_chunk_data(
+		 write_pipeline,
+		 &( job->chunk_data ),
+		 NULL );
+
+		return( -1 );
+	}
+	*chunk_index     = job->chunk_index;
+	*chunk_data      = job->chunk_data;
+	*input_data_size = job->input_data_size;
+
+	job->chunk_data = NULL;
+
+	return( 1 );
+}
+
+/* Packs the chunk data of a job
+ * Callback function for the write pipeline thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int libewf_write_pipeline_pack_callback(
+     libewf_write_pipeline_job_t *job,
+     libewf_write_pipeline_t *write_pipeline )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "libewf_write_pipeline_pack_callback";
+	int status               = -1;
+
+	if( job == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid job.",
+		 function );
+
+		goto on_error;
+	}
+	if( write_pipeline == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write pipeline.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_chunk_data_pack(
+	     job->chunk_data,
+	     write_pipeline->io_handle,
+	     job->compression_level,
+	     write_pipeline->compressed_zero_byte_empty_block,
+	     write_pipeline->compressed_zero_byte_empty_block_size,
+	     job->pack_flags,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to pack chunk: %" PRIu64 " data.",
+		 function,
+		 job->chunk_index );
+	}
+	else
+	{
+		status = 1;
+	}
+	/* The job status is always set so that a waiting pop does not block indefinitely
+	 */
+	if( libcthreads_mutex_grab(
+	     write_pipeline->mutex,
+	     NULL ) == 1 )
+	{
+		job->status = status;
+
+		libcthreads_condition_broadcast(
+		 write_pipeline->condition,
+		 NULL );
+
+		libcthreads_mutex_release(
+		 write_pipeline->mutex,
+		 NULL );
+	}
+	if( status != 1 )
+	{
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
@@ -0,0 +1,168 @@
+/*
+ * Write pipeline functions
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBEWF_WRITE_PIPELINE_H )
+#define _LIBEWF_WRITE_PIPELINE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libewf_chunk_data.h"
+#include "libewf_chunk_data_pool.h"
+#include "libewf_io_handle.h"
+#include "libewf_libcerror.h"
+#include "libewf_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+typedef struct libewf_write_pipeline libewf_write_pipeline_t;
+
+typedef struct libewf_write_pipeline_job libewf_write_pipeline_job_t;
+
+struct libewf_write_pipeline_job
+{
+	/* The write pipeline
+	 */
+	libewf_write_pipeline_t *write_pipeline;
+
+	/* The chunk index
+	 */
+	uint64_t chunk_index;
+
+	/* The chunk data
+	 */
+	libewf_chunk_data_t *chunk_data;
+
+	/* The size of the chunk data before it was packed
+	 */
+	size_t input_data_size;
+
+	/* The compression level
+	 */
+	int8_t compression_level;
+
+	/* The pack flags
+	 */
+	uint8_t pack_flags;
+
+	/* The status, 0 if pending, 1 if packed or -1 on error
+	 */
+	int status;
+};
+
+struct libewf_write_pipeline
+{
+	/* The IO handle
+	 */
+	libewf_io_handle_t *io_handle;
+
+	/* The chunk data pool to which the chunk data of failed jobs is released
+	 */
+	libewf_chunk_data_pool_t *chunk_data_pool;
+
+	/* The compressed zero byte empty block
+	 */
+	const uint8_t *compressed_zero_byte_empty_block;
+
+	/* The compressed zero byte empty block size
+	 */
+	size_t compressed_zero_byte_empty_block_size;
+
+	/* The jobs, used as a ring buffer in chunk index order
+	 */
+	libewf_write_pipeline_job_t *jobs;
+
+	/* The maximum number of jobs
+	 */
+	int maximum_number_of_jobs;
+
+	/* The index of the first (oldest) job
+	 */
+	int first_job_index;
+
+	/* The number of jobs, the jobs are only added and removed by the writing thread
+	 */
+	int number_of_jobs;
+
+	/* The thread pool that packs the chunk data
+	 */
+	libcthreads_thread_pool_t *thread_pool;
+
+	/* The mutex that protects the job status
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The condition that is signalled when a job has completed
+	 */
+	libcthreads_condition_t *condition;
+};
+
+int libewf_write_pipeline_initialize(
+     libewf_write_pipeline_t **write_pipeline,
+     int number_of_threads,
+     libewf_io_handle_t *io_handle,
+     libewf_chunk_data_pool_t *chunk_data_pool,
+     const uint8_t *compressed_zero_byte_empty_block,
+     size_t compressed_zero_byte_empty_block_size,
+     libcerror_error_t **error );
+
+int libewf_write_pipeline_free(
+     libewf_write_pipeline_t **write_pipeline,
+     libcerror_error_t **error );
+
+int libewf_write_pipeline_release_chunk_data(
+     libewf_write_pipeline_t *write_pipeline,
+     libewf_chunk_data_t **chunk_data,
+     libcerror_error_t **error );
+
+int libewf_write_pipeline_push(
+     libewf_write_pipeline_t *write_pipeline,
+     uint64_t chunk_index,
+     libewf_chunk_data_t *chunk_data,
+     size_t input_data_size,
+     int8_t compression_level,
+     uint8_t pack_flags,
+     libcerror_error_t **error );
+
+int libewf_write_pipeline_pop(
+     libewf_write_pipeline_t *write_pipeline,
+     uint64_t *chunk_index,
+     libewf_chunk_data_t **chunk_data,
+     size_t *input_data_size,
+     uint8_t wait_for_job,
+     libcerror_error_t **error );
+
+int libewf_write_pipeline_pack_callback(
+     libewf_write_pipeline_job_t *job,
+     libewf_write_pipeline_t *write_pipeline );
+
+#endif /* defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBEWF_WRITE_PIPELINE_H ) */
+
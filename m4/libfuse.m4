@@ -1,6 +1,6 @@
 dnl Functions for libfuse
 dnl
-dnl Version: 20180403
+dnl Version: 20201230
 
 dnl Function to detect if libfuse is available
 dnl ac_libfuse_dummy is used to prevent AC_CHECK_LIB adding unnecessary -l<library> arguments
@@ -22,14 +22,27 @@ AC_DEFUN([AX_LIBFUSE_CHECK_LIB],
     [dnl Check for a pkg-config file
     AS_IF(
       [test "x$cross_compiling" != "xyes" && test "x$PKGCONFIG" != "x"],
-      [PKG_CHECK_MODULES(
-        [fuse],
-        [fuse >= 2.6],
-        [ac_cv_libfuse=libfuse],
+      [dnl Prefer libfuse 3 which supports larger read requests
+      PKG_CHECK_MODULES(
+        [fuse3],
+        [fuse3 >= 3.1],
+        [ac_cv_libfuse=libfuse3],
         [ac_cv_libfuse=no])
+
+      AS_IF(
+        [test "x$ac_cv_libfuse" = xno],
+        [PKG_CHECK_MODULES(
+          [fuse],
+          [fuse >= 2.6],
+          [ac_cv_libfuse=libfuse],
+          [ac_cv_libfuse=no])
+        ])
       ])
 
     AS_IF(
+      [test "x$ac_cv_libfuse" = xlibfuse3],
+      [ac_cv_libfuse_CPPFLAGS="$pkg_cv_fuse3_CFLAGS"
+      ac_cv_libfuse_LIBADD="$pkg_cv_fuse3_LIBS"],
       [test "x$ac_cv_libfuse" = xlibfuse],
       [ac_cv_libfuse_CPPFLAGS="$pkg_cv_fuse_CFLAGS"
       ac_cv_libfuse_LIBADD="$pkg_cv_fuse_LIBS"],
@@ -124,6 +137,13 @@ AC_DEFUN([AX_LIBFUSE_CHECK_LIB],
       ])
     ])
 
+  AS_IF(
+    [test "x$ac_cv_libfuse" = xlibfuse3],
+    [AC_DEFINE(
+      [HAVE_LIBFUSE3],
+      [1],
+      [Define to 1 if you have the 'fuse3' library (-lfuse3).])
+    ])
   AS_IF(
     [test "x$ac_cv_libfuse" = xlibfuse],
     [AC_DEFINE(
@@ -175,6 +195,12 @@ AC_DEFUN([AX_LIBFUSE_CHECK_ENABLE],
       [$ac_cv_libfuse_LIBADD])
     ])
 
+  AS_IF(
+    [test "x$ac_cv_libfuse" = xlibfuse3],
+    [AC_SUBST(
+      [ax_libfuse_pc_libs_private],
+      [-lfuse3])
+    ])
   AS_IF(
     [test "x$ac_cv_libfuse" = xlibfuse],
     [AC_SUBST(
@@ -188,6 +214,15 @@ AC_DEFUN([AX_LIBFUSE_CHECK_ENABLE],
       [-losxfuse])
     ])
 
+  AS_IF(
+    [test "x$ac_cv_libfuse" = xlibfuse3],
+    [AC_SUBST(
+      [ax_libfuse_spec_requires],
+      [fuse3-libs])
+    AC_SUBST(
+      [ax_libfuse_spec_build_requires],
+      [fuse3-devel])
+    ])
   AS_IF(
     [test "x$ac_cv_libfuse" = xlibfuse],
     [AC_SUBST(
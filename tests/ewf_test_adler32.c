@@ -0,0 +1,398 @@
+/*
+ * Library Adler-32 SIMD functions test program
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_adler32.h"
+#include "../libewf/libewf_deflate.h"
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+/* Large enough to cover multiple reductions of the 32-bit sums
+ */
+#define EWF_TEST_ADLER32_BUFFER_SIZE	( 3 * 5552 + 67 )
+
+uint8_t ewf_test_adler32_buffer[ EWF_TEST_ADLER32_BUFFER_SIZE ];
+
+size_t ewf_test_adler32_sizes[ 13 ] = {
+	0, 1, 15, 31, 32, 33, 64, 5535, 5536, 5552, 5553, 16384, EWF_TEST_ADLER32_BUFFER_SIZE - 3 };
+
+uint32_t ewf_test_adler32_initial_values[ 3 ] = {
+	0x00000001UL, 0xfff0fff0UL, 0x9abc5678UL };
+
+/* Calculates the Adler-32 of a buffer using the straightforward scalar definition
+ * Returns the Adler-32
+ */
+uint32_t ewf_test_adler32_calculate_scalar(
+          uint32_t initial_value,
+          const uint8_t *buffer,
+          size_t size )
+{
+	uint32_t lower_word = initial_value & 0xffff;
+	uint32_t upper_word = ( initial_value >> 16 ) & 0xffff;
+
+	while( size > 0 )
+	{
+		lower_word = ( lower_word + *buffer++ ) % 65521;
+		upper_word = ( upper_word + lower_word ) % 65521;
+
+		size--;
+	}
+	return( ( upper_word << 16 ) | lower_word );
+}
+
+/* Fills the test buffer with a specific byte value or pseudo random data if fill value is -1
+ */
+void ewf_test_adler32_fill_buffer(
+      int fill_value )
+{
+	uint32_t random_value = 0x12345678UL;
+	size_t buffer_offset  = 0;
+
+	for( buffer_offset = 0;
+	     buffer_offset < EWF_TEST_ADLER32_BUFFER_SIZE;
+	     buffer_offset++ )
+	{
+		if( fill_value == -1 )
+		{
+			random_value = ( random_value * 1103515245UL ) + 12345UL;
+
+			ewf_test_adler32_buffer[ buffer_offset ] = (uint8_t) ( random_value >> 24 );
+		}
+		else
+		{
+			ewf_test_adler32_buffer[ buffer_offset ] = (uint8_t) fill_value;
+		}
+	}
+}
+
+/* Cross-checks an Adler-32 kernel against the scalar calculation
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_adler32_cross_check(
+     uint32_t (*calculate_function)( uint32_t initial_value, const uint8_t *buffer, size_t size ) )
+{
+	int fill_values[ 3 ]    = { -1, 0xff, 0x00 };
+	size_t buffer_offset    = 0;
+	uint32_t checksum       = 0;
+	uint32_t expected       = 0;
+	int fill_value_index    = 0;
+	int initial_value_index = 0;
+	int size_index          = 0;
+
+	for( fill_value_index = 0;
+	     fill_value_index < 3;
+	     fill_value_index++ )
+	{
+		ewf_test_adler32_fill_buffer(
+		 fill_values[ fill_value_index ] );
+
+		for( size_index = 0;
+		     size_index < 13;
+		     size_index++ )
+		{
+			for( initial_value_index = 0;
+			     initial_value_index < 3;
+			     initial_value_index++ )
+			{
+				/* Test unaligned buffers as well
+				 */
+				for( buffer_offset = 0;
+				     buffer_offset < 3;
+				     buffer_offset++ )
+				{
+					expected = ewf_test_adler32_calculate_scalar(
+					            ewf_test_adler32_initial_values[ initial_value_index ],
+					            &( ewf_test_adler32_buffer[ buffer_offset ] ),
+					            ewf_test_adler32_sizes[ size_index ] );
+
+					checksum = calculate_function(
+					            ewf_test_adler32_initial_values[ initial_value_index ],
+					            &( ewf_test_adler32_buffer[ buffer_offset ] ),
+					            ewf_test_adler32_sizes[ size_index ] );
+
+					EWF_TEST_ASSERT_EQUAL_UINT32(
+					 "checksum",
+					 checksum,
+					 expected );
+				}
+			}
+		}
+	}
+	return( 1 );
+
+on_error:
+	return( 0 );
+}
+
+#if defined( LIBEWF_ADLER32_HAVE_SSSE3 )
+
+/* Tests the libewf_adler32_calculate_ssse3 function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_adler32_calculate_ssse3(
+     void )
+{
+	if( ( libewf_adler32_get_cpu_features() & LIBEWF_ADLER32_CPU_FEATURE_SSSE3 ) == 0 )
+	{
+		return( 1 );
+	}
+	return( ewf_test_adler32_cross_check(
+	         &libewf_adler32_calculate_ssse3 ) );
+}
+
+#endif /* defined( LIBEWF_ADLER32_HAVE_SSSE3 ) */
+
+#if defined( LIBEWF_ADLER32_HAVE_AVX2 )
+
+/* Tests the libewf_adler32_calculate_avx2 function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_adler32_calculate_avx2(
+     void )
+{
+	if( ( libewf_adler32_get_cpu_features() & LIBEWF_ADLER32_CPU_FEATURE_AVX2 ) == 0 )
+	{
+		return( 1 );
+	}
+	return( ewf_test_adler32_cross_check(
+	         &libewf_adler32_calculate_avx2 ) );
+}
+
+#endif /* defined( LIBEWF_ADLER32_HAVE_AVX2 ) */
+
+#if defined( LIBEWF_ADLER32_HAVE_NEON )
+
+/* Tests the libewf_adler32_calculate_neon function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_adler32_calculate_neon(
+     void )
+{
+	return( ewf_test_adler32_cross_check(
+	         &libewf_adler32_calculate_neon ) );
+}
+
+#endif /* defined( LIBEWF_ADLER32_HAVE_NEON ) */
+
+/* Tests the libewf_adler32_calculate_pattern_fill function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_adler32_calculate_pattern_fill(
+     void )
+{
+	uint8_t patterns[ 3 ][ 8 ] = {
+		{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },
+		{ 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff },
+		{ 0x01, 0x02, 0x03, 0xfe, 0x05, 0x06, 0x07, 0x80 } };
+
+	size_t buffer_offset    = 0;
+	size_t size             = 0;
+	uint32_t checksum       = 0;
+	uint32_t expected       = 0;
+	int initial_value_index = 0;
+	int pattern_index       = 0;
+
+	for( pattern_index = 0;
+	     pattern_index < 3;
+	     pattern_index++ )
+	{
+		for( buffer_offset = 0;
+		     buffer_offset < EWF_TEST_ADLER32_BUFFER_SIZE;
+		     buffer_offset++ )
+		{
+			ewf_test_adler32_buffer[ buffer_offset ] = patterns[ pattern_index ][ buffer_offset % 8 ];
+		}
+		/* Cover sizes beyond the reduction boundaries of the sums
+		 */
+		for( size = 0;
+		     size <= EWF_TEST_ADLER32_BUFFER_SIZE;
+		     size += 8 * 131 )
+		{
+			for( initial_value_index = 0;
+			     initial_value_index < 3;
+			     initial_value_index++ )
+			{
+				expected = ewf_test_adler32_calculate_scalar(
+				            ewf_test_adler32_initial_values[ initial_value_index ],
+				            ewf_test_adler32_buffer,
+				            size );
+
+				checksum = libewf_adler32_calculate_pattern_fill(
+				            ewf_test_adler32_initial_values[ initial_value_index ],
+				            patterns[ pattern_index ],
+				            size );
+
+				EWF_TEST_ASSERT_EQUAL_UINT32(
+				 "checksum",
+				 checksum,
+				 expected );
+			}
+		}
+	}
+	return( 1 );
+
+on_error:
+	return( 0 );
+}
+
+/* Tests the libewf_adler32_calculate_simd function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_adler32_calculate_simd(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	uint32_t checksum        = 0;
+	uint32_t expected        = 0;
+	int result               = 0;
+
+	ewf_test_adler32_fill_buffer(
+	 -1 );
+
+	/* Test regular cases
+	 */
+	result = libewf_adler32_calculate_simd(
+	          &checksum,
+	          ewf_test_adler32_buffer,
+	          EWF_TEST_ADLER32_BUFFER_SIZE,
+	          1 );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	if( result == 1 )
+	{
+		expected = ewf_test_adler32_calculate_scalar(
+		            1,
+		            ewf_test_adler32_buffer,
+		            EWF_TEST_ADLER32_BUFFER_SIZE );
+
+		EWF_TEST_ASSERT_EQUAL_UINT32(
+		 "checksum",
+		 checksum,
+		 expected );
+	}
+	/* The deflate implementation dispatches to the SIMD kernels if supported
+	 */
+	result = libewf_deflate_calculate_adler32(
+	          &checksum,
+	          ewf_test_adler32_buffer,
+	          EWF_TEST_ADLER32_BUFFER_SIZE,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	expected = ewf_test_adler32_calculate_scalar(
+	            1,
+	            ewf_test_adler32_buffer,
+	            EWF_TEST_ADLER32_BUFFER_SIZE );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "checksum",
+	 checksum,
+	 expected );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+#if defined( LIBEWF_ADLER32_HAVE_SSSE3 )
+	EWF_TEST_RUN(
+	 "libewf_adler32_calculate_ssse3",
+	 ewf_test_adler32_calculate_ssse3 );
+#endif
+
+#if defined( LIBEWF_ADLER32_HAVE_AVX2 )
+	EWF_TEST_RUN(
+	 "libewf_adler32_calculate_avx2",
+	 ewf_test_adler32_calculate_avx2 );
+#endif
+
+#if defined( LIBEWF_ADLER32_HAVE_NEON )
+	EWF_TEST_RUN(
+	 "libewf_adler32_calculate_neon",
+	 ewf_test_adler32_calculate_neon );
+#endif
+
+	EWF_TEST_RUN(
+	 "libewf_adler32_calculate_pattern_fill",
+	 ewf_test_adler32_calculate_pattern_fill );
+
+	EWF_TEST_RUN(
+	 "libewf_adler32_calculate_simd",
+	 ewf_test_adler32_calculate_simd );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
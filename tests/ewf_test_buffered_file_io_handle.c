@@ -0,0 +1,915 @@
+/*
+ * Library buffered_file_io_handle type test program
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_buffered_file_io_handle.h"
+#include "../libewf/libewf_definitions.h"
+#include "../libewf/libewf_libbfio.h"
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) && defined( LIBEWF_HAVE_BUFFERED_FILE_IO )
+
+#define EWF_TEST_BUFFERED_FILE_IO_HANDLE_FILENAME	"ewf_test_buffered_file_io_handle.raw"
+
+/* Tests the libewf_buffered_file_io_handle_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_buffered_file_io_handle_initialize(
+     void )
+{
+	libcerror_error_t *error                         = NULL;
+	libewf_buffered_file_io_handle_t *file_io_handle = NULL;
+	int result                                       = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_buffered_file_io_handle_initialize(
+	          &file_io_handle,
+	          5000,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "file_io_handle->buffer_size",
+	 file_io_handle->buffer_size,
+	 (size_t) ( 2 * LIBEWF_SEGMENT_WRITE_BUFFER_ALIGNMENT ) );
+
+	result = libewf_buffered_file_io_handle_free(
+	          &file_io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_buffered_file_io_handle_initialize(
+	          NULL,
+	          LIBEWF_DEFAULT_SEGMENT_WRITE_BUFFER_SIZE,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	file_io_handle = (libewf_buffered_file_io_handle_t *) 0x12345678UL;
+
+	result = libewf_buffered_file_io_handle_initialize(
+	          &file_io_handle,
+	          LIBEWF_DEFAULT_SEGMENT_WRITE_BUFFER_SIZE,
+	          0,
+	          &error );
+
+	file_io_handle = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_buffered_file_io_handle_initialize(
+	          &file_io_handle,
+	          0,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_buffered_file_io_handle_initialize(
+	          &file_io_handle,
+	          LIBEWF_MAXIMUM_SEGMENT_WRITE_BUFFER_SIZE + 1,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_io_handle != NULL )
+	{
+		libewf_buffered_file_io_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_buffered_file_io_handle_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_buffered_file_io_handle_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libewf_buffered_file_io_handle_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests writing and reading back data with the buffered file IO handle
+ * The writes are larger and smaller than the write buffer and one of them
+ * overwrites data that is still buffered
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_buffered_file_io_handle_write_and_read(
+     uint8_t write_flags )
+{
+	uint8_t expected_data[ 20000 ];
+	uint8_t read_data[ 20000 ];
+
+	libcerror_error_t *error                         = NULL;
+	libewf_buffered_file_io_handle_t *file_io_handle = NULL;
+	size64_t size                                    = 0;
+	ssize_t read_count                               = 0;
+	ssize_t write_count                              = 0;
+	off64_t offset                                   = 0;
+	size_t data_index                                = 0;
+	int result                                       = 0;
+
+	for( data_index = 0;
+	     data_index < 20000;
+	     data_index++ )
+	{
+		expected_data[ data_index ] = (uint8_t) ( data_index % 251 );
+	}
+	/* Initialize test
+	 */
+	result = libewf_buffered_file_io_handle_initialize(
+	          &file_io_handle,
+	          LIBEWF_SEGMENT_WRITE_BUFFER_ALIGNMENT,
+	          write_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_buffered_file_io_handle_set_name(
+	          file_io_handle,
+	          EWF_TEST_BUFFERED_FILE_IO_HANDLE_FILENAME,
+	          narrow_string_length( EWF_TEST_BUFFERED_FILE_IO_HANDLE_FILENAME ) + 1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_buffered_file_io_handle_open(
+	          file_io_handle,
+	          LIBBFIO_ACCESS_FLAG_READ | LIBBFIO_ACCESS_FLAG_WRITE | LIBBFIO_ACCESS_FLAG_TRUNCATE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	write_count = libewf_buffered_file_io_handle_write(
+	               file_io_handle,
+	               expected_data,
+	               100,
+	               &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) 100 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	write_count = libewf_buffered_file_io_handle_write(
+	               file_io_handle,
+	               &( expected_data[ 100 ] ),
+	               9900,
+	               &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) 9900 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Overwrite data that is still buffered
+	 */
+	expected_data[ 9000 ] = 0xff;
+
+	offset = libewf_buffered_file_io_handle_seek_offset(
+	          file_io_handle,
+	          9000,
+	          SEEK_SET,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 9000 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	write_count = libewf_buffered_file_io_handle_write(
+	               file_io_handle,
+	               &( expected_data[ 9000 ] ),
+	               1,
+	               &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	offset = libewf_buffered_file_io_handle_seek_offset(
+	          file_io_handle,
+	          0,
+	          SEEK_END,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 10000 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	write_count = libewf_buffered_file_io_handle_write(
+	               file_io_handle,
+	               &( expected_data[ 10000 ] ),
+	               10000,
+	               &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) 10000 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_buffered_file_io_handle_get_size(
+	          file_io_handle,
+	          &size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "size",
+	 (uint64_t) size,
+	 (uint64_t) 20000 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Read back data that is partially still buffered
+	 */
+	offset = libewf_buffered_file_io_handle_seek_offset(
+	          file_io_handle,
+	          0,
+	          SEEK_SET,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	read_count = libewf_buffered_file_io_handle_read(
+	              file_io_handle,
+	              read_data,
+	              20000,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 20000 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          read_data,
+	          expected_data,
+	          20000 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libewf_buffered_file_io_handle_close(
+	          file_io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Read back data after the file was closed
+	 */
+	result = libewf_buffered_file_io_handle_open(
+	          file_io_handle,
+	          LIBBFIO_ACCESS_FLAG_READ,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_buffered_file_io_handle_get_size(
+	          file_io_handle,
+	          &size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "size",
+	 (uint64_t) size,
+	 (uint64_t) 20000 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	read_count = libewf_buffered_file_io_handle_read(
+	              file_io_handle,
+	              read_data,
+	              20000,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 20000 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          read_data,
+	          expected_data,
+	          20000 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	write_count = libewf_buffered_file_io_handle_write(
+	               file_io_handle,
+	               expected_data,
+	               100,
+	               &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_buffered_file_io_handle_close(
+	          file_io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_buffered_file_io_handle_free(
+	          &file_io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	unlink(
+	 EWF_TEST_BUFFERED_FILE_IO_HANDLE_FILENAME );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_io_handle != NULL )
+	{
+		libewf_buffered_file_io_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	unlink(
+	 EWF_TEST_BUFFERED_FILE_IO_HANDLE_FILENAME );
+
+	return( 0 );
+}
+
+/* Tests the libewf_buffered_file_io_handle_preallocate function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_buffered_file_io_handle_preallocate(
+     void )
+{
+	uint8_t data[ 10000 ];
+
+	libcerror_error_t *error                         = NULL;
+	libewf_buffered_file_io_handle_t *file_io_handle = NULL;
+	size64_t size                                    = 0;
+	ssize_t write_count                              = 0;
+	int result                                       = 0;
+
+	if( memory_set(
+	     data,
+	     0xa5,
+	     10000 ) == NULL )
+	{
+		return( 0 );
+	}
+	/* Initialize test
+	 */
+	result = libewf_buffered_file_io_handle_initialize(
+	          &file_io_handle,
+	          LIBEWF_SEGMENT_WRITE_BUFFER_ALIGNMENT,
+	          LIBEWF_WRITE_FLAG_PREALLOCATE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_buffered_file_io_handle_set_name(
+	          file_io_handle,
+	          EWF_TEST_BUFFERED_FILE_IO_HANDLE_FILENAME,
+	          narrow_string_length( EWF_TEST_BUFFERED_FILE_IO_HANDLE_FILENAME ) + 1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_buffered_file_io_handle_set_preallocation_size(
+	          file_io_handle,
+	          1048576,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_buffered_file_io_handle_open(
+	          file_io_handle,
+	          LIBBFIO_ACCESS_FLAG_WRITE | LIBBFIO_ACCESS_FLAG_TRUNCATE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The pre-allocated blocks do not count as data written
+	 */
+	result = libewf_buffered_file_io_handle_get_size(
+	          file_io_handle,
+	          &size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "size",
+	 (uint64_t) size,
+	 (uint64_t) 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	write_count = libewf_buffered_file_io_handle_write(
+	               file_io_handle,
+	               data,
+	               10000,
+	               &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) 10000 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_buffered_file_io_handle_close(
+	          file_io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The file is truncated to the size of the data written on close
+	 * and is not pre-allocated when it is opened without truncate
+	 */
+	result = libewf_buffered_file_io_handle_open(
+	          file_io_handle,
+	          LIBBFIO_ACCESS_FLAG_READ | LIBBFIO_ACCESS_FLAG_WRITE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "file_io_handle->is_preallocated",
+	 file_io_handle->is_preallocated,
+	 0 );
+
+	result = libewf_buffered_file_io_handle_get_size(
+	          file_io_handle,
+	          &size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "size",
+	 (uint64_t) size,
+	 (uint64_t) 10000 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_buffered_file_io_handle_close(
+	          file_io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_buffered_file_io_handle_preallocate(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_buffered_file_io_handle_preallocate(
+	          file_io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_buffered_file_io_handle_free(
+	          &file_io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	unlink(
+	 EWF_TEST_BUFFERED_FILE_IO_HANDLE_FILENAME );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_io_handle != NULL )
+	{
+		libewf_buffered_file_io_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	unlink(
+	 EWF_TEST_BUFFERED_FILE_IO_HANDLE_FILENAME );
+
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) && defined( LIBEWF_HAVE_BUFFERED_FILE_IO ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) && defined( LIBEWF_HAVE_BUFFERED_FILE_IO )
+
+	EWF_TEST_RUN(
+	 "libewf_buffered_file_io_handle_initialize",
+	 ewf_test_buffered_file_io_handle_initialize );
+
+	EWF_TEST_RUN(
+	 "libewf_buffered_file_io_handle_free",
+	 ewf_test_buffered_file_io_handle_free );
+
+	EWF_TEST_RUN_WITH_ARGS(
+	 "libewf_buffered_file_io_handle_write_and_read",
+	 ewf_test_buffered_file_io_handle_write_and_read,
+	 0 );
+
+	EWF_TEST_RUN_WITH_ARGS(
+	 "libewf_buffered_file_io_handle_write_and_read (direct IO)",
+	 ewf_test_buffered_file_io_handle_write_and_read,
+	 LIBEWF_WRITE_FLAG_DIRECT_IO | LIBEWF_WRITE_FLAG_DONT_CACHE );
+
+	EWF_TEST_RUN(
+	 "libewf_buffered_file_io_handle_preallocate",
+	 ewf_test_buffered_file_io_handle_preallocate );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) && defined( LIBEWF_HAVE_BUFFERED_FILE_IO ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
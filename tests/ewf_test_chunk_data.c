@@ -1049,6 +1049,8 @@ int ewf_test_chunk_data_pack(
 	libewf_chunk_data_t *chunk_data = NULL;
 	libewf_io_handle_t *io_handle   = NULL;
 	uint8_t *data                   = NULL;
+	uint32_t random_value           = 0;
+	size_t data_index               = 0;
 	int result                      = 0;
 
 	/* Initialize test
@@ -1098,6 +1100,7 @@ int ewf_test_chunk_data_pack(
 	result = libewf_chunk_data_pack(
 	          chunk_data,
 	          io_handle,
+	          LIBEWF_COMPRESSION_NONE,
 	          NULL,
 	          0,
 	          0,
@@ -1119,6 +1122,7 @@ int ewf_test_chunk_data_pack(
 	result = libewf_chunk_data_pack(
 	          NULL,
 	          io_handle,
+	          LIBEWF_COMPRESSION_NONE,
 	          NULL,
 	          0,
 	          0,
@@ -1143,6 +1147,7 @@ int ewf_test_chunk_data_pack(
 	result = libewf_chunk_data_pack(
 	          chunk_data,
 	          io_handle,
+	          LIBEWF_COMPRESSION_NONE,
 	          NULL,
 	          0,
 	          0,
@@ -1165,6 +1170,7 @@ int ewf_test_chunk_data_pack(
 	result = libewf_chunk_data_pack(
 	          chunk_data,
 	          NULL,
+	          LIBEWF_COMPRESSION_NONE,
 	          NULL,
 	          0,
 	          0,
@@ -1187,6 +1193,7 @@ int ewf_test_chunk_data_pack(
 	result = libewf_chunk_data_pack(
 	          chunk_data,
 	          io_handle,
+	          LIBEWF_COMPRESSION_NONE,
 	          NULL,
 	          0,
 	          0,
@@ -1206,6 +1213,112 @@ int ewf_test_chunk_data_pack(
 	libcerror_error_free(
 	 &error );
 
+	/* Test pack with trial compression
+	 */
+	result = libewf_chunk_data_free(
+	          &chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_data_initialize(
+	          &chunk_data,
+	          32768,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_data",
+	 chunk_data );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Incompressible data is stored uncompressed
+	 */
+	random_value = 0x12345678UL;
+
+	for( data_index = 0;
+	     data_index < 32768;
+	     data_index++ )
+	{
+		random_value = ( random_value * 1103515245UL ) + 12345UL;
+
+		chunk_data->data[ data_index ] = (uint8_t) ( random_value >> 16 );
+	}
+	chunk_data->data_size   = 32768;
+	chunk_data->range_flags = 0;
+
+	result = libewf_chunk_data_pack(
+	          chunk_data,
+	          io_handle,
+	          LIBEWF_COMPRESSION_FAST,
+	          NULL,
+	          0,
+	          LIBEWF_PACK_FLAG_CALCULATE_CHECKSUM | LIBEWF_PACK_FLAG_USE_TRIAL_COMPRESSION,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED",
+	 (int) ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED ),
+	 0 );
+
+	/* Compressible data is compressed
+	 */
+	for( data_index = 0;
+	     data_index < 32768;
+	     data_index++ )
+	{
+		chunk_data->data[ data_index ] = (uint8_t) ( data_index % 251 );
+	}
+	chunk_data->data_size   = 32768;
+	chunk_data->range_flags = 0;
+
+	result = libewf_chunk_data_pack(
+	          chunk_data,
+	          io_handle,
+	          LIBEWF_COMPRESSION_FAST,
+	          NULL,
+	          0,
+	          LIBEWF_PACK_FLAG_CALCULATE_CHECKSUM | LIBEWF_PACK_FLAG_USE_TRIAL_COMPRESSION,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED",
+	 (int) ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED ),
+	 LIBEWF_RANGE_FLAG_IS_COMPRESSED );
+
 /* TODO improve test coverage */
 
 	/* Clean up
@@ -1540,6 +1653,333 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libewf_chunk_data_unpack function on chunk data that reuses buffers after pack
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_chunk_data_unpack_after_pack(
+     void )
+{
+	libcerror_error_t *error        = NULL;
+	libewf_chunk_data_t *chunk_data = NULL;
+	libewf_io_handle_t *io_handle   = NULL;
+	uint8_t *data                   = NULL;
+	uint8_t *packed_data            = NULL;
+	uint8_t *spare_data             = NULL;
+	size_t data_index               = 0;
+	size_t packed_data_size         = 0;
+	uint32_t random_value           = 0;
+	int result                      = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_data_initialize(
+	          &chunk_data,
+	          32768,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_data",
+	 chunk_data );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( data_index = 0;
+	     data_index < 32768;
+	     data_index++ )
+	{
+		chunk_data->data[ data_index ] = (uint8_t) ( data_index % 7 );
+	}
+	chunk_data->data_size = 32768;
+
+	data = chunk_data->data;
+
+	/* Test pack of compressible data retains the data buffer as spare data
+	 */
+	result = libewf_chunk_data_pack(
+	          chunk_data,
+	          io_handle,
+	          LIBEWF_COMPRESSION_DEFAULT,
+	          NULL,
+	          0,
+	          LIBEWF_PACK_FLAG_CALCULATE_CHECKSUM,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED",
+	 (int) ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED ),
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_data->compressed_data",
+	 chunk_data->compressed_data );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "chunk_data->spare_data",
+	 (int) ( chunk_data->spare_data == data ),
+	 1 );
+
+	/* Test unpack of compressed data that fails restores the packed data
+	 */
+	packed_data      = chunk_data->data;
+	packed_data_size = chunk_data->data_size;
+
+	chunk_data->range_flags |= LIBEWF_RANGE_FLAG_USES_PATTERN_FILL;
+	chunk_data->data_size    = 4;
+
+	result = libewf_chunk_data_unpack(
+	          chunk_data,
+	          io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "chunk_data->data",
+	 (int) ( chunk_data->data == packed_data ),
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "chunk_data->data_size",
+	 chunk_data->data_size,
+	 (size_t) 4 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_data->compressed_data",
+	 chunk_data->compressed_data );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "chunk_data->spare_data",
+	 (int) ( chunk_data->spare_data == data ),
+	 1 );
+
+	chunk_data->range_flags &= ~( LIBEWF_RANGE_FLAG_USES_PATTERN_FILL );
+	chunk_data->data_size    = packed_data_size;
+
+	result = libewf_chunk_data_unpack(
+	          chunk_data,
+	          io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "chunk_data->data_size",
+	 chunk_data->data_size,
+	 (size_t) 32768 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "chunk_data->data",
+	 (int) ( chunk_data->data == data ),
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED",
+	 (uint32_t) ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_CORRUPTED ),
+	 (uint32_t) 0 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "chunk_data->data[ 32767 ]",
+	 (int) chunk_data->data[ 32767 ],
+	 (int) ( 32767 % 7 ) );
+
+	/* Test pack of incompressible data retains the compressed data buffer as spare data
+	 */
+	random_value = 0x12345678UL;
+
+	for( data_index = 0;
+	     data_index < 32768;
+	     data_index++ )
+	{
+		random_value = ( random_value * 1103515245UL ) + 12345UL;
+
+		chunk_data->data[ data_index ] = (uint8_t) ( random_value >> 16 );
+	}
+	chunk_data->data_size   = 32768;
+	chunk_data->range_flags = 0;
+
+	result = libewf_chunk_data_pack(
+	          chunk_data,
+	          io_handle,
+	          LIBEWF_COMPRESSION_DEFAULT,
+	          NULL,
+	          0,
+	          LIBEWF_PACK_FLAG_CALCULATE_CHECKSUM,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED",
+	 (uint32_t) ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED ),
+	 (uint32_t) 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_data->compressed_data",
+	 chunk_data->compressed_data );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_data->spare_data",
+	 chunk_data->spare_data );
+
+	/* Test unpack of uncompressed data that fails does not swap in the spare data
+	 */
+	spare_data = chunk_data->spare_data;
+
+	chunk_data->data_size = 2;
+
+	result = libewf_chunk_data_unpack(
+	          chunk_data,
+	          io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "chunk_data->data",
+	 (int) ( chunk_data->data == data ),
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_SIZE(
+	 "chunk_data->data_size",
+	 chunk_data->data_size,
+	 (size_t) 2 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_data->compressed_data",
+	 chunk_data->compressed_data );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "chunk_data->spare_data",
+	 (int) ( chunk_data->spare_data == spare_data ),
+	 1 );
+
+	/* Clean up
+	 */
+	result = libewf_chunk_data_free(
+	          &chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_data",
+	 chunk_data );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libewf_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
 /* Tests the libewf_chunk_data_check_for_empty_block function
  * Returns 1 if successful or 0 if not
  */
@@ -2392,6 +2832,10 @@ int main(
 	 "libewf_chunk_data_unpack",
 	 ewf_test_chunk_data_unpack );
 
+	EWF_TEST_RUN(
+	 "libewf_chunk_data_unpack_after_pack",
+	 ewf_test_chunk_data_unpack_after_pack );
+
 	EWF_TEST_RUN(
 	 "libewf_chunk_data_check_for_empty_block",
 	 ewf_test_chunk_data_check_for_empty_block );
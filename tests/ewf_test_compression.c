@@ -701,6 +701,7 @@ int ewf_test_compress_data(
 	compressed_data_size = 4096;
 
 	result = libewf_compress_data(
+	          NULL,
 	          compressed_data,
 	          &compressed_data_size,
 	          LIBEWF_COMPRESSION_METHOD_DEFLATE,
@@ -725,6 +726,7 @@ int ewf_test_compress_data(
 	compressed_data_size = 4096;
 
 	result = libewf_compress_data(
+	          NULL,
 	          NULL,
 	          &compressed_data_size,
 	          LIBEWF_COMPRESSION_METHOD_DEFLATE,
@@ -746,6 +748,7 @@ int ewf_test_compress_data(
 	 &error );
 
 	result = libewf_compress_data(
+	          NULL,
 	          compressed_data,
 	          NULL,
 	          LIBEWF_COMPRESSION_METHOD_DEFLATE,
@@ -767,6 +770,7 @@ int ewf_test_compress_data(
 	 &error );
 
 	result = libewf_compress_data(
+	          NULL,
 	          compressed_data,
 	          &compressed_data_size,
 	          LIBEWF_COMPRESSION_METHOD_DEFLATE,
@@ -790,6 +794,7 @@ int ewf_test_compress_data(
 	/* Test compressed_data == uncompressed_data
 	 */
 	result = libewf_compress_data(
+	          NULL,
 	          compressed_data,
 	          &compressed_data_size,
 	          LIBEWF_COMPRESSION_METHOD_DEFLATE,
@@ -811,6 +816,7 @@ int ewf_test_compress_data(
 	 &error );
 
 	result = libewf_compress_data(
+	          NULL,
 	          compressed_data,
 	          &compressed_data_size,
 	          LIBEWF_COMPRESSION_METHOD_DEFLATE,
@@ -840,6 +846,7 @@ int ewf_test_compress_data(
 	compressed_data_size = maximum_data_size + 1;
 
 	result = libewf_compress_data(
+	          NULL,
 	          compressed_data,
 	          &compressed_data_size,
 	          LIBEWF_COMPRESSION_METHOD_DEFLATE,
@@ -863,6 +870,7 @@ int ewf_test_compress_data(
 	 &error );
 
 	result = libewf_compress_data(
+	          NULL,
 	          compressed_data,
 	          &compressed_data_size,
 	          LIBEWF_COMPRESSION_METHOD_DEFLATE,
@@ -886,6 +894,7 @@ int ewf_test_compress_data(
 #if defined( HAVE_LIBBZ2 ) || defined( BZIP2_DLL )
 
 	result = libewf_compress_data(
+	          NULL,
 	          compressed_data,
 	          &compressed_data_size,
 	          LIBEWF_COMPRESSION_METHOD_BZIP2,
@@ -920,6 +929,7 @@ int ewf_test_compress_data(
 		compressed_data_size = maximum_data_size + 1;
 
 		result = libewf_compress_data(
+		          NULL,
 		          compressed_data,
 		          &compressed_data_size,
 		          LIBEWF_COMPRESSION_METHOD_BZIP2,
@@ -943,6 +953,7 @@ int ewf_test_compress_data(
 		 &error );
 
 		result = libewf_compress_data(
+		          NULL,
 		          compressed_data,
 		          &compressed_data_size,
 		          LIBEWF_COMPRESSION_METHOD_BZIP2,
@@ -965,6 +976,7 @@ int ewf_test_compress_data(
 	}
 */
 	result = libewf_compress_data(
+	          NULL,
 	          compressed_data,
 	          &compressed_data_size,
 	          LIBEWF_COMPRESSION_METHOD_NONE,
@@ -1014,6 +1026,7 @@ int ewf_test_decompress_data(
 	uncompressed_data_size = 8196;
 
 	result = libewf_decompress_data(
+	          NULL,
 	          ewf_test_compression_deflate_compressed_data1,
 	          2627,
 	          LIBEWF_COMPRESSION_METHOD_DEFLATE,
@@ -1037,6 +1050,7 @@ int ewf_test_decompress_data(
 	uncompressed_data_size = 8196;
 
 	result = libewf_decompress_data(
+	          NULL,
 	          NULL,
 	          2627,
 	          LIBEWF_COMPRESSION_METHOD_DEFLATE,
@@ -1057,6 +1071,7 @@ int ewf_test_decompress_data(
 	 &error );
 
 	result = libewf_decompress_data(
+	          NULL,
 	          ewf_test_compression_deflate_compressed_data1,
 	          2627,
 	          LIBEWF_COMPRESSION_METHOD_DEFLATE,
@@ -1077,6 +1092,7 @@ int ewf_test_decompress_data(
 	 &error );
 
 	result = libewf_decompress_data(
+	          NULL,
 	          ewf_test_compression_deflate_compressed_data1,
 	          2627,
 	          LIBEWF_COMPRESSION_METHOD_DEFLATE,
@@ -1099,6 +1115,7 @@ int ewf_test_decompress_data(
 	/* Test uncompressed_data == compressed_data
 	 */
 	result = libewf_decompress_data(
+	          NULL,
 	          uncompressed_data,
 	          2627,
 	          LIBEWF_COMPRESSION_METHOD_DEFLATE,
@@ -1125,6 +1142,7 @@ int ewf_test_decompress_data(
 #endif
 
 	result = libewf_decompress_data(
+	          NULL,
 	          ewf_test_compression_deflate_compressed_data1,
 	          maximum_data_size + 1,
 	          LIBEWF_COMPRESSION_METHOD_DEFLATE,
@@ -1147,6 +1165,7 @@ int ewf_test_decompress_data(
 	uncompressed_data_size = maximum_data_size + 1;
 
 	result = libewf_decompress_data(
+	          NULL,
 	          ewf_test_compression_deflate_compressed_data1,
 	          2627,
 	          LIBEWF_COMPRESSION_METHOD_DEFLATE,
@@ -1178,6 +1197,7 @@ int ewf_test_decompress_data(
 	if( maximum_data_size > 0 )
 	{
 		result = libewf_decompress_data(
+		          NULL,
 		          ewf_test_compression_deflate_compressed_data1,
 		          maximum_data_size + 1,
 		          LIBEWF_COMPRESSION_METHOD_BZIP2,
@@ -1200,6 +1220,7 @@ int ewf_test_decompress_data(
 		uncompressed_data_size = maximum_data_size + 1;
 
 		result = libewf_decompress_data(
+		          NULL,
 		          ewf_test_compression_deflate_compressed_data1,
 		          2627,
 		          LIBEWF_COMPRESSION_METHOD_BZIP2,
@@ -1223,6 +1244,7 @@ int ewf_test_decompress_data(
 	}
 */
 	result = libewf_decompress_data(
+	          NULL,
 	          ewf_test_compression_deflate_compressed_data1,
 	          2627,
 	          LIBEWF_COMPRESSION_METHOD_NONE,
@@ -586,6 +586,44 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libewf_data_chunk_is_corrupted function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_data_chunk_is_corrupted(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libewf_data_chunk_is_corrupted(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
 /* The main program
  */
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
@@ -629,6 +667,10 @@ int main(
 	 "libewf_data_chunk_write_buffer",
 	 ewf_test_data_chunk_write_buffer );
 
+	EWF_TEST_RUN(
+	 "libewf_data_chunk_is_corrupted",
+	 ewf_test_data_chunk_is_corrupted );
+
 	return( EXIT_SUCCESS );
 
 on_error:
@@ -736,10 +736,10 @@ int ewf_test_deflate_bit_stream_get_value(
 	 bit_stream.byte_stream_offset,
 	 (size_t) 0 );
 
-	EWF_TEST_ASSERT_EQUAL_UINT32(
+	EWF_TEST_ASSERT_EQUAL_UINT64(
 	 "bit_stream.bit_buffer",
 	 bit_stream.bit_buffer,
-	 (uint32_t) 0x00000000UL );
+	 (uint64_t) 0x00000000ULL );
 
 	EWF_TEST_ASSERT_EQUAL_UINT8(
 	 "bit_stream.bit_buffer_size",
@@ -771,10 +771,10 @@ int ewf_test_deflate_bit_stream_get_value(
 	 bit_stream.byte_stream_offset,
 	 (size_t) 1 );
 
-	EWF_TEST_ASSERT_EQUAL_UINT32(
+	EWF_TEST_ASSERT_EQUAL_UINT64(
 	 "bit_stream.bit_buffer",
 	 bit_stream.bit_buffer,
-	 (uint32_t) 0x00000007UL );
+	 (uint64_t) 0x00000007ULL );
 
 	EWF_TEST_ASSERT_EQUAL_UINT8(
 	 "bit_stream.bit_buffer_size",
@@ -806,10 +806,10 @@ int ewf_test_deflate_bit_stream_get_value(
 	 bit_stream.byte_stream_offset,
 	 (size_t) 2 );
 
-	EWF_TEST_ASSERT_EQUAL_UINT32(
+	EWF_TEST_ASSERT_EQUAL_UINT64(
 	 "bit_stream.bit_buffer",
 	 bit_stream.bit_buffer,
-	 (uint32_t) 0x00000000UL );
+	 (uint64_t) 0x00000000ULL );
 
 	EWF_TEST_ASSERT_EQUAL_UINT8(
 	 "bit_stream.bit_buffer_size",
@@ -841,10 +841,10 @@ int ewf_test_deflate_bit_stream_get_value(
 	 bit_stream.byte_stream_offset,
 	 (size_t) 6 );
 
-	EWF_TEST_ASSERT_EQUAL_UINT32(
+	EWF_TEST_ASSERT_EQUAL_UINT64(
 	 "bit_stream.bit_buffer",
 	 bit_stream.bit_buffer,
-	 (uint32_t) 0x00000000UL );
+	 (uint64_t) 0x00000000ULL );
 
 	EWF_TEST_ASSERT_EQUAL_UINT8(
 	 "bit_stream.bit_buffer_size",
@@ -1110,6 +1110,170 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libewf_deflate_huffman_table_construct_lookup_table function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_deflate_huffman_table_construct_lookup_table(
+     void )
+{
+	uint16_t code_size_array[ 318 ];
+
+	libewf_deflate_huffman_table_t table;
+
+	libcerror_error_t *error = NULL;
+	uint16_t symbol          = 0;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	for( symbol = 0;
+	     symbol < 318;
+	     symbol++ )
+	{
+		if( symbol < 144 )
+		{
+			code_size_array[ symbol ] = 8;
+		}
+		else if( symbol < 256 )
+		{
+			code_size_array[ symbol ] = 9;
+		}
+		else if( symbol < 280 )
+		{
+			code_size_array[ symbol ] = 7;
+		}
+		else if( symbol < 288 )
+		{
+			code_size_array[ symbol ] = 8;
+		}
+		else
+		{
+			code_size_array[ symbol ] = 5;
+		}
+	}
+	/* Test regular cases
+	 */
+	result = libewf_deflate_huffman_table_construct(
+	          &table,
+	          code_size_array,
+	          288,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "table.lookup_table_bits",
+	 table.lookup_table_bits,
+	 (uint8_t) 9 );
+
+	/* The end-of-block symbol has the 7-bit code 0000000
+	 */
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "table.lookup_table[ 0 ]",
+	 table.lookup_table[ 0 ],
+	 (uint32_t) 0x00070100UL );
+
+	result = libewf_deflate_huffman_table_construct(
+	          &table,
+	          &( code_size_array[ 288 ] ),
+	          30,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "table.lookup_table_bits",
+	 table.lookup_table_bits,
+	 (uint8_t) 5 );
+
+	/* The 5-bit codes 11110 and 11111 are not used
+	 */
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "table.lookup_table[ 15 ]",
+	 table.lookup_table[ 15 ],
+	 (uint32_t) 0x00000000UL );
+
+	/* Test error cases
+	 */
+	result = libewf_deflate_huffman_table_construct_lookup_table(
+	          NULL,
+	          code_size_array,
+	          288,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_deflate_huffman_table_construct_lookup_table(
+	          &table,
+	          NULL,
+	          288,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_deflate_huffman_table_construct_lookup_table(
+	          &table,
+	          code_size_array,
+	          -1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
 /* Tests the libewf_deflate_bit_stream_get_huffman_encoded_value function
  * Returns 1 if successful or 0 if not
  */
@@ -2354,6 +2518,10 @@ int main(
 	 "libewf_deflate_huffman_table_construct",
 	 ewf_test_deflate_huffman_table_construct );
 
+	EWF_TEST_RUN(
+	 "libewf_deflate_huffman_table_construct_lookup_table",
+	 ewf_test_deflate_huffman_table_construct_lookup_table );
+
 	EWF_TEST_RUN(
 	 "libewf_deflate_bit_stream_get_huffman_encoded_value",
 	 ewf_test_deflate_bit_stream_get_huffman_encoded_value );
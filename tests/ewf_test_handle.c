@@ -20,7 +20,9 @@
  */
 
 #include <common.h>
+#include <byte_stream.h>
 #include <file_stream.h>
+#include <memory.h>
 #include <narrow_string.h>
 #include <system_string.h>
 #include <types.h>
@@ -2402,6 +2404,166 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libewf_handle_get_chunk_view function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_get_chunk_view(
+     libewf_handle_t *handle )
+{
+	uint8_t buffer[ EWF_TEST_HANDLE_READ_BUFFER_SIZE ];
+
+	libcerror_error_t *error  = NULL;
+	const uint8_t *chunk_data = NULL;
+	size_t chunk_data_size    = 0;
+	size_t compare_size       = 0;
+	ssize_t read_count        = 0;
+	int result                = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_get_chunk_view(
+	          handle,
+	          0,
+	          &chunk_data,
+	          &chunk_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( result != 0 )
+	{
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "chunk_data",
+		 chunk_data );
+
+		compare_size = chunk_data_size;
+
+		if( compare_size > EWF_TEST_HANDLE_READ_BUFFER_SIZE )
+		{
+			compare_size = EWF_TEST_HANDLE_READ_BUFFER_SIZE;
+		}
+		read_count = libewf_handle_read_buffer_at_offset(
+		              handle,
+		              buffer,
+		              compare_size,
+		              0,
+		              &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) compare_size );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          chunk_data,
+		          buffer,
+		          compare_size );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	/* Test error cases
+	 */
+	result = libewf_handle_get_chunk_view(
+	          NULL,
+	          0,
+	          &chunk_data,
+	          &chunk_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_chunk_view(
+	          handle,
+	          (uint64_t) -1,
+	          &chunk_data,
+	          &chunk_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_chunk_view(
+	          handle,
+	          0,
+	          NULL,
+	          &chunk_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_chunk_view(
+	          handle,
+	          0,
+	          &chunk_data,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
 /* Tests the libewf_handle_get_data_chunk function
  * Returns 1 if successful or 0 if not
  */
@@ -2506,92 +2668,1059 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libewf_handle_seek_offset function
+/* Tests the libewf_handle_read_data_chunks function
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_handle_seek_offset(
+int ewf_test_handle_read_data_chunks(
      libewf_handle_t *handle )
 {
-	libcerror_error_t *error = NULL;
-	size64_t size            = 0;
-	off64_t offset           = 0;
+	uint8_t data_chunk_buffer[ EWF_TEST_HANDLE_READ_BUFFER_SIZE ];
+	uint8_t buffer[ EWF_TEST_HANDLE_READ_BUFFER_SIZE ];
+
+	libewf_data_chunk_t *data_chunks[ 2 ] = { NULL, NULL };
+	libcerror_error_t *error              = NULL;
+	ssize_t buffer_read_count             = 0;
+	ssize_t read_count                    = 0;
+	int data_chunk_index                  = 0;
+	int result                            = 0;
+
+	/* Initialize test
+	 */
+	for( data_chunk_index = 0;
+	     data_chunk_index < 2;
+	     data_chunk_index++ )
+	{
+		result = libewf_handle_get_data_chunk(
+		          handle,
+		          &( data_chunks[ data_chunk_index ] ),
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
 
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
 	/* Test regular cases
 	 */
-	offset = libewf_handle_seek_offset(
+	result = libewf_handle_read_data_chunks(
 	          handle,
 	          0,
-	          SEEK_END,
+	          2,
+	          data_chunks,
 	          &error );
 
-	EWF_TEST_ASSERT_NOT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) -1 );
+	EWF_TEST_ASSERT_GREATER_THAN_INT(
+	 "result",
+	 result,
+	 0 );
 
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	size = (size64_t) offset;
+	read_count = libewf_data_chunk_read_buffer(
+	              data_chunks[ 0 ],
+	              data_chunk_buffer,
+	              EWF_TEST_HANDLE_READ_BUFFER_SIZE,
+	              &error );
 
-	offset = libewf_handle_seek_offset(
+	EWF_TEST_ASSERT_NOT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	buffer_read_count = libewf_handle_read_buffer_at_offset(
+	                     handle,
+	                     buffer,
+	                     (size_t) read_count,
+	                     0,
+	                     &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "buffer_read_count",
+	 buffer_read_count,
+	 read_count );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          data_chunk_buffer,
+	          buffer,
+	          (size_t) read_count );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test read beyond the last chunk
+	 */
+	result = libewf_handle_read_data_chunks(
 	          handle,
-	          1024,
-	          SEEK_SET,
+	          (uint64_t) -1,
+	          2,
+	          data_chunks,
 	          &error );
 
-	EWF_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) 1024 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
 
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	offset = libewf_handle_seek_offset(
+	/* Test error cases
+	 */
+	result = libewf_handle_read_data_chunks(
+	          NULL,
+	          0,
+	          2,
+	          data_chunks,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_read_data_chunks(
 	          handle,
-	          -512,
-	          SEEK_CUR,
+	          0,
+	          -1,
+	          data_chunks,
 	          &error );
 
-	EWF_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) 512 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
-	EWF_TEST_ASSERT_IS_NULL(
+	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
 
-	offset = libewf_handle_seek_offset(
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_read_data_chunks(
 	          handle,
-	          (off64_t) ( size + 512 ),
-	          SEEK_SET,
+	          0,
+	          2,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	for( data_chunk_index = 0;
+	     data_chunk_index < 2;
+	     data_chunk_index++ )
+	{
+		result = libewf_data_chunk_free(
+		          &( data_chunks[ data_chunk_index ] ),
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	for( data_chunk_index = 0;
+	     data_chunk_index < 2;
+	     data_chunk_index++ )
+	{
+		if( data_chunks[ data_chunk_index ] != NULL )
+		{
+			libewf_data_chunk_free(
+			 &( data_chunks[ data_chunk_index ] ),
+			 NULL );
+		}
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_read_packed_data_chunk function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_read_packed_data_chunk(
+     libewf_handle_t *handle )
+{
+	uint8_t data_chunk_buffer[ EWF_TEST_HANDLE_READ_BUFFER_SIZE ];
+	uint8_t buffer[ EWF_TEST_HANDLE_READ_BUFFER_SIZE ];
+
+	libewf_data_chunk_t *data_chunk = NULL;
+	libcerror_error_t *error        = NULL;
+	ssize_t buffer_read_count       = 0;
+	ssize_t read_count              = 0;
+	off64_t offset                  = 0;
+	int result                      = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_handle_get_data_chunk(
+	          handle,
+	          &data_chunk,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          0,
+	          SEEK_SET,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 (int64_t) offset,
+	 (int64_t) 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	read_count = libewf_handle_read_packed_data_chunk(
+	              handle,
+	              data_chunk,
+	              &error );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_data_chunk_is_corrupted(
+	          data_chunk,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	read_count = libewf_data_chunk_read_buffer(
+	              data_chunk,
+	              data_chunk_buffer,
+	              EWF_TEST_HANDLE_READ_BUFFER_SIZE,
+	              &error );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	buffer_read_count = libewf_handle_read_buffer_at_offset(
+	                     handle,
+	                     buffer,
+	                     (size_t) read_count,
+	                     0,
+	                     &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "buffer_read_count",
+	 buffer_read_count,
+	 read_count );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          data_chunk_buffer,
+	          buffer,
+	          (size_t) read_count );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	read_count = libewf_handle_read_packed_data_chunk(
+	              NULL,
+	              data_chunk,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libewf_handle_read_packed_data_chunk(
+	              handle,
+	              NULL,
+	              &error );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_data_chunk_free(
+	          &data_chunk,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( data_chunk != NULL )
+	{
+		libewf_data_chunk_free(
+		 &data_chunk,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_get_chunk_fill_info function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_get_chunk_fill_info(
+     libewf_handle_t *handle )
+{
+	uint8_t buffer[ EWF_TEST_HANDLE_READ_BUFFER_SIZE ];
+	uint8_t fill_pattern_data[ 8 ];
+
+	libcerror_error_t *error = NULL;
+	size_t buffer_offset     = 0;
+	ssize_t read_count       = 0;
+	uint64_t fill_pattern    = 0;
+	int fill_pattern_result  = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	fill_pattern_result = libewf_handle_get_chunk_fill_info(
+	                       handle,
+	                       0,
+	                       &fill_pattern,
+	                       &error );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "fill_pattern_result",
+	 fill_pattern_result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( fill_pattern_result != 0 )
+	{
+		read_count = libewf_handle_read_buffer_at_offset(
+		              handle,
+		              buffer,
+		              EWF_TEST_HANDLE_READ_BUFFER_SIZE,
+		              0,
+		              &error );
+
+		EWF_TEST_ASSERT_NOT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) -1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 fill_pattern_data,
+		 fill_pattern );
+
+		for( buffer_offset = 0;
+		     ( buffer_offset + 8 ) <= (size_t) read_count;
+		     buffer_offset += 8 )
+		{
+			result = memory_compare(
+			          &( buffer[ buffer_offset ] ),
+			          fill_pattern_data,
+			          8 );
+
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 0 );
+		}
+	}
+	/* Test error cases
+	 */
+	result = libewf_handle_get_chunk_fill_info(
+	          NULL,
+	          0,
+	          &fill_pattern,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_chunk_fill_info(
+	          handle,
+	          (uint64_t) -1,
+	          &fill_pattern,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_chunk_fill_info(
+	          handle,
+	          0,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_seek_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_seek_offset(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error = NULL;
+	size64_t size            = 0;
+	off64_t offset           = 0;
+
+	/* Test regular cases
+	 */
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          0,
+	          SEEK_END,
+	          &error );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	size = (size64_t) offset;
+
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          1024,
+	          SEEK_SET,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 1024 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          -512,
+	          SEEK_CUR,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 512 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          (off64_t) ( size + 512 ),
+	          SEEK_SET,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) ( size + 512 ) );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Reset offset to 0
+	 */
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          0,
+	          SEEK_SET,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	offset = libewf_handle_seek_offset(
+	          NULL,
+	          0,
+	          SEEK_SET,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          -1,
+	          SEEK_SET,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          -1,
+	          SEEK_CUR,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          (off64_t) ( -1 * ( size + 1 ) ),
+	          SEEK_END,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_EWF_TEST_RWLOCK )
+
+	/* Test libewf_handle_seek_offset with pthread_rwlock_wrlock failing in libcthreads_read_write_lock_grab_for_write
+	 */
+	ewf_test_pthread_rwlock_wrlock_attempts_before_fail = 0;
+
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          0,
+	          SEEK_SET,
+	          &error );
+
+	if( ewf_test_pthread_rwlock_wrlock_attempts_before_fail != -1 )
+	{
+		ewf_test_pthread_rwlock_wrlock_attempts_before_fail = -1;
+	}
+	else
+	{
+		EWF_TEST_ASSERT_EQUAL_INT64(
+		 "offset",
+		 (int64_t) offset,
+		 (int64_t) -1 );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+	/* Test libewf_handle_seek_offset with pthread_rwlock_unlock failing in libcthreads_read_write_lock_release_for_write
+	 */
+	ewf_test_pthread_rwlock_unlock_attempts_before_fail = 0;
+
+	offset = libewf_handle_seek_offset(
+	          handle,
+	          0,
+	          SEEK_SET,
+	          &error );
+
+	if( ewf_test_pthread_rwlock_unlock_attempts_before_fail != -1 )
+	{
+		ewf_test_pthread_rwlock_unlock_attempts_before_fail = -1;
+	}
+	else
+	{
+		EWF_TEST_ASSERT_EQUAL_INT64(
+		 "offset",
+		 (int64_t) offset,
+		 (int64_t) -1 );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+#endif /* defined( HAVE_EWF_TEST_RWLOCK ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_get_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_get_offset(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error = NULL;
+	off64_t offset           = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_get_offset(
+	          handle,
+	          &offset,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_handle_get_offset(
+	          NULL,
+	          &offset,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_offset(
+	          handle,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_set_cache_limits function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_set_cache_limits(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_set_cache_limits(
+	          handle,
+	          8 * 1024 * 1024,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_handle_set_cache_limits(
+	          NULL,
+	          8 * 1024 * 1024,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_set_cache_limits(
+	          handle,
+	          8 * 1024 * 1024,
+	          (size64_t) UINT64_MAX,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_set_maximum_number_of_read_ahead_chunks function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_set_maximum_number_of_read_ahead_chunks(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_set_maximum_number_of_read_ahead_chunks(
+	          handle,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_handle_set_maximum_number_of_read_ahead_chunks(
+	          handle,
+	          16,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_handle_set_maximum_number_of_read_ahead_chunks(
+	          NULL,
+	          16,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_set_maximum_number_of_read_ahead_chunks(
+	          handle,
+	          -1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_set_maximum_number_of_read_ahead_chunks(
+	          handle,
+	          1025,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_handle_set_number_of_compression_threads function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_handle_set_number_of_compression_threads(
+     libewf_handle_t *handle )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_handle_set_number_of_compression_threads(
+	          handle,
+	          0,
 	          &error );
 
-	EWF_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) ( size + 512 ) );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	/* Reset offset to 0
-	 */
-	offset = libewf_handle_seek_offset(
+	result = libewf_handle_set_number_of_compression_threads(
 	          handle,
-	          0,
-	          SEEK_SET,
+	          4,
 	          &error );
 
-	EWF_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) 0 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
 	EWF_TEST_ASSERT_IS_NULL(
 	 "error",
@@ -2599,16 +3728,15 @@ int ewf_test_handle_seek_offset(
 
 	/* Test error cases
 	 */
-	offset = libewf_handle_seek_offset(
+	result = libewf_handle_set_number_of_compression_threads(
 	          NULL,
-	          0,
-	          SEEK_SET,
+	          4,
 	          &error );
 
-	EWF_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) -1 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -2617,16 +3745,15 @@ int ewf_test_handle_seek_offset(
 	libcerror_error_free(
 	 &error );
 
-	offset = libewf_handle_seek_offset(
+	result = libewf_handle_set_number_of_compression_threads(
 	          handle,
 	          -1,
-	          SEEK_SET,
 	          &error );
 
-	EWF_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) -1 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -2635,31 +3762,15 @@ int ewf_test_handle_seek_offset(
 	libcerror_error_free(
 	 &error );
 
-	offset = libewf_handle_seek_offset(
-	          handle,
-	          -1,
-	          SEEK_CUR,
-	          &error );
-
-	EWF_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) -1 );
-
-	EWF_TEST_ASSERT_IS_NOT_NULL(
-	 "error",
-	 error );
-
-	offset = libewf_handle_seek_offset(
+	result = libewf_handle_set_number_of_compression_threads(
 	          handle,
-	          (off64_t) ( -1 * ( size + 1 ) ),
-	          SEEK_END,
+	          65,
 	          &error );
 
-	EWF_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) -1 );
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	EWF_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -2668,66 +3779,6 @@ int ewf_test_handle_seek_offset(
 	libcerror_error_free(
 	 &error );
 
-#if defined( HAVE_EWF_TEST_RWLOCK )
-
-	/* Test libewf_handle_seek_offset with pthread_rwlock_wrlock failing in libcthreads_read_write_lock_grab_for_write
-	 */
-	ewf_test_pthread_rwlock_wrlock_attempts_before_fail = 0;
-
-	offset = libewf_handle_seek_offset(
-	          handle,
-	          0,
-	          SEEK_SET,
-	          &error );
-
-	if( ewf_test_pthread_rwlock_wrlock_attempts_before_fail != -1 )
-	{
-		ewf_test_pthread_rwlock_wrlock_attempts_before_fail = -1;
-	}
-	else
-	{
-		EWF_TEST_ASSERT_EQUAL_INT64(
-		 "offset",
-		 (int64_t) offset,
-		 (int64_t) -1 );
-
-		EWF_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
-
-		libcerror_error_free(
-		 &error );
-	}
-	/* Test libewf_handle_seek_offset with pthread_rwlock_unlock failing in libcthreads_read_write_lock_release_for_write
-	 */
-	ewf_test_pthread_rwlock_unlock_attempts_before_fail = 0;
-
-	offset = libewf_handle_seek_offset(
-	          handle,
-	          0,
-	          SEEK_SET,
-	          &error );
-
-	if( ewf_test_pthread_rwlock_unlock_attempts_before_fail != -1 )
-	{
-		ewf_test_pthread_rwlock_unlock_attempts_before_fail = -1;
-	}
-	else
-	{
-		EWF_TEST_ASSERT_EQUAL_INT64(
-		 "offset",
-		 (int64_t) offset,
-		 (int64_t) -1 );
-
-		EWF_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
-
-		libcerror_error_free(
-		 &error );
-	}
-#endif /* defined( HAVE_EWF_TEST_RWLOCK ) */
-
 	return( 1 );
 
 on_error:
@@ -2739,21 +3790,77 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libewf_handle_get_offset function
+/* Tests the libewf_handle_get_cache_statistics function
  * Returns 1 if successful or 0 if not
  */
-int ewf_test_handle_get_offset(
+int ewf_test_handle_get_cache_statistics(
      libewf_handle_t *handle )
 {
-	libcerror_error_t *error = NULL;
-	off64_t offset           = 0;
-	int result               = 0;
+	uint8_t buffer[ 512 ];
+
+	libcerror_error_t *error        = NULL;
+	size64_t media_size             = 0;
+	ssize_t read_count              = 0;
+	uint64_t number_of_cache_hits   = 0;
+	uint64_t number_of_cache_misses = 0;
+	int result                      = 0;
 
 	/* Test regular cases
 	 */
-	result = libewf_handle_get_offset(
+	result = libewf_handle_get_media_size(
 	          handle,
-	          &offset,
+	          &media_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( media_size >= 512 )
+	{
+		/* Read the same data twice so that the second read is a cache hit
+		 */
+		read_count = libewf_handle_read_buffer_at_offset(
+		              handle,
+		              buffer,
+		              512,
+		              0,
+		              &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 512 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		read_count = libewf_handle_read_buffer_at_offset(
+		              handle,
+		              buffer,
+		              512,
+		              0,
+		              &error );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 512 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = libewf_handle_get_cache_statistics(
+	          handle,
+	          &number_of_cache_hits,
+	          &number_of_cache_misses,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -2765,11 +3872,19 @@ int ewf_test_handle_get_offset(
 	 "error",
 	 error );
 
+	if( media_size >= 512 )
+	{
+		EWF_TEST_ASSERT_NOT_EQUAL_UINT64(
+		 "number_of_cache_hits",
+		 number_of_cache_hits,
+		 (uint64_t) 0 );
+	}
 	/* Test error cases
 	 */
-	result = libewf_handle_get_offset(
+	result = libewf_handle_get_cache_statistics(
 	          NULL,
-	          &offset,
+	          &number_of_cache_hits,
+	          &number_of_cache_misses,
 	          &error );
 
 	EWF_TEST_ASSERT_EQUAL_INT(
@@ -2784,8 +3899,27 @@ int ewf_test_handle_get_offset(
 	libcerror_error_free(
 	 &error );
 
-	result = libewf_handle_get_offset(
+	result = libewf_handle_get_cache_statistics(
+	          handle,
+	          NULL,
+	          &number_of_cache_misses,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_handle_get_cache_statistics(
 	          handle,
+	          &number_of_cache_hits,
 	          NULL,
 	          &error );
 
@@ -4891,6 +6025,10 @@ int main(
 
 		/* TODO: add tests for libewf_internal_handle_read_buffer_from_file_io_pool */
 
+		/* TODO: add tests for libewf_internal_handle_get_chunk_data_for_concurrent_read */
+
+		/* TODO: add tests for libewf_internal_handle_read_buffer_at_offset_from_file_io_pool */
+
 #endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
 
 		EWF_TEST_RUN_WITH_ARGS(
@@ -4903,6 +6041,19 @@ int main(
 		 ewf_test_handle_read_buffer_at_offset,
 		 handle );
 
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+		/* TODO: add tests for libewf_internal_handle_get_segment_file_mapping */
+
+		/* TODO: add tests for libewf_internal_handle_get_chunk_view */
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_get_chunk_view",
+		 ewf_test_handle_get_chunk_view,
+		 handle );
+
 #if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
 
 		/* TODO: add tests for libewf_internal_handle_write_buffer_to_file_io_pool */
@@ -4926,6 +6077,41 @@ int main(
 
 		/* TODO: add tests for libewf_handle_read_data_chunk */
 
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+		/* TODO: add tests for libewf_internal_handle_read_packed_chunks_from_file_io_pool */
+
+		/* TODO: add tests for libewf_internal_handle_read_data_chunks_from_file_io_pool */
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_read_data_chunks",
+		 ewf_test_handle_read_data_chunks,
+		 handle );
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+		/* TODO: add tests for libewf_internal_handle_read_packed_data_chunk_from_file_io_pool */
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_read_packed_data_chunk",
+		 ewf_test_handle_read_packed_data_chunk,
+		 handle );
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+		/* TODO: add tests for libewf_internal_handle_get_chunk_fill_info_from_file_io_pool */
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_get_chunk_fill_info",
+		 ewf_test_handle_get_chunk_fill_info,
+		 handle );
+
 #if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
 
 		/* TODO: add tests for libewf_internal_handle_write_data_chunk_to_file_io_pool */
@@ -4934,6 +6120,14 @@ int main(
 
 		/* TODO: add tests for libewf_handle_write_data_chunk */
 
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+		/* TODO: add tests for libewf_internal_handle_write_packed_data_chunk_to_file_io_pool */
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+		/* TODO: add tests for libewf_handle_write_packed_data_chunk */
+
 #if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
 
 		/* TODO: add tests for libewf_internal_handle_write_finalize_file_io_pool */
@@ -4960,6 +6154,26 @@ int main(
 
 		/* TODO: add tests for libewf_handle_set_maximum_number_of_open_handles */
 
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_set_cache_limits",
+		 ewf_test_handle_set_cache_limits,
+		 handle );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_set_maximum_number_of_read_ahead_chunks",
+		 ewf_test_handle_set_maximum_number_of_read_ahead_chunks,
+		 handle );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_set_number_of_compression_threads",
+		 ewf_test_handle_set_number_of_compression_threads,
+		 handle );
+
+		EWF_TEST_RUN_WITH_ARGS(
+		 "libewf_handle_get_cache_statistics",
+		 ewf_test_handle_get_cache_statistics,
+		 handle );
+
 		/* TODO: add tests for libewf_handle_segment_files_corrupted */
 
 		/* TODO: add tests for libewf_handle_segment_files_encrypted */
@@ -5137,6 +6351,8 @@ int main(
 
 		/* TODO: add tests for libewf_handle_set_read_zero_chunk_on_error */
 
+		/* TODO: add tests for libewf_handle_set_read_tables_on_demand */
+
 		/* TODO: add tests for libewf_handle_copy_media_values */
 
 		EWF_TEST_RUN_WITH_ARGS(
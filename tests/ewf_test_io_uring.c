@@ -0,0 +1,726 @@
+/*
+ * Library io_uring type test program
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_io_uring.h"
+
+#define EWF_TEST_IO_URING_FILE_SIZE		262144
+#define EWF_TEST_IO_URING_NUMBER_OF_REQUESTS	12
+#define EWF_TEST_IO_URING_QUEUE_DEPTH		4
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+/* Tests the libewf_io_uring_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_io_uring_initialize(
+     void )
+{
+	libcerror_error_t *error    = NULL;
+	libewf_io_uring_t *io_uring = NULL;
+	int result                  = 0;
+
+	/* Test regular cases
+	 */
+	result = libewf_io_uring_initialize(
+	          &io_uring,
+	          EWF_TEST_IO_URING_QUEUE_DEPTH,
+	          &error );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* io_uring is not supported by every kernel
+	 */
+	if( result != 0 )
+	{
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "io_uring",
+		 io_uring );
+
+		result = libewf_io_uring_free(
+		          &io_uring,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	EWF_TEST_ASSERT_IS_NULL(
+	 "io_uring",
+	 io_uring );
+
+	/* Test error cases
+	 */
+	result = libewf_io_uring_initialize(
+	          NULL,
+	          EWF_TEST_IO_URING_QUEUE_DEPTH,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	io_uring = (libewf_io_uring_t *) 0x12345678UL;
+
+	result = libewf_io_uring_initialize(
+	          &io_uring,
+	          EWF_TEST_IO_URING_QUEUE_DEPTH,
+	          &error );
+
+	io_uring = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_io_uring_initialize(
+	          &io_uring,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_io_uring_initialize(
+	          &io_uring,
+	          4097,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( io_uring != NULL )
+	{
+		libewf_io_uring_free(
+		 &io_uring,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_io_uring_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_io_uring_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libewf_io_uring_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#if defined( LIBEWF_HAVE_IO_URING )
+
+/* Reads requests with the io_uring and compares the data with that read by pread
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_io_uring_read_and_compare_requests(
+     libewf_io_uring_t *io_uring,
+     int file_descriptor,
+     libewf_io_request_t *requests,
+     int number_of_requests )
+{
+	uint8_t expected_data[ 16384 ];
+
+	libcerror_error_t *error = NULL;
+	ssize_t read_count       = 0;
+	int request_index        = 0;
+	int result               = 0;
+
+	for( request_index = 0;
+	     request_index < number_of_requests;
+	     request_index++ )
+	{
+		if( memory_set(
+		     requests[ request_index ].buffer,
+		     0,
+		     requests[ request_index ].size ) == NULL )
+		{
+			return( 0 );
+		}
+	}
+	result = libewf_io_uring_read_requests(
+	          io_uring,
+	          requests,
+	          number_of_requests,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( request_index = 0;
+	     request_index < number_of_requests;
+	     request_index++ )
+	{
+		EWF_TEST_ASSERT_EQUAL_SIZE(
+		 "read_count",
+		 requests[ request_index ].read_count,
+		 requests[ request_index ].size );
+
+		read_count = pread(
+		              file_descriptor,
+		              expected_data,
+		              requests[ request_index ].size,
+		              (off_t) requests[ request_index ].offset );
+
+		EWF_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) requests[ request_index ].size );
+
+		result = memory_compare(
+		          requests[ request_index ].buffer,
+		          expected_data,
+		          requests[ request_index ].size );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_io_uring_read_requests function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_io_uring_read_requests(
+     void )
+{
+	char filename[ 32 ]                                                 = "ewf_test_io_uring.XXXXXX";
+	libewf_io_request_t requests[ EWF_TEST_IO_URING_NUMBER_OF_REQUESTS ];
+
+	libcerror_error_t *error                                            = NULL;
+	libewf_io_uring_t *io_uring                                         = NULL;
+	uint8_t *buffers                                                    = NULL;
+	uint8_t *data                                                       = NULL;
+	ssize_t write_count                                                 = 0;
+	size_t data_offset                                                  = 0;
+	uint32_t value_32bit                                                = 0x12345678UL;
+	int file_descriptor                                                 = -1;
+	int request_index                                                   = 0;
+	int result                                                          = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_io_uring_initialize(
+	          &io_uring,
+	          EWF_TEST_IO_URING_QUEUE_DEPTH,
+	          &error );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* io_uring is not supported by every kernel
+	 */
+	if( result == 0 )
+	{
+		return( 1 );
+	}
+	data = (uint8_t *) memory_allocate(
+	                    sizeof( uint8_t ) * EWF_TEST_IO_URING_FILE_SIZE );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "data",
+	 data );
+
+	for( data_offset = 0;
+	     data_offset < EWF_TEST_IO_URING_FILE_SIZE;
+	     data_offset++ )
+	{
+		value_32bit        = ( value_32bit * 1103515245UL ) + 12345;
+		data[ data_offset ] = (uint8_t) ( value_32bit >> 16 );
+	}
+	file_descriptor = mkstemp(
+	                   filename );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "file_descriptor",
+	 file_descriptor,
+	 -1 );
+
+	write_count = write(
+	               file_descriptor,
+	               data,
+	               EWF_TEST_IO_URING_FILE_SIZE );
+
+	EWF_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) EWF_TEST_IO_URING_FILE_SIZE );
+
+	memory_free(
+	 data );
+
+	data = NULL;
+
+	buffers = (uint8_t *) memory_allocate(
+	                       sizeof( uint8_t ) * 16384 * EWF_TEST_IO_URING_NUMBER_OF_REQUESTS );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "buffers",
+	 buffers );
+
+	/* Test libewf_io_uring_has_file and libewf_io_uring_open_file
+	 */
+	result = libewf_io_uring_has_file(
+	          io_uring,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_io_uring_open_file(
+	          io_uring,
+	          1,
+	          filename,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_io_uring_has_file(
+	          io_uring,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_io_uring_has_file(
+	          io_uring,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test reading more requests than the queue depth, of different sizes and at unaligned offsets
+	 */
+	for( request_index = 0;
+	     request_index < EWF_TEST_IO_URING_NUMBER_OF_REQUESTS;
+	     request_index++ )
+	{
+		requests[ request_index ].file_io_pool_entry = 1;
+		requests[ request_index ].offset             = (off64_t) ( ( request_index * 21011 ) % ( EWF_TEST_IO_URING_FILE_SIZE - 16384 ) );
+		requests[ request_index ].buffer             = &( buffers[ request_index * 16384 ] );
+		requests[ request_index ].size               = (size_t) ( 512 + ( ( request_index * 1399 ) % ( 16384 - 512 ) ) );
+		requests[ request_index ].read_count         = 0;
+	}
+	result = ewf_test_io_uring_read_and_compare_requests(
+	          io_uring,
+	          file_descriptor,
+	          requests,
+	          EWF_TEST_IO_URING_NUMBER_OF_REQUESTS );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Test reading past the end of the file
+	 */
+	requests[ 5 ].offset = (off64_t) EWF_TEST_IO_URING_FILE_SIZE;
+
+	result = libewf_io_uring_read_requests(
+	          io_uring,
+	          requests,
+	          EWF_TEST_IO_URING_NUMBER_OF_REQUESTS,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test that the io_uring can be used after a read error
+	 */
+	requests[ 5 ].offset = 0;
+
+	result = ewf_test_io_uring_read_and_compare_requests(
+	          io_uring,
+	          file_descriptor,
+	          requests,
+	          EWF_TEST_IO_URING_NUMBER_OF_REQUESTS );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Test error cases
+	 */
+	result = libewf_io_uring_read_requests(
+	          NULL,
+	          requests,
+	          EWF_TEST_IO_URING_NUMBER_OF_REQUESTS,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_io_uring_read_requests(
+	          io_uring,
+	          NULL,
+	          EWF_TEST_IO_URING_NUMBER_OF_REQUESTS,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_io_uring_read_requests(
+	          io_uring,
+	          requests,
+	          -1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	requests[ 3 ].file_io_pool_entry = 0;
+
+	result = libewf_io_uring_read_requests(
+	          io_uring,
+	          requests,
+	          EWF_TEST_IO_URING_NUMBER_OF_REQUESTS,
+	          &error );
+
+	requests[ 3 ].file_io_pool_entry = 1;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test that an io_uring that can no longer be used is reported as such
+	 */
+	io_uring->is_unusable = 1;
+
+	result = libewf_io_uring_read_requests(
+	          io_uring,
+	          requests,
+	          EWF_TEST_IO_URING_NUMBER_OF_REQUESTS,
+	          &error );
+
+	io_uring->is_unusable = 0;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Clean up
+	 */
+	result = libewf_io_uring_free(
+	          &io_uring,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "io_uring",
+	 io_uring );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_free(
+	 buffers );
+
+	close(
+	 file_descriptor );
+
+	unlink(
+	 filename );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( io_uring != NULL )
+	{
+		libewf_io_uring_free(
+		 &io_uring,
+		 NULL );
+	}
+	if( buffers != NULL )
+	{
+		memory_free(
+		 buffers );
+	}
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	if( file_descriptor != -1 )
+	{
+		close(
+		 file_descriptor );
+
+		unlink(
+		 filename );
+	}
+	return( 0 );
+}
+
+#endif /* defined( LIBEWF_HAVE_IO_URING ) */
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_io_uring_initialize",
+	 ewf_test_io_uring_initialize );
+
+	EWF_TEST_RUN(
+	 "libewf_io_uring_free",
+	 ewf_test_io_uring_free );
+
+#if defined( LIBEWF_HAVE_IO_URING )
+
+	EWF_TEST_RUN(
+	 "libewf_io_uring_read_requests",
+	 ewf_test_io_uring_read_requests );
+
+#endif /* defined( LIBEWF_HAVE_IO_URING ) */
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
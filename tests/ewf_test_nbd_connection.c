@@ -0,0 +1,1813 @@
+/*
+ * Tools nbd_connection type test program
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_SYS_SOCKET_H )
+#include <sys/socket.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libcthreads.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_unused.h"
+
+#include "../ewftools/nbd_connection.h"
+
+#if defined( HAVE_SYS_SOCKET_H ) && defined( HAVE_SYS_UN_H )
+
+#define EWF_TEST_NBD_MAGIC_PASSWORD		0x4e42444d41474943ULL
+#define EWF_TEST_NBD_MAGIC_OPTION		0x49484156454f5054ULL
+#define EWF_TEST_NBD_MAGIC_OPTION_REPLY		0x0003e889045565a9ULL
+#define EWF_TEST_NBD_MAGIC_REQUEST		0x25609513UL
+#define EWF_TEST_NBD_MAGIC_SIMPLE_REPLY		0x67446698UL
+
+#define EWF_TEST_NBD_OPT_ABORT			2
+#define EWF_TEST_NBD_OPT_INFO			6
+#define EWF_TEST_NBD_OPT_GO			7
+#define EWF_TEST_NBD_OPT_STRUCTURED_REPLY	8
+#define EWF_TEST_NBD_OPT_LIST_META_CONTEXT	9
+#define EWF_TEST_NBD_OPT_SET_META_CONTEXT	10
+
+#define EWF_TEST_NBD_REP_ACK			1
+#define EWF_TEST_NBD_REP_INFO			3
+#define EWF_TEST_NBD_REP_META_CONTEXT		4
+
+#define EWF_TEST_NBD_CMD_READ			0
+#define EWF_TEST_NBD_CMD_WRITE			1
+#define EWF_TEST_NBD_CMD_FLUSH			3
+
+/* Set meta context option data that selects base:allocation of the default export
+ */
+uint8_t ewf_test_nbd_connection_set_meta_context_data[ 27 ] = {
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x0f, 'b', 'a', 's', 'e',
+	':', 'a', 'l', 'l', 'o', 'c', 'a', 't', 'i', 'o', 'n' };
+
+/* Info option data of the default export that requests the block size information
+ */
+uint8_t ewf_test_nbd_connection_info_data[ 8 ] = {
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x03 };
+
+/* Writes an option to the socket
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_nbd_connection_write_option(
+     int socket_descriptor,
+     uint32_t option,
+     const uint8_t *data,
+     size_t data_size )
+{
+	uint8_t option_header[ 16 ];
+
+	byte_stream_copy_from_uint64_big_endian(
+	 &( option_header[ 0 ] ),
+	 EWF_TEST_NBD_MAGIC_OPTION );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( option_header[ 8 ] ),
+	 option );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( option_header[ 12 ] ),
+	 (uint32_t) data_size );
+
+	if( send(
+	     socket_descriptor,
+	     option_header,
+	     16,
+	     0 ) != 16 )
+	{
+		return( -1 );
+	}
+	if( data_size > 0 )
+	{
+		if( send(
+		     socket_descriptor,
+		     data,
+		     data_size,
+		     0 ) != (ssize_t) data_size )
+		{
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Reads data from the socket
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_nbd_connection_read_socket(
+     int socket_descriptor,
+     uint8_t *buffer,
+     size_t buffer_size )
+{
+	size_t buffer_offset = 0;
+	ssize_t read_count   = 0;
+
+	while( buffer_offset < buffer_size )
+	{
+		read_count = recv(
+		              socket_descriptor,
+		              &( buffer[ buffer_offset ] ),
+		              buffer_size - buffer_offset,
+		              0 );
+
+		if( read_count <= 0 )
+		{
+			return( -1 );
+		}
+		buffer_offset += (size_t) read_count;
+	}
+	return( 1 );
+}
+
+/* Reads an option reply from the socket and checks its option and type
+ * Returns 1 if successful, 0 if the reply does not match or -1 on error
+ */
+int ewf_test_nbd_connection_read_option_reply(
+     int socket_descriptor,
+     uint32_t expected_option,
+     uint32_t expected_reply_type,
+     uint8_t *data,
+     size_t data_size )
+{
+	uint8_t reply_header[ 20 ];
+
+	uint64_t magic      = 0;
+	uint32_t option     = 0;
+	uint32_t reply_size = 0;
+	uint32_t reply_type = 0;
+
+	if( ewf_test_nbd_connection_read_socket(
+	     socket_descriptor,
+	     reply_header,
+	     20 ) != 1 )
+	{
+		return( -1 );
+	}
+	byte_stream_copy_to_uint64_big_endian(
+	 &( reply_header[ 0 ] ),
+	 magic );
+
+	byte_stream_copy_to_uint32_big_endian(
+	 &( reply_header[ 8 ] ),
+	 option );
+
+	byte_stream_copy_to_uint32_big_endian(
+	 &( reply_header[ 12 ] ),
+	 reply_type );
+
+	byte_stream_copy_to_uint32_big_endian(
+	 &( reply_header[ 16 ] ),
+	 reply_size );
+
+	if( ( magic != EWF_TEST_NBD_MAGIC_OPTION_REPLY )
+	 || ( option != expected_option )
+	 || ( reply_type != expected_reply_type )
+	 || ( (size_t) reply_size != data_size ) )
+	{
+		return( 0 );
+	}
+	if( data_size > 0 )
+	{
+		if( ewf_test_nbd_connection_read_socket(
+		     socket_descriptor,
+		     data,
+		     data_size ) != 1 )
+		{
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Tests the nbd_connection_read_option_header_data function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_nbd_connection_read_option_header_data(
+     void )
+{
+	uint8_t option_header[ 16 ];
+
+	libcerror_error_t *error  = NULL;
+	uint32_t option           = 0;
+	uint32_t option_data_size = 0;
+	int result                = 0;
+
+	byte_stream_copy_from_uint64_big_endian(
+	 &( option_header[ 0 ] ),
+	 EWF_TEST_NBD_MAGIC_OPTION );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( option_header[ 8 ] ),
+	 EWF_TEST_NBD_OPT_GO );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( option_header[ 12 ] ),
+	 6 );
+
+	/* Test regular cases
+	 */
+	result = nbd_connection_read_option_header_data(
+	          option_header,
+	          16,
+	          &option,
+	          &option_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "option",
+	 option,
+	 (uint32_t) EWF_TEST_NBD_OPT_GO );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "option_data_size",
+	 option_data_size,
+	 (uint32_t) 6 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = nbd_connection_read_option_header_data(
+	          NULL,
+	          16,
+	          &option,
+	          &option_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = nbd_connection_read_option_header_data(
+	          option_header,
+	          8,
+	          &option,
+	          &option_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = nbd_connection_read_option_header_data(
+	          option_header,
+	          16,
+	          NULL,
+	          &option_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = nbd_connection_read_option_header_data(
+	          option_header,
+	          16,
+	          &option,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test with an option data size that exceeds the maximum
+	 */
+	byte_stream_copy_from_uint32_big_endian(
+	 &( option_header[ 12 ] ),
+	 NBD_CONNECTION_MAXIMUM_OPTION_DATA_SIZE + 1 );
+
+	result = nbd_connection_read_option_header_data(
+	          option_header,
+	          16,
+	          &option,
+	          &option_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test with an invalid magic
+	 */
+	byte_stream_copy_from_uint32_big_endian(
+	 &( option_header[ 12 ] ),
+	 6 );
+
+	option_header[ 0 ] = 0xff;
+
+	result = nbd_connection_read_option_header_data(
+	          option_header,
+	          16,
+	          &option,
+	          &option_data_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the nbd_connection_check_info_option_data function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_nbd_connection_check_info_option_data(
+     void )
+{
+	uint8_t option_data[ 16 ];
+
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = nbd_connection_check_info_option_data(
+	          ewf_test_nbd_connection_info_data,
+	          8,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test with an export name and no information requests
+	 */
+	byte_stream_copy_from_uint32_big_endian(
+	 &( option_data[ 0 ] ),
+	 3 );
+
+	option_data[ 4 ] = 'e';
+	option_data[ 5 ] = 'w';
+	option_data[ 6 ] = 'f';
+
+	byte_stream_copy_from_uint16_big_endian(
+	 &( option_data[ 7 ] ),
+	 0 );
+
+	result = nbd_connection_check_info_option_data(
+	          option_data,
+	          9,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test with data that is too small
+	 */
+	result = nbd_connection_check_info_option_data(
+	          ewf_test_nbd_connection_info_data,
+	          5,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test with an export name size that exceeds the data
+	 */
+	result = nbd_connection_check_info_option_data(
+	          option_data,
+	          8,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test with a number of information requests that does not match the data
+	 */
+	result = nbd_connection_check_info_option_data(
+	          ewf_test_nbd_connection_info_data,
+	          6,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = nbd_connection_check_info_option_data(
+	          option_data,
+	          10,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = nbd_connection_check_info_option_data(
+	          NULL,
+	          8,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = nbd_connection_check_info_option_data(
+	          ewf_test_nbd_connection_info_data,
+	          NBD_CONNECTION_MAXIMUM_OPTION_DATA_SIZE + 1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the nbd_connection_read_meta_context_option_data function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_nbd_connection_read_meta_context_option_data(
+     void )
+{
+	uint8_t option_data[ 32 ];
+
+	libcerror_error_t *error   = NULL;
+	uint32_t number_of_queries = 0;
+	uint8_t select_context     = 0;
+	int result                 = 0;
+
+	/* Test regular cases
+	 */
+	result = nbd_connection_read_meta_context_option_data(
+	          EWF_TEST_NBD_OPT_SET_META_CONTEXT,
+	          ewf_test_nbd_connection_set_meta_context_data,
+	          27,
+	          &select_context,
+	          &number_of_queries,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "select_context",
+	 select_context,
+	 (uint8_t) 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "number_of_queries",
+	 number_of_queries,
+	 (uint32_t) 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test a list query without queries
+	 */
+	memory_set(
+	 option_data,
+	 0,
+	 8 );
+
+	result = nbd_connection_read_meta_context_option_data(
+	          EWF_TEST_NBD_OPT_LIST_META_CONTEXT,
+	          option_data,
+	          8,
+	          &select_context,
+	          &number_of_queries,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "select_context",
+	 select_context,
+	 (uint8_t) 0 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "number_of_queries",
+	 number_of_queries,
+	 (uint32_t) 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test a namespace query, which only selects the context when listing
+	 */
+	byte_stream_copy_from_uint32_big_endian(
+	 &( option_data[ 0 ] ),
+	 0 );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( option_data[ 4 ] ),
+	 1 );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( option_data[ 8 ] ),
+	 5 );
+
+	option_data[ 12 ] = 'b';
+	option_data[ 13 ] = 'a';
+	option_data[ 14 ] = 's';
+	option_data[ 15 ] = 'e';
+	option_data[ 16 ] = ':';
+
+	result = nbd_connection_read_meta_context_option_data(
+	          EWF_TEST_NBD_OPT_LIST_META_CONTEXT,
+	          option_data,
+	          17,
+	          &select_context,
+	          &number_of_queries,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "select_context",
+	 select_context,
+	 (uint8_t) 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = nbd_connection_read_meta_context_option_data(
+	          EWF_TEST_NBD_OPT_SET_META_CONTEXT,
+	          option_data,
+	          17,
+	          &select_context,
+	          &number_of_queries,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "select_context",
+	 select_context,
+	 (uint8_t) 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test with a query that exceeds the data
+	 */
+	result = nbd_connection_read_meta_context_option_data(
+	          EWF_TEST_NBD_OPT_SET_META_CONTEXT,
+	          ewf_test_nbd_connection_set_meta_context_data,
+	          26,
+	          &select_context,
+	          &number_of_queries,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test with a missing query
+	 */
+	result = nbd_connection_read_meta_context_option_data(
+	          EWF_TEST_NBD_OPT_SET_META_CONTEXT,
+	          ewf_test_nbd_connection_set_meta_context_data,
+	          10,
+	          &select_context,
+	          &number_of_queries,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test with trailing data
+	 */
+	result = nbd_connection_read_meta_context_option_data(
+	          EWF_TEST_NBD_OPT_LIST_META_CONTEXT,
+	          option_data,
+	          18,
+	          &select_context,
+	          &number_of_queries,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test with data that is too small
+	 */
+	result = nbd_connection_read_meta_context_option_data(
+	          EWF_TEST_NBD_OPT_SET_META_CONTEXT,
+	          ewf_test_nbd_connection_set_meta_context_data,
+	          7,
+	          &select_context,
+	          &number_of_queries,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = nbd_connection_read_meta_context_option_data(
+	          EWF_TEST_NBD_OPT_SET_META_CONTEXT,
+	          NULL,
+	          27,
+	          &select_context,
+	          &number_of_queries,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = nbd_connection_read_meta_context_option_data(
+	          EWF_TEST_NBD_OPT_SET_META_CONTEXT,
+	          ewf_test_nbd_connection_set_meta_context_data,
+	          NBD_CONNECTION_MAXIMUM_OPTION_DATA_SIZE + 1,
+	          &select_context,
+	          &number_of_queries,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = nbd_connection_read_meta_context_option_data(
+	          EWF_TEST_NBD_OPT_SET_META_CONTEXT,
+	          ewf_test_nbd_connection_set_meta_context_data,
+	          27,
+	          NULL,
+	          &number_of_queries,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = nbd_connection_read_meta_context_option_data(
+	          EWF_TEST_NBD_OPT_SET_META_CONTEXT,
+	          ewf_test_nbd_connection_set_meta_context_data,
+	          27,
+	          &select_context,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the nbd_connection_read_request_data function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_nbd_connection_read_request_data(
+     void )
+{
+	uint8_t request_data[ 28 ];
+
+	nbd_request_t request;
+
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( request_data[ 0 ] ),
+	 EWF_TEST_NBD_MAGIC_REQUEST );
+
+	byte_stream_copy_from_uint16_big_endian(
+	 &( request_data[ 4 ] ),
+	 0x0008 );
+
+	byte_stream_copy_from_uint16_big_endian(
+	 &( request_data[ 6 ] ),
+	 7 );
+
+	byte_stream_copy_from_uint64_big_endian(
+	 &( request_data[ 8 ] ),
+	 0x0123456789abcdefULL );
+
+	byte_stream_copy_from_uint64_big_endian(
+	 &( request_data[ 16 ] ),
+	 0x0000000100008000ULL );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( request_data[ 24 ] ),
+	 65536 );
+
+	/* Test regular cases
+	 */
+	result = nbd_connection_read_request_data(
+	          &request,
+	          request_data,
+	          28,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT16(
+	 "request.flags",
+	 request.flags,
+	 (uint16_t) 0x0008 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT16(
+	 "request.type",
+	 request.type,
+	 (uint16_t) 7 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "request.cookie",
+	 request.cookie,
+	 (uint64_t) 0x0123456789abcdefULL );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "request.offset",
+	 request.offset,
+	 (uint64_t) 0x0000000100008000ULL );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "request.length",
+	 request.length,
+	 (uint32_t) 65536 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = nbd_connection_read_request_data(
+	          NULL,
+	          request_data,
+	          28,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = nbd_connection_read_request_data(
+	          &request,
+	          NULL,
+	          28,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = nbd_connection_read_request_data(
+	          &request,
+	          request_data,
+	          27,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test with an invalid magic
+	 */
+	request_data[ 0 ] = 0xff;
+
+	result = nbd_connection_read_request_data(
+	          &request,
+	          request_data,
+	          28,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the nbd_connection_negotiate function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_nbd_connection_negotiate(
+     void )
+{
+	uint8_t client_flags[ 4 ];
+	uint8_t handshake_data[ 18 ];
+	uint8_t reply_data[ 32 ];
+	int socket_descriptors[ 2 ] = { -1, -1 };
+
+	nbd_connection_t connection;
+
+	libcerror_error_t *error    = NULL;
+	uint64_t magic              = 0;
+	uint64_t value_64bit        = 0;
+	uint32_t value_32bit        = 0;
+	uint16_t value_16bit        = 0;
+	int result                  = 0;
+
+	/* Initialize test
+	 */
+	result = socketpair(
+	          AF_UNIX,
+	          SOCK_STREAM,
+	          0,
+	          socket_descriptors );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	memory_set(
+	 &connection,
+	 0,
+	 sizeof( nbd_connection_t ) );
+
+	connection.media_size        = 1048576;
+	connection.chunk_size        = 32768;
+	connection.socket_descriptor = socket_descriptors[ 0 ];
+
+	/* The client data is written in advance since the socket buffers are large
+	 * enough to hold both the client data and the server replies
+	 */
+	byte_stream_copy_from_uint32_big_endian(
+	 client_flags,
+	 0x00000003UL );
+
+	result = (int) send(
+	                socket_descriptors[ 1 ],
+	                client_flags,
+	                4,
+	                0 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 4 );
+
+	result = ewf_test_nbd_connection_write_option(
+	          socket_descriptors[ 1 ],
+	          EWF_TEST_NBD_OPT_STRUCTURED_REPLY,
+	          NULL,
+	          0 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = ewf_test_nbd_connection_write_option(
+	          socket_descriptors[ 1 ],
+	          EWF_TEST_NBD_OPT_SET_META_CONTEXT,
+	          ewf_test_nbd_connection_set_meta_context_data,
+	          27 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = ewf_test_nbd_connection_write_option(
+	          socket_descriptors[ 1 ],
+	          EWF_TEST_NBD_OPT_GO,
+	          ewf_test_nbd_connection_info_data,
+	          8 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Test regular cases
+	 */
+	result = nbd_connection_negotiate(
+	          &connection,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "connection.no_zeroes",
+	 connection.no_zeroes,
+	 (uint8_t) 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "connection.use_structured_replies",
+	 connection.use_structured_replies,
+	 (uint8_t) 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "connection.use_base_allocation",
+	 connection.use_base_allocation,
+	 (uint8_t) 1 );
+
+	/* Check the fixed newstyle handshake
+	 */
+	result = ewf_test_nbd_connection_read_socket(
+	          socket_descriptors[ 1 ],
+	          handshake_data,
+	          18 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	byte_stream_copy_to_uint64_big_endian(
+	 &( handshake_data[ 0 ] ),
+	 magic );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "magic",
+	 magic,
+	 (uint64_t) EWF_TEST_NBD_MAGIC_PASSWORD );
+
+	byte_stream_copy_to_uint64_big_endian(
+	 &( handshake_data[ 8 ] ),
+	 magic );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "magic",
+	 magic,
+	 (uint64_t) EWF_TEST_NBD_MAGIC_OPTION );
+
+	byte_stream_copy_to_uint16_big_endian(
+	 &( handshake_data[ 16 ] ),
+	 value_16bit );
+
+	EWF_TEST_ASSERT_EQUAL_UINT16(
+	 "handshake flags",
+	 value_16bit,
+	 (uint16_t) 0x0003 );
+
+	/* Check the structured reply option replies
+	 */
+	result = ewf_test_nbd_connection_read_option_reply(
+	          socket_descriptors[ 1 ],
+	          EWF_TEST_NBD_OPT_STRUCTURED_REPLY,
+	          EWF_TEST_NBD_REP_ACK,
+	          NULL,
+	          0 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Check the set meta context option replies
+	 */
+	result = ewf_test_nbd_connection_read_option_reply(
+	          socket_descriptors[ 1 ],
+	          EWF_TEST_NBD_OPT_SET_META_CONTEXT,
+	          EWF_TEST_NBD_REP_META_CONTEXT,
+	          reply_data,
+	          19 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	byte_stream_copy_to_uint32_big_endian(
+	 reply_data,
+	 value_32bit );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "context identifier",
+	 value_32bit,
+	 (uint32_t) 1 );
+
+	result = memory_compare(
+	          &( reply_data[ 4 ] ),
+	          "base:allocation",
+	          15 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = ewf_test_nbd_connection_read_option_reply(
+	          socket_descriptors[ 1 ],
+	          EWF_TEST_NBD_OPT_SET_META_CONTEXT,
+	          EWF_TEST_NBD_REP_ACK,
+	          NULL,
+	          0 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Check the go option replies
+	 */
+	result = ewf_test_nbd_connection_read_option_reply(
+	          socket_descriptors[ 1 ],
+	          EWF_TEST_NBD_OPT_GO,
+	          EWF_TEST_NBD_REP_INFO,
+	          reply_data,
+	          12 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	byte_stream_copy_to_uint64_big_endian(
+	 &( reply_data[ 2 ] ),
+	 value_64bit );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "media size",
+	 value_64bit,
+	 (uint64_t) 1048576 );
+
+	result = ewf_test_nbd_connection_read_option_reply(
+	          socket_descriptors[ 1 ],
+	          EWF_TEST_NBD_OPT_GO,
+	          EWF_TEST_NBD_REP_INFO,
+	          reply_data,
+	          14 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	byte_stream_copy_to_uint32_big_endian(
+	 &( reply_data[ 6 ] ),
+	 value_32bit );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "preferred block size",
+	 value_32bit,
+	 (uint32_t) 32768 );
+
+	result = ewf_test_nbd_connection_read_option_reply(
+	          socket_descriptors[ 1 ],
+	          EWF_TEST_NBD_OPT_GO,
+	          EWF_TEST_NBD_REP_ACK,
+	          NULL,
+	          0 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Clean up
+	 */
+	close(
+	 socket_descriptors[ 0 ] );
+
+	socket_descriptors[ 0 ] = -1;
+
+	close(
+	 socket_descriptors[ 1 ] );
+
+	socket_descriptors[ 1 ] = -1;
+
+	/* Test negotiate with a client that aborts
+	 */
+	result = socketpair(
+	          AF_UNIX,
+	          SOCK_STREAM,
+	          0,
+	          socket_descriptors );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	memory_set(
+	 &connection,
+	 0,
+	 sizeof( nbd_connection_t ) );
+
+	connection.socket_descriptor = socket_descriptors[ 0 ];
+
+	result = (int) send(
+	                socket_descriptors[ 1 ],
+	                client_flags,
+	                4,
+	                0 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 4 );
+
+	result = ewf_test_nbd_connection_write_option(
+	          socket_descriptors[ 1 ],
+	          EWF_TEST_NBD_OPT_ABORT,
+	          NULL,
+	          0 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = nbd_connection_negotiate(
+	          &connection,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test negotiate with a client that disconnects without selecting an export
+	 */
+	result = (int) send(
+	                socket_descriptors[ 1 ],
+	                client_flags,
+	                4,
+	                0 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 4 );
+
+	result = ewf_test_nbd_connection_write_option(
+	          socket_descriptors[ 1 ],
+	          EWF_TEST_NBD_OPT_INFO,
+	          ewf_test_nbd_connection_info_data,
+	          8 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	shutdown(
+	 socket_descriptors[ 1 ],
+	 SHUT_WR );
+
+	result = nbd_connection_negotiate(
+	          &connection,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	close(
+	 socket_descriptors[ 0 ] );
+
+	socket_descriptors[ 0 ] = -1;
+
+	close(
+	 socket_descriptors[ 1 ] );
+
+	socket_descriptors[ 1 ] = -1;
+
+	/* Test error cases
+	 */
+	result = nbd_connection_negotiate(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test negotiate with an invalid option magic
+	 */
+	result = socketpair(
+	          AF_UNIX,
+	          SOCK_STREAM,
+	          0,
+	          socket_descriptors );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	memory_set(
+	 &connection,
+	 0,
+	 sizeof( nbd_connection_t ) );
+
+	connection.socket_descriptor = socket_descriptors[ 0 ];
+
+	result = (int) send(
+	                socket_descriptors[ 1 ],
+	                client_flags,
+	                4,
+	                0 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 4 );
+
+	memory_set(
+	 reply_data,
+	 0xff,
+	 16 );
+
+	result = (int) send(
+	                socket_descriptors[ 1 ],
+	                reply_data,
+	                16,
+	                0 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 16 );
+
+	result = nbd_connection_negotiate(
+	          &connection,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	close(
+	 socket_descriptors[ 0 ] );
+
+	socket_descriptors[ 0 ] = -1;
+
+	close(
+	 socket_descriptors[ 1 ] );
+
+	socket_descriptors[ 1 ] = -1;
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( socket_descriptors[ 1 ] != -1 )
+	{
+		close(
+		 socket_descriptors[ 1 ] );
+	}
+	if( socket_descriptors[ 0 ] != -1 )
+	{
+		close(
+		 socket_descriptors[ 0 ] );
+	}
+	return( 0 );
+}
+
+/* Tests the nbd_connection_process_request function with requests that are answered without data
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_nbd_connection_process_request(
+     void )
+{
+	uint16_t request_types[ 4 ]   = { EWF_TEST_NBD_CMD_FLUSH, EWF_TEST_NBD_CMD_WRITE, 99, EWF_TEST_NBD_CMD_READ };
+	uint32_t request_lengths[ 4 ] = { 0, 0, 0, ( 32 * 1024 * 1024 ) + 1 };
+	uint32_t error_codes[ 4 ]     = { 0, 1, 22, 22 };
+	uint8_t reply_data[ 16 ];
+	int socket_descriptors[ 2 ]   = { -1, -1 };
+
+	nbd_connection_t connection;
+	nbd_request_t request;
+
+	libcerror_error_t *error      = NULL;
+	uint64_t cookie               = 0;
+	uint32_t error_code           = 0;
+	uint32_t magic                = 0;
+	int request_index             = 0;
+	int result                    = 0;
+
+	/* Initialize test
+	 */
+	memory_set(
+	 &connection,
+	 0,
+	 sizeof( nbd_connection_t ) );
+
+	result = socketpair(
+	          AF_UNIX,
+	          SOCK_STREAM,
+	          0,
+	          socket_descriptors );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	connection.socket_descriptor = socket_descriptors[ 0 ];
+
+	/* The media is large enough for the read that exceeds the maximum request size
+	 */
+	connection.media_size = 64 * 1024 * 1024;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	result = libcthreads_mutex_initialize(
+	          &( connection.write_mutex ),
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+#endif
+	/* Test regular cases
+	 */
+	for( request_index = 0;
+	     request_index < 4;
+	     request_index++ )
+	{
+		memory_set(
+		 &request,
+		 0,
+		 sizeof( nbd_request_t ) );
+
+		request.type   = request_types[ request_index ];
+		request.cookie = 0x1000 + request_index;
+		request.length = request_lengths[ request_index ];
+
+		result = nbd_connection_process_request(
+		          &connection,
+		          &request,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = ewf_test_nbd_connection_read_socket(
+		          socket_descriptors[ 1 ],
+		          reply_data,
+		          16 );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		byte_stream_copy_to_uint32_big_endian(
+		 &( reply_data[ 0 ] ),
+		 magic );
+
+		EWF_TEST_ASSERT_EQUAL_UINT32(
+		 "magic",
+		 magic,
+		 (uint32_t) EWF_TEST_NBD_MAGIC_SIMPLE_REPLY );
+
+		byte_stream_copy_to_uint32_big_endian(
+		 &( reply_data[ 4 ] ),
+		 error_code );
+
+		EWF_TEST_ASSERT_EQUAL_UINT32(
+		 "error_code",
+		 error_code,
+		 error_codes[ request_index ] );
+
+		byte_stream_copy_to_uint64_big_endian(
+		 &( reply_data[ 8 ] ),
+		 cookie );
+
+		EWF_TEST_ASSERT_EQUAL_UINT64(
+		 "cookie",
+		 cookie,
+		 (uint64_t) 0x1000 + request_index );
+	}
+	/* Test error cases
+	 */
+	result = nbd_connection_process_request(
+	          &connection,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	result = libcthreads_mutex_free(
+	          &( connection.write_mutex ),
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+#endif
+	close(
+	 socket_descriptors[ 0 ] );
+
+	socket_descriptors[ 0 ] = -1;
+
+	close(
+	 socket_descriptors[ 1 ] );
+
+	socket_descriptors[ 1 ] = -1;
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( connection.write_mutex != NULL )
+	{
+		libcthreads_mutex_free(
+		 &( connection.write_mutex ),
+		 NULL );
+	}
+#endif
+	if( socket_descriptors[ 1 ] != -1 )
+	{
+		close(
+		 socket_descriptors[ 1 ] );
+	}
+	if( socket_descriptors[ 0 ] != -1 )
+	{
+		close(
+		 socket_descriptors[ 0 ] );
+	}
+	return( 0 );
+}
+
+#endif /* defined( HAVE_SYS_SOCKET_H ) && defined( HAVE_SYS_UN_H ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( HAVE_SYS_SOCKET_H ) && defined( HAVE_SYS_UN_H )
+
+	EWF_TEST_RUN(
+	 "nbd_connection_read_option_header_data",
+	 ewf_test_nbd_connection_read_option_header_data );
+
+	EWF_TEST_RUN(
+	 "nbd_connection_check_info_option_data",
+	 ewf_test_nbd_connection_check_info_option_data );
+
+	EWF_TEST_RUN(
+	 "nbd_connection_read_meta_context_option_data",
+	 ewf_test_nbd_connection_read_meta_context_option_data );
+
+	EWF_TEST_RUN(
+	 "nbd_connection_read_request_data",
+	 ewf_test_nbd_connection_read_request_data );
+
+	EWF_TEST_RUN(
+	 "nbd_connection_negotiate",
+	 ewf_test_nbd_connection_negotiate );
+
+	EWF_TEST_RUN(
+	 "nbd_connection_process_request",
+	 ewf_test_nbd_connection_process_request );
+
+#endif /* defined( HAVE_SYS_SOCKET_H ) && defined( HAVE_SYS_UN_H ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( HAVE_SYS_SOCKET_H ) && defined( HAVE_SYS_UN_H )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( HAVE_SYS_SOCKET_H ) && defined( HAVE_SYS_UN_H ) */
+}
+
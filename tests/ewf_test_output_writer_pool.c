@@ -0,0 +1,1715 @@
+/*
+ * Tools output_writer_pool type test program
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libcfile.h"
+#include "ewf_test_libcthreads.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../ewftools/output_writer_pool.h"
+#include "../ewftools/storage_media_buffer.h"
+#include "../ewftools/storage_media_buffer_queue.h"
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* The number of chunks written, more than fit in the ring of the output writer pool
+ */
+#define EWF_TEST_OUTPUT_WRITER_POOL_NUMBER_OF_CHUNKS		64
+
+/* The number of storage media buffers in the storage media buffer queue
+ */
+#define EWF_TEST_OUTPUT_WRITER_POOL_NUMBER_OF_QUEUED_BUFFERS	32
+
+/* The number of output handles, the primary and 2 secondary targets
+ */
+#define EWF_TEST_OUTPUT_WRITER_POOL_NUMBER_OF_OUTPUT_HANDLES	3
+
+/* The number of chunks the media size of the failing target can hold
+ */
+#define EWF_TEST_OUTPUT_WRITER_POOL_NUMBER_OF_FAILING_CHUNKS	8
+
+const system_character_t *ewf_test_output_writer_pool_target_basenames[ EWF_TEST_OUTPUT_WRITER_POOL_NUMBER_OF_OUTPUT_HANDLES ] = {
+	_SYSTEM_STRING( "ewf_test_output_writer_pool_target1" ),
+	_SYSTEM_STRING( "ewf_test_output_writer_pool_target2" ),
+	_SYSTEM_STRING( "ewf_test_output_writer_pool_target3" ) };
+
+const system_character_t *ewf_test_output_writer_pool_target_filenames[ EWF_TEST_OUTPUT_WRITER_POOL_NUMBER_OF_OUTPUT_HANDLES ] = {
+	_SYSTEM_STRING( "ewf_test_output_writer_pool_target1.E01" ),
+	_SYSTEM_STRING( "ewf_test_output_writer_pool_target2.E01" ),
+	_SYSTEM_STRING( "ewf_test_output_writer_pool_target3.E01" ) };
+
+/* Fills a buffer with the test data of a chunk
+ * Every fourth chunk is empty and the other chunks alternate between
+ * incompressible and compressible data
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_output_writer_pool_fill_buffer(
+     uint8_t *buffer,
+     size_t buffer_size,
+     uint32_t chunk_index,
+     libcerror_error_t **error )
+{
+	static char *function = "ewf_test_output_writer_pool_fill_buffer";
+	size_t buffer_index   = 0;
+	uint32_t value_32bit  = 0;
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunk_index % 4 ) == 1 )
+	{
+		if( memory_set(
+		     buffer,
+		     0,
+		     buffer_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear buffer.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	else if( ( chunk_index % 4 ) == 3 )
+	{
+		for( buffer_index = 0;
+		     buffer_index < buffer_size;
+		     buffer_index++ )
+		{
+			buffer[ buffer_index ] = (uint8_t) ( 'A' + ( ( buffer_index / 512 ) % 26 ) );
+		}
+	}
+	else
+	{
+		value_32bit = 0x12345678UL ^ chunk_index;
+
+		for( buffer_index = 0;
+		     buffer_index < buffer_size;
+		     buffer_index++ )
+		{
+			value_32bit = ( value_32bit * 1103515245UL ) + 12345UL;
+
+			buffer[ buffer_index ] = (uint8_t) ( value_32bit >> 24 );
+		}
+	}
+	return( 1 );
+}
+
+/* Opens an output handle for writing
+ * The header values are set to fixed values so that the output is reproducible
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_output_writer_pool_open_output_handle(
+     libewf_handle_t **output_handle,
+     const system_character_t *basename,
+     size64_t media_size,
+     libcerror_error_t **error )
+{
+	static char *function = "ewf_test_output_writer_pool_open_output_handle";
+
+	if( output_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid output handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libewf_handle_initialize(
+	     output_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create output handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_handle_open_wide(
+	     *output_handle,
+	     (wchar_t * const *) &basename,
+	     1,
+	     LIBEWF_OPEN_WRITE,
+	     error ) != 1 )
+#else
+	if( libewf_handle_open(
+	     *output_handle,
+	     (char * const *) &basename,
+	     1,
+	     LIBEWF_OPEN_WRITE,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open output handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( media_size > 0 )
+	{
+		if( libewf_handle_set_media_size(
+		     *output_handle,
+		     media_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set media size.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libewf_handle_set_compression_values(
+	     *output_handle,
+	     LIBEWF_COMPRESSION_FAST,
+	     LIBEWF_COMPRESS_FLAG_USE_EMPTY_BLOCK_COMPRESSION,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set compression values.",
+		 function );
+
+		goto on_error;
+	}
+	/* Without the dates the current time is stored in the header sections
+	 */
+	if( libewf_handle_set_utf8_header_value(
+	     *output_handle,
+	     (uint8_t *) "acquiry_date",
+	     12,
+	     (uint8_t *) "2020 12 30 12 00 00",
+	     19,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set header value: acquiry_date.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_set_utf8_header_value(
+	     *output_handle,
+	     (uint8_t *) "system_date",
+	     11,
+	     (uint8_t *) "2020 12 30 12 00 00",
+	     19,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set header value: system_date.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *output_handle != NULL )
+	{
+		libewf_handle_free(
+		 output_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Closes and frees an output handle
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_output_writer_pool_close_output_handle(
+     libewf_handle_t **output_handle,
+     uint8_t finalize,
+     libcerror_error_t **error )
+{
+	static char *function = "ewf_test_output_writer_pool_close_output_handle";
+	int result = 1;
+
+	if( output_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid output handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *output_handle == NULL )
+	{
+		return( 1 );
+	}
+	if( finalize != 0 )
+	{
+		if( libewf_handle_write_finalize(
+		     *output_handle,
+		     error ) < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to finalize output handle.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( libewf_handle_close(
+	     *output_handle,
+	     ( result == 1 ) ? error : NULL ) != 0 )
+	{
+		if( result == 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close output handle.",
+			 function );
+		}
+		result = -1;
+	}
+	if( libewf_handle_free(
+	     output_handle,
+	     ( result == 1 ) ? error : NULL ) != 1 )
+	{
+		if( result == 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free output handle.",
+			 function );
+		}
+		result = -1;
+	}
+	return( result );
+}
+
+/* Removes a file created by the tests, if it exists
+ */
+void ewf_test_output_writer_pool_remove_file(
+      const system_character_t *filename )
+{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	libcfile_file_remove_wide(
+	 filename,
+	 NULL );
+#else
+	libcfile_file_remove(
+	 filename,
+	 NULL );
+#endif
+}
+
+/* Compares the media data of a file with the test data
+ * Returns 1 if equal, 0 if not or -1 on error
+ */
+int ewf_test_output_writer_pool_compare_media_data(
+     const system_character_t *filename,
+     size32_t chunk_size,
+     uint32_t number_of_chunks,
+     libcerror_error_t **error )
+{
+	libewf_handle_t *input_handle = NULL;
+	uint8_t *expected_buffer      = NULL;
+	uint8_t *read_buffer          = NULL;
+	static char *function         = "ewf_test_output_writer_pool_compare_media_data";
+	size64_t media_size           = 0;
+	ssize_t read_count            = 0;
+	uint32_t chunk_index          = 0;
+	int result                    = 1;
+
+	if( libewf_handle_initialize(
+	     &input_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create input handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libewf_handle_open_wide(
+	     input_handle,
+	     (wchar_t * const *) &filename,
+	     1,
+	     LIBEWF_OPEN_READ,
+	     error ) != 1 )
+#else
+	if( libewf_handle_open(
+	     input_handle,
+	     (char * const *) &filename,
+	     1,
+	     LIBEWF_OPEN_READ,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open input handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_get_media_size(
+	     input_handle,
+	     &media_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size.",
+		 function );
+
+		goto on_error;
+	}
+	if( media_size != ( (size64_t) chunk_size * number_of_chunks ) )
+	{
+		result = 0;
+	}
+	if( result == 1 )
+	{
+		expected_buffer = (uint8_t *) memory_allocate(
+		                               sizeof( uint8_t ) * chunk_size );
+
+		if( expected_buffer == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create expected buffer.",
+			 function );
+
+			goto on_error;
+		}
+		read_buffer = (uint8_t *) memory_allocate(
+		                           sizeof( uint8_t ) * chunk_size );
+
+		if( read_buffer == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create read buffer.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	for( chunk_index = 0;
+	     ( result == 1 ) && ( chunk_index < number_of_chunks );
+	     chunk_index++ )
+	{
+		if( ewf_test_output_writer_pool_fill_buffer(
+		     expected_buffer,
+		     (size_t) chunk_size,
+		     chunk_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to fill expected buffer.",
+			 function );
+
+			goto on_error;
+		}
+		read_count = libewf_handle_read_buffer(
+		              input_handle,
+		              read_buffer,
+		              (size_t) chunk_size,
+		              error );
+
+		if( read_count != (ssize_t) chunk_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read chunk: %" PRIu32 " from input handle.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		if( memory_compare(
+		     expected_buffer,
+		     read_buffer,
+		     (size_t) chunk_size ) != 0 )
+		{
+			result = 0;
+		}
+	}
+	if( read_buffer != NULL )
+	{
+		memory_free(
+		 read_buffer );
+
+		read_buffer = NULL;
+	}
+	if( expected_buffer != NULL )
+	{
+		memory_free(
+		 expected_buffer );
+
+		expected_buffer = NULL;
+	}
+	if( libewf_handle_close(
+	     input_handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close input handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libewf_handle_free(
+	     &input_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free input handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( read_buffer != NULL )
+	{
+		memory_free(
+		 read_buffer );
+	}
+	if( expected_buffer != NULL )
+	{
+		memory_free(
+		 expected_buffer );
+	}
+	if( input_handle != NULL )
+	{
+		libewf_handle_close(
+		 input_handle,
+		 NULL );
+
+		libewf_handle_free(
+		 &input_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Writes the test data to the output handles of an output writer pool
+ * The chunks are processed and pushed the same way the imaging handle does
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_output_writer_pool_write_chunks(
+     output_writer_pool_t *output_writer_pool,
+     libcthreads_queue_t *storage_media_buffer_queue,
+     size32_t chunk_size,
+     uint32_t number_of_chunks,
+     libcerror_error_t **error )
+{
+	storage_media_buffer_t *storage_media_buffer = NULL;
+	static char *function = "ewf_test_output_writer_pool_write_chunks";
+	ssize_t process_count = 0;
+	uint32_t chunk_index  = 0;
+
+	for( chunk_index = 0;
+	     chunk_index < number_of_chunks;
+	     chunk_index++ )
+	{
+		if( storage_media_buffer_queue_grab_buffer(
+		     storage_media_buffer_queue,
+		     &storage_media_buffer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to grab storage media buffer from queue.",
+			 function );
+
+			goto on_error;
+		}
+		if( ewf_test_output_writer_pool_fill_buffer(
+		     storage_media_buffer->raw_buffer,
+		     (size_t) chunk_size,
+		     chunk_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to fill storage media buffer.",
+			 function );
+
+			goto on_error;
+		}
+		storage_media_buffer->storage_media_offset = (off64_t) chunk_index * chunk_size;
+		storage_media_buffer->requested_size       = (size_t) chunk_size;
+		storage_media_buffer->raw_buffer_data_size = (size_t) chunk_size;
+
+		process_count = storage_media_buffer_write_process(
+		                 storage_media_buffer,
+		                 error );
+
+		if( process_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to prepare storage media buffer before write.",
+			 function );
+
+			goto on_error;
+		}
+		if( output_writer_pool_push(
+		     output_writer_pool,
+		     storage_media_buffer,
+		     storage_media_buffer->processed_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to push storage media buffer onto output writer pool.",
+			 function );
+
+			goto on_error;
+		}
+		storage_media_buffer = NULL;
+	}
+	return( 1 );
+
+on_error:
+	if( storage_media_buffer != NULL )
+	{
+		storage_media_buffer_queue_release_buffer(
+		 storage_media_buffer_queue,
+		 storage_media_buffer,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Tests the output_writer_pool_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_output_writer_pool_initialize(
+     void )
+{
+	libcerror_error_t *error                        = NULL;
+	libcthreads_queue_t *storage_media_buffer_queue = NULL;
+	libewf_handle_t *output_handles[ OUTPUT_WRITER_POOL_MAXIMUM_NUMBER_OF_OUTPUT_HANDLES + 1 ];
+	output_writer_pool_t *output_writer_pool        = NULL;
+	int output_handle_index                         = 0;
+	int result                                      = 0;
+
+	for( output_handle_index = 0;
+	     output_handle_index < ( OUTPUT_WRITER_POOL_MAXIMUM_NUMBER_OF_OUTPUT_HANDLES + 1 );
+	     output_handle_index++ )
+	{
+		output_handles[ output_handle_index ] = NULL;
+	}
+	/* Initialize test
+	 */
+	for( output_handle_index = 0;
+	     output_handle_index < ( OUTPUT_WRITER_POOL_MAXIMUM_NUMBER_OF_OUTPUT_HANDLES + 1 );
+	     output_handle_index++ )
+	{
+		result = libewf_handle_initialize(
+		          &( output_handles[ output_handle_index ] ),
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = libcthreads_queue_initialize(
+	          &storage_media_buffer_queue,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = output_writer_pool_initialize(
+	          &output_writer_pool,
+	          output_handles,
+	          OUTPUT_WRITER_POOL_MAXIMUM_NUMBER_OF_OUTPUT_HANDLES,
+	          storage_media_buffer_queue,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "output_writer_pool",
+	 output_writer_pool );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "output_writer_pool->number_of_workers",
+	 output_writer_pool->number_of_workers,
+	 OUTPUT_WRITER_POOL_MAXIMUM_NUMBER_OF_OUTPUT_HANDLES );
+
+	result = output_writer_pool_free(
+	          &output_writer_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "output_writer_pool",
+	 output_writer_pool );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = output_writer_pool_initialize(
+	          NULL,
+	          output_handles,
+	          1,
+	          storage_media_buffer_queue,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	output_writer_pool = (output_writer_pool_t *) 0x12345678UL;
+
+	result = output_writer_pool_initialize(
+	          &output_writer_pool,
+	          output_handles,
+	          1,
+	          storage_media_buffer_queue,
+	          &error );
+
+	output_writer_pool = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = output_writer_pool_initialize(
+	          &output_writer_pool,
+	          NULL,
+	          1,
+	          storage_media_buffer_queue,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "output_writer_pool",
+	 output_writer_pool );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = output_writer_pool_initialize(
+	          &output_writer_pool,
+	          output_handles,
+	          0,
+	          storage_media_buffer_queue,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "output_writer_pool",
+	 output_writer_pool );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = output_writer_pool_initialize(
+	          &output_writer_pool,
+	          output_handles,
+	          OUTPUT_WRITER_POOL_MAXIMUM_NUMBER_OF_OUTPUT_HANDLES + 1,
+	          storage_media_buffer_queue,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "output_writer_pool",
+	 output_writer_pool );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = output_writer_pool_initialize(
+	          &output_writer_pool,
+	          output_handles,
+	          1,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "output_writer_pool",
+	 output_writer_pool );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test with a missing output handle
+	 */
+	result = libewf_handle_free(
+	          &( output_handles[ 1 ] ),
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = output_writer_pool_initialize(
+	          &output_writer_pool,
+	          output_handles,
+	          2,
+	          storage_media_buffer_queue,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "output_writer_pool",
+	 output_writer_pool );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libcthreads_queue_free(
+	          &storage_media_buffer_queue,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( output_handle_index = 0;
+	     output_handle_index < ( OUTPUT_WRITER_POOL_MAXIMUM_NUMBER_OF_OUTPUT_HANDLES + 1 );
+	     output_handle_index++ )
+	{
+		if( output_handles[ output_handle_index ] != NULL )
+		{
+			result = libewf_handle_free(
+			          &( output_handles[ output_handle_index ] ),
+			          &error );
+
+			EWF_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			EWF_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( output_writer_pool != NULL )
+	{
+		output_writer_pool_free(
+		 &output_writer_pool,
+		 NULL );
+	}
+	if( storage_media_buffer_queue != NULL )
+	{
+		libcthreads_queue_free(
+		 &storage_media_buffer_queue,
+		 NULL,
+		 NULL );
+	}
+	for( output_handle_index = 0;
+	     output_handle_index < ( OUTPUT_WRITER_POOL_MAXIMUM_NUMBER_OF_OUTPUT_HANDLES + 1 );
+	     output_handle_index++ )
+	{
+		if( output_handles[ output_handle_index ] != NULL )
+		{
+			libewf_handle_free(
+			 &( output_handles[ output_handle_index ] ),
+			 NULL );
+		}
+	}
+	return( 0 );
+}
+
+/* Tests the output_writer_pool_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_output_writer_pool_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result = 0;
+
+	/* Test error cases
+	 */
+	result = output_writer_pool_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the output_writer_pool_push and output_writer_pool_join functions
+ * with multiple output handles, the media data of every output handle must
+ * match the data that was written
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_output_writer_pool_write_multiple_targets(
+     void )
+{
+	libcerror_error_t *error                        = NULL;
+	libcthreads_queue_t *storage_media_buffer_queue = NULL;
+	libewf_handle_t *output_handles[ EWF_TEST_OUTPUT_WRITER_POOL_NUMBER_OF_OUTPUT_HANDLES ];
+	output_writer_pool_t *output_writer_pool        = NULL;
+	size64_t media_size                             = 0;
+	size32_t chunk_size                             = 0;
+	int output_handle_index                         = 0;
+	int result                                      = 0;
+
+	for( output_handle_index = 0;
+	     output_handle_index < EWF_TEST_OUTPUT_WRITER_POOL_NUMBER_OF_OUTPUT_HANDLES;
+	     output_handle_index++ )
+	{
+		output_handles[ output_handle_index ] = NULL;
+	}
+	for( output_handle_index = 0;
+	     output_handle_index < EWF_TEST_OUTPUT_WRITER_POOL_NUMBER_OF_OUTPUT_HANDLES;
+	     output_handle_index++ )
+	{
+		result = ewf_test_output_writer_pool_open_output_handle(
+		          &( output_handles[ output_handle_index ] ),
+		          ewf_test_output_writer_pool_target_basenames[ output_handle_index ],
+		          0,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = libewf_handle_get_chunk_size(
+	          output_handles[ 0 ],
+	          &chunk_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	media_size = (size64_t) chunk_size * EWF_TEST_OUTPUT_WRITER_POOL_NUMBER_OF_CHUNKS;
+
+	for( output_handle_index = 0;
+	     output_handle_index < EWF_TEST_OUTPUT_WRITER_POOL_NUMBER_OF_OUTPUT_HANDLES;
+	     output_handle_index++ )
+	{
+		result = libewf_handle_set_media_size(
+		          output_handles[ output_handle_index ],
+		          media_size,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* The storage media buffers are created from the primary output handle
+	 * and the chunks are packed once for every output handle
+	 */
+	result = storage_media_buffer_queue_initialize(
+	          &storage_media_buffer_queue,
+	          output_handles[ 0 ],
+	          EWF_TEST_OUTPUT_WRITER_POOL_NUMBER_OF_QUEUED_BUFFERS,
+	          STORAGE_MEDIA_BUFFER_MODE_CHUNK_DATA,
+	          (size_t) chunk_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = output_writer_pool_initialize(
+	          &output_writer_pool,
+	          output_handles,
+	          EWF_TEST_OUTPUT_WRITER_POOL_NUMBER_OF_OUTPUT_HANDLES,
+	          storage_media_buffer_queue,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = ewf_test_output_writer_pool_write_chunks(
+	          output_writer_pool,
+	          storage_media_buffer_queue,
+	          chunk_size,
+	          EWF_TEST_OUTPUT_WRITER_POOL_NUMBER_OF_CHUNKS,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = output_writer_pool_join(
+	          output_writer_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "output_writer_pool->number_of_buffers",
+	 output_writer_pool->number_of_buffers,
+	 (uint64_t) EWF_TEST_OUTPUT_WRITER_POOL_NUMBER_OF_CHUNKS );
+
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "output_writer_pool->number_of_released_buffers",
+	 output_writer_pool->number_of_released_buffers,
+	 (uint64_t) EWF_TEST_OUTPUT_WRITER_POOL_NUMBER_OF_CHUNKS );
+
+	for( output_handle_index = 0;
+	     output_handle_index < EWF_TEST_OUTPUT_WRITER_POOL_NUMBER_OF_OUTPUT_HANDLES;
+	     output_handle_index++ )
+	{
+		EWF_TEST_ASSERT_EQUAL_UINT64(
+		 "number_of_written_buffers",
+		 output_writer_pool->workers[ output_handle_index ].number_of_written_buffers,
+		 (uint64_t) EWF_TEST_OUTPUT_WRITER_POOL_NUMBER_OF_CHUNKS );
+	}
+	/* Test error cases
+	 */
+	result = output_writer_pool_push(
+	          NULL,
+	          NULL,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = output_writer_pool_push(
+	          output_writer_pool,
+	          NULL,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = output_writer_pool_join(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = output_writer_pool_free(
+	          &output_writer_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = storage_media_buffer_queue_free(
+	          &storage_media_buffer_queue,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( output_handle_index = 0;
+	     output_handle_index < EWF_TEST_OUTPUT_WRITER_POOL_NUMBER_OF_OUTPUT_HANDLES;
+	     output_handle_index++ )
+	{
+		result = ewf_test_output_writer_pool_close_output_handle(
+		          &( output_handles[ output_handle_index ] ),
+		          1,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* The media data of every target must match the data that was written
+	 */
+	for( output_handle_index = 0;
+	     output_handle_index < EWF_TEST_OUTPUT_WRITER_POOL_NUMBER_OF_OUTPUT_HANDLES;
+	     output_handle_index++ )
+	{
+		result = ewf_test_output_writer_pool_compare_media_data(
+		          ewf_test_output_writer_pool_target_filenames[ output_handle_index ],
+		          chunk_size,
+		          EWF_TEST_OUTPUT_WRITER_POOL_NUMBER_OF_CHUNKS,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	for( output_handle_index = 0;
+	     output_handle_index < EWF_TEST_OUTPUT_WRITER_POOL_NUMBER_OF_OUTPUT_HANDLES;
+	     output_handle_index++ )
+	{
+		ewf_test_output_writer_pool_remove_file(
+		 ewf_test_output_writer_pool_target_filenames[ output_handle_index ] );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( output_writer_pool != NULL )
+	{
+		output_writer_pool_free(
+		 &output_writer_pool,
+		 NULL );
+	}
+	if( storage_media_buffer_queue != NULL )
+	{
+		storage_media_buffer_queue_free(
+		 &storage_media_buffer_queue,
+		 NULL );
+	}
+	for( output_handle_index = 0;
+	     output_handle_index < EWF_TEST_OUTPUT_WRITER_POOL_NUMBER_OF_OUTPUT_HANDLES;
+	     output_handle_index++ )
+	{
+		ewf_test_output_writer_pool_close_output_handle(
+		 &( output_handles[ output_handle_index ] ),
+		 0,
+		 NULL );
+
+		ewf_test_output_writer_pool_remove_file(
+		 ewf_test_output_writer_pool_target_filenames[ output_handle_index ] );
+	}
+	return( 0 );
+}
+
+/* Tests the output_writer_pool_push and output_writer_pool_join functions
+ * with an output handle that fails part way through the data
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_output_writer_pool_write_failing_target(
+     void )
+{
+	libcerror_error_t *error                        = NULL;
+	libcthreads_queue_t *storage_media_buffer_queue = NULL;
+	libewf_handle_t *output_handles[ EWF_TEST_OUTPUT_WRITER_POOL_NUMBER_OF_OUTPUT_HANDLES ];
+	output_writer_pool_t *output_writer_pool        = NULL;
+	size64_t media_size                             = 0;
+	size32_t chunk_size                             = 0;
+	int output_handle_index                         = 0;
+	int result                                      = 0;
+
+	for( output_handle_index = 0;
+	     output_handle_index < EWF_TEST_OUTPUT_WRITER_POOL_NUMBER_OF_OUTPUT_HANDLES;
+	     output_handle_index++ )
+	{
+		output_handles[ output_handle_index ] = NULL;
+	}
+	/* Initialize test
+	 */
+	for( output_handle_index = 0;
+	     output_handle_index < EWF_TEST_OUTPUT_WRITER_POOL_NUMBER_OF_OUTPUT_HANDLES;
+	     output_handle_index++ )
+	{
+		result = ewf_test_output_writer_pool_open_output_handle(
+		          &( output_handles[ output_handle_index ] ),
+		          ewf_test_output_writer_pool_target_basenames[ output_handle_index ],
+		          0,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = libewf_handle_get_chunk_size(
+	          output_handles[ 0 ],
+	          &chunk_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( output_handle_index = 0;
+	     output_handle_index < EWF_TEST_OUTPUT_WRITER_POOL_NUMBER_OF_OUTPUT_HANDLES;
+	     output_handle_index++ )
+	{
+		media_size = (size64_t) chunk_size * EWF_TEST_OUTPUT_WRITER_POOL_NUMBER_OF_CHUNKS;
+
+		/* The media size of the last secondary target ends inside a chunk,
+		 * which makes writing that chunk to it fail
+		 */
+		if( output_handle_index == ( EWF_TEST_OUTPUT_WRITER_POOL_NUMBER_OF_OUTPUT_HANDLES - 1 ) )
+		{
+			media_size = ( (size64_t) chunk_size * EWF_TEST_OUTPUT_WRITER_POOL_NUMBER_OF_FAILING_CHUNKS ) + 512;
+		}
+		result = libewf_handle_set_media_size(
+		          output_handles[ output_handle_index ],
+		          media_size,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = storage_media_buffer_queue_initialize(
+	          &storage_media_buffer_queue,
+	          output_handles[ 0 ],
+	          EWF_TEST_OUTPUT_WRITER_POOL_NUMBER_OF_QUEUED_BUFFERS,
+	          STORAGE_MEDIA_BUFFER_MODE_CHUNK_DATA,
+	          (size_t) chunk_size,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = output_writer_pool_initialize(
+	          &output_writer_pool,
+	          output_handles,
+	          EWF_TEST_OUTPUT_WRITER_POOL_NUMBER_OF_OUTPUT_HANDLES,
+	          storage_media_buffer_queue,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = ewf_test_output_writer_pool_write_chunks(
+	          output_writer_pool,
+	          storage_media_buffer_queue,
+	          chunk_size,
+	          EWF_TEST_OUTPUT_WRITER_POOL_NUMBER_OF_CHUNKS,
+	          &error );
+
+	/* Depending on how far the other threads got pushing can fail
+	 * before all the chunks were pushed
+	 */
+	if( result == -1 )
+	{
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+	else
+	{
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = output_writer_pool_join(
+	          output_writer_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "output_writer_pool->status",
+	 output_writer_pool->status,
+	 0 );
+
+	/* Every pushed buffer must have been released onto the storage media buffer queue
+	 */
+	EWF_TEST_ASSERT_EQUAL_UINT64(
+	 "output_writer_pool->number_of_released_buffers",
+	 output_writer_pool->number_of_released_buffers,
+	 output_writer_pool->number_of_buffers );
+
+	/* Pushing after the output writer pool was joined must fail
+	 */
+	result = ewf_test_output_writer_pool_write_chunks(
+	          output_writer_pool,
+	          storage_media_buffer_queue,
+	          chunk_size,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = output_writer_pool_free(
+	          &output_writer_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = storage_media_buffer_queue_free(
+	          &storage_media_buffer_queue,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( output_handle_index = 0;
+	     output_handle_index < EWF_TEST_OUTPUT_WRITER_POOL_NUMBER_OF_OUTPUT_HANDLES;
+	     output_handle_index++ )
+	{
+		/* The output is incomplete, errors on close are expected
+		 */
+		ewf_test_output_writer_pool_close_output_handle(
+		 &( output_handles[ output_handle_index ] ),
+		 0,
+		 NULL );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "output_handle",
+		 output_handles[ output_handle_index ] );
+
+		ewf_test_output_writer_pool_remove_file(
+		 ewf_test_output_writer_pool_target_filenames[ output_handle_index ] );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( output_writer_pool != NULL )
+	{
+		output_writer_pool_free(
+		 &output_writer_pool,
+		 NULL );
+	}
+	if( storage_media_buffer_queue != NULL )
+	{
+		storage_media_buffer_queue_free(
+		 &storage_media_buffer_queue,
+		 NULL );
+	}
+	for( output_handle_index = 0;
+	     output_handle_index < EWF_TEST_OUTPUT_WRITER_POOL_NUMBER_OF_OUTPUT_HANDLES;
+	     output_handle_index++ )
+	{
+		ewf_test_output_writer_pool_close_output_handle(
+		 &( output_handles[ output_handle_index ] ),
+		 0,
+		 NULL );
+
+		ewf_test_output_writer_pool_remove_file(
+		 ewf_test_output_writer_pool_target_filenames[ output_handle_index ] );
+	}
+	return( 0 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+	EWF_TEST_RUN(
+	 "output_writer_pool_initialize",
+	 ewf_test_output_writer_pool_initialize );
+
+	EWF_TEST_RUN(
+	 "output_writer_pool_free",
+	 ewf_test_output_writer_pool_free );
+
+	EWF_TEST_RUN(
+	 "output_writer_pool_write_multiple_targets",
+	 ewf_test_output_writer_pool_write_multiple_targets );
+
+	EWF_TEST_RUN(
+	 "output_writer_pool_write_failing_target",
+	 ewf_test_output_writer_pool_write_failing_target );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+}
+
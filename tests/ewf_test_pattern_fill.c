@@ -0,0 +1,162 @@
+/*
+ * Library pattern fill SIMD functions test program
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_pattern_fill.h"
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+#define EWF_TEST_PATTERN_FILL_BUFFER_SIZE	600
+
+uint8_t ewf_test_pattern_fill_buffer[ EWF_TEST_PATTERN_FILL_BUFFER_SIZE + 1 ];
+
+uint8_t ewf_test_pattern_fill_patterns[ 3 ][ 8 ] = {
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },
+	{ 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff },
+	{ 0x01, 0x02, 0x03, 0xfe, 0x05, 0x06, 0x07, 0x80 } };
+
+/* Determines the expected prefix size byte by byte
+ * Returns the size of the prefix, which is a multiple of 8 or the data size if all the data matches
+ */
+size_t ewf_test_pattern_fill_get_prefix_size_scalar(
+        const uint8_t *data,
+        size_t data_size,
+        const uint8_t *pattern )
+{
+	size_t data_offset = 0;
+
+	for( data_offset = 0;
+	     data_offset < data_size;
+	     data_offset++ )
+	{
+		if( data[ data_offset ] != pattern[ data_offset % 8 ] )
+		{
+			return( data_offset - ( data_offset % 8 ) );
+		}
+	}
+	return( data_size );
+}
+
+/* Tests the libewf_pattern_fill_get_prefix_size function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_pattern_fill_get_prefix_size(
+     void )
+{
+	size_t buffer_offset   = 0;
+	size_t data_size       = 0;
+	size_t expected        = 0;
+	size_t mismatch_offset = 0;
+	size_t prefix_size     = 0;
+	int pattern_index      = 0;
+
+	for( pattern_index = 0;
+	     pattern_index < 3;
+	     pattern_index++ )
+	{
+		for( data_size = 0;
+		     data_size <= EWF_TEST_PATTERN_FILL_BUFFER_SIZE;
+		     data_size += 13 )
+		{
+			/* A mismatch offset equal to the data size means no mismatch
+			 */
+			for( mismatch_offset = 0;
+			     mismatch_offset <= data_size;
+			     mismatch_offset += 7 )
+			{
+				/* Use an unaligned buffer to make sure the kernels do not rely on alignment
+				 */
+				for( buffer_offset = 0;
+				     buffer_offset < EWF_TEST_PATTERN_FILL_BUFFER_SIZE;
+				     buffer_offset++ )
+				{
+					ewf_test_pattern_fill_buffer[ buffer_offset + 1 ] = ewf_test_pattern_fill_patterns[ pattern_index ][ buffer_offset % 8 ];
+				}
+				if( mismatch_offset < data_size )
+				{
+					ewf_test_pattern_fill_buffer[ mismatch_offset + 1 ] ^= 0x10;
+				}
+				expected = ewf_test_pattern_fill_get_prefix_size_scalar(
+				            &( ewf_test_pattern_fill_buffer[ 1 ] ),
+				            data_size,
+				            ewf_test_pattern_fill_patterns[ pattern_index ] );
+
+				prefix_size = libewf_pattern_fill_get_prefix_size(
+				               &( ewf_test_pattern_fill_buffer[ 1 ] ),
+				               data_size,
+				               ewf_test_pattern_fill_patterns[ pattern_index ] );
+
+				EWF_TEST_ASSERT_EQUAL_SIZE(
+				 "prefix_size",
+				 prefix_size,
+				 expected );
+			}
+		}
+	}
+	return( 1 );
+
+on_error:
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_pattern_fill_get_prefix_size",
+	 ewf_test_pattern_fill_get_prefix_size );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
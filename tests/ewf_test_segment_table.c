@@ -33,6 +33,7 @@
 #include "ewf_test_memory.h"
 #include "ewf_test_unused.h"
 
+#include "../libewf/libewf_definitions.h"
 #include "../libewf/libewf_segment_table.h"
 
 #if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
@@ -264,6 +265,197 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libewf_segment_table_map_segment_files_to_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_segment_table_map_segment_files_to_offset(
+     void )
+{
+	libcerror_error_t *error              = NULL;
+	libewf_io_handle_t *io_handle         = NULL;
+	libewf_segment_table_t *segment_table = NULL;
+	int result                            = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_segment_table_initialize(
+	          &segment_table,
+	          io_handle,
+	          LIBEWF_DEFAULT_SEGMENT_FILE_SIZE,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "segment_table",
+	 segment_table );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_segment_table_map_segment_files_to_offset(
+	          segment_table,
+	          NULL,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test without segments to map
+	 */
+	segment_table->flags |= LIBEWF_SEGMENT_TABLE_FLAG_HAS_UNMAPPED_SEGMENTS;
+
+	result = libewf_segment_table_map_segment_files_to_offset(
+	          segment_table,
+	          NULL,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "segment_table->flags",
+	 ( segment_table->flags & LIBEWF_SEGMENT_TABLE_FLAG_HAS_UNMAPPED_SEGMENTS ),
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libewf_segment_table_map_segment_files_to_offset(
+	          NULL,
+	          NULL,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	segment_table->flags |= LIBEWF_SEGMENT_TABLE_FLAG_HAS_UNMAPPED_SEGMENTS;
+
+	result = libewf_segment_table_map_segment_files_to_offset(
+	          segment_table,
+	          NULL,
+	          -1,
+	          &error );
+
+	segment_table->flags &= ~( LIBEWF_SEGMENT_TABLE_FLAG_HAS_UNMAPPED_SEGMENTS );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_segment_table_free(
+	          &segment_table,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "segment_table",
+	 segment_table );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( segment_table != NULL )
+	{
+		libewf_segment_table_free(
+		 &segment_table,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libewf_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
 #endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
 
 /* The main program
@@ -323,6 +515,10 @@ int main(
 
 	/* TODO: add tests for libewf_segment_table_set_segment_storage_media_size_by_index */
 
+	EWF_TEST_RUN(
+	 "libewf_segment_table_map_segment_files_to_offset",
+	 ewf_test_segment_table_map_segment_files_to_offset );
+
 	/* TODO: add tests for libewf_segment_table_get_segment_file_by_index */
 
 	/* TODO: add tests for libewf_segment_table_get_segment_file_at_offset */
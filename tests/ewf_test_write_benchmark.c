@@ -0,0 +1,661 @@
+/*
+ * Segment file write benchmark program
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_FCNTL_H )
+#include <fcntl.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include <stdio.h>
+#include <time.h>
+
+#include "ewf_test_libbfio.h"
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_buffered_file_io_handle.h"
+#include "../libewf/libewf_definitions.h"
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) && defined( LIBEWF_HAVE_BUFFERED_FILE_IO )
+
+/* The benchmark writes the data the way a segment file is written, every chunk
+ * is followed by its 4-byte checksum and a group of chunks is preceded by a section descriptor
+ */
+#define EWF_TEST_WRITE_BENCHMARK_CHUNK_SIZE		32768
+#define EWF_TEST_WRITE_BENCHMARK_NUMBER_OF_CHUNKS	8192
+#define EWF_TEST_WRITE_BENCHMARK_CHUNKS_PER_SECTION	2048
+#define EWF_TEST_WRITE_BENCHMARK_SECTION_SIZE		76
+
+#define EWF_TEST_WRITE_BENCHMARK_NUMBER_OF_MODES	4
+
+/* The write modes, unbuffered writes through libbfio_file as segment files were written before
+ * the buffered file IO handle
+ */
+const char *ewf_test_write_benchmark_mode_names[ EWF_TEST_WRITE_BENCHMARK_NUMBER_OF_MODES ] = {
+	"unbuffered",
+	"buffered",
+	"nocache",
+	"direct" };
+
+uint8_t ewf_test_write_benchmark_mode_write_flags[ EWF_TEST_WRITE_BENCHMARK_NUMBER_OF_MODES ] = {
+	0,
+	0,
+	LIBEWF_WRITE_FLAG_DONT_CACHE,
+	LIBEWF_WRITE_FLAG_DIRECT_IO };
+
+/* Retrieves the number of write system calls of the process
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int ewf_test_write_benchmark_get_number_of_write_calls(
+     uint64_t *number_of_write_calls,
+     libcerror_error_t **error )
+{
+	char line[ 128 ];
+
+	FILE *stream             = NULL;
+	static char *function    = "ewf_test_write_benchmark_get_number_of_write_calls";
+	unsigned long long value = 0;
+	int result               = 0;
+
+	if( number_of_write_calls == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of write calls.",
+		 function );
+
+		return( -1 );
+	}
+	/* The I/O accounting of Linux counts the write system calls in syscw
+	 */
+	stream = file_stream_open(
+	          "/proc/self/io",
+	          "r" );
+
+	if( stream == NULL )
+	{
+		return( 0 );
+	}
+	while( file_stream_get_string(
+	        stream,
+	        line,
+	        128 ) != NULL )
+	{
+		if( sscanf(
+		     line,
+		     "syscw: %llu",
+		     &value ) == 1 )
+		{
+			*number_of_write_calls = (uint64_t) value;
+
+			result = 1;
+
+			break;
+		}
+	}
+	file_stream_close(
+	 stream );
+
+	return( result );
+}
+
+/* Retrieves the current time in seconds
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_write_benchmark_get_time(
+     double *seconds,
+     libcerror_error_t **error )
+{
+	struct timespec time_value;
+
+	static char *function = "ewf_test_write_benchmark_get_time";
+
+	if( seconds == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid seconds.",
+		 function );
+
+		return( -1 );
+	}
+	if( clock_gettime(
+	     CLOCK_MONOTONIC,
+	     &time_value ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve time.",
+		 function );
+
+		return( -1 );
+	}
+	*seconds = (double) time_value.tv_sec + ( (double) time_value.tv_nsec / 1000000000.0 );
+
+	return( 1 );
+}
+
+/* Writes the benchmark data to a file IO handle
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_write_benchmark_write_data(
+     libbfio_handle_t *file_io_handle,
+     const uint8_t *chunk_data,
+     libcerror_error_t **error )
+{
+	uint8_t checksum_data[ 4 ];
+	uint8_t section_data[ EWF_TEST_WRITE_BENCHMARK_SECTION_SIZE ];
+
+	static char *function = "ewf_test_write_benchmark_write_data";
+	ssize_t write_count   = 0;
+	int chunk_index       = 0;
+
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     section_data,
+	     0,
+	     EWF_TEST_WRITE_BENCHMARK_SECTION_SIZE ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear section data.",
+		 function );
+
+		return( -1 );
+	}
+	for( chunk_index = 0;
+	     chunk_index < EWF_TEST_WRITE_BENCHMARK_NUMBER_OF_CHUNKS;
+	     chunk_index++ )
+	{
+		if( ( chunk_index % EWF_TEST_WRITE_BENCHMARK_CHUNKS_PER_SECTION ) == 0 )
+		{
+			write_count = libbfio_handle_write_buffer(
+			               file_io_handle,
+			               section_data,
+			               EWF_TEST_WRITE_BENCHMARK_SECTION_SIZE,
+			               error );
+
+			if( write_count != (ssize_t) EWF_TEST_WRITE_BENCHMARK_SECTION_SIZE )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write section data.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		write_count = libbfio_handle_write_buffer(
+		               file_io_handle,
+		               chunk_data,
+		               EWF_TEST_WRITE_BENCHMARK_CHUNK_SIZE,
+		               error );
+
+		if( write_count != (ssize_t) EWF_TEST_WRITE_BENCHMARK_CHUNK_SIZE )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write chunk: %d data.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+		checksum_data[ 0 ] = (uint8_t) chunk_index;
+		checksum_data[ 1 ] = (uint8_t) ( chunk_index >> 8 );
+		checksum_data[ 2 ] = 0;
+		checksum_data[ 3 ] = 0;
+
+		write_count = libbfio_handle_write_buffer(
+		               file_io_handle,
+		               checksum_data,
+		               4,
+		               error );
+
+		if( write_count != 4 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write chunk: %d checksum.",
+			 function,
+			 chunk_index );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Runs the benchmark for a specific write mode
+ * The time includes writing the data to the storage media
+ * Returns 1 if successful or -1 on error
+ */
+int ewf_test_write_benchmark_run(
+     const char *filename,
+     int mode_index,
+     const uint8_t *chunk_data,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	static char *function            = "ewf_test_write_benchmark_run";
+	size_t filename_length           = 0;
+	uint64_t end_write_calls         = 0;
+	uint64_t start_write_calls       = 0;
+	double end_time                  = 0.0;
+	double megabytes                 = 0.0;
+	double start_time                = 0.0;
+	int file_descriptor              = -1;
+	int has_write_calls              = 0;
+
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( mode_index < 0 )
+	 || ( mode_index >= EWF_TEST_WRITE_BENCHMARK_NUMBER_OF_MODES ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid mode index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	filename_length = narrow_string_length(
+	                   filename );
+
+	if( mode_index == 0 )
+	{
+		if( libbfio_file_initialize(
+		     &file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+		if( libbfio_file_set_name(
+		     file_io_handle,
+		     filename,
+		     filename_length,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set name in file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	else
+	{
+		if( libewf_buffered_file_initialize(
+		     &file_io_handle,
+		     filename,
+		     filename_length + 1,
+		     LIBEWF_DEFAULT_SEGMENT_WRITE_BUFFER_SIZE,
+		     ewf_test_write_benchmark_mode_write_flags[ mode_index ],
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create buffered file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	has_write_calls = ewf_test_write_benchmark_get_number_of_write_calls(
+	                   &start_write_calls,
+	                   error );
+
+	if( has_write_calls == -1 )
+	{
+		goto on_error;
+	}
+	if( ewf_test_write_benchmark_get_time(
+	     &start_time,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( libbfio_handle_open(
+	     file_io_handle,
+	     LIBBFIO_OPEN_WRITE_TRUNCATE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file: %s.",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	if( ewf_test_write_benchmark_write_data(
+	     file_io_handle,
+	     chunk_data,
+	     error ) != 1 )
+	{
+		libbfio_handle_close(
+		 file_io_handle,
+		 NULL );
+
+		goto on_error;
+	}
+	if( libbfio_handle_close(
+	     file_io_handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file: %s.",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	if( has_write_calls != 0 )
+	{
+		has_write_calls = ewf_test_write_benchmark_get_number_of_write_calls(
+		                   &end_write_calls,
+		                   error );
+
+		if( has_write_calls == -1 )
+		{
+			goto on_error;
+		}
+	}
+	/* Include writing the data to the storage media otherwise the page cache is measured
+	 */
+	file_descriptor = open(
+	                   filename,
+	                   O_WRONLY );
+
+	if( file_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file: %s.",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	if( fsync(
+	     file_descriptor ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 "%s: unable to synchronize file: %s.",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	close(
+	 file_descriptor );
+
+	file_descriptor = -1;
+
+	if( ewf_test_write_benchmark_get_time(
+	     &end_time,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( libbfio_handle_free(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	unlink(
+	 filename );
+
+	megabytes = (double) EWF_TEST_WRITE_BENCHMARK_NUMBER_OF_CHUNKS
+	          * (double) ( EWF_TEST_WRITE_BENCHMARK_CHUNK_SIZE + 4 )
+	          / ( 1024.0 * 1024.0 );
+
+	if( has_write_calls != 0 )
+	{
+		fprintf(
+		 stdout,
+		 "%-12s%12" PRIu64 "",
+		 ewf_test_write_benchmark_mode_names[ mode_index ],
+		 end_write_calls - start_write_calls );
+	}
+	else
+	{
+		fprintf(
+		 stdout,
+		 "%-12s%12s",
+		 ewf_test_write_benchmark_mode_names[ mode_index ],
+		 "n/a" );
+	}
+	fprintf(
+	 stdout,
+	 "%12.3f%12.1f\n",
+	 end_time - start_time,
+	 megabytes / ( end_time - start_time ) );
+
+	return( 1 );
+
+on_error:
+	if( file_descriptor != -1 )
+	{
+		close(
+		 file_descriptor );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	unlink(
+	 filename );
+
+	return( -1 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) && defined( LIBEWF_HAVE_BUFFERED_FILE_IO ) */
+
+/* The main program
+ */
+int main( int argc, char * const argv[] )
+{
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) && defined( LIBEWF_HAVE_BUFFERED_FILE_IO )
+	libcerror_error_t *error = NULL;
+	uint8_t *chunk_data      = NULL;
+	int data_index           = 0;
+	int mode_index           = 0;
+
+	if( argc < 2 )
+	{
+		fprintf(
+		 stderr,
+		 "Usage: ewf_test_write_benchmark filename\n\n"
+		 "Writes %d MiB of %d KiB chunks, each followed by a 4-byte checksum, to\n"
+		 "the file with every write mode and prints the number of write system\n"
+		 "calls, the time in seconds and the throughput in MiB/s per mode.\n"
+		 "The file is removed afterwards.\n",
+		 ( EWF_TEST_WRITE_BENCHMARK_NUMBER_OF_CHUNKS * EWF_TEST_WRITE_BENCHMARK_CHUNK_SIZE ) / ( 1024 * 1024 ),
+		 EWF_TEST_WRITE_BENCHMARK_CHUNK_SIZE / 1024 );
+
+		return( EXIT_FAILURE );
+	}
+	chunk_data = (uint8_t *) memory_allocate(
+	                          sizeof( uint8_t ) * EWF_TEST_WRITE_BENCHMARK_CHUNK_SIZE );
+
+	if( chunk_data == NULL )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create chunk data.\n" );
+
+		goto on_error;
+	}
+	/* Use data that does not compress to resemble stored chunks
+	 */
+	srand(
+	 0x45574631 );
+
+	for( data_index = 0;
+	     data_index < EWF_TEST_WRITE_BENCHMARK_CHUNK_SIZE;
+	     data_index++ )
+	{
+		chunk_data[ data_index ] = (uint8_t) rand();
+	}
+	fprintf(
+	 stdout,
+	 "%-12s%12s%12s%12s\n",
+	 "Write mode",
+	 "Writes",
+	 "Seconds",
+	 "MiB/s" );
+
+	for( mode_index = 0;
+	     mode_index < EWF_TEST_WRITE_BENCHMARK_NUMBER_OF_MODES;
+	     mode_index++ )
+	{
+		if( ewf_test_write_benchmark_run(
+		     argv[ 1 ],
+		     mode_index,
+		     chunk_data,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to run benchmark with write mode: %s.\n",
+			 ewf_test_write_benchmark_mode_names[ mode_index ] );
+
+			goto on_error;
+		}
+	}
+	memory_free(
+	 chunk_data );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_backtrace_fprint(
+		 error,
+		 stderr );
+
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_data != NULL )
+	{
+		memory_free(
+		 chunk_data );
+	}
+	return( EXIT_FAILURE );
+
+#else
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+	fprintf(
+	 stderr,
+	 "Buffered file IO is not supported on this platform.\n" );
+
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) && defined( LIBEWF_HAVE_BUFFERED_FILE_IO ) */
+}
+
@@ -33,6 +33,9 @@
 #include "ewf_test_memory.h"
 #include "ewf_test_unused.h"
 
+#include "../libewf/libewf_chunk_data.h"
+#include "../libewf/libewf_definitions.h"
+#include "../libewf/libewf_io_handle.h"
 #include "../libewf/libewf_write_io_handle.h"
 
 #if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT )
@@ -648,6 +651,658 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libewf_write_io_handle_get_pack_flags function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_write_io_handle_get_pack_flags(
+     void )
+{
+	libcerror_error_t *error                  = NULL;
+	libewf_io_handle_t *io_handle             = NULL;
+	libewf_write_io_handle_t *write_io_handle = NULL;
+	uint8_t pack_flags                        = 0;
+	int result                                = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_write_io_handle_initialize(
+	          &write_io_handle,
+	          io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "write_io_handle",
+	 write_io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	write_io_handle->pack_flags = LIBEWF_PACK_FLAG_CALCULATE_CHECKSUM;
+
+	/* Test regular cases
+	 */
+	result = libewf_write_io_handle_get_pack_flags(
+	          write_io_handle,
+	          &pack_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "pack_flags",
+	 pack_flags,
+	 (uint8_t) LIBEWF_PACK_FLAG_CALCULATE_CHECKSUM );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	write_io_handle->use_trial_compression = 1;
+
+	result = libewf_write_io_handle_get_pack_flags(
+	          write_io_handle,
+	          &pack_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "pack_flags",
+	 pack_flags,
+	 (uint8_t) ( LIBEWF_PACK_FLAG_CALCULATE_CHECKSUM | LIBEWF_PACK_FLAG_USE_TRIAL_COMPRESSION ) );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The trial compression flag is not stored in the shared pack flags
+	 */
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "write_io_handle->pack_flags",
+	 write_io_handle->pack_flags,
+	 (uint8_t) LIBEWF_PACK_FLAG_CALCULATE_CHECKSUM );
+
+	/* Test error cases
+	 */
+	result = libewf_write_io_handle_get_pack_flags(
+	          NULL,
+	          &pack_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_write_io_handle_get_pack_flags(
+	          write_io_handle,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_write_io_handle_free(
+	          &write_io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "write_io_handle",
+	 write_io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( write_io_handle != NULL )
+	{
+		libewf_write_io_handle_free(
+		 &write_io_handle,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libewf_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Writes a number of chunks with the same range flags to the adaptive compression state
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_write_io_handle_update_adaptive_compression_chunks(
+     libewf_write_io_handle_t *write_io_handle,
+     libewf_io_handle_t *io_handle,
+     libewf_chunk_data_t *chunk_data,
+     uint32_t range_flags,
+     int number_of_chunks )
+{
+	libcerror_error_t *error = NULL;
+	int chunk_number         = 0;
+	int result               = 0;
+
+	chunk_data->range_flags = range_flags;
+
+	for( chunk_number = 0;
+	     chunk_number < number_of_chunks;
+	     chunk_number++ )
+	{
+		result = libewf_write_io_handle_update_adaptive_compression(
+		          write_io_handle,
+		          io_handle,
+		          chunk_data,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_write_io_handle_update_adaptive_compression function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_write_io_handle_update_adaptive_compression(
+     void )
+{
+	libcerror_error_t *error                  = NULL;
+	libewf_chunk_data_t *chunk_data           = NULL;
+	libewf_io_handle_t *io_handle             = NULL;
+	libewf_write_io_handle_t *write_io_handle = NULL;
+	uint8_t pack_flags                        = 0;
+	int result                                = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	io_handle->compression_level = LIBEWF_COMPRESSION_FAST;
+	io_handle->compression_flags = LIBEWF_COMPRESS_FLAG_USE_ADAPTIVE_COMPRESSION;
+
+	result = libewf_write_io_handle_initialize(
+	          &write_io_handle,
+	          io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "write_io_handle",
+	 write_io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	write_io_handle->pack_flags = LIBEWF_PACK_FLAG_CALCULATE_CHECKSUM;
+
+	result = libewf_chunk_data_initialize(
+	          &chunk_data,
+	          512,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_data",
+	 chunk_data );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that trial compression is not used before the threshold of incompressible chunks
+	 */
+	result = ewf_test_write_io_handle_update_adaptive_compression_chunks(
+	          write_io_handle,
+	          io_handle,
+	          chunk_data,
+	          0,
+	          LIBEWF_ADAPTIVE_COMPRESSION_NUMBER_OF_INCOMPRESSIBLE_CHUNKS - 1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "write_io_handle->number_of_incompressible_chunks",
+	 write_io_handle->number_of_incompressible_chunks,
+	 (uint32_t) ( LIBEWF_ADAPTIVE_COMPRESSION_NUMBER_OF_INCOMPRESSIBLE_CHUNKS - 1 ) );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "write_io_handle->use_trial_compression",
+	 write_io_handle->use_trial_compression,
+	 0 );
+
+	/* Test that trial compression is used at the threshold of incompressible chunks
+	 */
+	result = ewf_test_write_io_handle_update_adaptive_compression_chunks(
+	          write_io_handle,
+	          io_handle,
+	          chunk_data,
+	          0,
+	          1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "write_io_handle->number_of_incompressible_chunks",
+	 write_io_handle->number_of_incompressible_chunks,
+	 (uint32_t) LIBEWF_ADAPTIVE_COMPRESSION_NUMBER_OF_INCOMPRESSIBLE_CHUNKS );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "write_io_handle->use_trial_compression",
+	 write_io_handle->use_trial_compression,
+	 1 );
+
+	result = libewf_write_io_handle_get_pack_flags(
+	          write_io_handle,
+	          &pack_flags,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "pack_flags",
+	 pack_flags,
+	 (uint8_t) ( LIBEWF_PACK_FLAG_CALCULATE_CHECKSUM | LIBEWF_PACK_FLAG_USE_TRIAL_COMPRESSION ) );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that the number of incompressible chunks does not exceed the threshold
+	 */
+	result = ewf_test_write_io_handle_update_adaptive_compression_chunks(
+	          write_io_handle,
+	          io_handle,
+	          chunk_data,
+	          0,
+	          2 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "write_io_handle->number_of_incompressible_chunks",
+	 write_io_handle->number_of_incompressible_chunks,
+	 (uint32_t) LIBEWF_ADAPTIVE_COMPRESSION_NUMBER_OF_INCOMPRESSIBLE_CHUNKS );
+
+	/* Test that a compressed chunk resets the adaptive compression state
+	 */
+	result = ewf_test_write_io_handle_update_adaptive_compression_chunks(
+	          write_io_handle,
+	          io_handle,
+	          chunk_data,
+	          LIBEWF_RANGE_FLAG_IS_COMPRESSED,
+	          1 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "write_io_handle->number_of_incompressible_chunks",
+	 write_io_handle->number_of_incompressible_chunks,
+	 (uint32_t) 0 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "write_io_handle->use_trial_compression",
+	 write_io_handle->use_trial_compression,
+	 0 );
+
+	/* The adaptive compression state is not stored in the shared pack flags
+	 */
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "write_io_handle->pack_flags",
+	 write_io_handle->pack_flags,
+	 (uint8_t) LIBEWF_PACK_FLAG_CALCULATE_CHECKSUM );
+
+	/* Test that the adaptive compression state is not changed when compression is forced
+	 */
+	write_io_handle->pack_flags |= LIBEWF_PACK_FLAG_FORCE_COMPRESSION;
+
+	result = ewf_test_write_io_handle_update_adaptive_compression_chunks(
+	          write_io_handle,
+	          io_handle,
+	          chunk_data,
+	          0,
+	          LIBEWF_ADAPTIVE_COMPRESSION_NUMBER_OF_INCOMPRESSIBLE_CHUNKS );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "write_io_handle->number_of_incompressible_chunks",
+	 write_io_handle->number_of_incompressible_chunks,
+	 (uint32_t) 0 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "write_io_handle->use_trial_compression",
+	 write_io_handle->use_trial_compression,
+	 0 );
+
+	write_io_handle->pack_flags &= ~( LIBEWF_PACK_FLAG_FORCE_COMPRESSION );
+
+	/* Test that the adaptive compression state is not changed without compression
+	 */
+	io_handle->compression_level = LIBEWF_COMPRESSION_NONE;
+
+	result = ewf_test_write_io_handle_update_adaptive_compression_chunks(
+	          write_io_handle,
+	          io_handle,
+	          chunk_data,
+	          0,
+	          LIBEWF_ADAPTIVE_COMPRESSION_NUMBER_OF_INCOMPRESSIBLE_CHUNKS );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "write_io_handle->number_of_incompressible_chunks",
+	 write_io_handle->number_of_incompressible_chunks,
+	 (uint32_t) 0 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "write_io_handle->use_trial_compression",
+	 write_io_handle->use_trial_compression,
+	 0 );
+
+	io_handle->compression_level = LIBEWF_COMPRESSION_FAST;
+
+	/* Test that the adaptive compression state is not changed without adaptive compression
+	 */
+	io_handle->compression_flags = 0;
+
+	result = ewf_test_write_io_handle_update_adaptive_compression_chunks(
+	          write_io_handle,
+	          io_handle,
+	          chunk_data,
+	          0,
+	          LIBEWF_ADAPTIVE_COMPRESSION_NUMBER_OF_INCOMPRESSIBLE_CHUNKS );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT32(
+	 "write_io_handle->number_of_incompressible_chunks",
+	 write_io_handle->number_of_incompressible_chunks,
+	 (uint32_t) 0 );
+
+	EWF_TEST_ASSERT_EQUAL_UINT8(
+	 "write_io_handle->use_trial_compression",
+	 write_io_handle->use_trial_compression,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libewf_write_io_handle_update_adaptive_compression(
+	          NULL,
+	          io_handle,
+	          chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_write_io_handle_update_adaptive_compression(
+	          write_io_handle,
+	          NULL,
+	          chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_write_io_handle_update_adaptive_compression(
+	          write_io_handle,
+	          io_handle,
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_chunk_data_free(
+	          &chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_data",
+	 chunk_data );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_write_io_handle_free(
+	          &write_io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "write_io_handle",
+	 write_io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
+	if( write_io_handle != NULL )
+	{
+		libewf_write_io_handle_free(
+		 &write_io_handle,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libewf_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
 #endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) */
 
 /* The main program
@@ -699,6 +1354,14 @@ int main(
 
 	/* TODO: add tests for libewf_write_io_handle_write_chunks_section_end */
 
+	EWF_TEST_RUN(
+	 "libewf_write_io_handle_get_pack_flags",
+	 ewf_test_write_io_handle_get_pack_flags );
+
+	EWF_TEST_RUN(
+	 "libewf_write_io_handle_update_adaptive_compression",
+	 ewf_test_write_io_handle_update_adaptive_compression );
+
 	/* TODO: add tests for libewf_write_io_handle_write_new_chunk */
 
 	/* TODO: add tests for libewf_write_io_handle_finalize_write_sections_corrections */
@@ -0,0 +1,986 @@
+/*
+ * Library write_pipeline type test program
+ *
+ * Copyright (C) 2006-2020, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "ewf_test_libcerror.h"
+#include "ewf_test_libewf.h"
+#include "ewf_test_macros.h"
+#include "ewf_test_memory.h"
+#include "ewf_test_unused.h"
+
+#include "../libewf/libewf_chunk_data.h"
+#include "../libewf/libewf_chunk_data_pool.h"
+#include "../libewf/libewf_definitions.h"
+#include "../libewf/libewf_io_handle.h"
+#include "../libewf/libewf_write_pipeline.h"
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) && defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+/* Tests the libewf_write_pipeline_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_write_pipeline_initialize(
+     void )
+{
+	libcerror_error_t *error                = NULL;
+	libewf_io_handle_t *io_handle           = NULL;
+	libewf_write_pipeline_t *write_pipeline = NULL;
+	int result                              = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libewf_write_pipeline_initialize(
+	          &write_pipeline,
+	          2,
+	          io_handle,
+	          NULL,
+	          NULL,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "write_pipeline",
+	 write_pipeline );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "write_pipeline->maximum_number_of_jobs",
+	 write_pipeline->maximum_number_of_jobs,
+	 4 );
+
+	result = libewf_write_pipeline_free(
+	          &write_pipeline,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "write_pipeline",
+	 write_pipeline );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_write_pipeline_initialize(
+	          NULL,
+	          2,
+	          io_handle,
+	          NULL,
+	          NULL,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	write_pipeline = (libewf_write_pipeline_t *) 0x12345678UL;
+
+	result = libewf_write_pipeline_initialize(
+	          &write_pipeline,
+	          2,
+	          io_handle,
+	          NULL,
+	          NULL,
+	          0,
+	          &error );
+
+	write_pipeline = NULL;
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_write_pipeline_initialize(
+	          &write_pipeline,
+	          0,
+	          io_handle,
+	          NULL,
+	          NULL,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_write_pipeline_initialize(
+	          &write_pipeline,
+	          2,
+	          NULL,
+	          NULL,
+	          NULL,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( write_pipeline != NULL )
+	{
+		libewf_write_pipeline_free(
+		 &write_pipeline,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libewf_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_write_pipeline_free function
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_write_pipeline_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libewf_write_pipeline_free(
+	          NULL,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_write_pipeline_push and libewf_write_pipeline_pop functions
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_write_pipeline_push_and_pop(
+     void )
+{
+	libcerror_error_t *error                = NULL;
+	libewf_chunk_data_t *chunk_data         = NULL;
+	libewf_io_handle_t *io_handle           = NULL;
+	libewf_write_pipeline_t *write_pipeline = NULL;
+	size_t input_data_size                  = 0;
+	uint64_t chunk_index                    = 0;
+	uint64_t expected_chunk_index           = 0;
+	int result                              = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_write_pipeline_initialize(
+	          &write_pipeline,
+	          2,
+	          io_handle,
+	          NULL,
+	          NULL,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "write_pipeline",
+	 write_pipeline );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	for( chunk_index = 0;
+	     chunk_index < 4;
+	     chunk_index++ )
+	{
+		result = libewf_chunk_data_initialize(
+		          &chunk_data,
+		          512,
+		          1,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "chunk_data",
+		 chunk_data );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		chunk_data->data_size = 512;
+
+		result = libewf_write_pipeline_push(
+		          write_pipeline,
+		          chunk_index,
+		          chunk_data,
+		          512,
+		          LIBEWF_COMPRESSION_NONE,
+		          0,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		chunk_data = NULL;
+	}
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "write_pipeline->number_of_jobs",
+	 write_pipeline->number_of_jobs,
+	 4 );
+
+	/* The pipeline is full
+	 */
+	result = libewf_chunk_data_initialize(
+	          &chunk_data,
+	          512,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libewf_write_pipeline_push(
+	          write_pipeline,
+	          4,
+	          chunk_data,
+	          512,
+	          LIBEWF_COMPRESSION_NONE,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_chunk_data_free(
+	          &chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* The chunk data is returned in chunk index order
+	 */
+	for( expected_chunk_index = 0;
+	     expected_chunk_index < 4;
+	     expected_chunk_index++ )
+	{
+		result = libewf_write_pipeline_pop(
+		          write_pipeline,
+		          &chunk_index,
+		          &chunk_data,
+		          &input_data_size,
+		          1,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		EWF_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		EWF_TEST_ASSERT_EQUAL_UINT64(
+		 "chunk_index",
+		 chunk_index,
+		 expected_chunk_index );
+
+		EWF_TEST_ASSERT_EQUAL_SIZE(
+		 "input_data_size",
+		 input_data_size,
+		 (size_t) 512 );
+
+		EWF_TEST_ASSERT_IS_NOT_NULL(
+		 "chunk_data",
+		 chunk_data );
+
+		EWF_TEST_ASSERT_NOT_EQUAL_INT(
+		 "chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_PACKED",
+		 (int) ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_PACKED ),
+		 0 );
+
+		result = libewf_chunk_data_free(
+		          &chunk_data,
+		          &error );
+
+		EWF_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+	}
+	result = libewf_write_pipeline_pop(
+	          write_pipeline,
+	          &chunk_index,
+	          &chunk_data,
+	          &input_data_size,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libewf_write_pipeline_push(
+	          NULL,
+	          0,
+	          NULL,
+	          0,
+	          LIBEWF_COMPRESSION_NONE,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libewf_write_pipeline_pop(
+	          NULL,
+	          &chunk_index,
+	          &chunk_data,
+	          &input_data_size,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libewf_write_pipeline_free(
+	          &write_pipeline,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "write_pipeline",
+	 write_pipeline );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
+	if( write_pipeline != NULL )
+	{
+		libewf_write_pipeline_free(
+		 &write_pipeline,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libewf_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libewf_write_pipeline_pop function with chunk data that cannot be packed
+ * Returns 1 if successful or 0 if not
+ */
+int ewf_test_write_pipeline_pop_with_pack_error(
+     void )
+{
+	libcerror_error_t *error                  = NULL;
+	libewf_chunk_data_t *chunk_data           = NULL;
+	libewf_chunk_data_pool_t *chunk_data_pool = NULL;
+	libewf_io_handle_t *io_handle             = NULL;
+	libewf_write_pipeline_t *write_pipeline   = NULL;
+	size_t input_data_size                    = 0;
+	uint64_t chunk_index                      = 0;
+	int result                                = 0;
+
+	/* Initialize test
+	 */
+	result = libewf_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_data_pool_initialize(
+	          &chunk_data_pool,
+	          512,
+	          4,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_data_pool",
+	 chunk_data_pool );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_write_pipeline_initialize(
+	          &write_pipeline,
+	          2,
+	          io_handle,
+	          chunk_data_pool,
+	          NULL,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "write_pipeline",
+	 write_pipeline );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test forced compression without a compression level does not modify the IO handle
+	 */
+	result = libewf_chunk_data_pool_get_chunk_data(
+	          chunk_data_pool,
+	          &chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_data",
+	 chunk_data );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	chunk_data->data_size = 512;
+
+	result = libewf_write_pipeline_push(
+	          write_pipeline,
+	          0,
+	          chunk_data,
+	          512,
+	          LIBEWF_COMPRESSION_NONE,
+	          LIBEWF_PACK_FLAG_FORCE_COMPRESSION,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	chunk_data = NULL;
+
+	result = libewf_write_pipeline_pop(
+	          write_pipeline,
+	          &chunk_index,
+	          &chunk_data,
+	          &input_data_size,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_data",
+	 chunk_data );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_NOT_EQUAL_INT(
+	 "chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED",
+	 (int) ( chunk_data->range_flags & LIBEWF_RANGE_FLAG_IS_COMPRESSED ),
+	 0 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "io_handle->compression_level",
+	 (int) io_handle->compression_level,
+	 (int) LIBEWF_COMPRESSION_NONE );
+
+	result = libewf_chunk_data_pool_release_chunk_data(
+	          chunk_data_pool,
+	          &chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "chunk_data_pool->number_of_free_chunk_data",
+	 chunk_data_pool->number_of_free_chunk_data,
+	 1 );
+
+	/* Test the chunk data of a job that cannot be packed is released to the chunk data pool
+	 */
+	io_handle->compression_method = 0xff;
+
+	result = libewf_chunk_data_pool_get_chunk_data(
+	          chunk_data_pool,
+	          &chunk_data,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "chunk_data",
+	 chunk_data );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "chunk_data_pool->number_of_free_chunk_data",
+	 chunk_data_pool->number_of_free_chunk_data,
+	 0 );
+
+	chunk_data->data_size = 512;
+
+	result = libewf_write_pipeline_push(
+	          write_pipeline,
+	          1,
+	          chunk_data,
+	          512,
+	          LIBEWF_COMPRESSION_DEFAULT,
+	          0,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	chunk_data = NULL;
+
+	result = libewf_write_pipeline_pop(
+	          write_pipeline,
+	          &chunk_index,
+	          &chunk_data,
+	          &input_data_size,
+	          1,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "chunk_data",
+	 chunk_data );
+
+	EWF_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "write_pipeline->number_of_jobs",
+	 write_pipeline->number_of_jobs,
+	 0 );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "chunk_data_pool->number_of_free_chunk_data",
+	 chunk_data_pool->number_of_free_chunk_data,
+	 1 );
+
+	/* Clean up
+	 */
+	result = libewf_write_pipeline_free(
+	          &write_pipeline,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "write_pipeline",
+	 write_pipeline );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_chunk_data_pool_free(
+	          &chunk_data_pool,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libewf_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	EWF_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	EWF_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( chunk_data != NULL )
+	{
+		libewf_chunk_data_free(
+		 &chunk_data,
+		 NULL );
+	}
+	if( write_pipeline != NULL )
+	{
+		libewf_write_pipeline_free(
+		 &write_pipeline,
+		 NULL );
+	}
+	if( chunk_data_pool != NULL )
+	{
+		libewf_chunk_data_pool_free(
+		 &chunk_data_pool,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libewf_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) && defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc EWF_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] EWF_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	EWF_TEST_UNREFERENCED_PARAMETER( argc )
+	EWF_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) && defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT )
+
+	EWF_TEST_RUN(
+	 "libewf_write_pipeline_initialize",
+	 ewf_test_write_pipeline_initialize );
+
+	EWF_TEST_RUN(
+	 "libewf_write_pipeline_free",
+	 ewf_test_write_pipeline_free );
+
+	EWF_TEST_RUN(
+	 "libewf_write_pipeline_push_and_pop",
+	 ewf_test_write_pipeline_push_and_pop );
+
+	EWF_TEST_RUN(
+	 "libewf_write_pipeline_pop_with_pack_error",
+	 ewf_test_write_pipeline_pop_with_pack_error );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBEWF_DLL_IMPORT ) && defined( HAVE_LIBEWF_MULTI_THREAD_SUPPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,172 @@
+#!/bin/bash
+# NBD server tool testing script
+#
+# Version: 20201230
+
+EXIT_SUCCESS=0;
+EXIT_FAILURE=1;
+EXIT_IGNORE=77;
+
+TEST_PREFIX=`dirname ${PWD}`;
+TEST_PREFIX=`basename ${TEST_PREFIX} | sed 's/^lib\([^-]*\)/\1/'`;
+
+# The input consists of 64 KiB of data, 128 KiB of zero bytes and 64 KiB of data
+# which is stored in chunks of 32 KiB
+ZERO_EXTENT_OFFSET=65536;
+ZERO_EXTENT_SIZE=131072;
+
+wait_for_socket()
+{
+	SOCKET_PATH=$1;
+
+	for ITERATION in `seq 1 50`;
+	do
+		if test -S "${SOCKET_PATH}";
+		then
+			return ${EXIT_SUCCESS};
+		fi
+		sleep 0.1;
+	done
+	return ${EXIT_FAILURE};
+}
+
+test_nbd_server()
+{
+	NUMBER_OF_JOBS=$1;
+
+	TMPDIR="tmp$$";
+
+	rm -rf ${TMPDIR};
+	mkdir ${TMPDIR};
+
+	INPUT_FILE="${TMPDIR}/input.raw";
+	SOCKET_PATH="${PWD}/${TMPDIR}/nbd.sock";
+	NBD_URI="nbd+unix:///?socket=${SOCKET_PATH}";
+
+	head -c 65536 /dev/urandom > ${INPUT_FILE};
+	head -c ${ZERO_EXTENT_SIZE} /dev/zero >> ${INPUT_FILE};
+	head -c 65536 /dev/urandom >> ${INPUT_FILE};
+
+	# Compressing with deflate:fast stores the zero byte chunks as compressed empty blocks
+	${ACQUIRESTREAM_TOOL} -q -b 64 -c deflate:fast -t ${TMPDIR}/image < ${INPUT_FILE} > /dev/null;
+
+	RESULT=$?;
+
+	SERVER_PID="";
+
+	if test ${RESULT} -eq ${EXIT_SUCCESS};
+	then
+		${NBD_TOOL} -j ${NUMBER_OF_JOBS} ${TMPDIR}/image.E01 ${SOCKET_PATH} > /dev/null &
+		SERVER_PID=$!;
+
+		wait_for_socket ${SOCKET_PATH};
+
+		RESULT=$?;
+	fi
+
+	# Comparing the export with the input covers the newstyle handshake and read requests
+	if test ${RESULT} -eq ${EXIT_SUCCESS};
+	then
+		${QEMU_IMG} compare -q -f raw -F raw "${NBD_URI}" ${INPUT_FILE};
+
+		RESULT=$?;
+	fi
+
+	# Mapping the export uses structured replies and base:allocation block status queries
+	if test ${RESULT} -eq ${EXIT_SUCCESS};
+	then
+		${QEMU_IMG} map --output=json -f raw "${NBD_URI}" | tr -d ' ' > ${TMPDIR}/map;
+
+		RESULT=$?;
+	fi
+	if test ${RESULT} -eq ${EXIT_SUCCESS};
+	then
+		ZERO_EXTENT=`grep "\"start\":${ZERO_EXTENT_OFFSET},\"length\":${ZERO_EXTENT_SIZE}," ${TMPDIR}/map`;
+
+		if test -z "${ZERO_EXTENT}";
+		then
+			RESULT=${EXIT_FAILURE};
+
+		elif ! echo "${ZERO_EXTENT}" | grep -q "\"zero\":true";
+		then
+			RESULT=${EXIT_FAILURE};
+
+		elif ! echo "${ZERO_EXTENT}" | grep -q "\"data\":false";
+		then
+			RESULT=${EXIT_FAILURE};
+		fi
+	fi
+	if test -n "${SERVER_PID}";
+	then
+		kill -INT ${SERVER_PID} 2> /dev/null;
+		wait ${SERVER_PID} 2> /dev/null;
+	fi
+	rm -rf ${TMPDIR};
+
+	echo -n "Testing ewfnbd with ${NUMBER_OF_JOBS} jobs";
+
+	if test ${RESULT} -ne ${EXIT_SUCCESS};
+	then
+		echo " (FAIL)";
+	else
+		echo " (PASS)";
+	fi
+	return ${RESULT};
+}
+
+if ! test -z ${SKIP_TOOLS_TESTS};
+then
+	exit ${EXIT_IGNORE};
+fi
+
+NBD_TOOL="../${TEST_PREFIX}tools/${TEST_PREFIX}nbd";
+
+if ! test -x "${NBD_TOOL}";
+then
+	NBD_TOOL="../${TEST_PREFIX}tools/${TEST_PREFIX}nbd.exe";
+fi
+
+if ! test -x "${NBD_TOOL}";
+then
+	echo "Missing executable: ${NBD_TOOL}";
+
+	exit ${EXIT_FAILURE};
+fi
+
+ACQUIRESTREAM_TOOL="../${TEST_PREFIX}tools/${TEST_PREFIX}acquirestream";
+
+if ! test -x "${ACQUIRESTREAM_TOOL}";
+then
+	ACQUIRESTREAM_TOOL="../${TEST_PREFIX}tools/${TEST_PREFIX}acquirestream.exe";
+fi
+
+if ! test -x "${ACQUIRESTREAM_TOOL}";
+then
+	echo "Missing executable: ${ACQUIRESTREAM_TOOL}";
+
+	exit ${EXIT_FAILURE};
+fi
+
+# qemu-img, which is distributed with qemu-nbd, is used as the NBD client
+QEMU_IMG=`which qemu-img 2> /dev/null`;
+
+if test -z "${QEMU_IMG}";
+then
+	echo "Missing NBD client: qemu-img";
+
+	exit ${EXIT_IGNORE};
+fi
+
+test_nbd_server 0
+RESULT=$?;
+
+if test ${RESULT} -ne ${EXIT_SUCCESS};
+then
+	exit ${RESULT};
+fi
+
+test_nbd_server 4
+RESULT=$?;
+
+exit ${RESULT};
+
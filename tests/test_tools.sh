@@ -7,7 +7,7 @@ EXIT_SUCCESS=0;
 EXIT_FAILURE=1;
 EXIT_IGNORE=77;
 
-TOOLS_TESTS="byte_size_string device_handle digest_hash guid info_handle platform verification_handle";
+TOOLS_TESTS="byte_size_string device_handle digest_hash digest_hash_pool guid info_handle nbd_connection output_writer_pool platform verification_handle";
 TOOLS_TESTS_WITH_INPUT="";
 OPTION_SETS="";
 